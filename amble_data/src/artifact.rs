@@ -0,0 +1,153 @@
+//! Precompiled binary world artifact.
+//!
+//! Alongside `world.ron`, `amble_script` writes `world.amblebin`: the same
+//! [`WorldDef`] encoded as CBOR behind a small fixed header. The compiler only
+//! writes an artifact for worlds that pass [`validate_world`](crate::validate_world),
+//! so an intact artifact can be loaded without re-validating it.
+//!
+//! # Layout
+//! ```text
+//! magic "AMBLEWLD" | version u16 LE | source_hash u64 LE | content_hash u64 LE | CBOR WorldDef
+//! ```
+//! `source_hash` is the FNV-1a hash of the RON world text written with the artifact;
+//! an artifact whose `source_hash` no longer matches the file on disk is stale.
+//! `content_hash` is the FNV-1a hash of the CBOR payload and guards against
+//! truncation/corruption.
+
+use crate::WorldDef;
+use std::io;
+use std::path::{Path, PathBuf};
+
+/// Current artifact layout version. Artifacts with another version are rejected.
+pub const ARTIFACT_VERSION: u16 = 2;
+
+/// File extension used for binary world artifacts.
+pub const ARTIFACT_EXTENSION: &str = "amblebin";
+
+const ARTIFACT_MAGIC: &[u8; 8] = b"AMBLEWLD";
+const HEADER_LEN: usize = 8 + 2 + 8 + 8;
+
+/// Path of the binary artifact for the compiled world at `world_path`.
+pub fn artifact_path(world_path: &Path) -> PathBuf {
+    world_path.with_extension(ARTIFACT_EXTENSION)
+}
+
+/// Header fields of a binary world artifact.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct ArtifactHeader {
+    pub version: u16,
+    pub source_hash: u64,
+    pub content_hash: u64,
+}
+
+impl ArtifactHeader {
+    /// True if the artifact was written for the RON world text `source`.
+    pub fn matches_source(&self, source: &[u8]) -> bool {
+        self.source_hash == content_hash(source)
+    }
+}
+
+/// Encode a validated `def` as an artifact accompanying the RON world text `source`.
+///
+/// # Errors
+/// Returns an error if the world cannot be encoded.
+pub fn encode_artifact(def: &WorldDef, source: &[u8]) -> io::Result<Vec<u8>> {
+    let mut payload = Vec::new();
+    ciborium::into_writer(def, &mut payload).map_err(io::Error::other)?;
+    let mut bytes = Vec::with_capacity(HEADER_LEN + payload.len());
+    bytes.extend_from_slice(ARTIFACT_MAGIC);
+    bytes.extend_from_slice(&ARTIFACT_VERSION.to_le_bytes());
+    bytes.extend_from_slice(&content_hash(source).to_le_bytes());
+    bytes.extend_from_slice(&content_hash(&payload).to_le_bytes());
+    bytes.extend_from_slice(&payload);
+    Ok(bytes)
+}
+
+/// Read just the header of an artifact.
+///
+/// # Errors
+/// Returns `InvalidData` if the bytes do not start with a current artifact header.
+pub fn read_artifact_header(bytes: &[u8]) -> io::Result<ArtifactHeader> {
+    if bytes.len() < HEADER_LEN || &bytes[..8] != ARTIFACT_MAGIC {
+        return Err(invalid("not a world artifact"));
+    }
+    let u64_at = |at: usize| u64::from_le_bytes(bytes[at..at + 8].try_into().expect("header slice length"));
+    let header = ArtifactHeader {
+        version: u16::from_le_bytes([bytes[8], bytes[9]]),
+        source_hash: u64_at(10),
+        content_hash: u64_at(18),
+    };
+    if header.version != ARTIFACT_VERSION {
+        return Err(invalid(&format!(
+            "unsupported world artifact version {} (expected {ARTIFACT_VERSION})",
+            header.version
+        )));
+    }
+    Ok(header)
+}
+
+/// Decode an artifact, verifying its content hash.
+///
+/// # Errors
+/// Returns `InvalidData` if the header is invalid, the payload does not match its
+/// hash, or the payload cannot be decoded as a `WorldDef`.
+pub fn decode_artifact(bytes: &[u8]) -> io::Result<(ArtifactHeader, WorldDef)> {
+    let header = read_artifact_header(bytes)?;
+    let payload = &bytes[HEADER_LEN..];
+    if content_hash(payload) != header.content_hash {
+        return Err(invalid("world artifact content hash mismatch"));
+    }
+    let def = ciborium::from_reader(payload).map_err(|err| invalid(&format!("decoding world artifact: {err}")))?;
+    Ok((header, def))
+}
+
+/// FNV-1a hash of `bytes`.
+pub fn content_hash(bytes: &[u8]) -> u64 {
+    bytes.iter().fold(0xcbf2_9ce4_8422_2325_u64, |hash, byte| {
+        (hash ^ u64::from(*byte)).wrapping_mul(0x0000_0100_0000_01b3)
+    })
+}
+
+fn invalid(msg: &str) -> io::Error {
+    io::Error::new(io::ErrorKind::InvalidData, msg.to_string())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn sample_def() -> WorldDef {
+        let mut def = WorldDef::default();
+        def.game.title = "Artifact Test".into();
+        def.game.slug = "artifact-test".into();
+        def
+    }
+
+    #[test]
+    fn artifact_round_trips() {
+        let bytes = encode_artifact(&sample_def(), b"(game: ())").unwrap();
+        let (header, def) = decode_artifact(&bytes).unwrap();
+        assert!(header.matches_source(b"(game: ())"));
+        // same length, different text
+        assert!(!header.matches_source(b"(game: [])"));
+        assert_eq!(header.version, ARTIFACT_VERSION);
+        assert_eq!(def.game.title, "Artifact Test");
+        assert_eq!(
+            artifact_path(Path::new("data/world.ron")),
+            PathBuf::from("data/world.amblebin")
+        );
+    }
+
+    #[test]
+    fn corrupt_or_truncated_artifacts_are_rejected() {
+        let bytes = encode_artifact(&sample_def(), b"(game: ())").unwrap();
+
+        let mut flipped = bytes.clone();
+        *flipped.last_mut().unwrap() ^= 0xFF;
+        assert!(decode_artifact(&flipped).is_err());
+
+        assert!(decode_artifact(&bytes[..bytes.len() - 1]).is_err());
+        assert!(decode_artifact(&bytes[..4]).is_err());
+        assert!(decode_artifact(b"(game: ())").is_err());
+    }
+}
@@ -1,7 +1,11 @@
 //! Shared data model for Amble content.
 
+pub mod artifact;
 pub mod defs;
+pub mod manifest;
 pub mod validate;
 
+pub use artifact::{ArtifactHeader, artifact_path, decode_artifact, encode_artifact};
 pub use defs::*;
+pub use manifest::{MANIFEST_VERSION, WorldManifest, manifest_path};
 pub use validate::{ValidationError, validate_world};
@@ -0,0 +1,90 @@
+//! Small metadata manifest written alongside each compiled world.
+//!
+//! The world chooser only needs a world's title, slug, author, version and blurb,
+//! but a compiled `world.ron` can run to hundreds of kilobytes. `amble_script
+//! compile-dir` therefore writes a [`WorldManifest`] next to the world file
+//! (`world.ron` -> `world.meta`) that the engine reads instead of parsing the world.
+//!
+//! The manifest records the byte length and FNV-1a hash of the world file it
+//! describes (the same hash the `.amblebin` artifact uses); a manifest whose length
+//! or hash no longer matches the file on disk is treated as stale and ignored.
+
+use crate::WorldDef;
+use crate::artifact::content_hash;
+use serde::{Deserialize, Serialize};
+use std::path::{Path, PathBuf};
+
+/// Current manifest layout version. Manifests with another version are ignored.
+pub const MANIFEST_VERSION: u32 = 2;
+
+/// File extension used for world manifests.
+pub const MANIFEST_EXTENSION: &str = "meta";
+
+/// World metadata needed to list a world without loading it.
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+pub struct WorldManifest {
+    pub manifest_version: u32,
+    pub title: String,
+    pub slug: String,
+    pub author: String,
+    pub version: String,
+    pub blurb: String,
+    /// Size in bytes of the compiled world file this manifest describes.
+    pub world_len: u64,
+    /// FNV-1a hash of that world file's text.
+    #[serde(default)]
+    pub source_hash: u64,
+}
+
+impl WorldManifest {
+    /// Build the manifest for `def`, serialized to the world file text `source`.
+    pub fn for_world(def: &WorldDef, source: &[u8]) -> Self {
+        WorldManifest {
+            manifest_version: MANIFEST_VERSION,
+            title: def.game.title.clone(),
+            slug: def.game.slug.clone(),
+            author: def.game.author.clone(),
+            version: def.game.version.clone(),
+            blurb: def.game.blurb.clone(),
+            world_len: source.len() as u64,
+            source_hash: content_hash(source),
+        }
+    }
+
+    /// True if this manifest describes the world file text `source` in the current layout.
+    pub fn is_current(&self, source: &[u8]) -> bool {
+        self.manifest_version == MANIFEST_VERSION
+            && self.world_len == source.len() as u64
+            && self.source_hash == content_hash(source)
+    }
+}
+
+/// Path of the manifest for the compiled world at `world_path`.
+pub fn manifest_path(world_path: &Path) -> PathBuf {
+    world_path.with_extension(MANIFEST_EXTENSION)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn manifest_sits_next_to_world_file() {
+        assert_eq!(
+            manifest_path(Path::new("data/worlds/amble-demo.ron")),
+            PathBuf::from("data/worlds/amble-demo.meta")
+        );
+    }
+
+    #[test]
+    fn manifest_is_stale_when_world_text_changes() {
+        let mut def = WorldDef::default();
+        def.game.title = "Demo".into();
+        let manifest = WorldManifest::for_world(&def, b"(game: 1)");
+        assert_eq!(manifest.title, "Demo");
+        assert!(manifest.is_current(b"(game: 1)"));
+        assert!(!manifest.is_current(b"(game: 12)"));
+        // same size, different text
+        assert!(!manifest.is_current(b"(game: 2)"));
+    }
+}
@@ -0,0 +1,45 @@
+//! Compares recursive `EventCondition` evaluation with compiled condition programs
+//! across every trigger in the bundled demo world.
+
+use std::hint::black_box;
+use std::path::Path;
+
+use amble_engine::trigger::{ConditionProgram, TriggerCondition};
+use amble_engine::{AmbleWorld, load_world_from_path};
+use criterion::{Criterion, criterion_group, criterion_main};
+
+fn demo_world() -> AmbleWorld {
+    let path = Path::new(env!("CARGO_MANIFEST_DIR")).join("data/worlds/amble-demo.ron");
+    load_world_from_path(&path).expect("demo world should load")
+}
+
+fn bench_condition_eval(c: &mut Criterion) {
+    let world = demo_world();
+    let programs: Vec<_> = world
+        .triggers
+        .iter()
+        .map(|t| ConditionProgram::compile(&t.conditions))
+        .collect();
+    let start = world.player_room_id();
+    let events = vec![TriggerCondition::Enter(start.clone()), TriggerCondition::Leave(start)];
+
+    let mut group = c.benchmark_group("condition_eval");
+    group.bench_function("tree", |b| {
+        b.iter(|| {
+            for trigger in &world.triggers {
+                black_box(trigger.conditions.eval_with_events(&world, black_box(&events)));
+            }
+        });
+    });
+    group.bench_function("compiled", |b| {
+        b.iter(|| {
+            for program in &programs {
+                black_box(program.eval_with_events(&world, black_box(&events)));
+            }
+        });
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_condition_eval);
+criterion_main!(benches);
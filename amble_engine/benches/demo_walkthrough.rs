@@ -0,0 +1,36 @@
+//! End-to-end regression benchmark: replays the canonical demo walkthrough
+//! (`tests/transcripts/amble-demo.txt`) from a fresh start each iteration and
+//! prints per-turn allocation counts once.
+
+use std::hint::black_box;
+use std::path::Path;
+
+use amble_engine::replay::{CountingAllocator, Transcript, replay};
+use criterion::{BatchSize, Criterion, Throughput, criterion_group, criterion_main};
+
+#[global_allocator]
+static ALLOCATOR: CountingAllocator = CountingAllocator;
+
+fn bench_demo_walkthrough(c: &mut Criterion) {
+    colored::control::set_override(false);
+    let root = Path::new(env!("CARGO_MANIFEST_DIR"));
+    let world = amble_engine::load_world_from_ron(&root.join("data/worlds/amble-demo.ron")).expect("demo world");
+    let transcript = Transcript::load(&root.join("tests/transcripts/amble-demo.txt")).expect("demo transcript");
+
+    let report = replay(world.clone(), &transcript).expect("walkthrough should replay");
+    print!("{}", report.summary(false));
+
+    let mut group = c.benchmark_group("demo_walkthrough");
+    group.throughput(Throughput::Elements(transcript.commands.len() as u64));
+    group.bench_function("full_replay", |b| {
+        b.iter_batched(
+            || world.clone(),
+            |world| black_box(replay(world, &transcript).expect("replay")),
+            BatchSize::SmallInput,
+        );
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_demo_walkthrough);
+criterion_main!(benches);
@@ -0,0 +1,65 @@
+//! Item name lookups (`find_item_match`) in a room crowded with hundreds of items,
+//! both with the search cache warm and with it rebuilt after every world change.
+
+use std::hint::black_box;
+use std::path::Path;
+
+use amble_engine::entity_search::{SearchScope, find_item_match};
+use amble_engine::{AmbleWorld, ItemId, Location, load_world_from_path};
+use criterion::{BenchmarkId, Criterion, criterion_group, criterion_main};
+
+const ADJECTIVES: [&str; 8] = ["brass", "rusty", "tiny", "heavy", "glowing", "cracked", "silver", "odd"];
+const NOUNS: [&str; 8] = ["lantern", "key", "box", "coin", "jar", "scroll", "bell", "gear"];
+
+/// The demo world with `count` extra items placed in the player's starting room.
+fn crowded_world(count: usize) -> AmbleWorld {
+    let path = Path::new(env!("CARGO_MANIFEST_DIR")).join("data/worlds/amble-demo.ron");
+    let mut world = load_world_from_path(&path).expect("demo world should load");
+    let room_id = world.player_room_id();
+    let template = world.items.values().next().expect("demo world has items").clone();
+    for i in 0..count {
+        let id = ItemId::new(&format!("bench_item_{i}"));
+        let mut item = template.clone();
+        item.id = id;
+        item.symbol = id.to_string();
+        item.name = format!("{} {} {i}", ADJECTIVES[i % 8], NOUNS[(i / 8) % 8]);
+        item.aliases = vec![NOUNS[(i / 8) % 8].to_string()];
+        item.location = Location::Room(room_id);
+        item.visible_when = None;
+        item.container_state = None;
+        item.contents.clear();
+        world.items.insert(id, item);
+        world.rooms.get_mut(&room_id).expect("start room").contents.insert(id);
+    }
+    world
+}
+
+fn bench_entity_search(c: &mut Criterion) {
+    let mut group = c.benchmark_group("entity_search");
+    for count in [100, 500] {
+        let mut world = crowded_world(count);
+        let room_id = world.player_room_id();
+        let lookups = ["odd gear 63", "lantern", "silv", "nothing here"];
+        let find_all = |world: &AmbleWorld| {
+            for term in lookups {
+                let _ = black_box(find_item_match(world, term, SearchScope::TouchableItems(room_id)));
+            }
+        };
+
+        group.bench_with_input(BenchmarkId::new("warm", count), &count, |b, _| {
+            b.iter(|| find_all(&world));
+        });
+        let touched = ItemId::new(&"bench_item_0");
+        group.bench_with_input(BenchmarkId::new("after_change", count), &count, |b, _| {
+            b.iter(|| {
+                // any mutable access to the item table invalidates the cached scopes
+                let _ = world.items.get_mut(&touched);
+                find_all(&world);
+            });
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_entity_search);
+criterion_main!(benches);
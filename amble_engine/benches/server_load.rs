@@ -0,0 +1,78 @@
+//! Multi-session server load: per-command round-trip latency (with p99) against a
+//! server that already holds many idle sessions, and session density (sessions/GB)
+//! measured from resident memory growth on Linux.
+
+use std::hint::black_box;
+use std::net::TcpListener;
+use std::path::Path;
+use std::sync::Arc;
+use std::thread;
+use std::time::{Duration, Instant};
+
+use amble_engine::server::{Client, WorkerPool, serve};
+use criterion::{Criterion, criterion_group, criterion_main};
+
+const IDLE_SESSIONS: usize = 256;
+
+/// Resident set size of this process, if the platform exposes it.
+fn resident_bytes() -> Option<u64> {
+    let statm = std::fs::read_to_string("/proc/self/statm").ok()?;
+    let pages: u64 = statm.split_whitespace().nth(1)?.parse().ok()?;
+    Some(pages * 4096)
+}
+
+fn bench_server_load(c: &mut Criterion) {
+    colored::control::set_override(false);
+    let world_path = Path::new(env!("CARGO_MANIFEST_DIR")).join("data/worlds/amble-demo.ron");
+    let template = Arc::new(amble_engine::load_world_from_ron(&world_path).expect("demo world should load"));
+    let workers = thread::available_parallelism().map_or(4, usize::from);
+    let pool = Arc::new(WorkerPool::new(template, workers));
+    let listener = TcpListener::bind("127.0.0.1:0").expect("bind");
+    let addr = listener.local_addr().expect("local addr");
+    thread::spawn(move || serve(&listener, &pool));
+
+    // Session density: open idle sessions and attribute the RSS growth to them.
+    let before = resident_bytes();
+    let idle: Vec<Client> = (0..IDLE_SESSIONS)
+        .map(|_| Client::connect(addr).expect("connect").0)
+        .collect();
+    if let (Some(before), Some(after)) = (before, resident_bytes()) {
+        let per_session = (after.saturating_sub(before) / IDLE_SESSIONS as u64).max(1);
+        println!(
+            "server_load: {IDLE_SESSIONS} sessions, ~{} KiB/session, ~{} sessions/GB",
+            per_session / 1024,
+            (1u64 << 30) / per_session
+        );
+    }
+
+    let (mut client, _) = Client::connect(addr).expect("connect");
+    let mut samples: Vec<Duration> = Vec::new();
+    let mut group = c.benchmark_group("server_load");
+    group.bench_function("look_round_trip", |b| {
+        b.iter_custom(|iters| {
+            let mut total = Duration::ZERO;
+            for _ in 0..iters {
+                let start = Instant::now();
+                black_box(client.send("look").expect("look"));
+                let elapsed = start.elapsed();
+                samples.push(elapsed);
+                total += elapsed;
+            }
+            total
+        });
+    });
+    group.finish();
+
+    samples.sort_unstable();
+    if !samples.is_empty() {
+        let p99 = samples[(samples.len() * 99 / 100).min(samples.len() - 1)];
+        println!(
+            "server_load: p99 command latency {p99:.2?} over {} commands",
+            samples.len()
+        );
+    }
+    drop(idle);
+}
+
+criterion_group!(benches, bench_server_load);
+criterion_main!(benches);
@@ -0,0 +1,59 @@
+//! Measures headless `Session` throughput (commands per second) on the bundled demo
+//! world, for a single session and for independent sessions spread across threads.
+
+use std::hint::black_box;
+use std::path::Path;
+use std::thread;
+
+use amble_engine::{AmbleWorld, Session};
+use criterion::{Criterion, Throughput, criterion_group, criterion_main};
+
+/// A short loop of ordinary commands that leaves the player where they started.
+fn script(world: &AmbleWorld) -> Vec<String> {
+    let room = world.player_room_ref().expect("demo world start room");
+    let mut commands = vec!["look".to_string(), "inventory".to_string()];
+    if let Some(direction) = room.exits.keys().min() {
+        commands.push(format!("go {direction}"));
+        commands.push("go back".to_string());
+    }
+    commands.push("xyzzy".to_string());
+    commands.push("goals".to_string());
+    commands
+}
+
+fn play(session: &mut Session, script: &[String]) {
+    for command in script {
+        black_box(session.send(command).expect("command failed"));
+    }
+}
+
+fn bench_session_throughput(c: &mut Criterion) {
+    let world_path = Path::new(env!("CARGO_MANIFEST_DIR")).join("data/worlds/amble-demo.ron");
+    let world = amble_engine::load_world_from_ron(&world_path).expect("demo world should load");
+    let script = script(&world);
+    let threads = thread::available_parallelism().map_or(4, usize::from);
+
+    let mut group = c.benchmark_group("session_throughput");
+    group.throughput(Throughput::Elements(script.len() as u64));
+    group.bench_function("single_session", |b| {
+        let mut session = Session::new(world.clone());
+        b.iter(|| play(&mut session, &script));
+    });
+
+    group.throughput(Throughput::Elements((script.len() * threads) as u64));
+    group.bench_function(format!("{threads}_threads"), |b| {
+        let mut sessions: Vec<Session> = (0..threads).map(|_| Session::new(world.clone())).collect();
+        b.iter(|| {
+            thread::scope(|scope| {
+                for session in &mut sessions {
+                    let script = &script;
+                    scope.spawn(move || play(session, script));
+                }
+            });
+        });
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_session_throughput);
+criterion_main!(benches);
@@ -0,0 +1,169 @@
+//! Measures theme-aware styling of full room views from the bundled demo world.
+//!
+//! `palette` styles each room's strings through `GameStyle`, which reads the
+//! published lock-free palette. `locked_clone` reproduces the previous access
+//! pattern (two `RwLock` reads on the theme manager plus a `ThemeColors` clone per
+//! styled string) for the same output, as the before/after comparison.
+
+use std::fmt::Write as _;
+use std::hint::black_box;
+use std::path::Path;
+
+use amble_engine::markup::{StyleKind, StyleMods, WrapMode, render_wrapped};
+use amble_engine::style::GameStyle;
+use amble_engine::theme::{THEME_MANAGER, ThemeColors};
+use amble_engine::{AmbleWorld, WorldObject, load_world_from_path};
+use colored::{ColoredString, Colorize};
+use criterion::{Criterion, criterion_group, criterion_main};
+
+const WIDTH: usize = 80;
+
+/// Text content of one room view: title, description, item names, exits and NPC names.
+struct RoomView {
+    name: String,
+    description: String,
+    items: Vec<String>,
+    exits: Vec<(String, String)>,
+    npcs: Vec<String>,
+}
+
+fn room_views(world: &AmbleWorld) -> Vec<RoomView> {
+    let mut rooms: Vec<_> = world.rooms.values().collect();
+    rooms.sort_by(|a, b| a.id.as_str().cmp(b.id.as_str()));
+    rooms
+        .into_iter()
+        .map(|room| RoomView {
+            name: room.name().to_string(),
+            description: room.description().to_string(),
+            items: room
+                .contents
+                .iter()
+                .filter_map(|id| world.items.get(id))
+                .map(|item| item.name().to_string())
+                .collect(),
+            exits: room
+                .exits
+                .iter()
+                .map(|(dir, exit)| {
+                    let dest = world.rooms.get(&exit.to).map_or("?", |r| r.name());
+                    (dir.clone(), dest.to_string())
+                })
+                .collect(),
+            npcs: room
+                .npcs
+                .iter()
+                .filter_map(|id| world.npcs.get(id))
+                .map(|npc| npc.name().to_string())
+                .collect(),
+        })
+        .collect()
+}
+
+fn render_with_palette(view: &RoomView, out: &mut String) {
+    let _ = writeln!(out, "{:^WIDTH$}", view.name.room_titlebar_style());
+    let _ = writeln!(
+        out,
+        "{}",
+        render_wrapped(
+            &view.description,
+            WIDTH,
+            WrapMode::Normal,
+            StyleKind::Description,
+            StyleMods::default()
+        )
+    );
+    let _ = writeln!(out, "{}:", "Items".subheading_style());
+    for item in &view.items {
+        let _ = writeln!(out, "    * {}", item.item_style());
+    }
+    let _ = writeln!(out, "{}:", "Exits".subheading_style());
+    for (dir, dest) in &view.exits {
+        let _ = writeln!(out, "    > {} (to {})", dir.exit_visited_style(), dest.room_style());
+    }
+    let _ = writeln!(out, "{}:", "Others".subheading_style());
+    for npc in &view.npcs {
+        let _ = writeln!(out, "    {}", npc.npc_style());
+    }
+}
+
+/// The pre-snapshot palette lookup: lock the manager, lock the theme, clone the colors.
+fn locked_colors() -> ThemeColors {
+    THEME_MANAGER
+        .read()
+        .ok()
+        .and_then(|m| m.current().read().ok().map(|t| t.colors.clone()))
+        .unwrap_or_default()
+}
+
+fn styled(text: &str, pick: impl FnOnce(&ThemeColors) -> colored::Color) -> ColoredString {
+    text.color(pick(&locked_colors()))
+}
+
+fn render_with_locked_clone(view: &RoomView, out: &mut String) {
+    let _ = writeln!(
+        out,
+        "{:^WIDTH$}",
+        styled(&view.name, |c| c.room_titlebar.to_color()).underline()
+    );
+    let _ = writeln!(
+        out,
+        "{}",
+        render_wrapped(
+            &view.description,
+            WIDTH,
+            WrapMode::Normal,
+            StyleKind::Description,
+            StyleMods::default()
+        )
+    );
+    let _ = writeln!(out, "{}:", "Items".bold());
+    for item in &view.items {
+        let _ = writeln!(out, "    * {}", styled(item, |c| c.item.to_color()));
+    }
+    let _ = writeln!(out, "{}:", "Exits".bold());
+    for (dir, dest) in &view.exits {
+        let _ = writeln!(
+            out,
+            "    > {} (to {})",
+            styled(dir, |c| c.exit_visited.to_color()).italic(),
+            styled(dest, |c| c.room.to_color())
+        );
+    }
+    let _ = writeln!(out, "{}:", "Others".bold());
+    for npc in &view.npcs {
+        let _ = writeln!(out, "    {}", styled(npc, |c| c.npc.to_color()).underline());
+    }
+}
+
+fn bench_theme_palette(c: &mut Criterion) {
+    colored::control::set_override(true);
+    let path = Path::new(env!("CARGO_MANIFEST_DIR")).join("data/worlds/amble-demo.ron");
+    let world = load_world_from_path(&path).expect("demo world should load");
+    let views = room_views(&world);
+
+    let mut group = c.benchmark_group("room_view_styling");
+    group.bench_function("locked_clone", |b| {
+        let mut out = String::new();
+        b.iter(|| {
+            out.clear();
+            for view in &views {
+                render_with_locked_clone(black_box(view), &mut out);
+            }
+            black_box(out.len())
+        });
+    });
+    group.bench_function("palette", |b| {
+        let mut out = String::new();
+        b.iter(|| {
+            out.clear();
+            for view in &views {
+                render_with_palette(black_box(view), &mut out);
+            }
+            black_box(out.len())
+        });
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_theme_palette);
+criterion_main!(benches);
@@ -0,0 +1,54 @@
+//! Compares full-scan trigger planning with the event-indexed path on the bundled demo world.
+
+use std::hint::black_box;
+use std::path::Path;
+
+use amble_engine::trigger::{TriggerCondition, make_fire_plan, make_fire_plan_full_scan};
+use amble_engine::{ItemId, load_world_from_path};
+use criterion::{Criterion, criterion_group, criterion_main};
+
+fn demo_world() -> amble_engine::AmbleWorld {
+    let path = Path::new(env!("CARGO_MANIFEST_DIR")).join("data/worlds/amble-demo.ron");
+    load_world_from_path(&path).expect("demo world should load")
+}
+
+/// A representative spread of per-command event slices: entering each room, and taking each item.
+fn sample_events(world: &amble_engine::AmbleWorld) -> Vec<Vec<TriggerCondition>> {
+    let mut rooms: Vec<_> = world.rooms.keys().cloned().collect();
+    rooms.sort_by(|a, b| a.as_str().cmp(b.as_str()));
+    let mut items: Vec<ItemId> = world.items.keys().cloned().collect();
+    items.sort_by(|a, b| a.as_str().cmp(b.as_str()));
+    let mut samples = vec![Vec::new()];
+    samples.extend(rooms.windows(2).map(|pair| {
+        vec![
+            TriggerCondition::Leave(pair[0].clone()),
+            TriggerCondition::Enter(pair[1].clone()),
+        ]
+    }));
+    samples.extend(items.into_iter().map(|id| vec![TriggerCondition::Take(id)]));
+    samples
+}
+
+fn bench_trigger_dispatch(c: &mut Criterion) {
+    let world = demo_world();
+    let samples = sample_events(&world);
+    let mut group = c.benchmark_group("trigger_fire_plan");
+    group.bench_function("full_scan", |b| {
+        b.iter(|| {
+            for events in &samples {
+                black_box(make_fire_plan_full_scan(&world, black_box(events)));
+            }
+        });
+    });
+    group.bench_function("indexed", |b| {
+        b.iter(|| {
+            for events in &samples {
+                black_box(make_fire_plan(&world, black_box(events)));
+            }
+        });
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_trigger_dispatch);
+criterion_main!(benches);
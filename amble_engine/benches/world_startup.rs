@@ -0,0 +1,39 @@
+//! Compares cold world loading from RON (parse + validate + build) with loading the
+//! precompiled binary artifact for the bundled demo world.
+
+use std::fs;
+use std::hint::black_box;
+use std::path::Path;
+
+use amble_engine::loader::worlddef::load_worlddef;
+use amble_engine::{load_world_from_path, load_world_from_ron};
+use criterion::{Criterion, criterion_group, criterion_main};
+
+fn bench_world_startup(c: &mut Criterion) {
+    // Stage the demo world and a freshly encoded artifact in a scratch directory so
+    // the benchmark doesn't depend on artifacts being present in `data/`.
+    let dir = tempfile::tempdir().expect("temp dir");
+    let world_path = dir.path().join("amble-demo.ron");
+    fs::copy(
+        Path::new(env!("CARGO_MANIFEST_DIR")).join("data/worlds/amble-demo.ron"),
+        &world_path,
+    )
+    .expect("copy demo world");
+    let source = fs::read(&world_path).expect("read demo world");
+    let def = load_worlddef(&world_path).expect("demo world should parse");
+    let artifact = amble_data::encode_artifact(&def, &source).expect("encode artifact");
+    fs::write(amble_data::artifact_path(&world_path), artifact).expect("write artifact");
+
+    let mut group = c.benchmark_group("world_startup");
+    group.sample_size(20);
+    group.bench_function("ron", |b| {
+        b.iter(|| black_box(load_world_from_ron(black_box(&world_path)).expect("ron load")));
+    });
+    group.bench_function("artifact", |b| {
+        b.iter(|| black_box(load_world_from_path(black_box(&world_path)).expect("artifact load")));
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_world_startup);
+criterion_main!(benches);
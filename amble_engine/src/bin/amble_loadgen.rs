@@ -0,0 +1,99 @@
+#![warn(clippy::pedantic)]
+
+//! Load generator for `amble_server`.
+//!
+//! Opens many concurrent client sessions, drives each through a short loop of
+//! commands, and reports throughput and per-command latency percentiles.
+//!
+//! ```text
+//! amble_loadgen [--addr HOST:PORT] [--clients N] [--commands N]
+//! ```
+
+use std::env;
+use std::thread;
+use std::time::{Duration, Instant};
+
+use amble_engine::server::Client;
+use anyhow::{Context, Result, anyhow, bail};
+
+/// Commands that are valid in any world and leave the player where they started.
+const SCRIPT: &[&str] = &["look", "inventory", "goals", "xyzzy", "look"];
+
+struct Args {
+    addr: String,
+    clients: usize,
+    commands: usize,
+}
+
+fn parse_args() -> Result<Args> {
+    let mut args = Args {
+        addr: "127.0.0.1:7878".to_string(),
+        clients: 64,
+        commands: 200,
+    };
+    let mut raw = env::args().skip(1);
+    while let Some(arg) = raw.next() {
+        let mut value = |name: &str| raw.next().with_context(|| format!("{name} requires a value"));
+        match arg.as_str() {
+            "--addr" => args.addr = value("--addr")?,
+            "--clients" => args.clients = value("--clients")?.parse().context("--clients must be an integer")?,
+            "--commands" => args.commands = value("--commands")?.parse().context("--commands must be an integer")?,
+            other => bail!("unknown argument '{other}'"),
+        }
+    }
+    Ok(args)
+}
+
+/// Run one client session, returning the latency of every command it sent.
+fn run_client(addr: &str, commands: usize) -> Result<Vec<Duration>> {
+    let (mut client, _) = Client::connect(addr).with_context(|| format!("connecting to {addr}"))?;
+    let mut latencies = Vec::with_capacity(commands);
+    for command in SCRIPT.iter().cycle().take(commands) {
+        let start = Instant::now();
+        client.send(command)?;
+        latencies.push(start.elapsed());
+    }
+    Ok(latencies)
+}
+
+fn percentile(sorted: &[Duration], pct: usize) -> Duration {
+    sorted[(sorted.len() * pct / 100).min(sorted.len() - 1)]
+}
+
+fn main() -> Result<()> {
+    let args = parse_args()?;
+    let start = Instant::now();
+    let mut latencies: Vec<Duration> = thread::scope(|scope| {
+        let handles: Vec<_> = (0..args.clients)
+            .map(|_| scope.spawn(|| run_client(&args.addr, args.commands)))
+            .collect();
+        handles
+            .into_iter()
+            .map(|handle| handle.join().map_err(|_| anyhow!("client thread panicked"))?)
+            .collect::<Result<Vec<_>>>()
+    })?
+    .into_iter()
+    .flatten()
+    .collect();
+    let elapsed = start.elapsed();
+    if latencies.is_empty() {
+        bail!("no commands were sent");
+    }
+    latencies.sort_unstable();
+
+    println!(
+        "{} clients x {} commands in {:.2?}: {:.0} commands/sec",
+        args.clients,
+        args.commands,
+        elapsed,
+        latencies.len() as f64 / elapsed.as_secs_f64()
+    );
+    println!(
+        "latency p50 {:.2?}  p90 {:.2?}  p99 {:.2?}  max {:.2?}",
+        percentile(&latencies, 50),
+        percentile(&latencies, 90),
+        percentile(&latencies, 99),
+        latencies[latencies.len() - 1]
+    );
+    Ok(())
+}
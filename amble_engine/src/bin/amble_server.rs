@@ -0,0 +1,95 @@
+#![warn(clippy::pedantic)]
+
+//! Multi-session Amble server.
+//!
+//! Loads one world and serves many concurrent players over a line-oriented TCP
+//! protocol (see [`amble_engine::server`]).
+//!
+//! ```text
+//! amble_server [WORLD_RON] [--addr HOST:PORT] [--workers N] [--max-connections N] [--plain]
+//! ```
+//!
+//! Without a world path, the default compiled world (`world.ron` in the data
+//! directory) is served. `--max-connections` caps the connections served at once
+//! (default [`DEFAULT_MAX_CONNECTIONS`]). `--plain` disables ANSI colors in responses.
+
+use std::env;
+use std::net::TcpListener;
+use std::path::PathBuf;
+use std::sync::Arc;
+use std::thread;
+
+use amble_engine::server::{DEFAULT_MAX_CONNECTIONS, WorkerPool, serve};
+use amble_engine::{load_world, load_world_from_path, set_active_world_path};
+use anyhow::{Context, Result, bail};
+
+struct Args {
+    world: Option<PathBuf>,
+    addr: String,
+    workers: usize,
+    max_connections: usize,
+    plain: bool,
+}
+
+fn parse_args() -> Result<Args> {
+    let mut args = Args {
+        world: None,
+        addr: "127.0.0.1:7878".to_string(),
+        workers: thread::available_parallelism().map_or(4, usize::from),
+        max_connections: DEFAULT_MAX_CONNECTIONS,
+        plain: false,
+    };
+    let mut raw = env::args().skip(1);
+    while let Some(arg) = raw.next() {
+        match arg.as_str() {
+            "--addr" => args.addr = raw.next().context("--addr requires a value")?,
+            "--workers" => {
+                args.workers = raw
+                    .next()
+                    .context("--workers requires a value")?
+                    .parse()
+                    .context("--workers must be a positive integer")?;
+            },
+            "--max-connections" => {
+                args.max_connections = raw
+                    .next()
+                    .context("--max-connections requires a value")?
+                    .parse()
+                    .context("--max-connections must be a positive integer")?;
+            },
+            "--plain" => args.plain = true,
+            flag if flag.starts_with("--") => bail!("unknown option '{flag}'"),
+            path => args.world = Some(PathBuf::from(path)),
+        }
+    }
+    Ok(args)
+}
+
+fn main() -> Result<()> {
+    env_logger::init();
+    let args = parse_args()?;
+    if args.plain {
+        colored::control::set_override(false);
+    }
+
+    let world = match &args.world {
+        Some(path) => {
+            set_active_world_path(path.clone());
+            load_world_from_path(path).with_context(|| format!("loading world from {}", path.display()))?
+        },
+        None => load_world().context("loading default world")?,
+    };
+    let template = Arc::new(world);
+    let pool =
+        Arc::new(WorkerPool::new(Arc::clone(&template), args.workers).with_max_connections(args.max_connections));
+
+    let listener = TcpListener::bind(&args.addr).with_context(|| format!("binding {}", args.addr))?;
+    println!(
+        "Serving \"{}\" on {} with {} workers, up to {} connections",
+        template.game_title,
+        listener.local_addr()?,
+        pool.len(),
+        pool.max_connections()
+    );
+    serve(&listener, &pool)
+}
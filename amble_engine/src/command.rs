@@ -71,6 +71,8 @@ pub enum Command {
     ResetSeq(String),
     SetFlag(String),
     DevNote(String),
+    Profile(String),
+    Reload,
     SpawnItem(String),
     StartSeq {
         // DEV_MODE only
@@ -86,6 +88,64 @@ pub enum Command {
     },
 }
 
+impl Command {
+    /// True for commands that act on process-wide state rather than the current game:
+    /// the shared save directory, the terminal theme, or developer tools. A host that
+    /// runs several sessions in one process must not let a player use them.
+    pub fn is_local_only(&self) -> bool {
+        #[allow(clippy::enum_glob_use)]
+        use Command::*;
+        // exhaustive on purpose: a new command must be classified here
+        match self {
+            ListSaves
+            | Load(_)
+            | Save(_)
+            | Theme(_)
+            | HelpDev
+            | ListNpcs
+            | ListFlags
+            | ListSched
+            | AdvanceSeq(_)
+            | ResetSeq(_)
+            | SetFlag(_)
+            | DevNote(_)
+            | Profile(_)
+            | Reload
+            | SpawnItem(_)
+            | StartSeq { .. }
+            | Teleport(_)
+            | SchedCancel(_)
+            | SchedDelay { .. } => true,
+            Close(_)
+            | Drop(_)
+            | GiveToNpc { .. }
+            | Goals
+            | GoBack
+            | Help
+            | Ingest { .. }
+            | Inventory
+            | LockItem(_)
+            | Look
+            | LookAt(_)
+            | MoveTo(_)
+            | Open(_)
+            | PutIn { .. }
+            | Quit
+            | Read(_)
+            | SetViewMode(_)
+            | Take(_)
+            | TakeFrom { .. }
+            | TalkTo(_)
+            | Touch(_)
+            | TurnOff(_)
+            | TurnOn(_)
+            | Unknown
+            | UnlockItem(_)
+            | UseItemOn { .. } => false,
+        }
+    }
+}
+
 /// PEG parser for player input, generated from [`repl_grammar.pest`].
 #[derive(Parser)]
 #[grammar = "repl_grammar.pest"]
@@ -0,0 +1,525 @@
+//! Copy-on-write split between world content and game state.
+//!
+//! Descriptions, overlays, scenery, dialogue, trigger definitions, goals, scoring
+//! and spinners are *content*: built once from the world file and almost never
+//! changed during play. Each is held in a [`Shared`] field, so copying a world
+//! (restart, server sessions, snapshots) only bumps reference counts. The rare
+//! in-game change (`SetItemDescription`, `AddSpinnerWedge`, item/NPC/room patches)
+//! copies just the value it touches and marks it as an override.
+//!
+//! When a world is loaded it is registered as the content template for its slug.
+//! Saves skip the [`Shared`] fields that still come from the template;
+//! [`rehydrate`] restores them from the matching template when a save is read, and
+//! [`fresh_world`] restarts a game from the template instead of reloading it from
+//! disk. Templates for different worlds live side by side, so reading a save for
+//! one world never displaces another's.
+//!
+//! The split covers the bulky text and rule content listed above, not the whole
+//! world: rooms, items and NPCs are still saved as records. Their ids, names, exits,
+//! aliases, abilities, container and movement settings are written in full next to
+//! the state (locations, contents, flags, moods, health) even when play never
+//! changed them.
+
+use std::collections::HashMap;
+use std::fmt;
+use std::hash::Hash;
+use std::ops::{Deref, DerefMut};
+use std::sync::{Arc, LazyLock, RwLock};
+
+use anyhow::{Result, bail};
+use log::warn;
+use serde::{Deserialize, Deserializer, Serialize, Serializer};
+
+use crate::loader::{discover_world_sources, load_world_from_path};
+use crate::tracked_map::TrackedMap;
+use crate::trigger::{Trigger, TriggerIndex};
+use crate::world::AmbleWorld;
+
+/// Where a [`Shared`] value came from.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Origin {
+    /// Unchanged content of the registered template; omitted from saves.
+    Content,
+    /// Built locally, changed in play or read from a save; always saved.
+    Local,
+    /// Omitted from a save and not yet restored from the template.
+    Pending,
+}
+
+/// Copy-on-write handle to a piece of world content.
+///
+/// Reads go through `Deref`. Mutable access (via `DerefMut` or [`Shared::set`])
+/// clones the value if it is still shared and marks it as a local override.
+#[derive(Clone)]
+pub struct Shared<T> {
+    value: Arc<T>,
+    origin: Origin,
+}
+
+impl<T> Shared<T> {
+    /// Wrap a locally built value.
+    pub fn new(value: T) -> Self {
+        Self {
+            value: Arc::new(value),
+            origin: Origin::Local,
+        }
+    }
+
+    /// Placeholder for content omitted from a save, to be restored by [`rehydrate`].
+    pub fn pending_with(value: T) -> Self {
+        Self {
+            value: Arc::new(value),
+            origin: Origin::Pending,
+        }
+    }
+
+    /// [`Shared::pending_with`] the default value (used as a serde default).
+    pub fn pending() -> Self
+    where
+        T: Default,
+    {
+        Self::pending_with(T::default())
+    }
+
+    /// Replace the value, recording it as an override.
+    pub fn set(&mut self, value: T) {
+        self.value = Arc::new(value);
+        self.origin = Origin::Local;
+    }
+
+    /// True if this value still comes from the content template (or is waiting to be
+    /// restored from it) and so is left out of saves.
+    pub fn is_content(&self) -> bool {
+        self.origin != Origin::Local
+    }
+
+    /// True if both handles point at the same allocation.
+    pub fn ptr_eq(&self, other: &Self) -> bool {
+        Arc::ptr_eq(&self.value, &other.value)
+    }
+
+    /// Mark a template value as content.
+    fn mark_content(&mut self) {
+        self.origin = Origin::Content;
+    }
+
+    /// Take the template's value if this one was omitted from the save, or is an
+    /// identical copy of it (as written by saves that stored all content).
+    fn adopt(&mut self, content: &Self)
+    where
+        T: PartialEq,
+    {
+        if self.origin == Origin::Pending || *self.value == *content.value {
+            self.share(content);
+        }
+    }
+
+    /// Take the template's value if this one was omitted from the save.
+    fn adopt_pending(&mut self, content: &Self) {
+        if self.origin == Origin::Pending {
+            self.share(content);
+        }
+    }
+
+    fn share(&mut self, content: &Self) {
+        self.value = Arc::clone(&content.value);
+        self.origin = Origin::Content;
+    }
+}
+
+impl<T> Deref for Shared<T> {
+    type Target = T;
+
+    fn deref(&self) -> &T {
+        &self.value
+    }
+}
+
+impl<T: Clone> DerefMut for Shared<T> {
+    fn deref_mut(&mut self) -> &mut T {
+        self.origin = Origin::Local;
+        Arc::make_mut(&mut self.value)
+    }
+}
+
+impl<T: Default> Default for Shared<T> {
+    fn default() -> Self {
+        Self::new(T::default())
+    }
+}
+
+impl<T> From<T> for Shared<T> {
+    fn from(value: T) -> Self {
+        Self::new(value)
+    }
+}
+
+impl From<&str> for Shared<String> {
+    fn from(value: &str) -> Self {
+        Self::new(value.to_string())
+    }
+}
+
+impl<T: fmt::Debug> fmt::Debug for Shared<T> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        self.value.fmt(f)
+    }
+}
+
+impl<T: fmt::Display> fmt::Display for Shared<T> {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        self.value.fmt(f)
+    }
+}
+
+impl<T: PartialEq> PartialEq for Shared<T> {
+    fn eq(&self, other: &Self) -> bool {
+        self.ptr_eq(other) || *self.value == *other.value
+    }
+}
+
+impl PartialEq<str> for Shared<String> {
+    fn eq(&self, other: &str) -> bool {
+        self.value.as_str() == other
+    }
+}
+
+impl PartialEq<&str> for Shared<String> {
+    fn eq(&self, other: &&str) -> bool {
+        self.value.as_str() == *other
+    }
+}
+
+impl<T: Serialize> Serialize for Shared<T> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        self.value.serialize(serializer)
+    }
+}
+
+impl<'de, T: Deserialize<'de>> Deserialize<'de> for Shared<T> {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        T::deserialize(deserializer).map(Self::new)
+    }
+}
+
+/// Serialize only the overridden entries of a map of shared content (used for spinners).
+///
+/// # Errors
+/// Propagates serializer errors.
+pub fn serialize_overrides<K, V, S>(map: &TrackedMap<K, Shared<V>>, serializer: S) -> Result<S::Ok, S::Error>
+where
+    K: Serialize + Eq + Hash,
+    V: Serialize,
+    S: Serializer,
+{
+    serializer.collect_map(map.iter().filter(|(_, value)| !value.is_content()))
+}
+
+/// Registered content templates, keyed by world slug.
+static TEMPLATES: LazyLock<RwLock<HashMap<String, Arc<AmbleWorld>>>> = LazyLock::new(RwLock::default);
+
+/// Mark `world`'s content as shared template content and register a copy of it as
+/// the template for its slug. Called when a world is loaded from its world file.
+pub fn register_template(world: &mut AmbleWorld) {
+    mark_world_content(world);
+    TEMPLATES
+        .write()
+        .expect("content templates poisoned")
+        .insert(world.world_slug.clone(), Arc::new(world.clone()));
+}
+
+fn mark_world_content(world: &mut AmbleWorld) {
+    for room in world.rooms.values_mut() {
+        room.base_description.mark_content();
+        room.overlays.mark_content();
+        room.scenery.mark_content();
+    }
+    for item in world.items.values_mut() {
+        item.description.mark_content();
+        item.text.mark_content();
+    }
+    for npc in world.npcs.values_mut() {
+        npc.description.mark_content();
+        npc.dialogue.mark_content();
+    }
+    for trigger in &mut world.triggers {
+        trigger.conditions.mark_content();
+        trigger.actions.mark_content();
+    }
+    for spinner in world.spinners.values_mut() {
+        spinner.mark_content();
+    }
+    world.goals.mark_content();
+    world.scoring.mark_content();
+    world.rooms.clear_changes();
+    world.items.clear_changes();
+    world.npcs.clear_changes();
+    world.spinners.clear_changes();
+}
+
+/// The content template registered for the world `slug`, if any.
+pub fn template(slug: &str) -> Option<Arc<AmbleWorld>> {
+    TEMPLATES.read().expect("content templates poisoned").get(slug).cloned()
+}
+
+/// A fresh game of world `slug` started from its template (no disk access), if one is registered.
+pub fn fresh_world(slug: &str) -> Option<AmbleWorld> {
+    template(slug).map(|template| (*template).clone())
+}
+
+/// Template whose content belongs to the same world as `world`: the one registered
+/// for its slug, or else the discovered world file with that slug, loaded now.
+fn template_for(world: &AmbleWorld) -> Result<Arc<AmbleWorld>> {
+    if let Some(template) = template(&world.world_slug) {
+        return Ok(template);
+    }
+    let sources = discover_world_sources()?;
+    let Some(source) = sources.iter().find(|source| source.slug == world.world_slug) else {
+        bail!("no world file found for saved world '{}'", world.world_slug);
+    };
+    // loading registers the template under the loaded world's own slug
+    let loaded = load_world_from_path(&source.path)?;
+    Ok(template(&world.world_slug).unwrap_or_else(|| Arc::new(loaded)))
+}
+
+/// True if any content field of `world` was omitted from its save.
+fn has_pending_content(world: &AmbleWorld) -> bool {
+    let pending = |origin: Origin| origin == Origin::Pending;
+    world
+        .rooms
+        .values()
+        .any(|r| pending(r.base_description.origin) || pending(r.overlays.origin) || pending(r.scenery.origin))
+        || world
+            .items
+            .values()
+            .any(|i| pending(i.description.origin) || pending(i.text.origin))
+        || world
+            .npcs
+            .values()
+            .any(|n| pending(n.description.origin) || pending(n.dialogue.origin))
+        || world
+            .triggers
+            .iter()
+            .any(|t| pending(t.conditions.origin) || pending(t.actions.origin))
+        || pending(world.goals.origin)
+        || pending(world.scoring.origin)
+}
+
+/// Restore content omitted from a save of `world` from the matching content template.
+///
+/// Values saved by older versions (which stored all content) that are identical to
+/// the template are shared with it again, so later saves omit them. A save written
+/// for a different version of the world is still restored, with a warning.
+///
+/// # Errors
+/// Returns an error if content is missing and no template for the save's world can be
+/// found, or if the template lacks content the save omitted.
+pub fn rehydrate(world: &mut AmbleWorld) -> Result<()> {
+    let template = match template_for(world) {
+        Ok(template) => template,
+        Err(err) if has_pending_content(world) => return Err(err),
+        Err(_) => return Ok(()),
+    };
+    rehydrate_from(world, &template)
+}
+
+fn rehydrate_from(world: &mut AmbleWorld, content: &AmbleWorld) -> Result<()> {
+    if world.world_version != content.world_version {
+        warn!(
+            "save of '{}' was written for world version '{}', restoring content from version '{}'",
+            world.world_slug, world.world_version, content.world_version
+        );
+    }
+    for room in world.rooms.values_mut() {
+        if let Some(src) = content.rooms.get(&room.id) {
+            room.base_description.adopt(&src.base_description);
+            room.overlays.adopt_pending(&src.overlays);
+            room.scenery.adopt_pending(&src.scenery);
+        } else {
+            warn!("room '{}' is not in the world content", room.id);
+        }
+    }
+    for item in world.items.values_mut() {
+        if let Some(src) = content.items.get(&item.id) {
+            item.description.adopt(&src.description);
+            item.text.adopt(&src.text);
+        } else {
+            warn!("item '{}' is not in the world content", item.id);
+        }
+    }
+    for npc in world.npcs.values_mut() {
+        if let Some(src) = content.npcs.get(&npc.id) {
+            npc.description.adopt(&src.description);
+            npc.dialogue.adopt(&src.dialogue);
+        } else {
+            warn!("npc '{}' is not in the world content", npc.id);
+        }
+    }
+    // Triggers have no ids; match them by name and position among same-named triggers.
+    let mut by_name: HashMap<&str, Vec<&Trigger>> = HashMap::new();
+    for src in &content.triggers {
+        by_name.entry(src.name.as_str()).or_default().push(src);
+    }
+    let mut seen: HashMap<String, usize> = HashMap::new();
+    for trigger in &mut world.triggers {
+        let nth = seen.entry(trigger.name.clone()).or_default();
+        match by_name.get(trigger.name.as_str()).and_then(|same| same.get(*nth)) {
+            Some(src) => {
+                trigger.conditions.adopt(&src.conditions);
+                trigger.actions.adopt(&src.actions);
+            },
+            None => warn!("trigger '{}' (#{nth}) is not in the world content", trigger.name),
+        }
+        *nth += 1;
+    }
+    for (kind, spinner) in content.spinners.iter() {
+        if !world.spinners.contains_key(kind) {
+            world.spinners.insert(kind.clone(), spinner.clone());
+        }
+    }
+    world.goals.adopt_pending(&content.goals);
+    world.scoring.adopt_pending(&content.scoring);
+    world.trigger_index = TriggerIndex::build(&world.triggers, world.triggers_revision);
+    if has_pending_content(world) {
+        bail!(
+            "save of '{}' omits content that world version '{}' no longer has",
+            world.world_slug,
+            content.world_version
+        );
+    }
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn mutation_copies_and_marks_override() {
+        let mut content: Shared<String> = "a dusty lamp".into();
+        content.mark_content();
+        let mut copy = content.clone();
+        assert!(copy.ptr_eq(&content) && copy.is_content());
+
+        copy.push_str(" (lit)");
+        assert!(!copy.is_content());
+        assert_eq!(content, "a dusty lamp");
+        assert_eq!(copy, "a dusty lamp (lit)");
+    }
+
+    #[test]
+    fn pending_and_unchanged_values_are_restored_from_content() {
+        let mut content: Shared<String> = "template".into();
+        content.mark_content();
+
+        let mut pending: Shared<String> = Shared::pending();
+        assert!(pending.is_content());
+        pending.adopt(&content);
+        assert!(pending.ptr_eq(&content) && pending.is_content());
+
+        let mut legacy: Shared<String> = ron::from_str("\"template\"").unwrap();
+        assert!(!legacy.is_content());
+        legacy.adopt(&content);
+        assert!(legacy.ptr_eq(&content));
+
+        let mut changed: Shared<String> = ron::from_str("\"changed\"").unwrap();
+        changed.adopt(&content);
+        assert_eq!(changed, "changed");
+        assert!(!changed.is_content());
+    }
+
+    #[test]
+    fn saves_hold_only_overrides_and_restore_content() {
+        use crate::room::Room;
+        use crate::{Location, RoomId};
+        use std::collections::{HashMap, HashSet};
+
+        let room = |symbol: &str, desc: &str| Room {
+            id: RoomId::new(&symbol),
+            symbol: symbol.into(),
+            name: symbol.into(),
+            base_description: desc.into(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
+            scenery_default: None,
+            location: Location::Nowhere,
+            visited: false,
+            exits: HashMap::new(),
+            contents: HashSet::new(),
+            npcs: HashSet::new(),
+        };
+        let mut content = AmbleWorld::new_empty();
+        for r in [room("hall", "A long hall."), room("vault", "A sealed vault.")] {
+            content.rooms.insert(r.id, r);
+        }
+        mark_world_content(&mut content);
+
+        let mut world = content.clone();
+        let vault = RoomId::new(&"vault");
+        world
+            .rooms
+            .get_mut(&vault)
+            .unwrap()
+            .base_description
+            .set("A looted vault.".into());
+        let saved = ron::to_string(&world).unwrap();
+        assert!(!saved.contains("A long hall."));
+        assert!(saved.contains("A looted vault."));
+
+        let mut loaded: AmbleWorld = ron::from_str(&saved).unwrap();
+        rehydrate_from(&mut loaded, &content).unwrap();
+        let hall = RoomId::new(&"hall");
+        assert!(
+            loaded.rooms[&hall]
+                .base_description
+                .ptr_eq(&content.rooms[&hall].base_description)
+        );
+        assert_eq!(loaded.rooms[&vault].base_description, "A looted vault.");
+        assert!(!has_pending_content(&loaded));
+
+        // a template that no longer has the hall cannot restore its description
+        let mut stale: AmbleWorld = ron::from_str(&saved).unwrap();
+        content.rooms.remove(&hall);
+        assert!(rehydrate_from(&mut stale, &content).is_err());
+    }
+
+    #[test]
+    fn triggers_are_restored_by_name_and_ordinal() {
+        let trigger = |name: &str| Trigger {
+            name: name.into(),
+            conditions: Shared::new(crate::scheduler::EventCondition::Any(Vec::new())),
+            actions: Shared::new(Vec::new()),
+            only_once: false,
+            fired: false,
+        };
+        let mut content = AmbleWorld::new_empty();
+        content.triggers = vec![trigger("open"), trigger("shout"), trigger("shout")];
+        mark_world_content(&mut content);
+
+        // the save no longer lists the first trigger, shifting the rest
+        let mut world = content.clone();
+        world.triggers.remove(0);
+        let saved = ron::to_string(&world).unwrap();
+        let mut loaded: AmbleWorld = ron::from_str(&saved).unwrap();
+        rehydrate_from(&mut loaded, &content).unwrap();
+        assert!(loaded.triggers[0].actions.ptr_eq(&content.triggers[1].actions));
+        assert!(loaded.triggers[1].actions.ptr_eq(&content.triggers[2].actions));
+    }
+
+    #[test]
+    fn templates_for_different_worlds_coexist() {
+        let mut first = AmbleWorld::new_empty();
+        first.world_slug = "content-test-first".into();
+        first.game_title = "First".into();
+        let mut second = AmbleWorld::new_empty();
+        second.world_slug = "content-test-second".into();
+        second.game_title = "Second".into();
+        register_template(&mut first);
+        register_template(&mut second);
+
+        assert_eq!(fresh_world("content-test-first").unwrap().game_title, "First");
+        assert_eq!(template_for(&first).unwrap().game_title, "First");
+        assert_eq!(template_for(&second).unwrap().game_title, "Second");
+        assert!(template("content-test-missing").is_none());
+    }
+}
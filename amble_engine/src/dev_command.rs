@@ -82,6 +82,9 @@ pub fn parse_dev_command(input: &str, view: &mut View) -> Option<Command> {
         }),
         ["reset-seq", seq_name] => Some(Command::ResetSeq((*seq_name).into())),
         ["set-flag", flag_name] => Some(Command::SetFlag((*flag_name).into())),
+        ["profile"] => Some(Command::Profile("report".into())),
+        ["profile", action @ ("on" | "off" | "reset" | "report")] => Some(Command::Profile((*action).into())),
+        ["reload"] => Some(Command::Reload),
         _ => None,
     }
 }
@@ -23,23 +23,31 @@
 //! `find_item_match(...)` when only interested in items for a given command
 //! `find_npc_match(...)` when only interested in npcs
 //! `find_entity_match(...)` when the input could refer to either an item or an npc
+//!
+//! Matches are ranked (exact name, whole word, word prefix, substring; see [`MatchRank`])
+//! and ties resolve by id, so the same input always finds the same entity. Commands
+//! that act on the item they find (take, look at, open) first call [`ask_which_item`],
+//! which asks the player to choose when several items tie for the best match.
+//!
+//! Item searches around a room or in the inventory resolve against a [`SearchCache`]
+//! kept on the world, so repeated commands do not rebuild candidate sets or lowercase
+//! every name on each call.
 
+use std::cmp::Ordering;
 use std::collections::{HashMap, HashSet};
+use std::fmt;
 use std::hash::BuildHasher;
+use std::sync::{Arc, Mutex, MutexGuard, PoisonError};
 
 pub use crate::EntityId;
-use crate::world::item_is_visible_item;
+use crate::item::ContainerState;
+use crate::world::{item_is_visible, item_is_visible_item};
 use crate::{Item, ItemId, Npc, NpcId, RoomId, View, ViewItem, WorldObject};
 use colored::Colorize;
 use thiserror::Error;
 use variantly::Variantly;
 
-use crate::{
-    AmbleWorld,
-    spinners::CoreSpinnerType,
-    style::GameStyle,
-    world::{nearby_reachable_items, nearby_vessel_items, nearby_visible_items},
-};
+use crate::{AmbleWorld, spinners::CoreSpinnerType, style::GameStyle};
 
 /// Represents the scope of a requested search by the caller and includes the location to search.
 #[derive(Debug, Clone, PartialEq)]
@@ -115,7 +123,53 @@ impl WorldEntity<'_> {
     }
 }
 
-/// Search item and NPC ids for a name match and return the resolved world entity.
+/// How well a search term matches a name, from weakest to strongest.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord, Hash)]
+pub enum MatchRank {
+    /// The term appears inside a word ("ant" in "brass lantern").
+    Substring,
+    /// The term starts a word ("lan" in "brass lantern").
+    Prefix,
+    /// The term is one or more whole words ("lantern" in "brass lantern").
+    Token,
+    /// The term is the whole name or alias.
+    Exact,
+}
+
+impl MatchRank {
+    /// Rank `lc_term` against `lc_name` (both already lowercase); `None` if it does not occur.
+    pub fn of(lc_name: &str, lc_term: &str) -> Option<Self> {
+        if lc_name == lc_term {
+            return Some(Self::Exact);
+        }
+        let is_boundary = |c: Option<char>| c.is_none_or(|c| !c.is_alphanumeric());
+        let mut best = None;
+        for (idx, _) in lc_name.match_indices(lc_term) {
+            let starts_word = is_boundary(lc_name[..idx].chars().next_back());
+            let ends_word = is_boundary(lc_name[idx + lc_term.len()..].chars().next());
+            let rank = match (starts_word, ends_word) {
+                (true, true) => return Some(Self::Token),
+                (true, false) => Self::Prefix,
+                (false, _) => Self::Substring,
+            };
+            best = best.max(Some(rank));
+        }
+        best
+    }
+}
+
+/// Best rank of `lc_term` against an item's name and aliases.
+fn rank_item(item: &Item, lc_term: &str) -> Option<MatchRank> {
+    std::iter::once(item.name())
+        .chain(item.aliases.iter().map(String::as_str))
+        .filter_map(|name| MatchRank::of(&name.to_lowercase(), lc_term))
+        .max()
+}
+
+/// Search item and NPC ids for a name match and return the best-ranked world entity.
+///
+/// Items are matched on name and aliases, NPCs on name. Ties go to items, then to the
+/// lowest symbol, so the result does not depend on set iteration order.
 pub fn find_world_entity<'a, S: BuildHasher>(
     nearby_item_ids: impl IntoIterator<Item = &'a ItemId>,
     nearby_npc_ids: impl IntoIterator<Item = &'a NpcId>,
@@ -124,25 +178,32 @@ pub fn find_world_entity<'a, S: BuildHasher>(
     search_term: &str,
 ) -> Option<WorldEntity<'a>> {
     let lc_term = search_term.to_lowercase();
-    for item_id in nearby_item_ids {
-        if let Some(found_item) = world_items.get(item_id)
-            && (found_item.name().to_lowercase().contains(&lc_term)
-                || found_item
-                    .aliases
-                    .iter()
-                    .any(|alias| alias.to_lowercase().contains(&lc_term)))
-        {
-            return Some(WorldEntity::Item(found_item));
+    let mut best: Option<(MatchRank, WorldEntity<'a>)> = None;
+    let mut consider = |rank: MatchRank, entity: WorldEntity<'a>| {
+        let better = best.as_ref().is_none_or(|(best_rank, best_entity)| {
+            rank > *best_rank
+                || (rank == *best_rank
+                    && best_entity.is_item() == entity.is_item()
+                    && entity.symbol() < best_entity.symbol())
+        });
+        if better {
+            best = Some((rank, entity));
+        }
+    };
+    for item in nearby_item_ids
+        .into_iter()
+        .filter_map(|item_id| world_items.get(item_id))
+    {
+        if let Some(rank) = rank_item(item, &lc_term) {
+            consider(rank, WorldEntity::Item(item));
         }
     }
-    for npc_id in nearby_npc_ids {
-        if let Some(found_npc) = world_npcs.get(npc_id)
-            && found_npc.name().to_lowercase().contains(&lc_term)
-        {
-            return Some(WorldEntity::Npc(found_npc));
+    for npc in nearby_npc_ids.into_iter().filter_map(|npc_id| world_npcs.get(npc_id)) {
+        if let Some(rank) = MatchRank::of(&npc.name().to_lowercase(), &lc_term) {
+            consider(rank, WorldEntity::Npc(npc));
         }
     }
-    None
+    best.map(|(_, entity)| entity)
 }
 
 /// Feedback to player if an entity search comes up empty.
@@ -155,53 +216,340 @@ pub fn entity_not_found(world: &AmbleWorld, view: &mut View, search_text: &str)
     )));
 }
 
-/// Find an `Item` with name matching `pattern` in the given `SearchScope` and return its id.
+/// Ask the player which item they mean if several tie for the best match of `pattern`.
+///
+/// Returns `true` after pushing the question when the input is ambiguous in `scope`;
+/// the caller should then act on none of the candidates. Candidates that all share one
+/// name cannot be told apart by the player, so they are not asked about and the caller's
+/// usual pick (the lowest id) stands.
+pub fn ask_which_item(world: &AmbleWorld, view: &mut View, pattern: &str, scope: SearchScope) -> bool {
+    let Ok(matches) = find_item_matches(world, pattern, scope) else {
+        return false;
+    };
+    let mut distinct: Vec<&str> = Vec::new();
+    for item in matches.iter().filter_map(|item_id| world.items.get(item_id)) {
+        if !distinct.contains(&item.name()) {
+            distinct.push(item.name());
+        }
+    }
+    if distinct.len() < 2 {
+        return false;
+    }
+    let mut names: Vec<String> = distinct
+        .into_iter()
+        .map(|name| format!("the {}", name.item_style()))
+        .collect();
+    let last = names.pop().unwrap_or_default();
+    view.push(ViewItem::ActionFailure(format!(
+        "Which one do you mean: {} or {last}?",
+        names.join(", ")
+    )));
+    true
+}
+
+/// Find the `Item` whose name best matches `pattern` in the given `SearchScope` and return its id.
+///
+/// Exact names beat whole-word matches, which beat word prefixes, which beat substrings
+/// (see [`MatchRank`]). Equally good matches resolve to the lowest item id; use
+/// [`find_item_matches`] to get all of them instead.
 ///
 /// # Errors
 /// - if no match found in the specified scope
 /// - if an invalid scope for an item search is specified
 /// - if the supplied room or NPC ids are invalid
 pub fn find_item_match(world: &AmbleWorld, pattern: &str, scope: SearchScope) -> Result<ItemId, SearchError> {
-    // construct a HashSet of item ids in scope for this search
-    let haystack: HashSet<_> = match scope {
+    let mut best: Option<(MatchRank, ItemId)> = None;
+    visit_item_hits(world, &pattern.to_lowercase(), scope, &mut |rank, item_id| {
+        if best.is_none_or(|(best_rank, best_id)| {
+            rank > best_rank || (rank == best_rank && item_id.as_str() < best_id.as_str())
+        }) {
+            best = Some((rank, item_id));
+        }
+    })?;
+    best.map(|(_, item_id)| item_id)
+        .ok_or_else(|| SearchError::NoMatchingName(pattern.to_string()))
+}
+
+/// Find every `Item` tied for the best match of `pattern` in the given `SearchScope`.
+///
+/// Ids are sorted, so the first one is what [`find_item_match`] returns; more than one
+/// means the input was ambiguous at its best rank.
+///
+/// # Errors
+/// Same as [`find_item_match`].
+pub fn find_item_matches(world: &AmbleWorld, pattern: &str, scope: SearchScope) -> Result<Vec<ItemId>, SearchError> {
+    let mut best_rank = None;
+    let mut hits = Vec::new();
+    visit_item_hits(
+        world,
+        &pattern.to_lowercase(),
+        scope,
+        &mut |rank, item_id| match best_rank.cmp(&Some(rank)) {
+            Ordering::Less => {
+                best_rank = Some(rank);
+                hits.clear();
+                hits.push(item_id);
+            },
+            Ordering::Equal => hits.push(item_id),
+            Ordering::Greater => {},
+        },
+    )?;
+    if hits.is_empty() {
+        return Err(SearchError::NoMatchingName(pattern.to_string()));
+    }
+    hits.sort_unstable_by_key(|item_id| item_id.as_str());
+    Ok(hits)
+}
+
+/// Report every item in `scope` whose name or an alias matches `lc_term`, with its rank.
+fn visit_item_hits(
+    world: &AmbleWorld,
+    lc_term: &str,
+    scope: SearchScope,
+    on_hit: &mut dyn FnMut(MatchRank, ItemId),
+) -> Result<(), SearchError> {
+    let cache = &world.search_cache;
+    match scope {
+        // room and inventory scopes resolve against the cached candidates
         SearchScope::VisibleItems(room_id) | SearchScope::AllVisible(room_id) => {
-            let room_items = nearby_visible_items(world, &room_id).map_err(|_| SearchError::InvalidRoomId(room_id))?;
-            room_items.union(&world.player.inventory).cloned().collect()
+            cache.visit_room(world, room_id, Reach::Visible, lc_term, on_hit)?;
+            cache.visit_inventory(world, lc_term, on_hit);
         },
         SearchScope::TouchableItems(room_id) | SearchScope::AllTouchable(room_id) => {
-            let room_items =
-                nearby_reachable_items(world, &room_id).map_err(|_| SearchError::InvalidRoomId(room_id))?;
-            room_items.union(&world.player.inventory).cloned().collect()
-        },
-        SearchScope::NearbyVessels(room_id) => {
-            nearby_vessel_items(world, &room_id).map_err(|_| SearchError::InvalidRoomId(room_id.clone()))?
+            cache.visit_room(world, room_id, Reach::Reachable, lc_term, on_hit)?;
+            cache.visit_inventory(world, lc_term, on_hit);
         },
-        SearchScope::Inventory => world.player.inventory.clone(),
+        SearchScope::NearbyVessels(room_id) => cache.visit_room(world, room_id, Reach::Vessel, lc_term, on_hit)?,
+        SearchScope::Inventory => cache.visit_inventory(world, lc_term, on_hit),
         SearchScope::NpcInventory(npc_id) => {
             let npc = world.npcs.get(&npc_id).ok_or(SearchError::InvalidNpcId(npc_id))?;
-            filter_visible_items(&npc.inventory, world)?
+            visit_unindexed(world, &filter_visible_items(&npc.inventory, world)?, lc_term, on_hit);
         },
         SearchScope::ItemContents(item_id) => {
             let item = world.items.get(&item_id).ok_or(SearchError::InvalidItemId(item_id))?;
-            filter_visible_items(&item.contents, world)?
+            visit_unindexed(world, &filter_visible_items(&item.contents, world)?, lc_term, on_hit);
         },
         SearchScope::VisibleNpcs(_) | SearchScope::TouchableNpcs(_) => {
             return Err(SearchError::InvalidScope("item".to_string(), "NPC".to_string()));
         },
-    };
+    }
+    Ok(())
+}
 
-    let Some(entity) = find_world_entity(
-        haystack.iter(),
-        std::iter::empty::<&NpcId>(),
-        &world.items,
-        &world.npcs,
-        pattern,
-    ) else {
-        return Err(SearchError::NoMatchingName(pattern.to_string()));
-    };
-    match entity.entity_id() {
-        EntityId::Item(item_id) => Ok(item_id),
-        EntityId::Npc(_) => Err(SearchError::InvalidScope("item".into(), "NPC".into())),
+/// Rank items that are not in the search cache (NPC inventories and container contents).
+fn visit_unindexed(
+    world: &AmbleWorld,
+    item_ids: &HashSet<ItemId>,
+    lc_term: &str,
+    on_hit: &mut dyn FnMut(MatchRank, ItemId),
+) {
+    for item in item_ids.iter().filter_map(|item_id| world.items.get(item_id)) {
+        if let Some(rank) = rank_item(item, lc_term) {
+            on_hit(rank, item.id);
+        }
+    }
+}
+
+/// Which of a room's cached candidates a search considers.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Reach {
+    /// In the room, or inside an open or transparent container there.
+    Visible,
+    /// In the room, or inside an open container there.
+    Reachable,
+    /// Containers in the room or directly inside something in the room.
+    Vessel,
+}
+
+/// A candidate item with its lowercase name and aliases.
+#[derive(Debug)]
+struct ScopedItem {
+    id: ItemId,
+    /// Container the item sits in, when it is not directly in the room or inventory.
+    parent: Option<ItemId>,
+    /// Lowercase name followed by lowercase aliases.
+    names: Box<[String]>,
+    /// True if the item or its parent has a `visible_when` condition to evaluate.
+    conditional: bool,
+    visible: bool,
+    reachable: bool,
+    vessel: bool,
+}
+
+impl ScopedItem {
+    fn new(item: &Item, parent: Option<&Item>) -> Self {
+        let names = std::iter::once(item.name().to_lowercase())
+            .chain(item.aliases.iter().map(|alias| alias.to_lowercase()))
+            .collect();
+        Self {
+            id: item.id,
+            parent: parent.map(|parent| parent.id),
+            names,
+            conditional: item.visible_when.is_some() || parent.is_some_and(|parent| parent.visible_when.is_some()),
+            visible: true,
+            reachable: true,
+            vessel: item.container_state.is_some(),
+        }
+    }
+
+    fn in_reach(&self, reach: Reach) -> bool {
+        match reach {
+            Reach::Visible => self.visible,
+            Reach::Reachable => self.reachable,
+            Reach::Vessel => self.vessel,
+        }
+    }
+
+    fn rank(&self, lc_term: &str) -> Option<MatchRank> {
+        self.names.iter().filter_map(|name| MatchRank::of(name, lc_term)).max()
+    }
+
+    /// Evaluate visibility conditions: the item's own, and for visible/reachable
+    /// searches its container's too (a hidden container hides its contents).
+    fn passes_conditions(&self, world: &AmbleWorld, reach: Reach) -> bool {
+        !self.conditional
+            || (item_is_visible(world, &self.id)
+                && (reach == Reach::Vessel || self.parent.is_none_or(|parent| item_is_visible(world, &parent))))
+    }
+}
+
+/// Items around one room, built from the room's contents and container states.
+#[derive(Debug)]
+struct RoomScope {
+    items: Vec<ScopedItem>,
+}
+
+impl RoomScope {
+    fn build(world: &AmbleWorld, room_id: RoomId) -> Result<Self, SearchError> {
+        let room = world.rooms.get(&room_id).ok_or(SearchError::InvalidRoomId(room_id))?;
+        let mut items = Vec::new();
+        for item_id in &room.contents {
+            let Some(item) = world.items.get(item_id) else {
+                continue;
+            };
+            items.push(ScopedItem::new(item, None));
+            let open = item.container_state == Some(ContainerState::Open);
+            let see_inside = open || item.is_transparent();
+            for contained_id in &item.contents {
+                let Some(contained) = world.items.get(contained_id) else {
+                    continue;
+                };
+                let mut scoped = ScopedItem::new(contained, Some(item));
+                scoped.visible = see_inside;
+                scoped.reachable = open;
+                if scoped.visible || scoped.vessel {
+                    items.push(scoped);
+                }
+            }
+        }
+        Ok(Self { items })
+    }
+}
+
+/// Cached item search candidates for a world.
+///
+/// This is the world's name index for item lookups. Per room it holds the items in
+/// view, in reach and usable as vessels, plus the player's inventory, each with
+/// lowercase names and aliases ready for [`MatchRank`] matching. The cache only stores
+/// structure: `visible_when` conditions can depend on any world state, so they are
+/// still evaluated per search (for the few items that have one). Everything is
+/// dropped when the world's item or room table reports a mutation, which covers item
+/// moves, container state changes and patches to names or aliases.
+#[derive(Default)]
+pub struct SearchCache {
+    state: Mutex<CacheState>,
+}
+
+#[derive(Default)]
+struct CacheState {
+    revisions: (u64, u64),
+    rooms: HashMap<RoomId, Arc<RoomScope>>,
+    inventory: Option<Arc<[ScopedItem]>>,
+}
+
+impl SearchCache {
+    /// Lock the cache, first emptying it if the world has changed since it was filled.
+    fn lock(&self, world: &AmbleWorld) -> MutexGuard<'_, CacheState> {
+        let mut state = self.state.lock().unwrap_or_else(PoisonError::into_inner);
+        let revisions = (world.items.revision(), world.rooms.revision());
+        if state.revisions != revisions {
+            state.rooms.clear();
+            state.inventory = None;
+            state.revisions = revisions;
+        }
+        state
+    }
+
+    fn room_scope(&self, world: &AmbleWorld, room_id: RoomId) -> Result<Arc<RoomScope>, SearchError> {
+        let mut state = self.lock(world);
+        if let Some(scope) = state.rooms.get(&room_id) {
+            return Ok(Arc::clone(scope));
+        }
+        let scope = Arc::new(RoomScope::build(world, room_id)?);
+        state.rooms.insert(room_id, Arc::clone(&scope));
+        Ok(scope)
+    }
+
+    fn inventory_scope(&self, world: &AmbleWorld) -> Arc<[ScopedItem]> {
+        let inventory = &world.player.inventory;
+        let mut state = self.lock(world);
+        // the player struct is not change-tracked, so check membership as well
+        if let Some(cached) = &state.inventory
+            && cached.len() == inventory.len()
+            && cached.iter().all(|scoped| inventory.contains(&scoped.id))
+        {
+            return Arc::clone(cached);
+        }
+        let items: Vec<ScopedItem> = inventory
+            .iter()
+            .filter_map(|item_id| world.items.get(item_id))
+            .map(|item| ScopedItem::new(item, None))
+            .collect();
+        let items: Arc<[ScopedItem]> = items.into();
+        state.inventory = Some(Arc::clone(&items));
+        items
+    }
+
+    /// Inventory items are always in scope, whatever their `visible_when` says.
+    fn visit_inventory(&self, world: &AmbleWorld, lc_term: &str, on_hit: &mut dyn FnMut(MatchRank, ItemId)) {
+        for scoped in self.inventory_scope(world).iter() {
+            if let Some(rank) = scoped.rank(lc_term) {
+                on_hit(rank, scoped.id);
+            }
+        }
+    }
+
+    fn visit_room(
+        &self,
+        world: &AmbleWorld,
+        room_id: RoomId,
+        reach: Reach,
+        lc_term: &str,
+        on_hit: &mut dyn FnMut(MatchRank, ItemId),
+    ) -> Result<(), SearchError> {
+        // the lock is released before conditions are evaluated against the world
+        let room = self.room_scope(world, room_id)?;
+        for scoped in room.items.iter().filter(|scoped| scoped.in_reach(reach)) {
+            if let Some(rank) = scoped.rank(lc_term)
+                && scoped.passes_conditions(world, reach)
+            {
+                on_hit(rank, scoped.id);
+            }
+        }
+        Ok(())
+    }
+}
+
+impl Clone for SearchCache {
+    /// A clone starts empty; it fills on the first search against its own world.
+    fn clone(&self) -> Self {
+        Self::default()
+    }
+}
+
+impl fmt::Debug for SearchCache {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("SearchCache").finish_non_exhaustive()
     }
 }
 
@@ -314,9 +662,9 @@ mod tests {
             id: room_id.clone(),
             symbol: format!("room_{room_id}"),
             name: name.to_string(),
-            base_description: format!("{name} description"),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            base_description: format!("{name} description").into(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -339,7 +687,7 @@ mod tests {
             id: item_id.clone(),
             symbol: format!("item_{item_id}"),
             name: name.to_string(),
-            description: format!("{name} item"),
+            description: format!("{name} item").into(),
             location,
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -349,7 +697,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.items.insert(item_id.clone(), item);
@@ -362,10 +710,10 @@ mod tests {
             id: npc_id.clone(),
             symbol: format!("npc_{npc_id}"),
             name: name.to_string(),
-            description: format!("{name} npc"),
+            description: format!("{name} npc").into(),
             location,
             inventory: HashSet::new(),
-            dialogue: HashMap::new(),
+            dialogue: HashMap::new().into(),
             state: NpcState::Normal,
             movement: None,
             health: HealthState::new(),
@@ -401,6 +749,111 @@ mod tests {
         assert_eq!(result, chest_id);
     }
 
+    #[test]
+    fn match_rank_prefers_exact_then_words_then_prefixes() {
+        assert_eq!(MatchRank::of("lantern", "lantern"), Some(MatchRank::Exact));
+        assert_eq!(MatchRank::of("brass lantern", "lantern"), Some(MatchRank::Token));
+        assert_eq!(
+            MatchRank::of("old brass lantern", "brass lantern"),
+            Some(MatchRank::Token)
+        );
+        assert_eq!(MatchRank::of("brass lanterns", "lantern"), Some(MatchRank::Prefix));
+        assert_eq!(MatchRank::of("plant", "ant"), Some(MatchRank::Substring));
+        assert_eq!(MatchRank::of("plant ant", "ant"), Some(MatchRank::Token));
+        assert_eq!(MatchRank::of("lamp", "ant"), None);
+    }
+
+    #[test]
+    fn find_item_match_picks_best_rank_and_reports_ties() {
+        let mut world = AmbleWorld::new_empty();
+        let room_id = insert_room(&mut world, "Shop");
+        let names = ["Brass Lantern", "Lanterns", "Lantern", "Lantern Oil"];
+        let ids: Vec<ItemId> = names
+            .iter()
+            .map(|name| insert_item(&mut world, name, Location::Room(room_id.clone()), None))
+            .collect();
+        world
+            .rooms
+            .get_mut(&room_id)
+            .unwrap()
+            .contents
+            .extend(ids.iter().cloned());
+        let scope = SearchScope::VisibleItems(room_id);
+
+        assert_eq!(find_item_match(&world, "lantern", scope.clone()).unwrap(), ids[2]);
+
+        assert_eq!(
+            find_item_matches(&world, "LANTERN OIL", scope.clone()).unwrap(),
+            vec![ids[3].clone()]
+        );
+        let mut word_hits = vec![ids[0].clone(), ids[1].clone(), ids[2].clone(), ids[3].clone()];
+        word_hits.sort_unstable_by_key(|id| id.as_str());
+        assert_eq!(find_item_matches(&world, "lan", scope.clone()).unwrap(), word_hits);
+        assert_eq!(find_item_match(&world, "lan", scope.clone()).unwrap(), word_hits[0]);
+
+        let mut view = View::new();
+        assert!(!ask_which_item(&world, &mut view, "lantern", scope.clone()));
+        assert!(view.items.is_empty());
+        assert!(ask_which_item(&world, &mut view, "lan", scope));
+        let [entry] = view.items.as_slice() else {
+            panic!("expected one question, got {:?}", view.items);
+        };
+        let ViewItem::ActionFailure(question) = &entry.view_item else {
+            panic!("expected a question, got {:?}", entry.view_item);
+        };
+        assert!(question.starts_with("Which one do you mean:"));
+        assert!(names.iter().all(|name| question.contains(name)));
+    }
+
+    #[test]
+    fn same_named_items_resolve_without_asking() {
+        let mut world = AmbleWorld::new_empty();
+        let room_id = insert_room(&mut world, "Cellar");
+        let ids: Vec<ItemId> = (0..2)
+            .map(|_| insert_item(&mut world, "Candle", Location::Room(room_id.clone()), None))
+            .collect();
+        world
+            .rooms
+            .get_mut(&room_id)
+            .unwrap()
+            .contents
+            .extend(ids.iter().cloned());
+        let scope = SearchScope::VisibleItems(room_id);
+
+        assert_eq!(find_item_matches(&world, "candle", scope.clone()).unwrap().len(), 2);
+        let mut view = View::new();
+        assert!(!ask_which_item(&world, &mut view, "candle", scope.clone()));
+        assert!(view.items.is_empty());
+        let first = ids.iter().min_by_key(|id| id.as_str()).unwrap();
+        assert_eq!(&find_item_match(&world, "candle", scope).unwrap(), first);
+    }
+
+    #[test]
+    fn cached_scopes_follow_container_state_and_item_moves() {
+        let mut world = AmbleWorld::new_empty();
+        let room_id = insert_room(&mut world, "Vault");
+        let chest_id = insert_item(
+            &mut world,
+            "Ancient Chest",
+            Location::Room(room_id.clone()),
+            Some(ContainerState::Open),
+        );
+        let gem_id = insert_item(&mut world, "Gem", Location::Item(chest_id.clone()), None);
+        world.rooms.get_mut(&room_id).unwrap().contents.insert(chest_id.clone());
+        world.items.get_mut(&chest_id).unwrap().contents.insert(gem_id.clone());
+
+        let reachable = SearchScope::TouchableItems(room_id.clone());
+        assert_eq!(find_item_match(&world, "GEM", reachable.clone()).unwrap(), gem_id);
+
+        world.items.get_mut(&chest_id).unwrap().container_state = Some(ContainerState::Closed);
+        assert!(find_item_match(&world, "gem", reachable.clone()).is_err());
+
+        world.items.get_mut(&chest_id).unwrap().contents.remove(&gem_id);
+        world.items.get_mut(&gem_id).unwrap().location = Location::Inventory;
+        world.player.inventory.insert(gem_id.clone());
+        assert_eq!(find_item_match(&world, "gem", reachable).unwrap(), gem_id);
+    }
+
     #[test]
     fn find_item_match_returns_items_from_selected_container_only() {
         let mut world = AmbleWorld::new_empty();
@@ -435,9 +888,8 @@ mod tests {
         world.rooms.get_mut(&room_id).unwrap().npcs.insert(npc_id.clone());
 
         let hidden_gem_id = insert_item(&mut world, "Gem", Location::Npc(npc_id.clone()), None);
-        world.items.get_mut(&hidden_gem_id).unwrap().visible_when = Some(EventCondition::Trigger(
-            TriggerCondition::HasFlag("npc_inventory_visible".to_string()),
-        ));
+        world.items.get_mut(&hidden_gem_id).unwrap().visible_when =
+            Some(EventCondition::Trigger(TriggerCondition::HasFlag("npc_inventory_visible".into())).into());
         let visible_coin_id = insert_item(&mut world, "Coin", Location::Npc(npc_id.clone()), None);
 
         world.npcs.get_mut(&npc_id).unwrap().inventory.insert(hidden_gem_id);
@@ -466,9 +918,8 @@ mod tests {
             Some(ContainerState::Open),
         );
         let hidden_gem_id = insert_item(&mut world, "Gem", Location::Item(chest_id.clone()), None);
-        world.items.get_mut(&hidden_gem_id).unwrap().visible_when = Some(EventCondition::Trigger(
-            TriggerCondition::HasFlag("container_contents_visible".to_string()),
-        ));
+        world.items.get_mut(&hidden_gem_id).unwrap().visible_when =
+            Some(EventCondition::Trigger(TriggerCondition::HasFlag("container_contents_visible".into())).into());
         let visible_coin_id = insert_item(&mut world, "Coin", Location::Item(chest_id.clone()), None);
 
         world.rooms.get_mut(&room_id).unwrap().contents.insert(chest_id.clone());
@@ -21,7 +21,7 @@ use serde::{Deserialize, Serialize};
 use std::fmt;
 use variantly::Variantly;
 
-use crate::{AmbleWorld, ItemHolder, player::Flag};
+use crate::{AmbleWorld, ItemHolder, player::FlagRef};
 
 /// Groups that goals can be assigned to.
 #[derive(Debug, Copy, Clone, PartialEq, Eq, Serialize)]
@@ -36,26 +36,21 @@ pub enum GoalGroup {
 #[derive(Debug, Clone, PartialEq, Eq, Serialize)]
 #[serde(tag = "type", rename_all = "camelCase")]
 pub enum GoalCondition {
-    FlagComplete { flag: String },    // for checking if sequence-type flags are at end
-    FlagInProgress { flag: String },  // check if a sequence flag not yet at end
+    FlagComplete { flag: FlagRef },   // for checking if sequence-type flags are at end
+    FlagInProgress { flag: FlagRef }, // check if a sequence flag not yet at end
     GoalComplete { goal_id: String }, // for activating a goal after another is done
     HasItem { item_id: ItemId },
-    HasFlag { flag: String },
-    MissingFlag { flag: String },
+    HasFlag { flag: FlagRef },
+    MissingFlag { flag: FlagRef },
     ReachedRoom { room_id: RoomId },
 }
 impl GoalCondition {
     /// Returns true if the condition has been satisfied.
     pub fn satisfied(&self, world: &AmbleWorld) -> bool {
-        // Helper closure to check if a flag is set by comparing flag values
-        // This works because Flag::value() returns the current state representation
-        // with sequence flags in the form <flag>#<step>.
-        let flag_is_set = |flag_str: &str| world.player.flags.iter().any(|f| f.value() == *flag_str);
-
         match self {
             Self::HasItem { item_id } => world.player.contains_item(item_id.clone()),
-            Self::HasFlag { flag } => flag_is_set(flag),
-            Self::MissingFlag { flag } => !flag_is_set(flag),
+            Self::HasFlag { flag } => world.player.flags.is_set(flag),
+            Self::MissingFlag { flag } => !world.player.flags.is_set(flag),
             Self::ReachedRoom { room_id } => {
                 if let Some(room) = world.rooms.get(room_id) {
                     room.visited
@@ -70,18 +65,8 @@ impl GoalCondition {
                     false
                 }
             },
-            Self::FlagInProgress { flag } => world
-                .player
-                .flags
-                .get(&Flag::Simple {
-                    name: flag.into(),
-                    turn_set: 0,
-                })
-                .is_some_and(|f| !f.is_complete()),
-            Self::FlagComplete { flag } => {
-                let target = Flag::simple(flag, world.turn_count);
-                world.player.flags.get(&target).is_some_and(Flag::is_complete)
-            },
+            Self::FlagInProgress { flag } => world.player.flags.in_progress(flag),
+            Self::FlagComplete { flag } => world.player.flags.is_complete(flag),
         }
     }
 }
@@ -313,10 +298,10 @@ impl<'de> Deserialize<'de> for GoalCondition {
         let repr = GoalConditionRepr::deserialize(deserializer)?;
         Ok(match repr.kind {
             GoalConditionKind::FlagComplete => GoalCondition::FlagComplete {
-                flag: repr.flag.ok_or_else(|| de::Error::missing_field("flag"))?,
+                flag: repr.flag.ok_or_else(|| de::Error::missing_field("flag"))?.into(),
             },
             GoalConditionKind::FlagInProgress => GoalCondition::FlagInProgress {
-                flag: repr.flag.ok_or_else(|| de::Error::missing_field("flag"))?,
+                flag: repr.flag.ok_or_else(|| de::Error::missing_field("flag"))?.into(),
             },
             GoalConditionKind::GoalComplete => GoalCondition::GoalComplete {
                 goal_id: repr.goal_id.ok_or_else(|| de::Error::missing_field("goal_id"))?,
@@ -325,10 +310,10 @@ impl<'de> Deserialize<'de> for GoalCondition {
                 item_id: repr.item_id.ok_or_else(|| de::Error::missing_field("item_id"))?,
             },
             GoalConditionKind::HasFlag => GoalCondition::HasFlag {
-                flag: repr.flag.ok_or_else(|| de::Error::missing_field("flag"))?,
+                flag: repr.flag.ok_or_else(|| de::Error::missing_field("flag"))?.into(),
             },
             GoalConditionKind::MissingFlag => GoalCondition::MissingFlag {
-                flag: repr.flag.ok_or_else(|| de::Error::missing_field("flag"))?,
+                flag: repr.flag.ok_or_else(|| de::Error::missing_field("flag"))?.into(),
             },
             GoalConditionKind::ReachedRoom => GoalCondition::ReachedRoom {
                 room_id: repr.room_id.ok_or_else(|| de::Error::missing_field("room_id"))?,
@@ -488,8 +473,8 @@ mod tests {
             symbol: "test_room".into(),
             name: "Test Room".into(),
             base_description: "A test room".into(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -516,7 +501,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.items.insert(item_id.clone(), item);
@@ -4,32 +4,34 @@
 //! belong in another module. Prefer adding generally useful, low‑level
 //! utilities here to avoid duplication across the codebase.
 
-use std::borrow::Borrow;
 use std::collections::HashMap;
 use std::hash::BuildHasher;
 
+use crate::ids::SymbolKey;
 use crate::world::WorldObject;
 use crate::{Item, Npc};
 use crate::{ItemId, NpcId, RoomId};
 
 /// Generic: Returns the symbol for a given object's id.
-pub fn symbol_from_id<K: Borrow<str> + Eq + std::hash::Hash, T: WorldObject, S: BuildHasher>(
+pub fn symbol_from_id<K: SymbolKey, T: WorldObject, S: BuildHasher>(
     map: &HashMap<K, T, S>,
     id: impl AsRef<str>,
 ) -> Option<&str> {
-    map.get(id.as_ref()).map(super::world::WorldObject::symbol)
+    map.get(&K::from_symbol(id.as_ref())?)
+        .map(super::world::WorldObject::symbol)
 }
 
 /// Generic: Returns the display name for a given object's id.
-pub fn name_from_id<K: Borrow<str> + Eq + std::hash::Hash, T: WorldObject, S: BuildHasher>(
+pub fn name_from_id<K: SymbolKey, T: WorldObject, S: BuildHasher>(
     map: &HashMap<K, T, S>,
     id: impl AsRef<str>,
 ) -> Option<&str> {
-    map.get(id.as_ref()).map(super::world::WorldObject::name)
+    map.get(&K::from_symbol(id.as_ref())?)
+        .map(super::world::WorldObject::name)
 }
 
 /// Convenience: Returns the symbol or a standard fallback string.
-pub fn symbol_or_unknown<K: Borrow<str> + Eq + std::hash::Hash, T: WorldObject, S: BuildHasher>(
+pub fn symbol_or_unknown<K: SymbolKey, T: WorldObject, S: BuildHasher>(
     map: &HashMap<K, T, S>,
     id: impl AsRef<str>,
 ) -> String {
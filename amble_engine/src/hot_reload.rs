@@ -0,0 +1,243 @@
+//! Developer hot reload: swap recompiled world content into a running game.
+//!
+//! [`reload_world`] loads the world file again and carries the game state of the
+//! running world over to it wherever ids still match. That state is where the player,
+//! items and NPCs are, flags, score and health, visited rooms, exit and container
+//! locks, NPC moods and movement, which triggers have fired, and scheduled events.
+//! Content comes from the new file, except descriptions, dialogue and spinners that
+//! were changed in play. Anything whose id disappeared from the new content is
+//! dropped and listed in the [`ReloadReport`]; new content starts where the world
+//! file puts it.
+//!
+//! Used by the `:reload` developer command, typically alongside
+//! `amble_script watch`, which recompiles the world whenever a source file is saved.
+
+use std::collections::HashMap;
+use std::path::Path;
+
+use anyhow::{Context, Result};
+
+use crate::loader::load_world_from_path;
+use crate::loader::placement::{place_items, place_npcs};
+use crate::npc::MovementType;
+use crate::world::{AmbleWorld, Location};
+
+/// What a reload kept and dropped.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct ReloadReport {
+    /// Rooms whose state was carried over.
+    pub rooms: usize,
+    /// Items whose state was carried over.
+    pub items: usize,
+    /// NPCs whose state was carried over.
+    pub npcs: usize,
+    /// Triggers whose fired state was carried over.
+    pub triggers: usize,
+    /// Symbols of rooms, items and NPCs that are no longer in the world content.
+    pub dropped: Vec<String>,
+    /// True if the player's room is gone and the player was moved to the start room.
+    pub player_moved: bool,
+}
+
+impl ReloadReport {
+    /// One-line summary for the developer.
+    pub fn summary(&self) -> String {
+        let mut text = format!(
+            "kept state for {} rooms, {} items, {} NPCs and {} triggers",
+            self.rooms, self.items, self.npcs, self.triggers
+        );
+        if !self.dropped.is_empty() {
+            text.push_str(&format!("; dropped {}", self.dropped.join(", ")));
+        }
+        if self.player_moved {
+            text.push_str("; your room is gone, so you are back at the start");
+        }
+        text
+    }
+}
+
+/// Reload the world file at `path` into `world`, keeping its game state.
+///
+/// `world` is left untouched if the file fails to load.
+///
+/// # Errors
+/// Returns an error if the world file cannot be loaded or its content cannot be placed.
+pub fn reload_world(world: &mut AmbleWorld, path: &Path) -> Result<ReloadReport> {
+    let mut fresh = load_world_from_path(path).with_context(|| format!("reloading {}", path.display()))?;
+    let report = carry_over_state(world, &mut fresh)?;
+    *world = fresh;
+    Ok(report)
+}
+
+/// Copy the game state of `old` onto the freshly loaded `fresh` where ids match.
+///
+/// # Errors
+/// Returns an error if the carried-over locations cannot be placed.
+pub fn carry_over_state(old: &AmbleWorld, fresh: &mut AmbleWorld) -> Result<ReloadReport> {
+    let mut report = ReloadReport::default();
+    fresh.turn_count = old.turn_count;
+    fresh.scheduler = old.scheduler.clone();
+    fresh.rng = old.rng.clone();
+    fresh.player_path = old
+        .player_path
+        .iter()
+        .copied()
+        .filter(|id| fresh.rooms.contains_key(id))
+        .collect();
+
+    // Locations are checked against the new content before anything is moved.
+    let valid = |location: &Location| match location {
+        Location::Room(id) => fresh.rooms.contains_key(id),
+        Location::Item(id) => fresh.items.contains_key(id),
+        Location::Npc(id) => fresh.npcs.contains_key(id),
+        Location::Inventory | Location::Nowhere => true,
+    };
+    let player_location_valid = valid(&old.player.location);
+    let item_locations: HashMap<_, _> = old
+        .items
+        .values()
+        .filter(|item| valid(&item.location))
+        .map(|item| (item.id, item.location.clone()))
+        .collect();
+    let npc_locations: HashMap<_, _> = old
+        .npcs
+        .values()
+        .filter(|npc| valid(&npc.location))
+        .map(|npc| (npc.id, npc.location.clone()))
+        .collect();
+
+    let start = fresh.player.location.clone();
+    fresh.player = old.player.clone();
+    if !player_location_valid {
+        fresh.player.location = start;
+        report.player_moved = true;
+    }
+    fresh.player.location_history.retain(|id| fresh.rooms.contains_key(id));
+    fresh.player.inventory.clear();
+
+    for room in fresh.rooms.values_mut() {
+        room.contents.clear();
+        room.npcs.clear();
+        let Some(prev) = old.rooms.get(&room.id) else {
+            continue;
+        };
+        report.rooms += 1;
+        room.visited = prev.visited;
+        if !prev.base_description.is_content() {
+            room.base_description = prev.base_description.clone();
+        }
+        for (direction, exit) in &mut room.exits {
+            if let Some(prev_exit) = prev.exits.get(direction).filter(|prev_exit| prev_exit.to == exit.to) {
+                exit.hidden = prev_exit.hidden;
+                exit.locked = prev_exit.locked;
+            }
+        }
+    }
+
+    for item in fresh.items.values_mut() {
+        item.contents.clear();
+        let Some(prev) = old.items.get(&item.id) else {
+            continue;
+        };
+        report.items += 1;
+        if let Some(location) = item_locations.get(&item.id) {
+            item.location = location.clone();
+        }
+        item.visibility = prev.visibility;
+        item.container_state = prev.container_state;
+        item.movability = prev.movability.clone();
+        item.consumable = prev.consumable.clone();
+        if !prev.description.is_content() {
+            item.description = prev.description.clone();
+        }
+        if !prev.text.is_content() {
+            item.text = prev.text.clone();
+        }
+    }
+
+    for npc in fresh.npcs.values_mut() {
+        npc.inventory.clear();
+        let Some(prev) = old.npcs.get(&npc.id) else {
+            continue;
+        };
+        report.npcs += 1;
+        if let Some(location) = npc_locations.get(&npc.id) {
+            npc.location = location.clone();
+        }
+        npc.state = prev.state.clone();
+        npc.health = prev.health.clone();
+        if let (Some(movement), Some(prev_movement)) = (&mut npc.movement, &prev.movement) {
+            movement.active = prev_movement.active;
+            movement.last_moved_turn = prev_movement.last_moved_turn;
+            movement.paused_until = prev_movement.paused_until;
+            if let (
+                MovementType::Route { rooms, current_idx, .. },
+                MovementType::Route {
+                    rooms: prev_rooms,
+                    current_idx: prev_idx,
+                    ..
+                },
+            ) = (&mut movement.movement_type, &prev_movement.movement_type)
+                && rooms == prev_rooms
+            {
+                *current_idx = *prev_idx;
+            }
+        }
+        if !prev.description.is_content() {
+            npc.description = prev.description.clone();
+        }
+        if !prev.dialogue.is_content() {
+            npc.dialogue = prev.dialogue.clone();
+        }
+    }
+
+    // Triggers have no ids; match them by name and position among same-named triggers.
+    let mut fired: HashMap<&str, Vec<bool>> = HashMap::new();
+    for trigger in &old.triggers {
+        fired.entry(trigger.name.as_str()).or_default().push(trigger.fired);
+    }
+    let mut seen: HashMap<String, usize> = HashMap::new();
+    for trigger in &mut fresh.triggers {
+        let nth = seen.entry(trigger.name.clone()).or_default();
+        if let Some(was_fired) = fired.get(trigger.name.as_str()).and_then(|flags| flags.get(*nth)) {
+            trigger.fired = *was_fired;
+            report.triggers += 1;
+        }
+        *nth += 1;
+    }
+
+    for (kind, spinner) in old.spinners.iter() {
+        if !spinner.is_content() && fresh.spinners.contains_key(kind) {
+            fresh.spinners.insert(kind.clone(), spinner.clone());
+        }
+    }
+
+    report.dropped = dropped_symbols(old, fresh);
+    place_npcs(fresh).context("placing NPCs after reload")?;
+    place_items(fresh).context("placing items after reload")?;
+    Ok(report)
+}
+
+/// Symbols of rooms, items and NPCs in `old` that `fresh` no longer has, sorted.
+fn dropped_symbols(old: &AmbleWorld, fresh: &AmbleWorld) -> Vec<String> {
+    let mut dropped: Vec<String> = old
+        .rooms
+        .values()
+        .filter(|room| !fresh.rooms.contains_key(&room.id))
+        .map(|room| room.symbol.clone())
+        .chain(
+            old.items
+                .values()
+                .filter(|item| !fresh.items.contains_key(&item.id))
+                .map(|item| item.symbol.clone()),
+        )
+        .chain(
+            old.npcs
+                .values()
+                .filter(|npc| !fresh.npcs.contains_key(&npc.id))
+                .map(|npc| npc.symbol.clone()),
+        )
+        .collect();
+    dropped.sort();
+    dropped
+}
@@ -1,166 +1,328 @@
 //! Core ID types used across the engine.
 //!
 //! `RoomId`, `ItemId`, and `NpcId` are stable newtypes centralized here.
+//!
+//! Each id is a dense `u32` handle into a process-wide symbol table (one table per
+//! id kind) paired with the interned symbol string. Ids are interned once, when
+//! content is loaded or a save is read, after which they are `Copy`: comparing
+//! and hashing an id touches only the handle, and cloning a `Location` or a set of
+//! ids never allocates. The symbol string remains the external form: ids display,
+//! serialize and deserialize exactly as the old `String` newtypes did.
 
-use serde::{Deserialize, Serialize};
-use std::{borrow::Borrow, fmt::Display, ops::Deref};
+use serde::{Deserialize, Deserializer, Serialize, Serializer, de};
+use std::{
+    collections::HashMap,
+    fmt::{self, Display},
+    hash::{Hash, Hasher},
+    marker::PhantomData,
+    ops::Deref,
+    sync::{LazyLock, RwLock},
+};
 
 pub type Id = String;
 
-#[derive(Debug, Clone, Default, Serialize, Deserialize, PartialEq, Eq, Hash)]
-pub struct ItemId(pub(crate) String);
-impl ItemId {
-    pub fn new(id: &impl ToString) -> Self {
-        Self(id.to_string())
-    }
-}
-impl From<&str> for ItemId {
-    fn from(id: &str) -> Self {
-        Self(id.to_string())
-    }
-}
-impl From<String> for ItemId {
-    fn from(id: String) -> Self {
-        Self(id)
-    }
-}
-impl Deref for ItemId {
-    type Target = String;
+/// Most distinct symbols a table interns.
+///
+/// Symbols come from loaded world content and from saves of it, so a real table
+/// holds a few thousand; `:reload` and watch add only the ids an edit introduced.
+/// The cap bounds what the leaked strings can cost if arbitrary symbols arrive
+/// instead (a corrupt or hostile save): past it, reading ids fails rather than
+/// growing the table.
+const MAX_SYMBOLS: usize = 1 << 20;
 
-    fn deref(&self) -> &Self::Target {
-        &self.0
-    }
-}
-impl AsRef<str> for ItemId {
-    fn as_ref(&self) -> &str {
-        &self.0
-    }
+/// Bidirectional mapping between symbol strings and dense handles.
+///
+/// Symbol strings are leaked so ids can carry a `&'static str`; the table only
+/// grows, up to `capacity` symbols (see [`MAX_SYMBOLS`]). Symbols that come from
+/// player or developer input must therefore be resolved with `lookup`, never
+/// interned with `new`/`from`.
+#[derive(Debug)]
+struct SymbolTable {
+    handles: HashMap<&'static str, u32>,
+    symbols: Vec<&'static str>,
+    capacity: usize,
 }
-impl Borrow<str> for ItemId {
-    fn borrow(&self) -> &str {
-        &self.0
+impl Default for SymbolTable {
+    fn default() -> Self {
+        Self {
+            handles: HashMap::new(),
+            symbols: Vec::new(),
+            capacity: MAX_SYMBOLS,
+        }
     }
 }
-impl Borrow<String> for ItemId {
-    fn borrow(&self) -> &String {
-        &self.0
+impl SymbolTable {
+    fn intern(table: &RwLock<SymbolTable>, symbol: &str) -> (u32, &'static str) {
+        Self::try_intern(table, symbol)
+            .unwrap_or_else(|| panic!("interning '{symbol}' would exceed {MAX_SYMBOLS} distinct ids of one kind"))
     }
-}
-impl PartialEq<String> for ItemId {
-    fn eq(&self, other: &String) -> bool {
-        *other == self.0
-    }
-}
-impl Display for ItemId {
-    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
-        write!(f, "{}", self.0)
+
+    /// Intern `symbol`, or `None` if it is new and the table is full.
+    fn try_intern(table: &RwLock<SymbolTable>, symbol: &str) -> Option<(u32, &'static str)> {
+        if let Some(found) = table.read().expect("symbol table poisoned").get(symbol) {
+            return Some(found);
+        }
+        let mut table = table.write().expect("symbol table poisoned");
+        if let Some(found) = table.get(symbol) {
+            return Some(found);
+        }
+        if table.symbols.len() >= table.capacity {
+            return None;
+        }
+        let handle = u32::try_from(table.symbols.len()).expect("symbol table exceeds u32 handles");
+        let leaked: &'static str = Box::leak(symbol.to_owned().into_boxed_str());
+        table.handles.insert(leaked, handle);
+        table.symbols.push(leaked);
+        Some((handle, leaked))
     }
-}
 
-#[derive(Debug, Clone, Default, Serialize, Deserialize, PartialEq, Eq, Hash)]
-pub struct NpcId(pub(crate) String);
-impl NpcId {
-    pub fn new(id: &impl ToString) -> Self {
-        Self(id.to_string())
+    fn get(&self, symbol: &str) -> Option<(u32, &'static str)> {
+        self.handles
+            .get(symbol)
+            .map(|&handle| (handle, self.symbols[handle as usize]))
     }
 }
-impl From<&str> for NpcId {
-    fn from(id: &str) -> Self {
-        Self(id.to_string())
-    }
+
+/// Ids that can be interned without panicking when their table is full.
+trait TryIntern: Sized {
+    fn try_intern(symbol: &str) -> Option<Self>;
 }
-impl From<String> for NpcId {
-    fn from(id: String) -> Self {
-        Self(id)
+
+/// Deserialize an id from a newtype wrapper (or its one-element tuple form) or a bare string.
+///
+/// Fails instead of panicking once the id kind's table is full, since the symbols
+/// come from a file.
+struct IdVisitor<T>(PhantomData<T>, &'static str);
+impl<T: TryIntern> IdVisitor<T> {
+    fn intern<E: de::Error>(&self, symbol: &str) -> Result<T, E> {
+        T::try_intern(symbol).ok_or_else(|| E::custom(format!("too many distinct {} symbols", self.1)))
     }
 }
-impl Deref for NpcId {
-    type Target = String;
+impl<'de, T: TryIntern> de::Visitor<'de> for IdVisitor<T> {
+    type Value = T;
 
-    fn deref(&self) -> &Self::Target {
-        &self.0
+    fn expecting(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        write!(f, "a {} symbol string", self.1)
     }
-}
-impl AsRef<str> for NpcId {
-    fn as_ref(&self) -> &str {
-        &self.0
+
+    fn visit_str<E: de::Error>(self, v: &str) -> Result<T, E> {
+        self.intern(v)
     }
-}
-impl Borrow<str> for NpcId {
-    fn borrow(&self) -> &str {
-        &self.0
+
+    fn visit_newtype_struct<D: Deserializer<'de>>(self, deserializer: D) -> Result<T, D::Error> {
+        let symbol = String::deserialize(deserializer)?;
+        self.intern(&symbol)
     }
-}
-impl Borrow<String> for NpcId {
-    fn borrow(&self) -> &String {
-        &self.0
+
+    fn visit_seq<A: de::SeqAccess<'de>>(self, mut seq: A) -> Result<T, A::Error> {
+        let symbol: String = seq.next_element()?.ok_or_else(|| de::Error::invalid_length(0, &self))?;
+        self.intern(&symbol)
     }
 }
-impl PartialEq<String> for NpcId {
-    fn eq(&self, other: &String) -> bool {
-        *other == self.0
-    }
+
+/// Id types that can be resolved from their symbol string.
+///
+/// Used by lookups that start from a symbol (for example, id-keyed map helpers)
+/// now that ids no longer borrow as `str`.
+pub trait SymbolKey: Copy + Eq + Hash {
+    /// The already-interned id for `symbol`, if any.
+    fn from_symbol(symbol: &str) -> Option<Self>;
 }
-impl Display for NpcId {
-    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
-        write!(f, "{}", self.0)
-    }
+
+macro_rules! entity_id {
+    ($(#[$meta:meta])* $name:ident, $table:ident) => {
+        static $table: LazyLock<RwLock<SymbolTable>> = LazyLock::new(|| RwLock::new(SymbolTable::default()));
+
+        $(#[$meta])*
+        #[derive(Clone, Copy)]
+        pub struct $name {
+            handle: u32,
+            symbol: &'static str,
+        }
+        impl $name {
+            pub fn new(id: &impl ToString) -> Self {
+                Self::from(id.to_string().as_str())
+            }
+
+            /// Look up the id for `symbol` without interning it.
+            pub fn lookup(symbol: &str) -> Option<Self> {
+                $table
+                    .read()
+                    .expect("symbol table poisoned")
+                    .get(symbol)
+                    .map(|(handle, symbol)| Self { handle, symbol })
+            }
+
+            /// Dense handle for this id, unique among ids of the same kind.
+            pub fn handle(self) -> u32 {
+                self.handle
+            }
+
+            /// The symbol string this id was interned from.
+            pub fn as_str(&self) -> &'static str {
+                self.symbol
+            }
+        }
+        impl SymbolKey for $name {
+            fn from_symbol(symbol: &str) -> Option<Self> {
+                Self::lookup(symbol)
+            }
+        }
+        impl Default for $name {
+            fn default() -> Self {
+                Self::from("")
+            }
+        }
+        impl From<&str> for $name {
+            fn from(id: &str) -> Self {
+                let (handle, symbol) = SymbolTable::intern(&$table, id);
+                Self { handle, symbol }
+            }
+        }
+        impl TryIntern for $name {
+            fn try_intern(id: &str) -> Option<Self> {
+                SymbolTable::try_intern(&$table, id).map(|(handle, symbol)| Self { handle, symbol })
+            }
+        }
+        impl From<String> for $name {
+            fn from(id: String) -> Self {
+                Self::from(id.as_str())
+            }
+        }
+        impl From<&String> for $name {
+            fn from(id: &String) -> Self {
+                Self::from(id.as_str())
+            }
+        }
+        impl Deref for $name {
+            type Target = str;
+
+            fn deref(&self) -> &Self::Target {
+                self.symbol
+            }
+        }
+        impl AsRef<str> for $name {
+            fn as_ref(&self) -> &str {
+                self.symbol
+            }
+        }
+        impl PartialEq for $name {
+            fn eq(&self, other: &Self) -> bool {
+                self.handle == other.handle
+            }
+        }
+        impl Eq for $name {}
+        impl Hash for $name {
+            fn hash<H: Hasher>(&self, state: &mut H) {
+                self.handle.hash(state);
+            }
+        }
+        impl PartialEq<String> for $name {
+            fn eq(&self, other: &String) -> bool {
+                other == self.symbol
+            }
+        }
+        impl PartialEq<str> for $name {
+            fn eq(&self, other: &str) -> bool {
+                other == self.symbol
+            }
+        }
+        impl PartialEq<&str> for $name {
+            fn eq(&self, other: &&str) -> bool {
+                *other == self.symbol
+            }
+        }
+        impl fmt::Debug for $name {
+            fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+                f.debug_tuple(stringify!($name)).field(&self.symbol).finish()
+            }
+        }
+        impl Display for $name {
+            fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+                f.write_str(self.symbol)
+            }
+        }
+        impl Serialize for $name {
+            fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+                serializer.serialize_newtype_struct(stringify!($name), self.symbol)
+            }
+        }
+        impl<'de> Deserialize<'de> for $name {
+            fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+                deserializer.deserialize_newtype_struct(
+                    stringify!($name),
+                    IdVisitor::<$name>(PhantomData, stringify!($name)),
+                )
+            }
+        }
+    };
 }
 
+entity_id!(
+    /// Stable identifier type for an `Item`.
+    ItemId,
+    ITEM_SYMBOLS
+);
+entity_id!(
+    /// Stable identifier type for an `Npc`.
+    NpcId,
+    NPC_SYMBOLS
+);
+entity_id!(
+    /// Stable identifier type for a `Room`.
+    RoomId,
+    ROOM_SYMBOLS
+);
+
 /// Typed identifier for item-or-npc search results.
-#[derive(Debug, Clone, PartialEq, Eq, Hash, Serialize, Deserialize)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, Serialize, Deserialize)]
 pub enum EntityId {
     Item(ItemId),
     Npc(NpcId),
 }
 
-#[derive(Debug, Clone, Default, Serialize, Deserialize, PartialEq, Eq, Hash)]
-/// Stable identifier type for a `Room`.
-pub struct RoomId(pub(crate) String);
-impl RoomId {
-    pub fn new(id: &impl ToString) -> Self {
-        Self(id.to_string())
-    }
-}
-impl From<&str> for RoomId {
-    fn from(id: &str) -> Self {
-        Self(id.to_string())
-    }
-}
-impl From<String> for RoomId {
-    fn from(id: String) -> Self {
-        Self(id)
-    }
-}
-impl Deref for RoomId {
-    type Target = String;
+#[cfg(test)]
+mod tests {
+    use super::*;
 
-    fn deref(&self) -> &Self::Target {
-        &self.0
-    }
-}
-impl AsRef<str> for RoomId {
-    fn as_ref(&self) -> &str {
-        &self.0
-    }
-}
-impl Borrow<str> for RoomId {
-    fn borrow(&self) -> &str {
-        &self.0
-    }
-}
-impl Borrow<String> for RoomId {
-    fn borrow(&self) -> &String {
-        &self.0
+    #[test]
+    fn interning_is_stable_and_dense_per_kind() {
+        let a = ItemId::from("ids_test_lamp");
+        let b = ItemId::from(String::from("ids_test_lamp"));
+        assert_eq!(a, b);
+        assert_eq!(a.handle(), b.handle());
+        assert_eq!(a.as_str(), "ids_test_lamp");
+        assert_eq!(ItemId::lookup("ids_test_lamp"), Some(a));
+        assert!(ItemId::lookup("ids_test_never_interned").is_none());
+
+        let other = ItemId::from("ids_test_key");
+        assert_ne!(a, other);
+        assert_ne!(a.handle(), other.handle());
     }
-}
-impl PartialEq<String> for RoomId {
-    fn eq(&self, other: &String) -> bool {
-        *other == self.0
+
+    #[test]
+    fn full_tables_refuse_new_symbols() {
+        let table = RwLock::new(SymbolTable {
+            capacity: 2,
+            ..SymbolTable::default()
+        });
+        let first = SymbolTable::try_intern(&table, "ids_test_a").unwrap();
+        assert!(SymbolTable::try_intern(&table, "ids_test_b").is_some());
+        assert!(SymbolTable::try_intern(&table, "ids_test_c").is_none());
+        assert_eq!(SymbolTable::try_intern(&table, "ids_test_a"), Some(first));
     }
-}
-impl Display for RoomId {
-    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
-        write!(f, "{}", self.0)
+
+    #[test]
+    fn ids_round_trip_through_ron_as_symbol_strings() {
+        #[derive(Serialize)]
+        #[serde(rename = "RoomId")]
+        struct Legacy(String);
+
+        let room = RoomId::from("ids_test_hall");
+        let text = ron::to_string(&room).unwrap();
+        assert_eq!(text, ron::to_string(&Legacy("ids_test_hall".into())).unwrap());
+        let back: RoomId = ron::from_str(&text).unwrap();
+        assert_eq!(back, room);
+        assert_eq!(format!("{back}"), "ids_test_hall");
     }
 }
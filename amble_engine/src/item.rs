@@ -6,8 +6,8 @@
 
 use crate::{
     ItemId, Location, NpcId, RoomId, View, ViewItem, WorldObject,
-    scheduler::EventCondition,
     style::GameStyle,
+    trigger::CompiledCondition,
     view::ContentLine,
     world::{AmbleWorld, item_is_listed, item_is_visible},
 };
@@ -16,6 +16,7 @@ use anyhow::{Context, Result};
 use colored::Colorize;
 
 use crate::Id;
+use crate::content::Shared;
 use log::info;
 use serde::{Deserialize, Serialize};
 use std::{
@@ -51,7 +52,8 @@ pub struct Item {
     /// The display name of the item.
     pub name: String,
     /// A general description of the item.
-    pub description: String,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub description: Shared<String>,
     /// The current `Location` of the item.
     pub location: Location,
     /// Determines whether the item appears in listings or is discoverable.
@@ -59,7 +61,7 @@ pub struct Item {
     pub visibility: ItemVisibility,
     /// Optional condition gating visibility.
     #[serde(default)]
-    pub visible_when: Option<EventCondition>,
+    pub visible_when: Option<CompiledCondition>,
     /// Alternate names that can match this item in parser searches.
     #[serde(default)]
     pub aliases: Vec<String>,
@@ -74,7 +76,8 @@ pub struct Item {
     /// Relates interactions to abilities. (Ex: to perform the "burn" interaction targeting this item, the other item must have the "ignite" capability.)
     pub interaction_requires: HashMap<ItemInteractionType, ItemAbility>,
     /// Any legible detail text on the item. **Also used as the detail text for the "examine" command.**
-    pub text: Option<String>,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub text: Shared<Option<String>>,
     /// Some consumable parameters [`ConsumableOpts`], or None it the item isn't consumable.
     pub consumable: Option<ConsumableOpts>,
 }
@@ -174,7 +177,7 @@ impl Item {
         // push general desccription to View
         view.push(ViewItem::ItemDescription {
             name: self.name.clone(),
-            description: self.description.clone(),
+            description: self.description.to_string(),
         });
 
         // push any consumable status to View
@@ -560,7 +563,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         }
     }
@@ -0,0 +1,529 @@
+//! Incremental autosave journal.
+//!
+//! Rather than rewriting the whole world every turn, autosave appends a
+//! [`JournalRecord`] describing what changed to a journal file that sits next to
+//! the autosave snapshot (`<slot>-amble-<version>.journal`). Every
+//! [`COMPACT_EVERY`] records, or whenever the journal no longer matches the
+//! world (first autosave of a session, after loading a game...), the journal is
+//! compacted: a full snapshot is written and the journal restarted empty.
+//!
+//! Changes are collected from the world's [`TrackedMap`](crate::tracked_map::TrackedMap)
+//! entity tables, which record the keys mutated by any handler or trigger action,
+//! plus cheap comparisons of the small remaining state (player, path, trigger
+//! flags, scheduler). Each record is therefore proportional to the number of
+//! entities touched during the turn rather than to the size of the world.
+//!
+//! # File layout
+//! A journal starts with magic bytes and the turn count and size of the snapshot
+//! it extends, followed by length- and checksum-prefixed CBOR records. Loading
+//! replays records in order and stops at the first incomplete or corrupt one, so
+//! a crash mid-append loses at most the turn being written.
+
+use crate::content::Shared;
+use crate::player::Player;
+use crate::save_files::{SaveFormat, active_save_format, save_dir_for_world, save_file_name, write_save_file};
+use crate::scheduler::Scheduler;
+use crate::spinners::SpinnerType;
+use crate::tracked_map::{MapChanges, TrackedMap};
+use crate::trigger::Trigger;
+use crate::{AmbleWorld, Item, ItemId, Npc, NpcId, Room, RoomId};
+
+use crate::spinners::Spinner;
+use anyhow::{Context, Result};
+use log::{info, warn};
+use serde::{Deserialize, Serialize};
+use std::fs::{self, OpenOptions};
+use std::hash::Hash;
+use std::io::Write;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicU64, Ordering};
+
+/// Number of journal records appended before the journal is compacted into a snapshot.
+pub const COMPACT_EVERY: usize = 50;
+
+const JOURNAL_MAGIC: &[u8; 8] = b"AMBLEJNL";
+const JOURNAL_HEADER_LEN: usize = 8 + 8 + 8;
+const FRAME_HEADER_LEN: usize = 4 + 4;
+
+static NEXT_EPOCH: AtomicU64 = AtomicU64::new(1);
+
+/// Path of the journal that extends the save at `save_path`.
+pub fn journal_path(save_path: &Path) -> PathBuf {
+    save_path.with_extension("journal")
+}
+
+/// Changes to one of the world's entity tables.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub enum MapDelta<K: Eq + Hash, V> {
+    /// Upsert these entries and remove these keys.
+    Changes { upserts: Vec<(K, V)>, removed: Vec<K> },
+    /// Replace the whole table.
+    Replace(Vec<(K, V)>),
+}
+
+impl<K: Eq + Hash + Clone, V: Clone> MapDelta<K, V> {
+    fn collect(map: &mut TrackedMap<K, V>) -> Self {
+        match map.take_changes() {
+            MapChanges::All => MapDelta::Replace(map.iter().map(|(k, v)| (k.clone(), v.clone())).collect()),
+            MapChanges::Keys(keys) => {
+                let mut upserts = Vec::new();
+                let mut removed = Vec::new();
+                for key in keys {
+                    match map.get(&key) {
+                        Some(value) => upserts.push((key, value.clone())),
+                        None => removed.push(key),
+                    }
+                }
+                MapDelta::Changes { upserts, removed }
+            },
+        }
+    }
+
+    #[cfg(test)]
+    fn is_empty(&self) -> bool {
+        matches!(self, MapDelta::Changes { upserts, removed } if upserts.is_empty() && removed.is_empty())
+    }
+
+    fn apply(self, map: &mut TrackedMap<K, V>) {
+        match self {
+            MapDelta::Replace(entries) => *map = entries.into_iter().collect(),
+            MapDelta::Changes { upserts, removed } => {
+                for key in &removed {
+                    map.remove(key);
+                }
+                for (key, value) in upserts {
+                    map.insert(key, value);
+                }
+            },
+        }
+        map.clear_changes();
+    }
+}
+
+/// World changes made between two autosaves.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+pub struct JournalRecord {
+    pub turn_count: usize,
+    pub max_score: usize,
+    pub player: Player,
+    /// Length the player path is truncated to before `path_tail` is appended.
+    pub path_len: usize,
+    pub path_tail: Vec<RoomId>,
+    pub rooms: MapDelta<RoomId, Room>,
+    pub items: MapDelta<ItemId, Item>,
+    pub npcs: MapDelta<NpcId, Npc>,
+    pub spinners: MapDelta<SpinnerType, Shared<Spinner<String>>>,
+    /// Trigger `fired` flags that changed, by trigger index.
+    pub fired: Vec<(usize, bool)>,
+    /// Full trigger list, present only when triggers were added or removed.
+    pub triggers: Option<Vec<Trigger>>,
+    /// Full scheduler, present only when it changed.
+    pub scheduler: Option<Scheduler>,
+    /// World RNG state at the time of the record.
+    #[serde(default)]
+    pub rng_state: Option<u64>,
+}
+
+impl JournalRecord {
+    /// Apply this record on top of `world`.
+    pub fn apply(self, world: &mut AmbleWorld) {
+        world.turn_count = self.turn_count;
+        world.max_score = self.max_score;
+        world.player = self.player;
+        world.player_path.truncate(self.path_len);
+        world.player_path.extend(self.path_tail);
+        self.rooms.apply(&mut world.rooms);
+        self.items.apply(&mut world.items);
+        self.npcs.apply(&mut world.npcs);
+        self.spinners.apply(&mut world.spinners);
+        if let Some(triggers) = self.triggers {
+            world.replace_triggers(triggers);
+        }
+        for (idx, fired) in self.fired {
+            if let Some(trigger) = world.triggers.get_mut(idx) {
+                trigger.fired = fired;
+            }
+        }
+        if let Some(state) = self.rng_state {
+            world.rng.reseed(state);
+        }
+        if let Some(scheduler) = self.scheduler {
+            world.scheduler = scheduler;
+        }
+    }
+}
+
+/// State from the last autosave used to detect changes outside the tracked maps.
+#[derive(Debug, Clone, Default)]
+struct Baseline {
+    fired: Vec<bool>,
+    path_len: usize,
+    /// (heap length, event count): every scheduler operation except direct edits changes one of these.
+    scheduler: (usize, usize),
+}
+
+impl Baseline {
+    fn capture(world: &AmbleWorld) -> Self {
+        Baseline {
+            fired: world.triggers.iter().map(|trigger| trigger.fired).collect(),
+            path_len: world.player_path.len(),
+            scheduler: (world.scheduler.heap.len(), world.scheduler.events.len()),
+        }
+    }
+
+    /// Collect the changes since the baseline into a record and advance the baseline.
+    fn record(&mut self, world: &mut AmbleWorld) -> JournalRecord {
+        let current = Baseline::capture(world);
+
+        let (path_len, path_tail) = if current.path_len >= self.path_len {
+            (self.path_len, world.player_path[self.path_len..].to_vec())
+        } else {
+            (0, world.player_path.clone())
+        };
+        let (fired, triggers) = if current.fired.len() == self.fired.len() {
+            let changed = current
+                .fired
+                .iter()
+                .zip(&self.fired)
+                .enumerate()
+                .filter(|(_, (now, before))| now != before)
+                .map(|(idx, (now, _))| (idx, *now))
+                .collect();
+            (changed, None)
+        } else {
+            (Vec::new(), Some(world.triggers.clone()))
+        };
+        let scheduler = (current.scheduler != self.scheduler).then(|| world.scheduler.clone());
+
+        *self = current;
+        JournalRecord {
+            turn_count: world.turn_count,
+            max_score: world.max_score,
+            player: world.player.clone(),
+            path_len,
+            path_tail,
+            rooms: MapDelta::collect(&mut world.rooms),
+            items: MapDelta::collect(&mut world.items),
+            npcs: MapDelta::collect(&mut world.npcs),
+            spinners: MapDelta::collect(&mut world.spinners),
+            fired,
+            triggers,
+            scheduler,
+            rng_state: Some(world.rng.state()),
+        }
+    }
+}
+
+/// Per-session autosave writer that appends to the journal and compacts it periodically.
+#[derive(Debug)]
+pub struct AutosaveJournal {
+    slot: String,
+    epoch: u64,
+    records: usize,
+    baseline: Baseline,
+    snapshot_path: Option<PathBuf>,
+}
+
+impl AutosaveJournal {
+    /// Create a journal writer for the given save slot.
+    pub fn new(slot: &str) -> Self {
+        AutosaveJournal {
+            slot: slot.to_string(),
+            epoch: NEXT_EPOCH.fetch_add(1, Ordering::Relaxed),
+            records: 0,
+            baseline: Baseline::default(),
+            snapshot_path: None,
+        }
+    }
+
+    /// Number of records appended since the last compaction.
+    pub fn pending_records(&self) -> usize {
+        self.records
+    }
+
+    /// Autosave `world`, appending a journal record or compacting as needed.
+    ///
+    /// # Errors
+    /// - on failure to create the save directory or write the snapshot or journal
+    pub fn autosave(&mut self, world: &mut AmbleWorld) -> Result<()> {
+        let save_dir = save_dir_for_world(world);
+        let save_path = save_dir.join(save_file_name(&self.slot, active_save_format()));
+        if world.journal_epoch != Some(self.epoch)
+            || self.snapshot_path.as_deref() != Some(save_path.as_path())
+            || self.records >= COMPACT_EVERY
+        {
+            fs::create_dir_all(&save_dir).with_context(|| "error creating saved_games folder".to_string())?;
+            return self.compact(world, save_path, active_save_format());
+        }
+        let record = self.baseline.record(world);
+        append_record(&journal_path(&save_path), &record)?;
+        self.records += 1;
+        Ok(())
+    }
+
+    /// Write a full snapshot of `world` and start a new, empty journal after it.
+    ///
+    /// # Errors
+    /// - on failure to write the snapshot or the journal header
+    pub fn compact(&mut self, world: &mut AmbleWorld, save_path: PathBuf, format: SaveFormat) -> Result<()> {
+        write_save_file(world, &save_path, format)?;
+        let snapshot_len = fs::metadata(&save_path)
+            .with_context(|| format!("reading metadata for '{}'", save_path.display()))?
+            .len();
+        write_journal_header(&journal_path(&save_path), world.turn_count, snapshot_len)?;
+
+        world.rooms.clear_changes();
+        world.items.clear_changes();
+        world.npcs.clear_changes();
+        world.spinners.clear_changes();
+        world.journal_epoch = Some(self.epoch);
+        self.baseline = Baseline::capture(world);
+        self.records = 0;
+        self.snapshot_path = Some(save_path);
+        info!("Autosave journal compacted into snapshot (turn {})", world.turn_count);
+        Ok(())
+    }
+}
+
+/// Replay the journal for the save at `save_path` (if any) on top of `world`.
+///
+/// Records are applied in order until the first truncated or corrupt frame. A
+/// journal written for a different snapshot is ignored. Returns the number of
+/// records applied.
+///
+/// # Errors
+/// - if the journal exists but cannot be read
+pub fn replay_journal(world: &mut AmbleWorld, save_path: &Path) -> Result<usize> {
+    let path = journal_path(save_path);
+    let bytes = match fs::read(&path) {
+        Ok(bytes) => bytes,
+        Err(err) if err.kind() == std::io::ErrorKind::NotFound => return Ok(0),
+        Err(err) => return Err(err).with_context(|| format!("reading journal {}", path.display())),
+    };
+    let snapshot_len = fs::metadata(save_path)
+        .with_context(|| format!("reading metadata for '{}'", save_path.display()))?
+        .len();
+    let Some((base_turn, base_len)) = parse_journal_header(&bytes) else {
+        warn!("ignoring journal {} with invalid header", path.display());
+        return Ok(0);
+    };
+    if base_turn != world.turn_count as u64 || base_len != snapshot_len {
+        warn!("ignoring journal {} written for a different snapshot", path.display());
+        return Ok(0);
+    }
+
+    let mut applied = 0;
+    let mut rest = &bytes[JOURNAL_HEADER_LEN..];
+    while let Some((payload, remaining)) = next_frame(rest) {
+        let Ok(record) = ciborium::from_reader::<JournalRecord, _>(payload) else {
+            warn!("journal {} has an undecodable record; stopping replay", path.display());
+            break;
+        };
+        record.apply(world);
+        applied += 1;
+        rest = remaining;
+    }
+    if !rest.is_empty() && applied > 0 {
+        warn!("journal {} ends with a partial record; ignored", path.display());
+    }
+    Ok(applied)
+}
+
+fn write_journal_header(path: &Path, base_turn: usize, snapshot_len: u64) -> Result<()> {
+    let mut tmp_name = path.as_os_str().to_owned();
+    tmp_name.push(".tmp");
+    let tmp_path = PathBuf::from(tmp_name);
+    let mut header = Vec::with_capacity(JOURNAL_HEADER_LEN);
+    header.extend_from_slice(JOURNAL_MAGIC);
+    header.extend_from_slice(&(base_turn as u64).to_le_bytes());
+    header.extend_from_slice(&snapshot_len.to_le_bytes());
+    fs::write(&tmp_path, &header).with_context(|| format!("writing journal '{}'", tmp_path.display()))?;
+    fs::rename(&tmp_path, path).with_context(|| format!("moving journal into place at '{}'", path.display()))
+}
+
+fn append_record(path: &Path, record: &JournalRecord) -> Result<()> {
+    let mut payload = Vec::new();
+    ciborium::into_writer(record, &mut payload).with_context(|| "error encoding journal record".to_string())?;
+    let len = u32::try_from(payload.len()).context("journal record too large")?;
+    let mut frame = Vec::with_capacity(FRAME_HEADER_LEN + payload.len());
+    frame.extend_from_slice(&len.to_le_bytes());
+    frame.extend_from_slice(&checksum(&payload).to_le_bytes());
+    frame.extend_from_slice(&payload);
+
+    let mut file = OpenOptions::new()
+        .append(true)
+        .open(path)
+        .with_context(|| format!("opening journal '{}'", path.display()))?;
+    file.write_all(&frame)
+        .with_context(|| format!("appending to journal '{}'", path.display()))?;
+    file.sync_data()
+        .with_context(|| format!("syncing journal '{}'", path.display()))
+}
+
+fn parse_journal_header(bytes: &[u8]) -> Option<(u64, u64)> {
+    if bytes.len() < JOURNAL_HEADER_LEN || &bytes[..8] != JOURNAL_MAGIC {
+        return None;
+    }
+    let base_turn = u64::from_le_bytes(bytes[8..16].try_into().ok()?);
+    let snapshot_len = u64::from_le_bytes(bytes[16..24].try_into().ok()?);
+    Some((base_turn, snapshot_len))
+}
+
+/// Split the next complete, checksum-valid frame off `bytes`.
+fn next_frame(bytes: &[u8]) -> Option<(&[u8], &[u8])> {
+    if bytes.len() < FRAME_HEADER_LEN {
+        return None;
+    }
+    let len = u32::from_le_bytes(bytes[0..4].try_into().ok()?) as usize;
+    let sum = u32::from_le_bytes(bytes[4..8].try_into().ok()?);
+    let end = FRAME_HEADER_LEN.checked_add(len)?;
+    if bytes.len() < end {
+        return None;
+    }
+    let payload = &bytes[FRAME_HEADER_LEN..end];
+    (checksum(payload) == sum).then_some((payload, &bytes[end..]))
+}
+
+/// FNV-1a checksum used to detect torn or corrupted journal records.
+fn checksum(bytes: &[u8]) -> u32 {
+    bytes.iter().fold(0x811c_9dc5_u32, |hash, byte| {
+        (hash ^ u32::from(*byte)).wrapping_mul(0x0100_0193)
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::player::Flag;
+    use crate::save_files::load_save_file;
+    use std::collections::{HashMap, HashSet};
+    use tempfile::tempdir;
+
+    fn room(id: &RoomId, name: &str) -> Room {
+        Room {
+            id: *id,
+            symbol: id.to_string(),
+            name: name.into(),
+            base_description: "Desc".into(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
+            scenery_default: None,
+            location: crate::Location::Nowhere,
+            visited: false,
+            exits: HashMap::new(),
+            contents: HashSet::new(),
+            npcs: HashSet::new(),
+        }
+    }
+
+    fn world() -> AmbleWorld {
+        let mut world = AmbleWorld::new_empty();
+        for (id, name) in [("journal_hall", "Hall"), ("journal_lab", "Lab")] {
+            let id = RoomId::from(id);
+            world.rooms.insert(id, room(&id, name));
+        }
+        world.player.location = crate::Location::Room(RoomId::from("journal_hall"));
+        world.turn_count = 1;
+        world
+    }
+
+    /// Take one "turn": move the player, visit a room and set a flag.
+    fn play_turn(world: &mut AmbleWorld, turn: usize) {
+        let dest = RoomId::from(if turn % 2 == 0 { "journal_hall" } else { "journal_lab" });
+        world.player.location = crate::Location::Room(dest);
+        world.player_path.push(dest);
+        world.rooms.get_mut(&dest).unwrap().visited = true;
+        world.player.flags.insert(Flag::simple(&format!("turn_{turn}"), turn));
+        world.turn_count = turn;
+    }
+
+    fn autosave_turns(dir: &Path, turns: usize) -> (AmbleWorld, PathBuf) {
+        let mut world = world();
+        let save_path = dir.join(save_file_name("journal", SaveFormat::Binary));
+        let mut journal = AutosaveJournal::new("journal");
+        journal
+            .compact(&mut world, save_path.clone(), SaveFormat::Binary)
+            .unwrap();
+        for turn in 2..=turns {
+            play_turn(&mut world, turn);
+            let record = journal.baseline.record(&mut world);
+            append_record(&journal_path(&save_path), &record).unwrap();
+        }
+        (world, save_path)
+    }
+
+    #[test]
+    fn replay_restores_state_after_snapshot() {
+        let dir = tempdir().unwrap();
+        let (expected, save_path) = autosave_turns(dir.path(), 6);
+
+        let loaded = load_save_file(&save_path).unwrap();
+        assert_eq!(loaded.turn_count, 6);
+        assert_eq!(loaded.player.location, expected.player.location);
+        assert_eq!(loaded.player_path, expected.player_path);
+        assert_eq!(loaded.player.flags.len(), expected.player.flags.len());
+        assert!(loaded.rooms.values().all(|room| room.visited));
+    }
+
+    #[test]
+    fn records_only_touched_entities() {
+        let mut world = world();
+        let mut baseline = Baseline::capture(&world);
+        world.rooms.clear_changes();
+        world.rooms.get_mut(&RoomId::from("journal_lab")).unwrap().visited = true;
+        let record = baseline.record(&mut world);
+        let MapDelta::Changes { upserts, removed } = &record.rooms else {
+            panic!("expected key-level room changes");
+        };
+        assert_eq!(upserts.len(), 1);
+        assert!(removed.is_empty());
+        assert!(record.items.is_empty());
+        assert!(record.scheduler.is_none());
+        assert!(record.triggers.is_none());
+    }
+
+    #[test]
+    fn truncated_journal_replays_complete_records_only() {
+        let dir = tempdir().unwrap();
+        let (_, save_path) = autosave_turns(dir.path(), 5);
+        let journal = journal_path(&save_path);
+        let full = fs::read(&journal).unwrap();
+
+        // Cut the journal at every possible byte offset: replay must never fail and
+        // must apply only whole records, in order.
+        let mut last_turn = 1;
+        for cut in JOURNAL_HEADER_LEN..=full.len() {
+            fs::write(&journal, &full[..cut]).unwrap();
+            let loaded = load_save_file(&save_path).unwrap();
+            assert!(loaded.turn_count >= last_turn, "replay went backwards at byte {cut}");
+            last_turn = loaded.turn_count;
+        }
+        assert_eq!(last_turn, 5);
+    }
+
+    #[test]
+    fn corrupt_record_stops_replay() {
+        let dir = tempdir().unwrap();
+        let (_, save_path) = autosave_turns(dir.path(), 4);
+        let journal = journal_path(&save_path);
+        let mut bytes = fs::read(&journal).unwrap();
+        // Flip a payload byte in the first record.
+        bytes[JOURNAL_HEADER_LEN + FRAME_HEADER_LEN + 2] ^= 0xFF;
+        fs::write(&journal, bytes).unwrap();
+        assert_eq!(load_save_file(&save_path).unwrap().turn_count, 1);
+    }
+
+    #[test]
+    fn journal_for_another_snapshot_is_ignored() {
+        let dir = tempdir().unwrap();
+        let (_, save_path) = autosave_turns(dir.path(), 3);
+        let journal = fs::read(journal_path(&save_path)).unwrap();
+
+        // A fresh full save replaces the snapshot; a stale journal must not be replayed over it.
+        let mut newer = world();
+        newer.turn_count = 9;
+        write_save_file(&newer, &save_path, SaveFormat::Binary).unwrap();
+        fs::write(journal_path(&save_path), journal).unwrap();
+        assert_eq!(load_save_file(&save_path).unwrap().turn_count, 9);
+    }
+}
@@ -33,27 +33,36 @@ pub const DEV_MODE: bool = false;
 
 // Core modules
 pub mod command;
+pub mod content;
 pub mod data_paths;
 pub mod dev_command;
 pub mod entity_search;
 pub mod goal;
 pub mod health;
 pub mod helpers;
+pub mod hot_reload;
 pub mod idgen;
 pub mod ids;
 pub mod item;
+pub mod journal;
 pub mod loader;
 pub mod markup;
 pub mod npc;
 pub mod player;
+pub mod profiler;
 pub mod repl;
+pub mod replay;
+pub mod rng;
 pub mod room;
 pub mod save_files;
 pub mod scheduler;
+pub mod server;
+pub mod session;
 pub mod slug;
 pub mod spinners;
 pub mod style;
 pub mod theme;
+pub mod tracked_map;
 pub mod trigger;
 pub mod view;
 pub mod world;
@@ -62,11 +71,14 @@ pub mod world;
 pub use goal::Goal;
 pub use ids::{EntityId, Id, ItemId, NpcId, RoomId};
 pub use item::{Item, ItemHolder};
-pub use loader::{WorldSource, discover_world_sources, load_world, load_world_from_path, set_active_world_path};
+pub use loader::{
+    WorldSource, discover_world_sources, load_world, load_world_from_path, load_world_from_ron, set_active_world_path,
+};
 pub use npc::Npc;
 pub use player::Player;
 pub use repl::run_repl;
 pub use room::Room;
 pub use scheduler::Scheduler;
+pub use session::{Frame, Session};
 pub use view::{View, ViewItem};
 pub use world::{AmbleWorld, Location, WorldObject};
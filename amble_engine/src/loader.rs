@@ -10,18 +10,20 @@ pub mod scoring;
 pub mod worlddef;
 
 use crate::loader::placement::{place_items, place_npcs};
-use crate::loader::worlddef::{build_world_from_def, load_worlddef};
+use crate::loader::worlddef::{build_world_from_def, load_precompiled_worlddef, load_worlddef};
 
 use crate::data_paths::data_path;
 use crate::slug::sanitize_slug;
 use crate::trigger::TriggerAction;
 use crate::{AmbleWorld, WorldObject};
-use amble_data::WorldDef;
+use amble_data::{WorldDef, WorldManifest, manifest_path};
 use anyhow::{Context, Result, bail};
 use log::{info, warn};
 use std::fs;
+use std::num::NonZeroUsize;
 use std::path::{Path, PathBuf};
 use std::sync::{LazyLock, RwLock};
+use std::thread;
 
 static ACTIVE_WORLD_PATH: LazyLock<RwLock<Option<PathBuf>>> = LazyLock::new(|| RwLock::new(None));
 
@@ -51,6 +53,10 @@ pub fn active_world_path() -> Option<PathBuf> {
 ///
 /// Looks for `data/worlds/*.ron` when a `worlds/` directory exists, falling back
 /// to `data/world.ron` if none are found.
+///
+/// Each world's metadata is read from its `.meta` manifest (written by
+/// `amble_script compile-dir`) when present and current; only worlds without one
+/// are fully parsed, in parallel.
 /// # Errors
 /// - on file/directory access problems
 pub fn discover_world_sources() -> Result<Vec<WorldSource>> {
@@ -76,26 +82,27 @@ pub fn discover_world_sources() -> Result<Vec<WorldSource>> {
     }
 
     candidates.sort();
-    let mut sources = Vec::new();
+    let mut resolved = Vec::with_capacity(candidates.len());
+    let mut unresolved = Vec::new();
     for path in candidates {
-        match load_worlddef(&path) {
-            Ok(def) => {
-                let slug = derive_world_slug(&def, &path);
-                let title = derive_world_title(&def, &path);
-                sources.push(WorldSource {
-                    path,
-                    title,
-                    slug,
-                    author: def.game.author.clone(),
-                    version: def.game.version.clone(),
-                    blurb: def.game.blurb.clone(),
-                });
-            },
-            Err(err) => {
-                warn!("Skipping world file {}: {err}", path.display());
+        match source_from_manifest(&path) {
+            Some(source) => resolved.push(Some(source)),
+            None => {
+                unresolved.push((resolved.len(), path));
+                resolved.push(None);
             },
         }
     }
+    if !unresolved.is_empty() {
+        info!(
+            "{} world file(s) have no current manifest; parsing them",
+            unresolved.len()
+        );
+    }
+    for (idx, source) in parse_sources_in_parallel(&unresolved) {
+        resolved[idx] = source;
+    }
+    let sources: Vec<WorldSource> = resolved.into_iter().flatten().collect();
 
     if sources.is_empty() {
         bail!(
@@ -110,6 +117,80 @@ pub fn discover_world_sources() -> Result<Vec<WorldSource>> {
 
     Ok(sources)
 }
+/// Build a `WorldSource` from the metadata manifest next to `path`, if it exists
+/// and still describes the world file on disk.
+fn source_from_manifest(path: &Path) -> Option<WorldSource> {
+    let raw = fs::read_to_string(manifest_path(path)).ok()?;
+    let source = fs::read(path).ok()?;
+    let manifest = match ron::from_str::<WorldManifest>(&raw) {
+        Ok(manifest) => manifest,
+        Err(err) => {
+            warn!("ignoring unreadable manifest for {}: {err}", path.display());
+            return None;
+        },
+    };
+    if !manifest.is_current(&source) {
+        info!("manifest for {} is stale", path.display());
+        return None;
+    }
+    Some(WorldSource {
+        path: path.to_path_buf(),
+        title: derive_world_title(&manifest.title, path),
+        slug: derive_world_slug(&manifest.slug, &manifest.title, path),
+        author: manifest.author,
+        version: manifest.version,
+        blurb: manifest.blurb,
+    })
+}
+
+/// Build a `WorldSource` by fully parsing the world file at `path`.
+fn source_from_worlddef(path: &Path) -> Option<WorldSource> {
+    match load_worlddef(path) {
+        Ok(def) => Some(WorldSource {
+            path: path.to_path_buf(),
+            title: derive_world_title(&def.game.title, path),
+            slug: derive_world_slug(&def.game.slug, &def.game.title, path),
+            author: def.game.author,
+            version: def.game.version,
+            blurb: def.game.blurb,
+        }),
+        Err(err) => {
+            warn!("Skipping world file {}: {err}", path.display());
+            None
+        },
+    }
+}
+
+/// Fully parse world files that have no usable manifest, spread across worker threads.
+///
+/// Returns each input's index paired with its source (`None` if it failed to load).
+fn parse_sources_in_parallel(paths: &[(usize, PathBuf)]) -> Vec<(usize, Option<WorldSource>)> {
+    if paths.is_empty() {
+        return Vec::new();
+    }
+    let workers = thread::available_parallelism()
+        .map_or(1, NonZeroUsize::get)
+        .min(paths.len());
+    let chunk_size = paths.len().div_ceil(workers);
+    thread::scope(|scope| {
+        let handles: Vec<_> = paths
+            .chunks(chunk_size)
+            .map(|chunk| {
+                scope.spawn(move || {
+                    chunk
+                        .iter()
+                        .map(|(idx, path)| (*idx, source_from_worlddef(path)))
+                        .collect::<Vec<_>>()
+                })
+            })
+            .collect();
+        handles
+            .into_iter()
+            .flat_map(|handle| handle.join().expect("world discovery worker panicked"))
+            .collect()
+    })
+}
+
 /// Load the `AmbleWorld` from the compiled `WorldDef` file.
 ///
 /// # Errors
@@ -121,18 +202,41 @@ pub fn load_world() -> Result<AmbleWorld> {
 
 /// Load the `AmbleWorld` from a specific compiled `WorldDef` file.
 ///
+/// If `amble_script` left a current precompiled artifact (`<stem>.amblebin`) next to
+/// the RON file, it is loaded instead, skipping RON parsing and validation.
+///
 /// # Errors
 /// Errors bubble up from file IO, deserialization, or missing references.
 pub fn load_world_from_path(world_ron_path: &Path) -> Result<AmbleWorld> {
+    if let Some(worlddef) = load_precompiled_worlddef(world_ron_path) {
+        info!(
+            "loaded precompiled world artifact for {}; building AmbleWorld for \"{}\"",
+            world_ron_path.display(),
+            worlddef.game.title
+        );
+        return build_loaded_world(&worlddef, world_ron_path);
+    }
+    load_world_from_ron(world_ron_path)
+}
+
+/// Load the `AmbleWorld` from a compiled `WorldDef` RON file, ignoring any precompiled artifact.
+///
+/// # Errors
+/// Errors bubble up from file IO, deserialization, validation, or missing references.
+pub fn load_world_from_ron(world_ron_path: &Path) -> Result<AmbleWorld> {
     info!("loading selected world definition from: {}", world_ron_path.display());
     let worlddef = load_worlddef(world_ron_path).context("while loading worlddef from file")?;
 
     validate_worlddef(&worlddef)?;
     info!("validation passed, building AmbleWorld for \"{}\"", worlddef.game.title);
+    build_loaded_world(&worlddef, world_ron_path)
+}
 
-    let mut world = build_world_from_def(&worlddef).context("while building world from worlddef")?;
-    world.world_slug = derive_world_slug(&worlddef, world_ron_path);
-    world.game_title = derive_world_title(&worlddef, world_ron_path);
+/// Build the runtime world from a validated `WorldDef` loaded from `world_ron_path`.
+fn build_loaded_world(worlddef: &WorldDef, world_ron_path: &Path) -> Result<AmbleWorld> {
+    let mut world = build_world_from_def(worlddef).context("while building world from worlddef")?;
+    world.world_slug = derive_world_slug(&worlddef.game.slug, &worlddef.game.title, world_ron_path);
+    world.game_title = derive_world_title(&worlddef.game.title, world_ron_path);
     info!("{} spinners added to AmbleWorld", world.spinners.len());
     info!("{} rooms added to AmbleWorld", world.rooms.len());
     info!("{} NPCs added to AmbleWorld", world.npcs.len());
@@ -159,7 +263,7 @@ pub fn load_world_from_path(world_ron_path: &Path) -> Result<AmbleWorld> {
     // we gather an estimate of possible maximum points to earn in the world here, but
     // in can be made inaccurate by repeatable awards or mutually exclusive reward paths
     for trigger in &world.triggers {
-        for action in &trigger.actions {
+        for action in trigger.actions.iter() {
             if let TriggerAction::AwardPoints { amount, .. } = &action.action
                 && *amount > 0
             {
@@ -168,11 +272,13 @@ pub fn load_world_from_path(world_ron_path: &Path) -> Result<AmbleWorld> {
         }
     }
 
+    // Everything built so far is authored content; later saves record only what play changes.
+    crate::content::register_template(&mut world);
     Ok(world)
 }
 
-fn derive_world_slug(def: &WorldDef, path: &Path) -> String {
-    let candidate = def.game.slug.trim();
+fn derive_world_slug(slug: &str, title: &str, path: &Path) -> String {
+    let candidate = slug.trim();
     if !candidate.is_empty() {
         return sanitize_slug(candidate);
     }
@@ -180,15 +286,15 @@ fn derive_world_slug(def: &WorldDef, path: &Path) -> String {
     if !stem.is_empty() && stem != "world" {
         return sanitize_slug(stem);
     }
-    let title = def.game.title.trim();
+    let title = title.trim();
     if !title.is_empty() {
         return sanitize_slug(title);
     }
     "world".to_string()
 }
 
-fn derive_world_title(def: &WorldDef, path: &Path) -> String {
-    let title = def.game.title.trim();
+fn derive_world_title(title: &str, path: &Path) -> String {
+    let title = title.trim();
     if !title.is_empty() {
         return title.to_string();
     }
@@ -212,3 +318,74 @@ fn validate_worlddef(def: &WorldDef) -> Result<()> {
         .join("\n");
     bail!("worlddef validation failed:\n{details}");
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use tempfile::tempdir;
+
+    fn write_manifest(world_path: &Path, title: &str, source: &[u8]) {
+        let mut def = WorldDef::default();
+        def.game.title = title.into();
+        def.game.slug = "manifest-world".into();
+        let manifest = WorldManifest::for_world(&def, source);
+        fs::write(manifest_path(world_path), ron::to_string(&manifest).unwrap()).unwrap();
+    }
+
+    #[test]
+    fn current_manifest_is_used_without_parsing_world() {
+        let dir = tempdir().unwrap();
+        let world_path = dir.path().join("demo.ron");
+        // not a valid WorldDef: the manifest must be enough
+        fs::write(&world_path, "not ron").unwrap();
+        write_manifest(&world_path, "From Manifest", b"not ron");
+
+        let source = source_from_manifest(&world_path).expect("manifest should be used");
+        assert_eq!(source.title, "From Manifest");
+        assert_eq!(source.slug, "manifest-world");
+        assert_eq!(source.path, world_path);
+    }
+
+    #[test]
+    fn stale_manifest_falls_back_to_parsing() {
+        let dir = tempdir().unwrap();
+        let world_path = dir.path().join("demo.ron");
+        let mut def = WorldDef::default();
+        def.game.title = "Parsed Title".into();
+        fs::write(&world_path, ron::to_string(&def).unwrap()).unwrap();
+        write_manifest(&world_path, "Old Title", b"(game: ())");
+
+        assert!(source_from_manifest(&world_path).is_none());
+        let parsed = parse_sources_in_parallel(&[(0, world_path.clone()), (1, dir.path().join("missing.ron"))]);
+        assert_eq!(parsed.len(), 2);
+        assert_eq!(parsed[0].1.as_ref().map(|s| s.title.as_str()), Some("Parsed Title"));
+        assert_eq!(parsed[0].1.as_ref().map(|s| s.slug.as_str()), Some("demo"));
+        assert!(parsed[1].1.is_none());
+    }
+
+    #[test]
+    fn current_artifact_is_preferred_over_ron() {
+        let dir = tempdir().unwrap();
+        let world_path = dir.path().join("hospital.ron");
+        let bundled = Path::new(env!("CARGO_MANIFEST_DIR")).join("data/worlds/hospital.ron");
+        fs::copy(&bundled, &world_path).unwrap();
+
+        // mark the artifact's copy so we can tell which one was loaded
+        let mut def = load_worlddef(&world_path).unwrap();
+        def.game.title = "From Artifact".into();
+        fs::write(
+            amble_data::artifact_path(&world_path),
+            amble_data::encode_artifact(&def, &fs::read(&world_path).unwrap()).unwrap(),
+        )
+        .unwrap();
+        assert_eq!(load_world_from_path(&world_path).unwrap().game_title, "From Artifact");
+        assert_ne!(load_world_from_ron(&world_path).unwrap().game_title, "From Artifact");
+
+        // editing the RON makes the artifact stale, even when its size is unchanged
+        let text = fs::read_to_string(&world_path).unwrap();
+        let edited = text.replacen("Hospital Game TBD", "Hospital Game TBA", 1);
+        assert_eq!(edited.len(), text.len());
+        fs::write(&world_path, edited).unwrap();
+        assert_ne!(load_world_from_path(&world_path).unwrap().game_title, "From Artifact");
+    }
+}
@@ -129,8 +129,8 @@ mod tests {
             symbol: "test_room".into(),
             name: "Test Room".into(),
             base_description: "A test room".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -156,7 +156,7 @@ mod tests {
             abilities: HashSet::new(),
             consumable: None,
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
         };
 
         let item_id: ItemId = idgen::new_id().into();
@@ -175,7 +175,7 @@ mod tests {
             abilities: HashSet::new(),
             consumable: None,
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
         };
 
         world.items.insert(container_id.clone(), container);
@@ -194,12 +194,12 @@ mod tests {
 
         let room_id = "room".to_string();
         let room = Room {
-            id: RoomId(room_id.clone()),
+            id: RoomId::from(room_id.as_str()),
             symbol: "room".into(),
             name: "Room".into(),
             base_description: "Room".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -207,7 +207,7 @@ mod tests {
             contents: HashSet::new(),
             npcs: HashSet::new(),
         };
-        world.rooms.insert(RoomId(room_id.clone()), room);
+        world.rooms.insert(RoomId::from(room_id.as_str()), room);
 
         let outer_id = ItemId::from("outer");
         let inner_id = ItemId::from("inner");
@@ -218,7 +218,7 @@ mod tests {
             symbol: "outer".into(),
             name: "Outer".into(),
             description: "Outer container".into(),
-            location: Location::Room(RoomId(room_id.clone())),
+            location: Location::Room(RoomId::from(room_id.as_str())),
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
             aliases: Vec::new(),
@@ -228,7 +228,7 @@ mod tests {
             abilities: HashSet::new(),
             consumable: None,
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
         };
 
         let inner = Item {
@@ -246,7 +246,7 @@ mod tests {
             abilities: HashSet::new(),
             consumable: None,
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
         };
 
         let item = Item {
@@ -264,7 +264,7 @@ mod tests {
             abilities: HashSet::new(),
             consumable: None,
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
         };
 
         world.items.insert(outer_id.clone(), outer);
@@ -273,7 +273,7 @@ mod tests {
 
         place_items(&mut world).unwrap();
 
-        let room = world.rooms.get(&room_id).unwrap();
+        let room = world.rooms.get(&RoomId::from(room_id.as_str())).unwrap();
         assert!(room.contents.contains(&outer_id));
 
         let outer = world.items.get(&outer_id).unwrap();
@@ -295,7 +295,7 @@ mod tests {
             description: "Npc".into(),
             location: Location::Nowhere,
             inventory: HashSet::new(),
-            dialogue: HashMap::new(),
+            dialogue: HashMap::new().into(),
             state: NpcState::Normal,
             movement: None,
             health: HealthState::new_at_max(10),
@@ -318,7 +318,7 @@ mod tests {
             abilities: HashSet::new(),
             consumable: None,
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
         };
         world.items.insert(item_id.clone(), item);
 
@@ -340,7 +340,7 @@ mod tests {
             description: "Npc".into(),
             location: Location::Item("box".into()),
             inventory: HashSet::new(),
-            dialogue: HashMap::new(),
+            dialogue: HashMap::new().into(),
             state: NpcState::Normal,
             movement: None,
             health: HealthState::new_at_max(10),
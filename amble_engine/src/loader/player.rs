@@ -10,7 +10,7 @@ use log::info;
 use amble_data::PlayerDef;
 
 use crate::health::HealthState;
-use crate::player::{Flag, Player};
+use crate::player::{FlagStore, Player};
 use crate::world::Location;
 use crate::{ItemId, RoomId};
 
@@ -23,10 +23,10 @@ pub fn build_player(def: &PlayerDef) -> Player {
         symbol: "player".to_string(),
         name: def.name.clone(),
         description: def.description.clone(),
-        location: Location::Room(RoomId(def.start_room.clone())),
+        location: Location::Room(RoomId::from(def.start_room.as_str())),
         location_history: Vec::new(),
         inventory: HashSet::<ItemId>::default(),
-        flags: HashSet::<Flag>::default(),
+        flags: FlagStore::default(),
         score: 0,
         health: HealthState::new_at_max(def.max_hp),
     }
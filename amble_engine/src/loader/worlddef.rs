@@ -6,8 +6,9 @@ use std::collections::{HashMap, HashSet};
 use std::fs;
 use std::path::Path;
 
+use crate::spinners::{Spinner, Wedge};
 use anyhow::{Context, Result};
-use gametools::{Spinner, Wedge};
+use log::{info, warn};
 
 use amble_data::{
     ActionDef, ActionKind, ConditionDef, ConditionExpr, ConsumableDef, ConsumeTypeDef,
@@ -16,9 +17,11 @@ use amble_data::{
     ItemInteractionType as DefItemInteractionType, ItemPatchDef, ItemVisibility as DefItemVisibility, LocationRef,
     Movability as DefMovability, NpcDef, NpcDialoguePatchDef, NpcMovementDef, NpcMovementPatchDef, NpcMovementTiming,
     NpcMovementType, NpcPatchDef, NpcState as DefNpcState, OnFalsePolicy as DefOnFalsePolicy, OverlayCondDef,
-    OverlayDef, RoomDef, RoomExitPatchDef, RoomPatchDef, SpinnerDef, TriggerDef, WorldDef,
+    OverlayDef, RoomDef, RoomExitPatchDef, RoomPatchDef, SpinnerDef, TriggerDef, WorldDef, artifact_path,
+    decode_artifact,
 };
 
+use crate::content::Shared;
 use crate::goal::{Goal, GoalCondition, GoalGroup};
 use crate::health::HealthState;
 use crate::item::{
@@ -28,12 +31,12 @@ use crate::item::{
 use crate::loader::player::build_player;
 use crate::loader::scoring::ScoringConfig;
 use crate::npc::{MovementTiming, MovementType, Npc, NpcMovement, NpcState};
-use crate::player::Flag;
+use crate::player::{Flag, FlagRef};
 use crate::room::{Exit, OverlayCondition, Room, RoomOverlay, RoomScenery};
 use crate::scheduler::{EventCondition, OnFalsePolicy};
 use crate::spinners::SpinnerType;
 use crate::spinners::create_default_spinners;
-use crate::trigger::{ScriptedAction, Trigger, TriggerAction, TriggerCondition};
+use crate::trigger::{ScriptedAction, Trigger, TriggerAction, TriggerCondition, TriggerIndex};
 use crate::world::{AmbleWorld, Location};
 use crate::{ItemId, NpcId, RoomId};
 
@@ -45,6 +48,29 @@ pub fn load_worlddef(path: &Path) -> Result<WorldDef> {
     ron::from_str(&text).with_context(|| format!("parsing worlddef RON from '{}'", path.display()))
 }
 
+/// Load the precompiled binary artifact for the RON world at `world_path`, if usable.
+///
+/// Returns `None` when there is no artifact or it is stale (written for a different
+/// version of the RON file), corrupt, or from an incompatible engine; the caller
+/// then falls back to the RON file. Artifacts are only written for worlds that
+/// passed validation, so a returned `WorldDef` does not need to be re-validated.
+pub fn load_precompiled_worlddef(world_path: &Path) -> Option<WorldDef> {
+    let artifact_path = artifact_path(world_path);
+    let bytes = fs::read(&artifact_path).ok()?;
+    let source = fs::read(world_path).ok()?;
+    match decode_artifact(&bytes) {
+        Ok((header, def)) if header.matches_source(&source) => Some(def),
+        Ok(_) => {
+            info!("world artifact {} is stale; loading RON", artifact_path.display());
+            None
+        },
+        Err(err) => {
+            warn!("ignoring world artifact {}: {err}", artifact_path.display());
+            None
+        },
+    }
+}
+
 /// Convert a `WorldDef` into a populated `AmbleWorld`.
 ///
 /// Item/NPC placements are applied later by the placement stage.
@@ -59,10 +85,13 @@ pub fn build_world_from_def(def: &WorldDef) -> Result<AmbleWorld> {
     world.world_version.clone_from(&def.game.version);
     world.world_blurb.clone_from(&def.game.blurb);
     world.intro_text.clone_from(&def.game.intro);
-    world.scoring = ScoringConfig::from_def(&def.game.scoring);
+    world.scoring = ScoringConfig::from_def(&def.game.scoring).into();
     world.player = build_player(&def.game.player);
 
-    world.spinners = build_spinners(&def.spinners);
+    world.spinners = build_spinners(&def.spinners)
+        .into_iter()
+        .map(|(kind, spinner)| (kind, Shared::new(spinner)))
+        .collect();
 
     for room_def in &def.rooms {
         let room = room_from_def(room_def);
@@ -80,9 +109,10 @@ pub fn build_world_from_def(def: &WorldDef) -> Result<AmbleWorld> {
         world.items.insert(item.id.clone(), item);
     }
 
-    world.triggers = def.triggers.iter().map(trigger_from_def).collect::<Result<Vec<_>>>()?;
+    world.replace_triggers(def.triggers.iter().map(trigger_from_def).collect::<Result<Vec<_>>>()?);
+    world.trigger_index = TriggerIndex::build(&world.triggers, world.triggers_revision);
 
-    world.goals = def.goals.iter().map(goal_from_def).collect::<Vec<_>>();
+    world.goals = def.goals.iter().map(goal_from_def).collect::<Vec<_>>().into();
 
     Ok(world)
 }
@@ -120,9 +150,9 @@ fn room_from_def(def: &RoomDef) -> Room {
         id: RoomId::new(&def.id),
         symbol: def.id.clone(),
         name: def.name.clone(),
-        base_description: def.desc.clone(),
-        overlays,
-        scenery,
+        base_description: def.desc.clone().into(),
+        overlays: overlays.into(),
+        scenery: scenery.into(),
         scenery_default: def.scenery_default.clone(),
         location: Location::Nowhere,
         visited: def.visited,
@@ -157,9 +187,15 @@ fn overlay_from_def(def: &OverlayDef) -> RoomOverlay {
 
 fn overlay_condition_from_def(def: &OverlayCondDef) -> OverlayCondition {
     match def {
-        OverlayCondDef::FlagSet { flag } => OverlayCondition::FlagSet { flag: flag.clone() },
-        OverlayCondDef::FlagUnset { flag } => OverlayCondition::FlagUnset { flag: flag.clone() },
-        OverlayCondDef::FlagComplete { flag } => OverlayCondition::FlagComplete { flag: flag.clone() },
+        OverlayCondDef::FlagSet { flag } => OverlayCondition::FlagSet {
+            flag: FlagRef::new(flag),
+        },
+        OverlayCondDef::FlagUnset { flag } => OverlayCondition::FlagUnset {
+            flag: FlagRef::new(flag),
+        },
+        OverlayCondDef::FlagComplete { flag } => OverlayCondition::FlagComplete {
+            flag: FlagRef::new(flag),
+        },
         OverlayCondDef::ItemPresent { item } => OverlayCondition::ItemPresent {
             item_id: item.clone().into(),
         },
@@ -197,13 +233,16 @@ fn item_from_def(def: &ItemDef) -> Item {
     }
     let consumable = def.consumable.as_ref().map(consumable_from_def);
     let visibility = item_visibility_from_def(def.visibility);
-    let visible_when = def.visible_when.as_ref().map(condition_expr_from_def);
+    let visible_when = def
+        .visible_when
+        .as_ref()
+        .map(|cond| condition_expr_from_def(cond).into());
 
     Item {
         id: def.id.clone().into(),
         symbol: def.id.clone(),
         name: def.name.clone(),
-        description: def.desc.clone(),
+        description: def.desc.clone().into(),
         location: location_from_ref(&def.location),
         visibility,
         visible_when,
@@ -213,7 +252,7 @@ fn item_from_def(def: &ItemDef) -> Item {
         contents: HashSet::new(),
         abilities,
         interaction_requires,
-        text: def.text.clone(),
+        text: def.text.clone().into(),
         consumable,
     }
 }
@@ -247,10 +286,10 @@ fn npc_from_def(def: &NpcDef) -> Npc {
         id: def.id.clone().into(),
         symbol: def.id.clone(),
         name: def.name.clone(),
-        description: def.desc.clone(),
+        description: def.desc.clone().into(),
         location: location_from_ref(&def.location),
         inventory: HashSet::new(),
-        dialogue,
+        dialogue: dialogue.into(),
         state: npc_state_from_def(&def.state),
         movement,
         health: HealthState::new_at_max(def.max_hp),
@@ -298,8 +337,8 @@ fn trigger_from_def(def: &TriggerDef) -> Result<Trigger> {
         .collect::<Result<Vec<_>>>()?;
     Ok(Trigger {
         name: def.name.clone(),
-        conditions,
-        actions,
+        conditions: conditions.into(),
+        actions: actions.into(),
         only_once: def.only_once,
         fired: false,
     })
@@ -412,7 +451,7 @@ fn action_from_def(def: &ActionKind) -> Result<TriggerAction> {
             npc_id: npc.clone().into(),
             item_id: item.clone().into(),
         },
-        ActionKind::PushPlayerTo { room } => TriggerAction::PushPlayerTo(RoomId(room.clone())),
+        ActionKind::PushPlayerTo { room } => TriggerAction::PushPlayerTo(RoomId::from(room.as_str())),
         ActionKind::AddSpinnerWedge { spinner, text, width } => TriggerAction::AddSpinnerWedge {
             spinner: SpinnerType::from_toml_key(spinner),
             text: text.clone(),
@@ -425,7 +464,7 @@ fn action_from_def(def: &ActionKind) -> Result<TriggerAction> {
         ActionKind::SpawnItemCurrentRoom { item } => TriggerAction::SpawnItemCurrentRoom(item.clone().into()),
         ActionKind::SpawnItemInRoom { item, room } => TriggerAction::SpawnItemInRoom {
             item_id: item.clone().into(),
-            room_id: RoomId(room.clone()),
+            room_id: RoomId::from(room.as_str()),
         },
         ActionKind::SpawnItemInInventory { item } => TriggerAction::SpawnItemInInventory(item.clone().into()),
         ActionKind::SpawnItemInContainer { item, container } => TriggerAction::SpawnItemInContainer {
@@ -434,7 +473,7 @@ fn action_from_def(def: &ActionKind) -> Result<TriggerAction> {
         },
         ActionKind::SpawnNpcInRoom { npc, room } => TriggerAction::SpawnNpcInRoom {
             npc_id: npc.clone().into(),
-            room_id: RoomId(room.clone()),
+            room_id: RoomId::from(room.as_str()),
         },
         ActionKind::DespawnItem { item } => TriggerAction::DespawnItem {
             item_id: item.clone().into(),
@@ -465,11 +504,11 @@ fn action_from_def(def: &ActionKind) -> Result<TriggerAction> {
             movability: movability_from_def(movability),
         },
         ActionKind::LockExit { from_room, direction } => TriggerAction::LockExit {
-            from_room: RoomId(from_room.clone()),
+            from_room: RoomId::from(from_room.as_str()),
             direction: direction.clone(),
         },
         ActionKind::UnlockExit { from_room, direction } => TriggerAction::UnlockExit {
-            from_room: RoomId(from_room.clone()),
+            from_room: RoomId::from(from_room.as_str()),
             direction: direction.clone(),
         },
         ActionKind::RevealExit {
@@ -477,8 +516,8 @@ fn action_from_def(def: &ActionKind) -> Result<TriggerAction> {
             exit_to,
             direction,
         } => TriggerAction::RevealExit {
-            exit_from: RoomId(exit_from.clone()),
-            exit_to: RoomId(exit_to.clone()),
+            exit_from: RoomId::from(exit_from.as_str()),
+            exit_to: RoomId::from(exit_to.as_str()),
             direction: direction.clone(),
         },
         ActionKind::SetBarredMessage {
@@ -486,8 +525,8 @@ fn action_from_def(def: &ActionKind) -> Result<TriggerAction> {
             exit_to,
             msg,
         } => TriggerAction::SetBarredMessage {
-            exit_from: RoomId(exit_from.clone()),
-            exit_to: RoomId(exit_to.clone()),
+            exit_from: RoomId::from(exit_from.as_str()),
+            exit_to: RoomId::from(exit_to.as_str()),
             msg: msg.clone(),
         },
         ActionKind::ModifyItem { item, patch } => TriggerAction::ModifyItem {
@@ -495,7 +534,7 @@ fn action_from_def(def: &ActionKind) -> Result<TriggerAction> {
             patch: item_patch_from_def(patch),
         },
         ActionKind::ModifyRoom { room, patch } => TriggerAction::ModifyRoom {
-            room_id: RoomId(room.clone()),
+            room_id: RoomId::from(room.as_str()),
             patch: room_patch_from_def(patch),
         },
         ActionKind::ModifyNpc { npc, patch } => TriggerAction::ModifyNpc {
@@ -600,7 +639,7 @@ fn room_patch_from_def(def: &RoomPatchDef) -> crate::trigger::RoomPatch {
 fn room_exit_patch_from_def(def: &RoomExitPatchDef) -> crate::trigger::RoomExitPatch {
     crate::trigger::RoomExitPatch {
         direction: def.direction.clone(),
-        to: RoomId(def.to.clone()),
+        to: RoomId::from(def.to.as_str()),
         hidden: def.hidden,
         locked: def.locked,
         required_flags: def.required_flags.iter().map(|flag| Flag::simple(flag, 0)).collect(),
@@ -659,18 +698,26 @@ fn goal_group_from_def(def: DefGoalGroup) -> GoalGroup {
 
 fn goal_condition_from_def(def: &DefGoalCondition) -> GoalCondition {
     match def {
-        DefGoalCondition::FlagComplete { flag } => GoalCondition::FlagComplete { flag: flag.clone() },
-        DefGoalCondition::FlagInProgress { flag } => GoalCondition::FlagInProgress { flag: flag.clone() },
+        DefGoalCondition::FlagComplete { flag } => GoalCondition::FlagComplete {
+            flag: FlagRef::new(flag),
+        },
+        DefGoalCondition::FlagInProgress { flag } => GoalCondition::FlagInProgress {
+            flag: FlagRef::new(flag),
+        },
         DefGoalCondition::GoalComplete { goal_id } => GoalCondition::GoalComplete {
             goal_id: goal_id.clone(),
         },
         DefGoalCondition::HasItem { item } => GoalCondition::HasItem {
             item_id: item.clone().into(),
         },
-        DefGoalCondition::HasFlag { flag } => GoalCondition::HasFlag { flag: flag.clone() },
-        DefGoalCondition::MissingFlag { flag } => GoalCondition::MissingFlag { flag: flag.clone() },
+        DefGoalCondition::HasFlag { flag } => GoalCondition::HasFlag {
+            flag: FlagRef::new(flag),
+        },
+        DefGoalCondition::MissingFlag { flag } => GoalCondition::MissingFlag {
+            flag: FlagRef::new(flag),
+        },
         DefGoalCondition::ReachedRoom { room } => GoalCondition::ReachedRoom {
-            room_id: RoomId(room.clone()),
+            room_id: RoomId::from(room.as_str()),
         },
     }
 }
@@ -685,14 +732,14 @@ fn condition_expr_from_def(def: &ConditionExpr) -> EventCondition {
 
 fn condition_from_def(def: &ConditionDef) -> TriggerCondition {
     match def {
-        ConditionDef::HasFlag { flag } => TriggerCondition::HasFlag(flag.clone()),
-        ConditionDef::MissingFlag { flag } => TriggerCondition::MissingFlag(flag.clone()),
-        ConditionDef::FlagInProgress { flag } => TriggerCondition::FlagInProgress(flag.clone()),
-        ConditionDef::FlagComplete { flag } => TriggerCondition::FlagComplete(flag.clone()),
+        ConditionDef::HasFlag { flag } => TriggerCondition::HasFlag(FlagRef::new(flag)),
+        ConditionDef::MissingFlag { flag } => TriggerCondition::MissingFlag(FlagRef::new(flag)),
+        ConditionDef::FlagInProgress { flag } => TriggerCondition::FlagInProgress(FlagRef::new(flag)),
+        ConditionDef::FlagComplete { flag } => TriggerCondition::FlagComplete(FlagRef::new(flag)),
         ConditionDef::HasItem { item } => TriggerCondition::HasItem(item.clone().into()),
         ConditionDef::MissingItem { item } => TriggerCondition::MissingItem(item.clone().into()),
-        ConditionDef::HasVisited { room } => TriggerCondition::HasVisited(RoomId(room.clone())),
-        ConditionDef::PlayerInRoom { room } => TriggerCondition::InRoom(RoomId(room.clone())),
+        ConditionDef::HasVisited { room } => TriggerCondition::HasVisited(RoomId::from(room.as_str())),
+        ConditionDef::PlayerInRoom { room } => TriggerCondition::InRoom(RoomId::from(room.as_str())),
         ConditionDef::WithNpc { npc } => TriggerCondition::WithNpc(npc.clone().into()),
         ConditionDef::NpcHasItem { npc, item } => TriggerCondition::NpcHasItem {
             npc_id: npc.clone().into(),
@@ -728,8 +775,8 @@ fn condition_from_def(def: &ConditionDef) -> TriggerCondition {
 fn event_condition_from_def(def: &EventDef) -> Option<TriggerCondition> {
     Some(match def {
         EventDef::Always => return None,
-        EventDef::EnterRoom { room } => TriggerCondition::Enter(RoomId(room.clone())),
-        EventDef::LeaveRoom { room } => TriggerCondition::Leave(RoomId(room.clone())),
+        EventDef::EnterRoom { room } => TriggerCondition::Enter(RoomId::from(room.as_str())),
+        EventDef::LeaveRoom { room } => TriggerCondition::Leave(RoomId::from(room.as_str())),
         EventDef::TakeItem { item } => TriggerCondition::Take(item.clone().into()),
         EventDef::DropItem { item } => TriggerCondition::Drop(item.clone().into()),
         EventDef::LookAtItem { item } => TriggerCondition::LookAt(item.clone()),
@@ -783,7 +830,7 @@ fn location_from_ref(loc: &LocationRef) -> Location {
     match loc {
         LocationRef::Inventory => Location::Inventory,
         LocationRef::Nowhere => Location::Nowhere,
-        LocationRef::Room(id) => Location::Room(RoomId(id.clone())),
+        LocationRef::Room(id) => Location::Room(RoomId::from(id.as_str())),
         LocationRef::Item(id) => Location::Item(ItemId::from(id.clone())),
         LocationRef::Npc(id) => Location::Npc(NpcId::from(id.clone())),
     }
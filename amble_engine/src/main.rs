@@ -6,8 +6,16 @@
 //!
 //! Handles CLI startup, logging configuration, and world loading before
 //! entering the interactive REPL.
+//!
+//! `amble_engine --seed N` seeds the world RNG so a session can be reproduced.
+//!
+//! `amble_engine replay WORLD TRANSCRIPT [--golden FILE] [--bless] [--turns] [--seed N]`
+//! instead replays a command transcript headlessly and reports its timing
+//! (see [`amble_engine::replay`]).
 
 use amble_engine::markup::{StyleKind, StyleMods, WrapMode, render_wrapped};
+use amble_engine::profiler;
+use amble_engine::replay::{Transcript, replay};
 use amble_engine::save_files::{
     LOG_DIR, SAVE_DIR, SaveFileEntry, build_save_entries_recursive, format_modified, load_save_file,
     save_dir_for_world, set_active_save_dir,
@@ -31,6 +39,12 @@ use std::{
     path::{Path, PathBuf},
 };
 
+// Counting allocations is two relaxed atomic adds per call; it lets `replay` report allocations
+// per turn, so it is only installed in builds with the `count-allocations` feature.
+#[cfg(feature = "count-allocations")]
+#[global_allocator]
+static ALLOCATOR: amble_engine::replay::CountingAllocator = amble_engine::replay::CountingAllocator;
+
 /// Initialize `env_logger` based on AMBLE_* environment variables.
 fn init_logging() -> Result<()> {
     let Ok(raw_level) = env::var("AMBLE_LOG") else {
@@ -243,9 +257,95 @@ fn match_world_for_save<'a>(entry: &SaveFileEntry, worlds: &'a [WorldSource]) ->
     None
 }
 
+/// Write the trigger profile on quit if profiling was enabled (`AMBLE_PROFILE` or `:profile on`).
+fn write_profile_report() {
+    match profiler::finish() {
+        Ok(Some((text, json))) => println!("Trigger profile written to {} and {}", text.display(), json.display()),
+        Ok(None) => {},
+        Err(err) => warn!("Failed to write trigger profile: {err:#}"),
+    }
+}
+
+/// Parse the value following a `--seed` flag.
+fn parse_seed(value: Option<&String>) -> Result<u64> {
+    let value = value.context("--seed requires a number")?;
+    value.parse().with_context(|| format!("invalid seed '{value}'"))
+}
+
+/// Run the `replay` subcommand: replay a transcript against a world and print timing.
+fn run_replay(args: &[String]) -> Result<()> {
+    let mut paths = Vec::new();
+    let mut golden: Option<PathBuf> = None;
+    let mut bless = false;
+    let mut per_turn = false;
+    let mut seed = None;
+    let mut args = args.iter();
+    while let Some(arg) = args.next() {
+        match arg.as_str() {
+            "--golden" => golden = Some(args.next().context("--golden requires a file")?.into()),
+            "--bless" => bless = true,
+            "--turns" => per_turn = true,
+            "--seed" => seed = Some(parse_seed(args.next())?),
+            flag if flag.starts_with("--") => bail!("unknown replay option '{flag}'"),
+            path => paths.push(PathBuf::from(path)),
+        }
+    }
+    let [world_path, transcript_path] = paths.as_slice() else {
+        bail!("usage: amble_engine replay WORLD TRANSCRIPT [--golden FILE] [--bless] [--turns] [--seed N]");
+    };
+
+    colored::control::set_override(false);
+    set_active_world_path(world_path.clone());
+    let mut transcript = Transcript::load(transcript_path)?;
+    if seed.is_some() {
+        transcript.seed = seed;
+    }
+    let world = load_world_from_path(world_path).with_context(|| format!("loading world {}", world_path.display()))?;
+    let report = replay(world, &transcript)?;
+    print!("{}", report.summary(per_turn));
+    write_profile_report();
+    if let Some(seed) = report.seed {
+        println!("seed: {seed}");
+    }
+
+    let Some(golden) = golden else {
+        return Ok(());
+    };
+    if bless {
+        fs::write(&golden, &report.output).with_context(|| format!("writing golden output {}", golden.display()))?;
+        println!("golden output written to {}", golden.display());
+        return Ok(());
+    }
+    let expected =
+        fs::read_to_string(&golden).with_context(|| format!("reading golden output {}", golden.display()))?;
+    match report.diff_golden(&expected) {
+        None => {
+            println!("output matches {}", golden.display());
+            Ok(())
+        },
+        Some(mismatch) => bail!(
+            "output differs from {} at line {}:\n  expected: {}\n  actual:   {}",
+            golden.display(),
+            mismatch.line,
+            mismatch.expected.as_deref().unwrap_or("<end of output>"),
+            mismatch.actual.as_deref().unwrap_or("<end of output>")
+        ),
+    }
+}
+
 /// Entry point: loads content, initializes themes, and starts the REPL.
 fn main() -> Result<()> {
     init_logging()?;
+    profiler::init_from_env();
+    let args: Vec<String> = env::args().skip(1).collect();
+    if args.first().is_some_and(|arg| arg == "replay") {
+        return run_replay(&args[1..]);
+    }
+    let seed = match args.as_slice() {
+        [] => None,
+        [flag, rest @ ..] if flag == "--seed" && rest.len() == 1 => Some(parse_seed(rest.first())?),
+        _ => bail!("usage: amble_engine [--seed N] | amble_engine replay WORLD TRANSCRIPT [options]"),
+    };
     info!("Starting Amble engine (version {AMBLE_VERSION})");
     info!("Start: loading game world from files");
     let saves = match build_save_entries_recursive(Path::new(SAVE_DIR)) {
@@ -288,6 +388,10 @@ fn main() -> Result<()> {
         },
     };
     set_active_save_dir(save_dir_for_world(&world));
+    if let Some(seed) = seed {
+        world.rng.reseed(seed);
+        info!("World RNG seeded with {seed}");
+    }
     info!("AmbleWorld loaded successfully.");
 
     // Initialize the theme system
@@ -337,5 +441,7 @@ fn main() -> Result<()> {
         //println!("{}", fill(&world.intro_text, termwidth()).description_style());
     }
 
-    run_repl(&mut world)
+    run_repl(&mut world)?;
+    write_profile_report();
+    Ok(())
 }
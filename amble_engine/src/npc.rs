@@ -12,10 +12,11 @@ use std::{
     fmt::Display,
 };
 
+use crate::rng::WorldRng;
+use crate::spinners::Spinner;
 use colored::Colorize;
-use gametools::Spinner;
-use rand::{prelude::IndexedRandom, seq::IteratorRandom};
 
+use crate::content::Shared;
 use crate::{Id, ItemId, NpcId, RoomId};
 
 use crate::{
@@ -33,10 +34,12 @@ pub struct Npc {
     pub id: NpcId,
     pub symbol: String,
     pub name: String,
-    pub description: String,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub description: Shared<String>,
     pub location: Location,
     pub inventory: HashSet<ItemId>,
-    pub dialogue: HashMap<NpcState, Vec<String>>,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub dialogue: Shared<HashMap<NpcState, Vec<String>>>,
     pub state: NpcState,
     pub movement: Option<NpcMovement>,
     pub health: HealthState,
@@ -50,13 +53,11 @@ impl Npc {
     }
 
     /// Pick a random line of dialogue respecting the NPC's current state / mood.
-    pub fn random_dialogue(&self, ignore_spinner: &Spinner<String>) -> String {
+    pub fn random_dialogue(&self, rng: &WorldRng, ignore_spinner: &Spinner<String>) -> String {
         if let Some(lines) = self.dialogue.get(&self.state) {
-            let mut rng = rand::rng();
-            lines
-                .choose(&mut rng)
-                .unwrap_or(&"Stands mute.".italic().dimmed().to_string())
-                .clone()
+            rng.choose(lines)
+                .cloned()
+                .unwrap_or_else(|| "Stands mute.".italic().dimmed().to_string())
         } else {
             warn!(
                 "Npc {}({}): failed dialogue lookup for mood: {:?}",
@@ -64,14 +65,14 @@ impl Npc {
                 self.id(),
                 self.state
             );
-            ignore_spinner.spin().unwrap_or("Ignores you.".to_string())
+            ignore_spinner.spin(rng).unwrap_or("Ignores you.".to_string())
         }
     }
     /// Display the NPC description and visible inventory.
     pub fn show(&self, world: &AmbleWorld, view: &mut View) {
         view.push(ViewItem::NpcDescription {
             name: self.name.clone(),
-            description: self.description.clone(),
+            description: self.description.to_string(),
             health: self.health.clone(),
             state: self.state.clone(),
         });
@@ -92,7 +93,7 @@ impl Npc {
             short.to_string()
         } else {
             // return the whole description if there is only one line
-            self.description.clone()
+            self.description.to_string()
         }
     }
 }
@@ -395,7 +396,7 @@ pub fn move_scheduled(movement: &NpcMovement, current_turn: usize) -> bool {
 }
 
 /// Calculate the next destination for a moving NPC.
-pub fn calculate_next_location(movement: &mut NpcMovement) -> Option<Location> {
+pub fn calculate_next_location(movement: &mut NpcMovement, rng: &WorldRng) -> Option<Location> {
     use crate::npc::MovementType::{RandomSet, Route};
     match &mut movement.movement_type {
         Route {
@@ -415,10 +416,12 @@ pub fn calculate_next_location(movement: &mut NpcMovement) -> Option<Location> {
                 None
             }
         },
-        RandomSet { rooms } => rooms
-            .iter()
-            .choose(&mut rand::rng())
-            .map(|room_id| Location::Room(room_id.clone())),
+        RandomSet { rooms } => {
+            // Set order varies between runs; sort so a seeded draw always picks the same room.
+            let mut candidates: Vec<&RoomId> = rooms.iter().collect();
+            candidates.sort_unstable_by_key(|room_id| room_id.as_str());
+            rng.choose(&candidates).map(|room_id| Location::Room(**room_id))
+        },
     }
 }
 
@@ -597,7 +600,7 @@ mod tests {
             description: "A test NPC".into(),
             location: Location::Nowhere,
             inventory: HashSet::new(),
-            dialogue,
+            dialogue: dialogue.into(),
             state: NpcState::Normal,
             movement: None,
             health: HealthState::new_at_max(10),
@@ -622,7 +625,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.items.insert(item_id.clone(), item);
@@ -680,26 +683,26 @@ mod tests {
 
     #[test]
     fn npc_random_dialogue_returns_appropriate_line() {
-        use gametools::{Spinner, Wedge};
+        use crate::spinners::{Spinner, Wedge};
 
         let npc = create_test_npc();
         let ignore_spinner = Spinner::new(vec![Wedge::new("Ignores you.".into())]);
 
         // Test normal state dialogue
-        let dialogue = npc.random_dialogue(&ignore_spinner);
+        let dialogue = npc.random_dialogue(&WorldRng::seeded(3), &ignore_spinner);
         let normal_lines = &npc.dialogue[&NpcState::Normal];
         assert!(normal_lines.contains(&dialogue) || dialogue == "Ignores you.");
     }
 
     #[test]
     fn npc_random_dialogue_returns_fallback_for_missing_state() {
-        use gametools::{Spinner, Wedge};
+        use crate::spinners::{Spinner, Wedge};
 
         let mut npc = create_test_npc();
         npc.state = NpcState::Tired; // State not in dialogue map
         let ignore_spinner = Spinner::new(vec![Wedge::new("Ignores you.".into())]);
 
-        let dialogue = npc.random_dialogue(&ignore_spinner);
+        let dialogue = npc.random_dialogue(&WorldRng::seeded(3), &ignore_spinner);
         assert_eq!(dialogue, "Ignores you.");
     }
 
@@ -856,8 +859,8 @@ mod tests {
             symbol: "player_room".into(),
             name: "Player Room".into(),
             base_description: "The player's room".into(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -871,8 +874,8 @@ mod tests {
             symbol: "other_room".into(),
             name: "Other Room".into(),
             base_description: "Another room".into(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -942,8 +945,8 @@ mod tests {
             symbol: "player_room".into(),
             name: "Player Room".into(),
             base_description: "The player's room".into(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -957,8 +960,8 @@ mod tests {
             symbol: "other_room".into(),
             name: "Other Room".into(),
             base_description: "Another room".into(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
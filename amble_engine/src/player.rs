@@ -10,8 +10,9 @@ use log::{info, warn};
 use serde::de::{self, Deserializer, EnumAccess, VariantAccess, Visitor};
 use serde::ser::SerializeStruct;
 use serde::{Deserialize, Serialize, Serializer};
-use std::collections::HashSet;
+use std::collections::{HashMap, HashSet, hash_map};
 use std::fmt;
+use std::sync::{LazyLock, PoisonError, RwLock};
 use variantly::Variantly;
 
 /// The player-controlled character.
@@ -26,7 +27,7 @@ pub struct Player {
     pub location: Location,
     pub location_history: Vec<RoomId>,
     pub inventory: HashSet<ItemId>,
-    pub flags: HashSet<Flag>,
+    pub flags: FlagStore,
     pub score: usize,
     pub health: HealthState,
 }
@@ -109,7 +110,7 @@ impl Default for Player {
             location: Location::default(),
             location_history: Vec::new(),
             inventory: HashSet::<ItemId>::default(),
-            flags: HashSet::<Flag>::default(),
+            flags: FlagStore::default(),
             score: 1,
             health: HealthState::default(),
         }
@@ -436,6 +437,250 @@ impl Hash for Flag {
     }
 }
 
+/// Process-wide table of interned flag names.
+#[derive(Debug, Default)]
+struct FlagInterner {
+    ids: HashMap<Box<str>, u32>,
+    names: Vec<Box<str>>,
+}
+
+static FLAG_NAMES: LazyLock<RwLock<FlagInterner>> = LazyLock::new(|| RwLock::new(FlagInterner::default()));
+
+/// Interned flag name.
+///
+/// Keys are only meaningful within the running process and are never serialized;
+/// saves and world data always refer to flags by name.
+#[derive(Debug, Copy, Clone, PartialEq, Eq, Hash)]
+pub struct FlagKey(u32);
+
+impl FlagKey {
+    /// Returns the key for a flag name, interning it if it hasn't been seen before.
+    ///
+    /// # Panics
+    /// Panics if more than `u32::MAX` distinct flag names are interned.
+    pub fn intern(name: &str) -> FlagKey {
+        if let Some(key) = FlagKey::lookup(name) {
+            return key;
+        }
+        let mut table = FLAG_NAMES.write().unwrap_or_else(PoisonError::into_inner);
+        if let Some(id) = table.ids.get(name) {
+            return FlagKey(*id);
+        }
+        let id = u32::try_from(table.names.len()).expect("flag name table overflow");
+        table.names.push(name.into());
+        table.ids.insert(name.into(), id);
+        FlagKey(id)
+    }
+
+    /// Returns the key for a flag name only if it has already been interned.
+    pub fn lookup(name: &str) -> Option<FlagKey> {
+        FLAG_NAMES
+            .read()
+            .unwrap_or_else(PoisonError::into_inner)
+            .ids
+            .get(name)
+            .copied()
+            .map(FlagKey)
+    }
+}
+
+/// A flag reference held by a trigger, goal, or overlay condition.
+///
+/// Conditions name flags by value: "`name`" for simple flags and "`name#N`" for a sequence
+/// flag at step N. The reference keeps the original string for serialization and display,
+/// and resolves it to interned keys when constructed so that checks against the player's
+/// [`FlagStore`] do no string work at all.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+#[serde(from = "String", into = "String")]
+pub struct FlagRef {
+    raw: String,
+    key: FlagKey,
+    step: Option<(FlagKey, u8)>,
+}
+
+impl FlagRef {
+    /// Create a reference from a flag value string.
+    pub fn new(raw: &str) -> FlagRef {
+        FlagRef::from(raw.to_string())
+    }
+
+    /// The flag value string as written in world data.
+    pub fn as_str(&self) -> &str {
+        &self.raw
+    }
+}
+
+impl From<String> for FlagRef {
+    fn from(raw: String) -> Self {
+        let step = raw.rsplit_once('#').and_then(|(name, step)| {
+            let step = step.parse::<u8>().ok()?;
+            (format_sequence_value(name, step) == raw).then(|| (FlagKey::intern(name), step))
+        });
+        FlagRef {
+            key: FlagKey::intern(&raw),
+            raw,
+            step,
+        }
+    }
+}
+
+impl From<&str> for FlagRef {
+    fn from(raw: &str) -> Self {
+        FlagRef::new(raw)
+    }
+}
+
+impl From<FlagRef> for String {
+    fn from(flag: FlagRef) -> Self {
+        flag.raw
+    }
+}
+
+impl PartialEq for FlagRef {
+    fn eq(&self, other: &Self) -> bool {
+        self.raw == other.raw
+    }
+}
+
+impl Eq for FlagRef {}
+
+impl PartialEq<str> for FlagRef {
+    fn eq(&self, other: &str) -> bool {
+        self.raw == other
+    }
+}
+
+impl PartialEq<&str> for FlagRef {
+    fn eq(&self, other: &&str) -> bool {
+        self.raw == *other
+    }
+}
+
+impl std::fmt::Display for FlagRef {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.write_str(&self.raw)
+    }
+}
+
+/// The player's flags, keyed by interned flag name.
+///
+/// Like the `HashSet<Flag>` it replaces, flags are identified by name only, so a sequence
+/// flag is updated by taking it out and re-inserting it. Serializes as a plain sequence
+/// of `Flag`s, so existing saves load unchanged.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct FlagStore {
+    flags: HashMap<FlagKey, Flag>,
+}
+
+impl FlagStore {
+    /// Add a flag. Returns false (leaving the existing flag in place) if one with the same name is set.
+    pub fn insert(&mut self, flag: Flag) -> bool {
+        match self.flags.entry(FlagKey::intern(flag.name())) {
+            hash_map::Entry::Occupied(_) => false,
+            hash_map::Entry::Vacant(slot) => {
+                slot.insert(flag);
+                true
+            },
+        }
+    }
+
+    /// Remove a flag with the same name as `flag`. Returns true if one was set.
+    pub fn remove(&mut self, flag: &Flag) -> bool {
+        self.take(flag).is_some()
+    }
+
+    /// Remove and return the flag with the same name as `flag`.
+    pub fn take(&mut self, flag: &Flag) -> Option<Flag> {
+        FlagKey::lookup(flag.name()).and_then(|key| self.flags.remove(&key))
+    }
+
+    /// Returns true if a flag with the same name as `flag` is set.
+    pub fn contains(&self, flag: &Flag) -> bool {
+        self.get(flag).is_some()
+    }
+
+    /// Get the flag with the same name as `flag`.
+    pub fn get(&self, flag: &Flag) -> Option<&Flag> {
+        self.get_by_name(flag.name())
+    }
+
+    /// Get a flag by name.
+    pub fn get_by_name(&self, name: &str) -> Option<&Flag> {
+        FlagKey::lookup(name).and_then(|key| self.flags.get(&key))
+    }
+
+    /// True if the flag value is set: a simple flag with that name, or a sequence flag at that step.
+    pub fn is_set(&self, flag: &FlagRef) -> bool {
+        matches!(self.flags.get(&flag.key), Some(Flag::Simple { .. }))
+            || flag.step.is_some_and(|(key, step)| self.at_step(key, step))
+    }
+
+    /// True if the named sequence flag is currently at `step`.
+    pub fn at_step(&self, key: FlagKey, step: u8) -> bool {
+        matches!(self.flags.get(&key), Some(Flag::Sequence { step: current, .. }) if *current == step)
+    }
+
+    /// True if the named flag is set and is a sequence that has not reached its end.
+    pub fn in_progress(&self, flag: &FlagRef) -> bool {
+        self.flags.get(&flag.key).is_some_and(|f| !f.is_complete())
+    }
+
+    /// True if the named flag is set and is either simple or a completed sequence.
+    pub fn is_complete(&self, flag: &FlagRef) -> bool {
+        self.flags.get(&flag.key).is_some_and(Flag::is_complete)
+    }
+
+    /// Iterate over all set flags (in arbitrary order).
+    pub fn iter(&self) -> hash_map::Values<'_, FlagKey, Flag> {
+        self.flags.values()
+    }
+
+    pub fn len(&self) -> usize {
+        self.flags.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.flags.is_empty()
+    }
+}
+
+impl<'a> IntoIterator for &'a FlagStore {
+    type Item = &'a Flag;
+    type IntoIter = hash_map::Values<'a, FlagKey, Flag>;
+
+    fn into_iter(self) -> Self::IntoIter {
+        self.iter()
+    }
+}
+
+impl FromIterator<Flag> for FlagStore {
+    fn from_iter<I: IntoIterator<Item = Flag>>(iter: I) -> Self {
+        let mut store = FlagStore::default();
+        for flag in iter {
+            store.insert(flag);
+        }
+        store
+    }
+}
+
+impl Serialize for FlagStore {
+    fn serialize<S>(&self, serializer: S) -> Result<S::Ok, S::Error>
+    where
+        S: Serializer,
+    {
+        serializer.collect_seq(self.flags.values())
+    }
+}
+
+impl<'de> Deserialize<'de> for FlagStore {
+    fn deserialize<D>(deserializer: D) -> Result<Self, D::Error>
+    where
+        D: Deserializer<'de>,
+    {
+        Ok(Vec::<Flag>::deserialize(deserializer)?.into_iter().collect())
+    }
+}
+
 /// Formats a sequence-type flag into a string value
 ///
 /// Format is "name"#"step", e.g. "`hal_reboot#2`"
@@ -876,4 +1121,58 @@ mod tests {
         let mut player = Player::default();
         assert_eq!(player.go_back(), None);
     }
+
+    #[test]
+    fn flag_store_matches_flag_values() {
+        let mut player = create_test_player();
+        assert!(player.flags.is_set(&FlagRef::new("test_flag")));
+        assert!(!player.flags.is_set(&FlagRef::new("test_seq")));
+        assert!(player.flags.is_set(&FlagRef::new("test_seq#0")));
+        assert!(!player.flags.is_set(&FlagRef::new("test_seq#1")));
+        assert!(!player.flags.is_set(&FlagRef::new("test_flag#0")));
+        player.advance_flag("test_seq");
+        assert!(player.flags.is_set(&FlagRef::new("test_seq#1")));
+        assert!(player.flags.in_progress(&FlagRef::new("test_seq")));
+        assert!(!player.flags.is_complete(&FlagRef::new("test_seq")));
+        assert!(player.flags.is_complete(&FlagRef::new("test_flag")));
+        assert!(!player.flags.is_set(&FlagRef::new("never_set")));
+    }
+
+    #[test]
+    fn flag_store_insert_keeps_existing_flag() {
+        let mut store = FlagStore::default();
+        assert!(store.insert(Flag::sequence("quest", Some(3), 0)));
+        assert!(!store.insert(Flag::simple("quest", 5)));
+        assert!(matches!(store.get_by_name("quest"), Some(Flag::Sequence { .. })));
+        assert!(store.remove(&Flag::simple("quest", 0)));
+        assert!(store.is_empty());
+    }
+
+    #[test]
+    fn flag_store_serializes_as_flag_sequence() {
+        let mut player = Player::default();
+        player.flags.insert(Flag::sequence("quest", Some(2), 4));
+        let store_ron = ron::ser::to_string(&player.flags).expect("flags should serialize");
+        let set: HashSet<Flag> = player.flags.iter().cloned().collect();
+        assert_eq!(store_ron, ron::ser::to_string(&set).expect("set should serialize"));
+
+        let legacy = ron::ser::to_string(&vec![Flag::simple("a", 1), Flag::sequence("b", None, 2)])
+            .expect("legacy flags should serialize");
+        let decoded: FlagStore = ron::from_str(&legacy).expect("legacy flags should deserialize");
+        assert_eq!(decoded.len(), 2);
+        assert!(decoded.is_set(&FlagRef::new("a")));
+        assert!(decoded.is_set(&FlagRef::new("b#0")));
+    }
+
+    #[test]
+    fn flag_ref_serializes_as_plain_string() {
+        let flag = FlagRef::new("quest#2");
+        assert_eq!(
+            ron::ser::to_string(&flag).unwrap(),
+            ron::ser::to_string("quest#2").unwrap()
+        );
+        let decoded: FlagRef = ron::from_str("\"quest#2\"").unwrap();
+        assert_eq!(decoded, flag);
+        assert_eq!(decoded.as_str(), "quest#2");
+    }
 }
@@ -0,0 +1,350 @@
+//! Opt-in trigger and turn-phase profiler.
+//!
+//! When enabled, the engine records for every trigger how often its conditions were
+//! evaluated, how often they held, and the cumulative time spent evaluating them,
+//! plus how long each turn phase ([`Phase`]) took. The report is sorted by
+//! evaluation time so the triggers worth restructuring in large worlds come first.
+//!
+//! Profiling is off by default and costs one relaxed atomic load per evaluation
+//! while off. Turn it on with `AMBLE_PROFILE` (`1`/`on`, or a path stem for the
+//! report files) or the `:profile on` developer command. If it is on when the game
+//! quits, the report is written as `<stem>.txt` and `<stem>.json` (default stem
+//! `logs/trigger-profile`).
+//!
+//! Counters are process-wide, so a server profiling several sessions reports
+//! their combined totals.
+
+use std::collections::HashMap;
+use std::fmt::Write as _;
+use std::fs;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{LazyLock, Mutex, MutexGuard, PoisonError};
+use std::time::{Duration, Instant};
+
+use anyhow::{Context, Result};
+use serde::Serialize;
+
+use crate::save_files::LOG_DIR;
+
+static ENABLED: AtomicBool = AtomicBool::new(false);
+static PROFILE: LazyLock<Mutex<Profile>> = LazyLock::new(|| Mutex::new(Profile::default()));
+
+/// Turn phases timed by the profiler.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum Phase {
+    /// `check_triggers`: event-driven trigger evaluation and firing.
+    Triggers,
+    /// `check_scheduled_events`: due scheduler events.
+    ScheduledEvents,
+    /// `tick_npc_movement`: planned NPC moves.
+    NpcMovement,
+    /// `check_ambient_triggers`: ambient spinner messages.
+    AmbientTriggers,
+}
+
+impl Phase {
+    const ALL: [Phase; 4] = [
+        Phase::Triggers,
+        Phase::ScheduledEvents,
+        Phase::NpcMovement,
+        Phase::AmbientTriggers,
+    ];
+
+    /// Name of the engine function the phase covers.
+    pub fn name(self) -> &'static str {
+        match self {
+            Phase::Triggers => "check_triggers",
+            Phase::ScheduledEvents => "check_scheduled_events",
+            Phase::NpcMovement => "tick_npc_movement",
+            Phase::AmbientTriggers => "check_ambient_triggers",
+        }
+    }
+}
+
+#[derive(Debug, Default)]
+struct Profile {
+    triggers: HashMap<String, TriggerStats>,
+    phases: HashMap<Phase, PhaseStats>,
+}
+
+/// Evaluation counters for one trigger (triggers sharing a name are combined).
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize)]
+pub struct TriggerStats {
+    pub name: String,
+    /// Times the trigger's conditions were evaluated.
+    pub evaluations: u64,
+    /// Evaluations whose conditions held.
+    pub hits: u64,
+    /// Cumulative evaluation time in nanoseconds.
+    pub eval_nanos: u64,
+}
+
+impl TriggerStats {
+    /// Fraction of evaluations whose conditions held.
+    pub fn hit_rate(&self) -> f64 {
+        if self.evaluations == 0 {
+            0.0
+        } else {
+            #[allow(clippy::cast_precision_loss)]
+            let rate = self.hits as f64 / self.evaluations as f64;
+            rate
+        }
+    }
+}
+
+/// Timing for one turn phase.
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize)]
+pub struct PhaseStats {
+    pub phase: String,
+    pub calls: u64,
+    pub total_nanos: u64,
+    pub max_nanos: u64,
+}
+
+/// Snapshot of everything recorded so far, sorted for reading.
+#[derive(Debug, Clone, Default, Serialize)]
+pub struct ProfileReport {
+    /// Triggers by cumulative evaluation time, most expensive first (ties by name).
+    pub triggers: Vec<TriggerStats>,
+    /// Phases in turn order; phases that never ran are omitted.
+    pub phases: Vec<PhaseStats>,
+}
+
+impl ProfileReport {
+    /// Render the report as an aligned text table; `limit` caps the trigger rows.
+    pub fn to_text(&self, limit: Option<usize>) -> String {
+        let mut out = String::new();
+        let _ = writeln!(out, "Turn phases:");
+        let _ = writeln!(
+            out,
+            "  {:<24} {:>8} {:>12} {:>12} {:>12}",
+            "phase", "calls", "total", "mean", "max"
+        );
+        for phase in &self.phases {
+            let total = Duration::from_nanos(phase.total_nanos);
+            let mean = Duration::from_nanos(phase.total_nanos / phase.calls.max(1));
+            let max = Duration::from_nanos(phase.max_nanos);
+            let _ = writeln!(
+                out,
+                "  {:<24} {:>8} {:>12.2?} {:>12.2?} {:>12.2?}",
+                phase.phase, phase.calls, total, mean, max
+            );
+        }
+        let shown = limit.unwrap_or(self.triggers.len()).min(self.triggers.len());
+        let _ = writeln!(
+            out,
+            "\nTriggers by evaluation time ({shown} of {}):",
+            self.triggers.len()
+        );
+        let _ = writeln!(
+            out,
+            "  {:>10} {:>8} {:>7} {:>12}  trigger",
+            "evals", "hits", "hit %", "time"
+        );
+        for trigger in &self.triggers[..shown] {
+            let _ = writeln!(
+                out,
+                "  {:>10} {:>8} {:>6.1}% {:>12.2?}  {}",
+                trigger.evaluations,
+                trigger.hits,
+                trigger.hit_rate() * 100.0,
+                Duration::from_nanos(trigger.eval_nanos),
+                trigger.name
+            );
+        }
+        out
+    }
+
+    /// Render the report as pretty-printed JSON.
+    ///
+    /// # Errors
+    /// Returns an error if serialization fails.
+    pub fn to_json(&self) -> Result<String> {
+        serde_json::to_string_pretty(self).context("serializing profile report")
+    }
+}
+
+fn profile() -> MutexGuard<'static, Profile> {
+    PROFILE.lock().unwrap_or_else(PoisonError::into_inner)
+}
+
+fn saturating_nanos(elapsed: Duration) -> u64 {
+    u64::try_from(elapsed.as_nanos()).unwrap_or(u64::MAX)
+}
+
+/// True if profiling is on.
+#[inline]
+pub fn enabled() -> bool {
+    ENABLED.load(Ordering::Relaxed)
+}
+
+/// Turn profiling on or off; counters are kept either way.
+pub fn set_enabled(on: bool) {
+    ENABLED.store(on, Ordering::Relaxed);
+}
+
+/// Discard everything recorded so far.
+pub fn reset() {
+    *profile() = Profile::default();
+}
+
+/// Enable profiling if `AMBLE_PROFILE` asks for it.
+pub fn init_from_env() {
+    if report_stem_from_env().is_some() {
+        set_enabled(true);
+    }
+}
+
+/// Report file stem requested by `AMBLE_PROFILE`, or `None` if profiling was not requested.
+fn report_stem_from_env() -> Option<PathBuf> {
+    let value = std::env::var("AMBLE_PROFILE").ok()?;
+    let value = value.trim();
+    match value.to_ascii_lowercase().as_str() {
+        "" | "0" | "off" | "false" => None,
+        "1" | "on" | "true" => Some(default_report_stem()),
+        _ => Some(PathBuf::from(value)),
+    }
+}
+
+fn default_report_stem() -> PathBuf {
+    Path::new(LOG_DIR).join("trigger-profile")
+}
+
+/// Evaluate one trigger's conditions via `eval`, recording the call when profiling is on.
+#[inline]
+pub fn profile_eval(trigger_name: &str, eval: impl FnOnce() -> bool) -> bool {
+    if !enabled() {
+        return eval();
+    }
+    let start = Instant::now();
+    let hit = eval();
+    let elapsed = start.elapsed();
+    let mut profile = profile();
+    // look up by &str first so the name is only allocated the first time
+    if !profile.triggers.contains_key(trigger_name) {
+        let stats = TriggerStats {
+            name: trigger_name.to_string(),
+            ..TriggerStats::default()
+        };
+        profile.triggers.insert(trigger_name.to_string(), stats);
+    }
+    let Some(stats) = profile.triggers.get_mut(trigger_name) else {
+        return hit;
+    };
+    stats.evaluations += 1;
+    stats.hits += u64::from(hit);
+    stats.eval_nanos = stats.eval_nanos.saturating_add(saturating_nanos(elapsed));
+    hit
+}
+
+/// Times a turn phase from creation until drop (nested phases are timed inclusively).
+#[must_use = "the phase is timed until the timer is dropped"]
+pub struct PhaseTimer {
+    phase: Phase,
+    start: Option<Instant>,
+}
+
+/// Start timing `phase` if profiling is on.
+pub fn time_phase(phase: Phase) -> PhaseTimer {
+    PhaseTimer {
+        phase,
+        start: enabled().then(Instant::now),
+    }
+}
+
+impl Drop for PhaseTimer {
+    fn drop(&mut self) {
+        let Some(start) = self.start else {
+            return;
+        };
+        let nanos = saturating_nanos(start.elapsed());
+        let mut profile = profile();
+        let stats = profile.phases.entry(self.phase).or_default();
+        stats.calls += 1;
+        stats.total_nanos = stats.total_nanos.saturating_add(nanos);
+        stats.max_nanos = stats.max_nanos.max(nanos);
+    }
+}
+
+/// Snapshot the recorded counters as a sorted report.
+pub fn report() -> ProfileReport {
+    let profile = profile();
+    let mut triggers: Vec<TriggerStats> = profile.triggers.values().cloned().collect();
+    triggers.sort_by(|a, b| b.eval_nanos.cmp(&a.eval_nanos).then_with(|| a.name.cmp(&b.name)));
+    let phases = Phase::ALL
+        .iter()
+        .filter_map(|phase| {
+            profile.phases.get(phase).map(|stats| PhaseStats {
+                phase: phase.name().to_string(),
+                ..stats.clone()
+            })
+        })
+        .collect();
+    ProfileReport { triggers, phases }
+}
+
+/// Write the report as `<stem>.txt` and `<stem>.json`, returning both paths.
+///
+/// # Errors
+/// Returns an error if the directory or either file cannot be written.
+pub fn write_report(stem: &Path) -> Result<(PathBuf, PathBuf)> {
+    let report = report();
+    if let Some(parent) = stem.parent().filter(|parent| !parent.as_os_str().is_empty()) {
+        fs::create_dir_all(parent).with_context(|| format!("creating {}", parent.display()))?;
+    }
+    let text_path = stem.with_extension("txt");
+    let json_path = stem.with_extension("json");
+    fs::write(&text_path, report.to_text(None)).with_context(|| format!("writing {}", text_path.display()))?;
+    fs::write(&json_path, report.to_json()?).with_context(|| format!("writing {}", json_path.display()))?;
+    Ok((text_path, json_path))
+}
+
+/// Write the report on quit if profiling is on, to the `AMBLE_PROFILE` stem or the default one.
+///
+/// Returns the paths written, or `None` if profiling is off.
+///
+/// # Errors
+/// Returns an error if the report files cannot be written.
+pub fn finish() -> Result<Option<(PathBuf, PathBuf)>> {
+    if !enabled() {
+        return Ok(None);
+    }
+    let stem = report_stem_from_env().unwrap_or_else(default_report_stem);
+    write_report(&stem).map(Some)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn records_evaluations_and_sorts_by_time() {
+        set_enabled(true);
+        reset();
+        assert!(profile_eval("cheap", || true));
+        assert!(!profile_eval("costly", || {
+            std::thread::sleep(Duration::from_millis(2));
+            false
+        }));
+        assert!(profile_eval("cheap", || true));
+        drop(time_phase(Phase::Triggers));
+        set_enabled(false);
+        assert!(profile_eval("ignored", || true));
+
+        // other tests may run triggers concurrently; only look at the ones recorded here
+        let report = report();
+        let ours: Vec<&TriggerStats> = report
+            .triggers
+            .iter()
+            .filter(|t| ["cheap", "costly", "ignored"].contains(&t.name.as_str()))
+            .collect();
+        let names: Vec<&str> = ours.iter().map(|t| t.name.as_str()).collect();
+        assert_eq!(names, ["costly", "cheap"]);
+        assert_eq!((ours[1].evaluations, ours[1].hits), (2, 2));
+        assert!(ours[0].hit_rate() < f64::EPSILON);
+        assert!(report.phases.iter().any(|phase| phase.phase == "check_triggers"));
+        assert!(report.to_text(None).contains("costly"));
+        assert!(report.to_json().unwrap().contains("\"evaluations\": 2"));
+    }
+}
@@ -13,7 +13,6 @@ pub mod npc;
 pub mod system;
 
 pub use dev::*;
-use gametools::Spinner;
 pub use inventory::*;
 pub use item::*;
 use log::info;
@@ -24,9 +23,11 @@ pub use system::*;
 
 use crate::command::{Command, parse_command};
 use crate::health::{LifeState, LivingEntity};
+use crate::journal::AutosaveJournal;
 use crate::loader::load_world;
 use crate::npc::{calculate_next_location, move_npc, move_scheduled};
-use crate::scheduler::{EventCondition, OnFalsePolicy, ScheduledEvent};
+use crate::profiler::{self, Phase, profile_eval};
+use crate::scheduler::{OnFalsePolicy, ScheduledEvent};
 use crate::spinners::CoreSpinnerType;
 use crate::style::GameStyle;
 use crate::trigger::{TriggerCondition, check_triggers, dispatch_action};
@@ -37,8 +38,6 @@ use colored::Colorize;
 
 use input::{InputEvent, InputManager};
 
-const AUTOSAVE_TURNS: usize = 5;
-
 /// Control flow signal used by handlers to exit the REPL.
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub enum ReplControl {
@@ -58,6 +57,7 @@ pub fn run_repl(world: &mut AmbleWorld) -> Result<()> {
     let mut input_manager = InputManager::new();
     world.turn_count = world.turn_count.max(1);
     let mut turn_log_state = TurnLogState::new(world);
+    let mut autosave = AutosaveJournal::new("autosave");
     // ---- enter main game loop here ----
     loop {
         turn_log_state.log_if_advanced(world)?;
@@ -85,10 +85,8 @@ pub fn run_repl(world: &mut AmbleWorld) -> Result<()> {
                     continue;
                 },
             }
-            // autosave if appropriate
-            if world.turn_count.is_multiple_of(AUTOSAVE_TURNS)
-                && let Err(err) = crate::repl::system::autosave_quiet(world, "autosave")
-            {
+            // autosave every turn (journaled; compacts into a snapshot periodically)
+            if let Err(err) = crate::repl::system::autosave_quiet(world, &mut autosave) {
                 view.push(ViewItem::Error(format!("Autosave failed: {err}")));
             }
         }
@@ -166,7 +164,7 @@ fn check_for_exit_fallback<'a>(input: &str, directions: impl Iterator<Item = &'a
 
 /// Parses input text into a Command variant, falling back to a MoveTo command if one of the
 /// current room's exits matches the input.
-fn parse_with_exit_fallback(world: &AmbleWorld, view: &mut View, input: String) -> Result<Command> {
+pub(crate) fn parse_with_exit_fallback(world: &AmbleWorld, view: &mut View, input: String) -> Result<Command> {
     let input = expand_abbreviated_input(&input);
     let mut command = parse_command(input, view);
     if matches!(command, Command::Unknown)
@@ -195,20 +193,20 @@ fn obtain_command(world: &AmbleWorld, view: &mut View, input_mgr: &mut InputMana
 
 /// Result returned from the command dispatcher.
 #[derive(Debug, Clone, PartialEq)]
-struct DispatchResult {
+pub(crate) struct DispatchResult {
     // Controls whether REPL should continue to run, or quit
-    control: ReplControl,
+    pub(crate) control: ReplControl,
     // True if the world was replaced (e.g. via load command), requiring turn-log resync.
-    world_reloaded: bool,
+    pub(crate) world_reloaded: bool,
     // True if the turn # was advanced this time around the REPL
-    turn_advanced: bool,
+    pub(crate) turn_advanced: bool,
 }
 
 /// Dispatch a `Command` to its appropriate handler.
 ///
 /// # Errors
 /// - propagated from any of the underlying command handlers
-fn dispatch_command(command: &Command, world: &mut AmbleWorld, view: &mut View) -> Result<DispatchResult> {
+pub(crate) fn dispatch_command(command: &Command, world: &mut AmbleWorld, view: &mut View) -> Result<DispatchResult> {
     #[allow(clippy::enum_glob_use)]
     use Command::*;
     let mut dr = DispatchResult {
@@ -294,6 +292,8 @@ fn dispatch_command(command: &Command, world: &mut AmbleWorld, view: &mut View)
         ResetSeq(seq_name) => dev_reset_seq_handler(world, view, seq_name),
         SetFlag(flag_name) => dev_set_flag_handler(world, view, flag_name),
         DevNote(note) => dev_note_handler(world, view, note),
+        Profile(action) => dev_profile_handler(view, action),
+        Reload => dr.world_reloaded = dev_reload_handler(world, view),
         StartSeq { seq_name, end } => dev_start_seq_handler(world, view, seq_name, end),
     }
     if dr.turn_advanced {
@@ -346,30 +346,44 @@ enum TimedEventsResult {
     WorldReloaded,
 }
 
-/// Process any turn-based events that are due this turn.
-/// - ticks health effects (damage/heal over time) and handles any deaths
-/// - moves NPCs scheduled to do so
-/// - fires due events from the scheduler
+/// Process any turn-based events that are due this turn, prompting the player if they died.
 fn run_timed_events(
     world: &mut AmbleWorld,
     view: &mut View,
     input_mgr: &mut InputManager,
 ) -> Result<TimedEventsResult> {
-    let (player_died, death_events) = run_health_effects(world, view);
-    if !death_events.is_empty() {
-        check_triggers(world, view, &death_events)?;
-    }
-    if player_died {
+    if advance_timed_events(world, view)? {
         view.flush();
         return match handle_player_death(world, view, input_mgr) {
             DeathReaction::WorldReloaded => Ok(TimedEventsResult::WorldReloaded),
             DeathReaction::Quit => Ok(TimedEventsResult::Quit),
         };
     }
+    Ok(TimedEventsResult::Continue)
+}
+
+/// Run the turn-based events for an advanced turn without any terminal interaction.
+/// - ticks health effects (damage/heal over time) and fires death triggers
+/// - moves NPCs scheduled to do so
+/// - fires due events from the scheduler
+///
+/// Returns `true` if the player died this turn, in which case NPC movement and
+/// scheduled events are skipped.
+///
+/// # Errors
+/// Propagates failures from triggered or scheduled actions.
+pub(crate) fn advance_timed_events(world: &mut AmbleWorld, view: &mut View) -> Result<bool> {
+    let (player_died, death_events) = run_health_effects(world, view);
+    if !death_events.is_empty() {
+        check_triggers(world, view, &death_events)?;
+    }
+    if player_died {
+        return Ok(true);
+    }
     // move surviving npcs and fire scheduled events
     tick_npc_movement(world, view)?;
     check_scheduled_events(world, view)?;
-    Ok(TimedEventsResult::Continue)
+    Ok(false)
 }
 
 /// Apply and update health effects for all `LivingEntity` (player and NPCs)
@@ -459,7 +473,9 @@ fn handle_player_death(world: &mut AmbleWorld, view: &mut View, input_manager: &
         }
 
         if trimmed.eq_ignore_ascii_case("restart") {
-            match load_world() {
+            // Restarting only resets game state; the shared content template is reused as-is.
+            let fresh = crate::content::fresh_world(&world.world_slug);
+            match fresh.map_or_else(load_world, Ok) {
                 Ok(mut new_world) => {
                     new_world.turn_count = 1;
                     crate::save_files::set_active_save_dir(crate::save_files::save_dir_for_world(&new_world));
@@ -499,6 +515,7 @@ fn handle_player_death(world: &mut AmbleWorld, view: &mut View, input_manager: &
 /// # Errors
 /// Returns an error if dispatching a scheduled trigger action fails.
 pub fn check_scheduled_events(world: &mut AmbleWorld, view: &mut View) -> Result<()> {
+    let _phase = profiler::time_phase(Phase::ScheduledEvents);
     let now = world.turn_count;
     while let Some(event) = world.scheduler.pop_due(now) {
         let note_text = event.note.clone().unwrap_or_else(|| "<no note recorded>".to_string());
@@ -553,20 +570,32 @@ struct MovementPlan {
 
 /// Create a `MovementPlan` listing which NPCs need to move, and their destinations.
 fn create_movement_plan(world: &mut AmbleWorld) -> MovementPlan {
-    let moves = world.npcs.values_mut().fold(Vec::new(), |mut plan, npc| {
-        if let Some(ref mut move_opts) = npc.movement
-            && move_opts.active
-            && move_opts.paused_until.is_none()
-            && move_scheduled(move_opts, world.turn_count)
+    let turn = world.turn_count;
+    let mut movers: Vec<NpcId> = world
+        .npcs
+        .values()
+        .filter(|npc| {
+            npc.movement.as_ref().is_some_and(|move_opts| {
+                move_opts.active && move_opts.paused_until.is_none() && move_scheduled(move_opts, turn)
+            })
+        })
+        .map(|npc| npc.id)
+        .collect();
+    // Map order differs between runs; visit movers in a fixed order so seeded random moves replay exactly.
+    movers.sort_unstable_by_key(|npc_id| npc_id.as_str());
+
+    let mut moves = Vec::new();
+    for npc_id in movers {
+        let Some(npc) = world.npcs.get_mut(&npc_id) else {
+            continue;
+        };
+        if let Some(move_opts) = npc.movement.as_mut()
+            && let Some(destination) = calculate_next_location(move_opts, &world.rng)
+            && npc.location != destination
         {
-            if let Some(destination) = calculate_next_location(move_opts)
-                && npc.location != destination
-            {
-                plan.push((npc.id.clone(), destination));
-            }
+            moves.push((npc_id, destination));
         }
-        plan
-    });
+    }
     MovementPlan { moves }
 }
 
@@ -574,6 +603,7 @@ fn create_movement_plan(world: &mut AmbleWorld) -> MovementPlan {
 /// # Errors
 ///
 pub fn tick_npc_movement(world: &mut AmbleWorld, view: &mut View) -> Result<()> {
+    let _phase = profiler::time_phase(Phase::NpcMovement);
     let planned = create_movement_plan(world);
     planned.moves.iter().try_for_each(|(npc_id, destination)| {
         let Some(movement) = world.npcs.get_mut(npc_id).and_then(|npc| npc.movement.as_mut()) else {
@@ -591,6 +621,10 @@ pub fn tick_npc_movement(world: &mut AmbleWorld, view: &mut View) -> Result<()>
 /// # Errors
 /// - on failed lookup of player's location
 pub fn check_ambient_triggers(world: &mut AmbleWorld, view: &mut View) -> Result<()> {
+    let _phase = profiler::time_phase(Phase::AmbientTriggers);
+    world
+        .trigger_index
+        .ensure_current(&world.triggers, world.triggers_revision);
     let current_room_id = world.player_room_id();
     for idx in local_ambient_trigger_idx(world) {
         fire_ambient_spinners(world, view, &current_room_id, idx);
@@ -607,7 +641,11 @@ fn fire_ambient_spinners(world: &mut AmbleWorld, view: &mut View, current_room_i
             if let TriggerCondition::Ambient { room_ids, spinner } = cond
                 && (room_ids.is_empty() || room_ids.contains(current_room_id))
             {
-                let message = world.spinners.get(spinner).and_then(Spinner::spin).unwrap_or_default();
+                let message = world
+                    .spinners
+                    .get(spinner)
+                    .and_then(|s| s.spin(&world.rng))
+                    .unwrap_or_default();
                 if !message.is_empty() {
                     view.push(ViewItem::AmbientEvent(format!("{}", message.ambient_trig_style())));
                 }
@@ -623,20 +661,17 @@ fn fire_ambient_spinners(world: &mut AmbleWorld, view: &mut View, current_room_i
 /// Returns list of indices to ambient triggers that apply to the current room.
 fn local_ambient_trigger_idx(world: &AmbleWorld) -> Vec<usize> {
     world
-        .triggers
+        .trigger_index
+        .ambient()
         .iter()
-        .enumerate()
-        .filter(|(_, trigger)| is_ambient(&trigger.conditions))
-        .filter(|(_, trigger)| trigger.conditions.eval_ambient(world))
-        .map(|(idx, _)| idx)
+        .copied()
+        .filter(|idx| {
+            let trigger = &world.triggers[*idx];
+            profile_eval(&trigger.name, || trigger.conditions.eval_ambient(world))
+        })
         .collect()
 }
 
-/// True if the condition contains an ambient variant.
-fn is_ambient(condition: &EventCondition) -> bool {
-    condition.any_trigger(|c| matches!(c, TriggerCondition::Ambient { .. }))
-}
-
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -657,8 +692,8 @@ mod tests {
             symbol: "r1".into(),
             name: "Room1".into(),
             base_description: "Room1".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -671,8 +706,8 @@ mod tests {
             symbol: "r2".into(),
             name: "Room2".into(),
             base_description: "Room2".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
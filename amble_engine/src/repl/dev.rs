@@ -23,6 +23,12 @@
 //! ## Playtest Notes
 //! - [`dev_note_handler`] - Append a playtest note with location metadata
 //!
+//! ## Profiling
+//! - [`dev_profile_handler`] - Toggle the trigger profiler or show its report
+//!
+//! ## Hot Reload
+//! - [`dev_reload_handler`] - Reload the recompiled world file, keeping game state
+//!
 //! ## Flag Management
 //! - [`dev_start_seq_handler`] - Create new sequence flags with custom limits
 //! - [`dev_set_flag_handler`] - Add simple boolean flags to player
@@ -44,7 +50,9 @@ use log::{info, warn};
 use time::{OffsetDateTime, format_description};
 
 use crate::RoomId;
+use crate::data_paths::data_path;
 use crate::helpers::symbol_or_unknown;
+use crate::loader::active_world_path;
 use crate::save_files::LOG_DIR;
 use crate::scheduler::{EventCondition, OnFalsePolicy, ScheduledEvent};
 use crate::slug::sanitize_slug;
@@ -56,6 +64,7 @@ use crate::{
     style::GameStyle,
     trigger::{self, spawn_item_in_inventory},
 };
+use crate::{hot_reload, profiler};
 
 /// Spawns an item directly into the player's inventory (`DEV_MODE` only).
 ///
@@ -88,8 +97,9 @@ use crate::{
 /// # Panics
 /// None -- `item_id` is already known to be valid and exist in symbol table before `expect()` is called
 pub fn dev_spawn_item_handler(world: &mut AmbleWorld, view: &mut View, symbol: &str) {
-    let item_id: ItemId = symbol_to_id(NAMESPACE_ITEM, symbol).into();
-    if world.items.contains_key(&item_id) {
+    if let Some(item_id) = ItemId::lookup(&symbol_to_id(NAMESPACE_ITEM, symbol))
+        && world.items.contains_key(&item_id)
+    {
         spawn_item_in_inventory(world, &item_id).expect("should not err; item_id already known to be valid");
         info!("player used DEV_MODE SpawnItem({symbol})");
         view.push(ViewItem::ActionSuccess(format!("Item '{symbol}' moved to inventory.")));
@@ -131,8 +141,9 @@ pub fn dev_spawn_item_handler(world: &mut AmbleWorld, view: &mut View, symbol: &
 /// - Movement-blocking conditions
 pub fn dev_teleport_handler(world: &mut AmbleWorld, view: &mut View, destination: &str) {
     // let room_id = symbol_to_id(NAMESPACE_ROOM, room_id);
-    let dest_id = RoomId::new(&destination);
-    if let Some(room) = world.rooms.get(&dest_id) {
+    if let Some(dest_id) = RoomId::lookup(destination)
+        && let Some(room) = world.rooms.get(&dest_id)
+    {
         world.player.location = Location::Room(dest_id);
         warn!(
             "DEV only command used: Teleported player to {} ({})",
@@ -220,6 +231,68 @@ pub fn dev_set_flag_handler(world: &mut AmbleWorld, view: &mut View, flag_name:
     trigger::add_flag(world, view, &flag);
 }
 
+/// Control the trigger profiler (`DEV_MODE` only).
+///
+/// `on`/`off` toggle recording, `reset` clears the counters, and `report` shows the
+/// turn phase timings and the most expensive triggers so far.
+pub fn dev_profile_handler(view: &mut View, action: &str) {
+    let message = match action {
+        "on" => {
+            profiler::set_enabled(true);
+            "Trigger profiler on; the report is written when the game quits.".to_string()
+        },
+        "off" => {
+            profiler::set_enabled(false);
+            "Trigger profiler off (counters kept).".to_string()
+        },
+        "reset" => {
+            profiler::reset();
+            "Trigger profiler counters cleared.".to_string()
+        },
+        _ => {
+            let report = profiler::report();
+            if report.triggers.is_empty() && report.phases.is_empty() {
+                "Nothing profiled yet (use :profile on).".to_string()
+            } else {
+                report.to_text(Some(15))
+            }
+        },
+    };
+    view.push(ViewItem::EngineMessage(message));
+    warn!("DEV_MODE command used: :profile {action}");
+}
+
+/// Reload the world file into the running game (`DEV_MODE` only).
+///
+/// Picks up content recompiled by `amble_script compile-dir` or `amble_script watch`
+/// while keeping the player's progress; see [`hot_reload`]. Returns true if the
+/// world was replaced.
+pub fn dev_reload_handler(world: &mut AmbleWorld, view: &mut View) -> bool {
+    let path = active_world_path().unwrap_or_else(|| data_path("world.ron"));
+    match hot_reload::reload_world(world, &path) {
+        Ok(report) => {
+            view.push(ViewItem::ActionSuccess(format!(
+                "Reloaded {}: {}.",
+                path.display(),
+                report.summary()
+            )));
+            warn!(
+                "DEV_MODE command used: :reload {} ({})",
+                path.display(),
+                report.summary()
+            );
+            true
+        },
+        Err(err) => {
+            view.push(ViewItem::Error(format!(
+                "Reload failed; keeping the current world: {err:#}"
+            )));
+            warn!("DEV_MODE :reload of {} failed: {err:#}", path.display());
+            false
+        },
+    }
+}
+
 /// Record a development note to the daily log file (`DEV_MODE` only).
 pub fn dev_note_handler(world: &AmbleWorld, view: &mut View, note: &str) {
     let log_dir = world_log_dir(world);
@@ -656,6 +729,8 @@ pub fn dev_sched_cancel_handler(world: &mut AmbleWorld, view: &mut View, idx: us
     }
     let note = ev.note.clone().unwrap_or_else(|| "<no note>".to_string());
     *ev = ScheduledEvent::default();
+    // an in-place edit isn't visible to the autosave journal's change detection; force a snapshot
+    world.journal_epoch = None;
     warn!("DEV_MODE: canceled scheduled event idx {idx} (note: {note})");
     view.push(ViewItem::ActionSuccess(format!("Scheduled event {idx} canceled.")));
 }
@@ -727,6 +802,21 @@ mod tests {
         }
     }
 
+    #[test]
+    fn dev_teleport_and_spawn_do_not_intern_unknown_ids() {
+        let mut world = create_test_world();
+        let mut view = View::new();
+
+        dev_teleport_handler(&mut world, &mut view, "dev_test_nowhere");
+        dev_spawn_item_handler(&mut world, &mut view, "dev_test_nothing");
+
+        assert!(RoomId::lookup("dev_test_nowhere").is_none());
+        assert!(ItemId::lookup("dev_test_nothing").is_none());
+        assert_eq!(view.items.len(), 2);
+        assert!(matches!(view.items[0].view_item, ViewItem::ActionFailure(_)));
+        assert!(matches!(view.items[1].view_item, ViewItem::ActionFailure(_)));
+    }
+
     #[test]
     fn dev_advance_seq_handler_works_for_existing_flag() {
         let mut world = create_test_world();
@@ -843,9 +933,9 @@ mod tests {
                 id: room_id.clone(),
                 symbol: "test_room".into(),
                 name: "Test Room".into(),
-                base_description: String::new(),
-                overlays: vec![],
-                scenery: Vec::new(),
+                base_description: String::new().into(),
+                overlays: vec![].into(),
+                scenery: Vec::new().into(),
                 scenery_default: None,
                 location: Location::Nowhere,
                 visited: false,
@@ -860,10 +950,10 @@ mod tests {
             id: npc_id.clone(),
             symbol: "npc_sym".into(),
             name: "Zed".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Room(room_id.clone()),
             inventory: HashSet::new(),
-            dialogue: HashMap::new(),
+            dialogue: HashMap::new().into(),
             state: crate::npc::NpcState::Normal,
             movement: None,
             health: HealthState::new_at_max(10),
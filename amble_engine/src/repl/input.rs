@@ -47,6 +47,8 @@ const DEV_COMMANDS: &[&str] = &[
     ":init-seq",
     ":reset-seq",
     ":set-flag",
+    ":profile",
+    ":reload",
 ];
 
 const EXCLUDED_TERMS: &[&str] = &[
@@ -45,7 +45,8 @@
 use crate::{
     AmbleWorld, Item, ItemHolder, ItemId, Location, NpcId, View, ViewItem, WorldObject,
     entity_search::{
-        EntityId, SearchError, SearchScope, WorldEntity, entity_not_found, find_entity_match, find_item_match,
+        EntityId, SearchError, SearchScope, WorldEntity, ask_which_item, entity_not_found, find_entity_match,
+        find_item_match,
     },
     helpers::{name_from_id, symbol_or_unknown},
     item::{ItemAbility, ItemInteractionType, Movability},
@@ -219,6 +220,10 @@ pub fn take_handler(world: &mut AmbleWorld, view: &mut View, thing: &str) -> Res
         },
         Err(e) => bail!(e),
     };
+    if matches!(entity_id, EntityId::Item(_)) && ask_which_item(world, view, thing, SearchScope::AllTouchable(room_id))
+    {
+        return Ok(false);
+    }
 
     let consumed_turn = match entity_id {
         EntityId::Item(item_id) => {
@@ -667,12 +672,16 @@ pub(crate) fn transfer_to_player(world: &mut AmbleWorld, view: &mut View, tx_dat
     // Remove item id from vessel's contents / inventory
     match tx_data.vessel_type {
         VesselType::Item => {
-            if let Some(vessel) = world.items.get_mut(tx_data.vessel_id.as_str()) {
+            if let Some(vessel_id) = ItemId::lookup(&tx_data.vessel_id)
+                && let Some(vessel) = world.items.get_mut(&vessel_id)
+            {
                 vessel.remove_item(tx_data.loot_id.clone());
             }
         },
         VesselType::Npc => {
-            if let Some(vessel) = world.npcs.get_mut(&tx_data.vessel_id) {
+            if let Some(vessel_id) = NpcId::lookup(&tx_data.vessel_id)
+                && let Some(vessel) = world.npcs.get_mut(&vessel_id)
+            {
                 // keeps NPC from walking away immediately after a transaction
                 vessel.pause_movement(world.turn_count, 4);
                 vessel.remove_item(tx_data.loot_id.clone());
@@ -890,9 +899,9 @@ mod tests {
             id: room_id.clone(),
             symbol: "room".into(),
             name: "Test Room".into(),
-            base_description: String::new(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            base_description: String::new().into(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -909,7 +918,7 @@ mod tests {
             id: inv_item_id.clone(),
             symbol: "apple".into(),
             name: "Apple".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Inventory,
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -919,7 +928,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.items.insert(inv_item_id.clone(), inv_item);
@@ -931,7 +940,7 @@ mod tests {
             id: room_item_id.clone(),
             symbol: "rock".into(),
             name: "Rock".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Room(room_id.clone()),
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -941,7 +950,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.items.insert(room_item_id.clone(), room_item);
@@ -953,7 +962,7 @@ mod tests {
             id: chest_id.clone(),
             symbol: "chest".into(),
             name: "Chest".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Room(room_id.clone()),
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -963,7 +972,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         let gem_id: ItemId = crate::idgen::new_id().into();
@@ -971,7 +980,7 @@ mod tests {
             id: gem_id.clone(),
             symbol: "gem".into(),
             name: "Gem".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Item(chest_id.clone()),
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -981,7 +990,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         let restricted_chest_item_id: ItemId = crate::idgen::new_id().into();
@@ -989,7 +998,7 @@ mod tests {
             id: restricted_chest_item_id.clone(),
             symbol: "rci".into(),
             name: "Restricted Chest Item".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Item(chest_id.clone()),
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -1001,7 +1010,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         chest.add_item(gem_id.clone());
@@ -1019,10 +1028,10 @@ mod tests {
             id: npc_id.clone(),
             symbol: "bob".into(),
             name: "Bob".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Room(room_id.clone()),
             inventory: HashSet::new(),
-            dialogue: HashMap::new(),
+            dialogue: HashMap::new().into(),
             state: NpcState::Normal,
             movement: None,
             health: HealthState::new_at_max(10),
@@ -1032,7 +1041,7 @@ mod tests {
             id: npc_item_id.clone(),
             symbol: "coin".into(),
             name: "Coin".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Npc(npc_id.clone()),
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -1042,7 +1051,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         let restricted_npc_item_id: ItemId = crate::idgen::new_id().into();
@@ -1050,7 +1059,7 @@ mod tests {
             id: restricted_npc_item_id.clone(),
             symbol: "key".into(),
             name: "Restricted NPC Item".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Npc(npc_id.clone()),
             container_state: None,
             visibility: crate::item::ItemVisibility::Listed,
@@ -1062,7 +1071,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         npc.add_item(npc_item_id.clone());
@@ -1147,7 +1156,7 @@ mod tests {
             id: floor_gem_id.clone(),
             symbol: "floor-gem".into(),
             name: "Gem".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Room(tw.room_id.clone()),
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -1157,7 +1166,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         tw.world.items.insert(floor_gem_id.clone(), floor_gem);
@@ -1249,7 +1258,7 @@ mod tests {
         assert!(
             !tw.world
                 .items
-                .get(&tx_data.vessel_id)
+                .get(&ItemId::from(tx_data.vessel_id.as_str()))
                 .unwrap()
                 .contents
                 .contains(&tx_data.loot_id)
@@ -1275,7 +1284,7 @@ mod tests {
         assert!(
             !tw.world
                 .npcs
-                .get(&tx_data.vessel_id)
+                .get(&NpcId::from(tx_data.vessel_id.as_str()))
                 .unwrap()
                 .inventory
                 .contains(&tx_data.loot_id)
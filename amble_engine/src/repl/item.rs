@@ -637,6 +637,9 @@ pub fn open_handler(world: &mut AmbleWorld, view: &mut View, pattern: &str) -> R
             _ => bail!(e),
         },
     };
+    if entity_search::ask_which_item(world, view, pattern, SearchScope::TouchableItems(room_id)) {
+        return Ok(false);
+    }
 
     // either show failure reasons, or set container state to open
     let mut container_opened = false;
@@ -1077,9 +1080,9 @@ mod tests {
             id: room_id.clone(),
             symbol: "r".into(),
             name: "Room".into(),
-            base_description: String::new(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            base_description: String::new().into(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -1095,7 +1098,7 @@ mod tests {
             id: container_id.clone(),
             symbol: "c".into(),
             name: "chest".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Room(room_id.clone()),
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -1105,7 +1108,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         container
@@ -1124,7 +1127,7 @@ mod tests {
             id: tool_id.clone(),
             symbol: "t".into(),
             name: "crowbar".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Inventory,
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -1134,7 +1137,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: [ItemAbility::Pry].into_iter().collect(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.player.inventory.insert(tool_id.clone());
@@ -1145,7 +1148,7 @@ mod tests {
             id: lamp_id.clone(),
             symbol: "l".into(),
             name: "lamp".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Room(room_id.clone()),
             container_state: None,
             visibility: crate::item::ItemVisibility::Listed,
@@ -1157,7 +1160,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: [ItemAbility::TurnOn].into_iter().collect(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.rooms.get_mut(&room_id).unwrap().contents.insert(lamp_id.clone());
@@ -1168,7 +1171,7 @@ mod tests {
             id: key_id.clone(),
             symbol: "k".into(),
             name: "key".into(),
-            description: String::new(),
+            description: String::new().into(),
             location: Location::Inventory,
             visibility: crate::item::ItemVisibility::Listed,
             visible_when: None,
@@ -1178,7 +1181,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: [ItemAbility::Unlock(Some(container_id.clone()))].into_iter().collect(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.player.inventory.insert(key_id.clone());
@@ -1197,8 +1200,9 @@ mod tests {
                 interaction: ItemInteractionType::Open,
                 target_id: container_id.clone(),
                 tool_id: tool_id.clone(),
-            }),
-            actions: vec![ScriptedAction::new(TriggerAction::UnlockItem(container_id.clone()))],
+            })
+            .into(),
+            actions: vec![ScriptedAction::new(TriggerAction::UnlockItem(container_id.clone()))].into(),
             only_once: false,
             fired: false,
         });
@@ -1223,8 +1227,9 @@ mod tests {
                 interaction: ItemInteractionType::Open,
                 target_id: container_id.clone(),
                 tool_id: tool_id.clone(),
-            }),
-            actions: vec![ScriptedAction::new(TriggerAction::UnlockItem(container_id.clone()))],
+            })
+            .into(),
+            actions: vec![ScriptedAction::new(TriggerAction::UnlockItem(container_id.clone()))].into(),
             only_once: false,
             fired: false,
         });
@@ -1243,8 +1248,9 @@ mod tests {
             conditions: EventCondition::Trigger(TriggerCondition::UseItem {
                 item_id: lamp_id.clone(),
                 ability: ItemAbility::TurnOn,
-            }),
-            actions: vec![ScriptedAction::new(TriggerAction::UnlockItem(container_id.clone()))],
+            })
+            .into(),
+            actions: vec![ScriptedAction::new(TriggerAction::UnlockItem(container_id.clone()))].into(),
             only_once: false,
             fired: false,
         });
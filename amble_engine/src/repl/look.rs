@@ -39,7 +39,9 @@
 
 use crate::{
     AmbleWorld, View, ViewItem, WorldObject,
-    entity_search::{EntityId, SearchError, SearchScope, entity_not_found, find_entity_match, find_item_match},
+    entity_search::{
+        EntityId, SearchError, SearchScope, ask_which_item, entity_not_found, find_entity_match, find_item_match,
+    },
     item::ItemAbility,
     room::{Room, RoomScenery},
     style::GameStyle,
@@ -105,6 +107,9 @@ pub fn look_at_handler(world: &mut AmbleWorld, view: &mut View, thing: &str) ->
         },
         Err(e) => bail!(e),
     };
+    if matches!(entity_id, EntityId::Item(_)) && ask_which_item(world, view, thing, SearchScope::AllVisible(room_id)) {
+        return Ok(false);
+    }
 
     match entity_id {
         EntityId::Item(item_id) => {
@@ -240,7 +245,7 @@ pub fn read_handler(world: &mut AmbleWorld, view: &mut View, pattern: &str) -> R
             .with_context(|| format!("item_id ({item_id}) not found in world items"))?;
 
         view.push(ViewItem::ItemText(
-            item.text.clone().unwrap_or_else(|| "(Nothing legible.)".to_string()),
+            item.text.as_deref().unwrap_or("(Nothing legible.)").to_string(),
         ));
         info!("{} read '{}' ({})", world.player.name(), item.name(), item.symbol());
     }
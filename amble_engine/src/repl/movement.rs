@@ -292,7 +292,11 @@ impl AccessDenial<'_> {
 
 /// Determines whether player's access to an exit is prevented
 fn exit_access_restriction<'a>(exit: &'a Exit, player: &'a Player) -> Option<AccessDenial<'a>> {
-    let unmet_flags: HashSet<_> = exit.required_flags.difference(&player.flags).collect();
+    let unmet_flags: HashSet<_> = exit
+        .required_flags
+        .iter()
+        .filter(|flag| !player.flags.contains(flag))
+        .collect();
     let unmet_items: HashSet<_> = exit.required_items.difference(&player.inventory).collect();
     if unmet_flags.is_empty() && unmet_items.is_empty() && !exit.locked {
         None
@@ -352,9 +356,9 @@ mod tests {
             id: start.clone(),
             symbol: "start".into(),
             name: "Start".into(),
-            base_description: String::new(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            base_description: String::new().into(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: true,
@@ -367,9 +371,9 @@ mod tests {
             id: dest.clone(),
             symbol: "dest".into(),
             name: "Dest".into(),
-            base_description: String::new(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            base_description: String::new().into(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -540,9 +544,9 @@ mod tests {
                 id: room_id.clone(),
                 symbol: format!("room_{short_id}"),
                 name: format!("Room {short_id}"),
-                base_description: String::new(),
-                overlays: vec![],
-                scenery: Vec::new(),
+                base_description: String::new().into(),
+                overlays: vec![].into(),
+                scenery: Vec::new().into(),
                 scenery_default: None,
                 location: Location::Nowhere,
                 visited: false,
@@ -577,9 +581,9 @@ mod tests {
             id: room3.clone(),
             symbol: "room3".into(),
             name: "Room3".into(),
-            base_description: String::new(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            base_description: String::new().into(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
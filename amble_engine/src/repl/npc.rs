@@ -163,7 +163,7 @@ pub fn talk_to_handler(world: &mut AmbleWorld, view: &mut View, npc_name: &str)
             .spinners
             .get(&crate::spinners::SpinnerType::Core(CoreSpinnerType::NpcIgnore))
     {
-        let dialogue = npc.random_dialogue(ignore_spinner);
+        let dialogue = npc.random_dialogue(&world.rng, ignore_spinner);
         view.push(ViewItem::NpcSpeech {
             speaker: npc.name.clone(),
             quote: dialogue.clone(),
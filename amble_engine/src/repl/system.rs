@@ -21,13 +21,15 @@
 //!
 //! # Save System
 //!
-//! The save system uses RON (Rusty Object Notation) format for human-readable
-//! and debuggable save files. Save files include version information to handle
+//! The save system writes a compact binary format by default, with a summary
+//! header so save listings don't need to decode the world. RON (Rusty Object
+//! Notation) remains available for human-readable, debuggable saves via
+//! `AMBLE_SAVE_FORMAT=ron`. Save files include version information to handle
 //! compatibility across game updates.
 //!
 //! ## Save File Format
 //! - **Location**: `saved_games/<world>/` directory
-//! - **Naming**: `{slot_name}-amble-{version}.ron`
+//! - **Naming**: `{slot_name}-amble-{version}.sav` (or `.ron`)
 //! - **Content**: Complete serialized `AmbleWorld` state
 //!
 //! ## Version Compatibility
@@ -59,15 +61,17 @@
 
 use colored::Colorize;
 use std::fs;
-use std::io::Write;
 use std::path::Path;
 
 use crate::data_paths::data_path;
 use crate::goal::GoalStatus;
+use crate::journal::AutosaveJournal;
 
 use crate::loader::help::{HelpCommand, load_help_data};
 use crate::loader::{discover_world_sources, set_active_world_path};
-use crate::save_files::{self, SAVE_DIR, save_dir_for_world, set_active_save_dir};
+use crate::save_files::{
+    self, SAVE_DIR, active_save_format, save_dir_for_world, save_file_name, set_active_save_dir, write_save_file,
+};
 use crate::style::GameStyle;
 use crate::theme::THEME_MANAGER;
 
@@ -76,7 +80,7 @@ use crate::{AMBLE_VERSION, Goal, RoomId, View, ViewItem, WorldSource};
 use crate::{AmbleWorld, WorldObject, repl::ReplControl};
 
 use anyhow::{Context, Result};
-use log::{info, warn};
+use log::{debug, info, warn};
 
 /// Changes the display verbosity and screen clearing behavior.
 ///
@@ -309,6 +313,14 @@ pub fn help_handler_dev(view: &mut View) {
                     command: ":set-flag <name>".into(),
                     description: "DEV: Create a simple flag on the player.".into(),
                 },
+                HelpCommand {
+                    command: ":profile [on|off|reset|report]".into(),
+                    description: "DEV: Toggle the trigger profiler or show its hottest triggers.".into(),
+                },
+                HelpCommand {
+                    command: ":reload".into(),
+                    description: "DEV: Reload the recompiled world file, keeping the current game state.".into(),
+                },
                 HelpCommand {
                     command: ":init-seq <name> <end|none>".into(),
                     description: "DEV: Create a sequence flag with limit or unlimited (none).".into(),
@@ -448,7 +460,7 @@ pub fn filtered_goals(world: &AmbleWorld, status: GoalStatus) -> Vec<&Goal> {
 ///
 /// # Save File Location
 ///
-/// Files are loaded from: `saved_games/<world>/{gamefile}-amble-{version}.ron`
+/// Files are loaded from: `saved_games/<world>/{gamefile}-amble-{version}.sav` (or `.ron`)
 ///
 /// # Version Compatibility
 ///
@@ -505,80 +517,71 @@ pub fn load_handler(world: &mut AmbleWorld, view: &mut View, gamefile: &str) ->
     let (load_path, loaded_version_hint) = if let Some(slot) = chosen_slot {
         (slot.path.clone(), Some(slot.version))
     } else {
-        (save_dir.join(format!("{gamefile}-amble-{AMBLE_VERSION}.ron")), None)
+        (save_dir.join(save_file_name(gamefile, active_save_format())), None)
     };
 
-    match fs::read_to_string(load_path.as_path()) {
-        Ok(world_ron) => match ron::from_str::<AmbleWorld>(&world_ron) {
-            Ok(new_world) => {
-                if new_world.version != AMBLE_VERSION {
-                    warn!(
-                        "player loaded '{gamefile}' (v{}), current version is v{AMBLE_VERSION}",
-                        new_world.version
-                    );
-                    view.push(ViewItem::Error(format!(
-                        "{}: '{gamefile}' version is v{} -- does not match current game (v{AMBLE_VERSION}).",
-                        "WARNING".bold().yellow(),
-                        new_world.version.error_style(),
-                    )));
-                } else if let Some(original_version) = loaded_version_hint.filter(|version| version != AMBLE_VERSION) {
-                    info!(
-                        "Loaded '{gamefile}' saved under v{original_version}, metadata indicates current version match."
-                    );
-                }
-                if let Ok(sources) = discover_world_sources()
-                    && let Some(source) = match_world_source(&new_world, &sources)
-                {
-                    set_active_world_path(source.path.clone());
-                }
-                set_active_save_dir(save_dir_for_world(&new_world));
-                *world = new_world;
-                view.push(ViewItem::ActionSuccess(format!(
-                    "Saved game {} (v{}) loaded successfully. Sally forth.",
-                    gamefile.underline().green(),
-                    world.version.highlight()
-                )));
-                view.push(ViewItem::GameLoaded {
-                    save_slot: gamefile.to_string(),
-                    save_file: load_path.to_string_lossy().to_string(),
-                });
-                info!(
-                    "Player reloaded AmbleWorld from file '{}' (version {})",
-                    load_path.display(),
-                    world.version
+    match save_files::load_save_file(&load_path) {
+        Ok(new_world) => {
+            if new_world.version != AMBLE_VERSION {
+                warn!(
+                    "player loaded '{gamefile}' (v{}), current version is v{AMBLE_VERSION}",
+                    new_world.version
                 );
-                true
-            },
-            Err(err) => {
-                log_and_report_failed_parse(view, gamefile, &load_path, err);
-                false
-            },
+                view.push(ViewItem::Error(format!(
+                    "{}: '{gamefile}' version is v{} -- does not match current game (v{AMBLE_VERSION}).",
+                    "WARNING".bold().yellow(),
+                    new_world.version.error_style(),
+                )));
+            } else if let Some(original_version) = loaded_version_hint.filter(|version| version != AMBLE_VERSION) {
+                info!("Loaded '{gamefile}' saved under v{original_version}, metadata indicates current version match.");
+            }
+            if let Ok(sources) = discover_world_sources()
+                && let Some(source) = match_world_source(&new_world, &sources)
+            {
+                set_active_world_path(source.path.clone());
+            }
+            set_active_save_dir(save_dir_for_world(&new_world));
+            *world = new_world;
+            view.push(ViewItem::ActionSuccess(format!(
+                "Saved game {} (v{}) loaded successfully. Sally forth.",
+                gamefile.underline().green(),
+                world.version.highlight()
+            )));
+            view.push(ViewItem::GameLoaded {
+                save_slot: gamefile.to_string(),
+                save_file: load_path.to_string_lossy().to_string(),
+            });
+            info!(
+                "Player reloaded AmbleWorld from file '{}' (version {})",
+                load_path.display(),
+                world.version
+            );
+            true
         },
         Err(err) => {
-            log_and_report_failed_load(view, gamefile, load_path, err);
+            if let Some(io_err) = err.downcast_ref::<std::io::Error>() {
+                log_and_report_failed_load(view, gamefile, &load_path, io_err);
+            } else {
+                log_and_report_failed_parse(view, gamefile, &load_path, &err);
+            }
             false
         },
     }
 }
 
-fn log_and_report_failed_parse(
-    view: &mut View,
-    gamefile: &str,
-    load_path: &std::path::PathBuf,
-    err: ron::de::SpannedError,
-) {
+fn log_and_report_failed_parse(view: &mut View, gamefile: &str, load_path: &std::path::PathBuf, err: &anyhow::Error) {
     view.push(ViewItem::ActionFailure(format!(
-        "Unable to load the {} save file. The Amble engine may have changed since it was created ({}).",
+        "Unable to load the {} save file. The Amble engine may have changed since it was created ({:#}).",
         gamefile.error_style(),
         err
     )));
     warn!(
-        "player attempted to load '{gamefile}' from '{}': parse failure ({err})",
+        "player attempted to load '{gamefile}' from '{}': parse failure ({err:#})",
         load_path.display()
     );
 }
 
-fn log_and_report_failed_load(view: &mut View, gamefile: &str, load_path: std::path::PathBuf, err: std::io::Error) {
+fn log_and_report_failed_load(view: &mut View, gamefile: &str, load_path: &std::path::PathBuf, err: &std::io::Error) {
     if err.kind() == std::io::ErrorKind::NotFound {
         view.push(ViewItem::Error(format!(
             "Unable to find {} save file. Load aborted. Type {} to list available saves.",
@@ -613,9 +616,9 @@ fn match_world_source<'a>(world: &AmbleWorld, sources: &'a [WorldSource]) -> Opt
 
 /// Saves the current game state to a persistent file on disk.
 ///
-/// This handler serializes the complete game world state using RON format
-/// and writes it to a versioned save file. The save system creates organized
-/// storage with version compatibility information.
+/// This handler serializes the complete game world state in the active save
+/// format and streams it to a versioned save file. The save system creates
+/// organized storage with version compatibility information.
 ///
 /// # Parameters
 ///
@@ -630,16 +633,15 @@ fn match_world_source<'a>(world: &AmbleWorld, sources: &'a [WorldSource]) -> Opt
 /// # Save File Organization
 ///
 /// - **Directory**: `saved_games/<world>/` (created if it doesn't exist)
-/// - **Filename**: `{gamefile}-amble-{version}.ron`
-/// - **Format**: RON (Rusty Object Notation) for human readability
+/// - **Filename**: `{gamefile}-amble-{version}.sav` (or `.ron`)
+/// - **Format**: compact binary by default; RON when `AMBLE_SAVE_FORMAT=ron`
 ///
 /// # Serialization Process
 ///
-/// 1. **World serialization** - Convert complete world state to RON format
-/// 2. **Directory creation** - Ensure save directory exists
-/// 3. **File creation** - Create versioned save file
-/// 4. **Data writing** - Write serialized world to file
-/// 5. **Confirmation** - Display success message with file details
+/// 1. **Directory creation** - Ensure save directory exists
+/// 2. **File creation** - Create versioned save file
+/// 3. **Data writing** - Stream the serialized world through a buffered writer
+/// 4. **Confirmation** - Display success message with file details
 ///
 /// # Errors
 ///
@@ -659,29 +661,18 @@ fn match_world_source<'a>(world: &AmbleWorld, sources: &'a [WorldSource]) -> Opt
 ///
 /// # File Format
 ///
-/// RON format provides:
-/// - Human-readable save files for debugging
-/// - Efficient serialization/deserialization
-/// - Version compatibility metadata
-/// - Complete world state preservation
+/// Binary saves begin with a small header (engine version, world, player,
+/// location, turn and score) so save listings can be built without decoding
+/// the world. RON saves are human-readable for debugging.
 pub fn save_handler(world: &AmbleWorld, view: &mut View, gamefile: &str) -> Result<()> {
-    // serialize the current AmbleWorld state to RON format
-    let world_ron =
-        ron::ser::to_string(world).with_context(|| "error converting AmbleWorld to 'ron' format".to_string())?;
-
     // create save dir if doesn't exist
     let save_dir = save_dir_for_world(world);
     fs::create_dir_all(&save_dir).with_context(|| "error creating saved_games folder".to_string())?;
 
-    // create save file
-    let save_path = save_dir.join(format!("{gamefile}-amble-{AMBLE_VERSION}.ron"));
-    let mut save_file =
-        fs::File::create(save_path.as_path()).with_context(|| format!("creating file '{}'", save_path.display()))?;
-
-    // write world to file
-    save_file
-        .write_all(world_ron.as_bytes())
-        .with_context(|| "failed to write AmbleWorld to .ron file".to_string())?;
+    // stream world to save file
+    let format = active_save_format();
+    let save_path = save_dir.join(save_file_name(gamefile, format));
+    write_save_file(world, &save_path, format)?;
 
     // disco!
     view.push(ViewItem::GameSaved {
@@ -696,24 +687,16 @@ pub fn save_handler(world: &AmbleWorld, view: &mut View, gamefile: &str) -> Resu
     Ok(())
 }
 
-/// Silent save used for autosaves; writes the world state without emitting view messages.
+/// Silent save used for autosaves; records the world state without emitting view messages.
+///
+/// Each call appends the turn's changes to the autosave journal, which compacts
+/// itself into a full snapshot periodically (see [`crate::journal`]).
 ///
 /// # Errors
-/// - propagates any errors from RON serializer or file I/O
-pub fn autosave_quiet(world: &AmbleWorld, gamefile: &str) -> Result<()> {
-    let world_ron =
-        ron::ser::to_string(world).with_context(|| "error converting AmbleWorld to 'ron' format".to_string())?;
-
-    let save_dir = save_dir_for_world(world);
-    fs::create_dir_all(&save_dir).with_context(|| "error creating saved_games folder".to_string())?;
-
-    let save_path = save_dir.join(format!("{gamefile}-amble-{AMBLE_VERSION}.ron"));
-    let mut save_file =
-        fs::File::create(save_path.as_path()).with_context(|| format!("creating file '{}'", save_path.display()))?;
-    save_file
-        .write_all(world_ron.as_bytes())
-        .with_context(|| "failed to write AmbleWorld to .ron file".to_string())?;
-    info!("Autosaved game to \"{gamefile}\"");
+/// - propagates any errors from the save serializer or file I/O
+pub fn autosave_quiet(world: &mut AmbleWorld, journal: &mut AutosaveJournal) -> Result<()> {
+    journal.autosave(world)?;
+    debug!("Autosaved game (turn {})", world.turn_count);
     Ok(())
 }
 
@@ -822,7 +805,7 @@ mod tests {
 
         // Create test world with custom scoring
         let mut world = AmbleWorld::new_empty();
-        world.scoring = custom_scoring;
+        world.scoring = custom_scoring.into();
         world.player.score = 60;
         world.max_score = 100;
 
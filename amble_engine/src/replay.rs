@@ -0,0 +1,313 @@
+//! Scripted transcript replay.
+//!
+//! A transcript is a fixed sequence of player commands. [`replay`] runs one
+//! headlessly through a [`Session`] (the same parse/dispatch pipeline as the
+//! REPL) and records how long each turn took and, when [`CountingAllocator`] is
+//! the global allocator, how many heap allocations it made. The rendered output
+//! can be compared against a golden copy to catch behavior changes.
+//!
+//! ## Transcript format
+//! One command per line. Blank lines and lines starting with `#` are ignored,
+//! except for a `# seed: <n>` directive, which seeds the world RNG before the
+//! first command so chance triggers, spinners and NPC moves replay identically.
+//!
+//! ```text
+//! # seed: 42
+//! look
+//! go up the steps
+//! ```
+
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::fmt::Write as _;
+use std::fs;
+use std::path::Path;
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::time::{Duration, Instant};
+
+use anyhow::{Context, Result};
+
+use crate::session::Session;
+use crate::world::AmbleWorld;
+
+/// A parsed transcript.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct Transcript {
+    /// World RNG seed from a `# seed:` directive, if any.
+    pub seed: Option<u64>,
+    /// Commands, in order.
+    pub commands: Vec<String>,
+}
+
+impl Transcript {
+    /// Parse transcript text.
+    ///
+    /// # Errors
+    /// Returns an error if a `# seed:` directive does not hold an integer.
+    pub fn parse(text: &str) -> Result<Self> {
+        let mut transcript = Transcript::default();
+        for (idx, line) in text.lines().enumerate() {
+            let line = line.trim();
+            if let Some(comment) = line.strip_prefix('#') {
+                if let Some(seed) = comment.trim().strip_prefix("seed:") {
+                    let seed = seed
+                        .trim()
+                        .parse()
+                        .with_context(|| format!("line {}: invalid seed '{}'", idx + 1, seed.trim()))?;
+                    transcript.seed = Some(seed);
+                }
+            } else if !line.is_empty() {
+                transcript.commands.push(line.to_string());
+            }
+        }
+        Ok(transcript)
+    }
+
+    /// Read and parse the transcript at `path`.
+    ///
+    /// # Errors
+    /// Returns an error if the file cannot be read or parsed.
+    pub fn load(path: &Path) -> Result<Self> {
+        let text = fs::read_to_string(path).with_context(|| format!("reading transcript {}", path.display()))?;
+        Self::parse(&text).with_context(|| format!("parsing transcript {}", path.display()))
+    }
+}
+
+/// Measurements for one replayed command.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct TurnStats {
+    /// The command as written in the transcript.
+    pub command: String,
+    /// Wall time spent processing the command (parse, dispatch, events, rendering).
+    pub elapsed: Duration,
+    /// Heap allocations made while processing, if allocations are being counted.
+    pub allocations: Option<u64>,
+    /// Turn number after the command.
+    pub turn: usize,
+    /// Score after the command.
+    pub score: usize,
+}
+
+/// Result of replaying a transcript.
+#[derive(Debug, Clone, Default)]
+pub struct ReplayReport {
+    /// Title of the world the transcript ran against.
+    pub world_title: String,
+    /// Seed the transcript was written against, if it recorded one.
+    pub seed: Option<u64>,
+    /// One entry per command that ran.
+    pub turns: Vec<TurnStats>,
+    /// Total wall time for all commands.
+    pub total: Duration,
+    /// Rendered output: each command as `> command`, followed by its frame text.
+    pub output: String,
+    /// True if the replay stopped early because the player died or quit.
+    pub ended_early: bool,
+}
+
+impl ReplayReport {
+    /// Total allocations across all turns, if allocations were counted.
+    pub fn total_allocations(&self) -> Option<u64> {
+        self.turns.iter().map(|turn| turn.allocations).sum()
+    }
+
+    /// Compare the rendered output with `expected`.
+    pub fn diff_golden(&self, expected: &str) -> Option<GoldenMismatch> {
+        diff_lines(expected, &self.output)
+    }
+
+    /// Human-readable summary; `per_turn` adds a line for every command.
+    pub fn summary(&self, per_turn: bool) -> String {
+        let mut out = String::new();
+        if per_turn {
+            let _ = writeln!(out, "{:>5} {:>10} {:>8}  command", "turn", "time", "allocs");
+            for turn in &self.turns {
+                let allocs = turn.allocations.map_or_else(|| "-".to_string(), |n| n.to_string());
+                let _ = writeln!(
+                    out,
+                    "{:>5} {:>10.2?} {:>8}  {}",
+                    turn.turn, turn.elapsed, allocs, turn.command
+                );
+            }
+        }
+        let count = u32::try_from(self.turns.len().max(1)).unwrap_or(u32::MAX);
+        let slowest = self.turns.iter().max_by_key(|turn| turn.elapsed);
+        let _ = writeln!(
+            out,
+            "replayed {} commands against \"{}\" in {:.2?} (mean {:.2?}/turn)",
+            self.turns.len(),
+            self.world_title,
+            self.total,
+            self.total / count
+        );
+        if let Some(slowest) = slowest {
+            let _ = writeln!(out, "slowest: \"{}\" at {:.2?}", slowest.command, slowest.elapsed);
+        }
+        if let Some(total) = self.total_allocations() {
+            let _ = writeln!(out, "allocations: {total} total, {} per turn", total / u64::from(count));
+        }
+        if self.ended_early {
+            let _ = writeln!(out, "transcript ended early: the player died or quit");
+        }
+        out
+    }
+}
+
+/// First difference between golden and actual replay output.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct GoldenMismatch {
+    /// 1-based line number of the first differing line.
+    pub line: usize,
+    /// Golden line (`None` if the golden output ended first).
+    pub expected: Option<String>,
+    /// Actual line (`None` if the actual output ended first).
+    pub actual: Option<String>,
+}
+
+fn diff_lines(expected: &str, actual: &str) -> Option<GoldenMismatch> {
+    let mut expected_lines = expected.lines();
+    let mut actual_lines = actual.lines();
+    let mut line = 0;
+    loop {
+        line += 1;
+        match (expected_lines.next(), actual_lines.next()) {
+            (None, None) => return None,
+            (e, a) if e == a => {},
+            (e, a) => {
+                return Some(GoldenMismatch {
+                    line,
+                    expected: e.map(str::to_string),
+                    actual: a.map(str::to_string),
+                });
+            },
+        }
+    }
+}
+
+/// Replay `transcript` on `world`, stopping early if the player dies or quits.
+///
+/// If the transcript carries a seed, the world RNG is reseeded with it first.
+///
+/// # Errors
+/// Returns an error if a command fails to process.
+pub fn replay(world: AmbleWorld, transcript: &Transcript) -> Result<ReplayReport> {
+    if let Some(seed) = transcript.seed {
+        world.rng.reseed(seed);
+    }
+    let mut report = ReplayReport {
+        world_title: world.game_title.clone(),
+        seed: transcript.seed,
+        ..ReplayReport::default()
+    };
+    let mut session = Session::new(world);
+    let mut frame_text = String::new();
+    for command in &transcript.commands {
+        frame_text.clear();
+        let allocations_before = allocation_count();
+        let start = Instant::now();
+        let frame = session
+            .send_rendered(command, &mut frame_text)
+            .with_context(|| format!("replaying \"{command}\""))?;
+        let elapsed = start.elapsed();
+        let allocations = allocation_count()
+            .zip(allocations_before)
+            .map(|(after, before)| after - before);
+
+        report.total += elapsed;
+        report.turns.push(TurnStats {
+            command: command.clone(),
+            elapsed,
+            allocations,
+            turn: frame.turn,
+            score: frame.score,
+        });
+        let _ = writeln!(report.output, "> {command}");
+        report.output.push_str(&frame_text);
+        if frame.player_died || frame.quit {
+            report.ended_early = true;
+            break;
+        }
+    }
+    Ok(report)
+}
+
+/// Load the world at `world_path` and replay the transcript at `transcript_path` on it.
+///
+/// # Errors
+/// Returns an error if either file cannot be loaded or a command fails.
+pub fn replay_file(world_path: &Path, transcript_path: &Path) -> Result<ReplayReport> {
+    let transcript = Transcript::load(transcript_path)?;
+    let world = crate::loader::load_world_from_path(world_path)
+        .with_context(|| format!("loading world {}", world_path.display()))?;
+    replay(world, &transcript)
+}
+
+static ALLOCATIONS: AtomicU64 = AtomicU64::new(0);
+static COUNTING: AtomicBool = AtomicBool::new(false);
+
+/// Global allocator wrapper that counts allocations for replay reports.
+///
+/// Install it in a binary or benchmark to have per-turn allocation counts reported:
+///
+/// ```ignore
+/// #[global_allocator]
+/// static ALLOC: amble_engine::replay::CountingAllocator = amble_engine::replay::CountingAllocator;
+/// ```
+pub struct CountingAllocator;
+
+// SAFETY: defers all allocation to `System`; the counters are plain atomics.
+unsafe impl GlobalAlloc for CountingAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        COUNTING.store(true, Ordering::Relaxed);
+        // SAFETY: the caller upholds `GlobalAlloc::alloc`'s contract.
+        unsafe { System.alloc(layout) }
+    }
+
+    unsafe fn alloc_zeroed(&self, layout: Layout) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        COUNTING.store(true, Ordering::Relaxed);
+        // SAFETY: as above.
+        unsafe { System.alloc_zeroed(layout) }
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        // SAFETY: as above.
+        unsafe { System.realloc(ptr, layout, new_size) }
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        // SAFETY: as above.
+        unsafe { System.dealloc(ptr, layout) }
+    }
+}
+
+/// Allocations made so far, or `None` if [`CountingAllocator`] is not installed.
+pub fn allocation_count() -> Option<u64> {
+    COUNTING
+        .load(Ordering::Relaxed)
+        .then(|| ALLOCATIONS.load(Ordering::Relaxed))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn transcript_skips_comments_and_reads_seed() {
+        let transcript = Transcript::parse("# demo walkthrough\n# seed: 7\n\nlook\n  go north  \n").unwrap();
+        assert_eq!(transcript.seed, Some(7));
+        assert_eq!(transcript.commands, vec!["look", "go north"]);
+        assert!(Transcript::parse("# seed: soon").is_err());
+    }
+
+    #[test]
+    fn golden_diff_reports_first_differing_line() {
+        assert_eq!(diff_lines("a\nb\n", "a\nb\n"), None);
+        let mismatch = diff_lines("a\nb\n", "a\nc\nd\n").unwrap();
+        assert_eq!(mismatch.line, 2);
+        assert_eq!(mismatch.expected.as_deref(), Some("b"));
+        assert_eq!(mismatch.actual.as_deref(), Some("c"));
+        assert_eq!(diff_lines("a\n", "a\nb\n").unwrap().expected, None);
+    }
+}
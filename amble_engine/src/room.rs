@@ -6,12 +6,13 @@
 //! Captures room metadata, exits, and overlays along with helpers used
 //! during movement, rendering, and trigger evaluation.
 
+use crate::content::Shared;
 use crate::{Id, ItemId, NpcId, RoomId};
 use crate::{
     ItemHolder, Location, View, ViewItem, WorldObject,
     health::{LifeState, LivingEntity},
     npc::NpcState,
-    player::Flag,
+    player::{Flag, FlagRef},
     view::{ExitLine, NpcLine, ViewMode},
     world::{AmbleWorld, item_is_listed, item_is_visible},
 };
@@ -73,9 +74,9 @@ impl RoomOverlay {
 #[derive(Debug, Clone, Serialize, Deserialize)]
 #[serde(rename_all = "camelCase")]
 pub enum OverlayCondition {
-    FlagComplete { flag: String },
-    FlagSet { flag: String },
-    FlagUnset { flag: String },
+    FlagComplete { flag: FlagRef },
+    FlagSet { flag: FlagRef },
+    FlagUnset { flag: FlagRef },
     ItemAbsent { item_id: ItemId },
     ItemInRoom { item_id: ItemId, room_id: RoomId },
     ItemPresent { item_id: ItemId },
@@ -88,18 +89,10 @@ pub enum OverlayCondition {
 impl OverlayCondition {
     /// Returns true if this condition currently applies.
     pub fn applies(&self, room_id: &RoomId, world: &AmbleWorld) -> bool {
-        let flag_is_set = |flag_str: &str| world.player.flags.iter().any(|f| f.value() == *flag_str);
         match &self {
-            OverlayCondition::FlagComplete { flag } => world
-                .player
-                .flags
-                .get(&Flag::Simple {
-                    name: flag.into(),
-                    turn_set: 0,
-                })
-                .is_some_and(Flag::is_complete),
-            OverlayCondition::FlagSet { flag } => flag_is_set(flag),
-            OverlayCondition::FlagUnset { flag } => !flag_is_set(flag),
+            OverlayCondition::FlagComplete { flag } => world.player.flags.is_complete(flag),
+            OverlayCondition::FlagSet { flag } => world.player.flags.is_set(flag),
+            OverlayCondition::FlagUnset { flag } => !world.player.flags.is_set(flag),
             OverlayCondition::ItemPresent { item_id } => world
                 .items
                 .get(item_id)
@@ -133,10 +126,12 @@ pub struct Room {
     pub id: RoomId,
     pub symbol: String,
     pub name: String,
-    pub base_description: String,
-    pub overlays: Vec<RoomOverlay>,
-    #[serde(default)]
-    pub scenery: Vec<RoomScenery>,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub base_description: Shared<String>,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub overlays: Shared<Vec<RoomOverlay>>,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub scenery: Shared<Vec<RoomScenery>>,
     #[serde(default)]
     pub scenery_default: Option<String>,
     pub location: Location,
@@ -297,8 +292,8 @@ mod tests {
             symbol: "test_room".into(),
             name: "Test Room".into(),
             base_description: "A test room for testing".into(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -331,7 +326,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         };
         world.items.insert(item_id.clone(), item);
@@ -344,7 +339,7 @@ mod tests {
             description: "A test NPC".into(),
             location: Location::Room(room_id.clone()),
             inventory: HashSet::new(),
-            dialogue: HashMap::new(),
+            dialogue: HashMap::new().into(),
             state: NpcState::Normal,
             movement: None,
             health: HealthState::new_at_max(10),
@@ -2,20 +2,99 @@
 //!
 //! Provides file management utilities for listing, loading, and writing
 //! player save slots with version awareness.
+//!
+//! Saves are written in one of two formats, chosen by file extension:
+//! - `.sav` (default): a compact binary format. A fixed header (magic bytes,
+//!   header format version, header length) is followed by a [`SaveHeader`]
+//!   carrying the engine version and a [`SaveSummary`], then the CBOR-encoded
+//!   world. Save listings read only the header.
+//! - `.ron`: the human-readable RON format, kept for debugging. Select it for new
+//!   saves with `AMBLE_SAVE_FORMAT=ron`.
+//!
+//! Both formats stream directly to a buffered file writer and are written
+//! atomically (temporary file + rename). RON saves also get a small summary
+//! sidecar (`.ron-summary`) so listings don't need to parse them.
+//!
+//! Save listings resolve each file's summary from, in order: an in-process cache
+//! keyed by path, size and mtime; the binary header or RON sidecar; and finally a
+//! full parse, run in parallel across any saves that have no summary.
+//!
+//! Autosaves may be extended by an append-only journal (see [`crate::journal`]),
+//! which [`load_save_file`] replays automatically. Listings show the summary of
+//! the snapshot itself.
 
+use crate::journal;
 use crate::slug::sanitize_slug;
 use crate::{AMBLE_VERSION, AmbleWorld, Location, WorldObject};
-use anyhow::{Context, Result};
-use log::warn;
-use std::fs;
+use anyhow::{Context, Result, bail};
+use log::{info, warn};
+use serde::{Deserialize, Serialize};
+use std::collections::HashMap;
+use std::fs::{self, File};
+use std::io::{BufReader, BufWriter, Read, Write};
+use std::num::NonZeroUsize;
 use std::path::{Path, PathBuf};
 use std::sync::{LazyLock, RwLock};
+use std::thread;
 use std::time::{Duration, SystemTime};
 
 pub const SAVE_DIR: &str = "saved_games";
 pub const LOG_DIR: &str = "logs";
 
+/// Magic bytes at the start of every binary save file.
+const SAVE_MAGIC: &[u8; 8] = b"AMBLESAV";
+/// Layout version of the binary save header; bump when the header changes shape.
+pub const SAVE_HEADER_VERSION: u16 = 1;
+/// Upper bound on the encoded header size, to reject garbage before allocating.
+const MAX_HEADER_LEN: u32 = 64 * 1024;
+
 static ACTIVE_SAVE_DIR: LazyLock<RwLock<PathBuf>> = LazyLock::new(|| RwLock::new(PathBuf::from(SAVE_DIR)));
+static SUMMARY_CACHE: LazyLock<RwLock<HashMap<PathBuf, CachedHeader>>> = LazyLock::new(|| RwLock::new(HashMap::new()));
+static ACTIVE_SAVE_FORMAT: LazyLock<RwLock<SaveFormat>> = LazyLock::new(|| {
+    let format = std::env::var("AMBLE_SAVE_FORMAT")
+        .ok()
+        .and_then(|raw| SaveFormat::from_name(&raw))
+        .unwrap_or_default();
+    RwLock::new(format)
+});
+
+/// On-disk encoding of a save file.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub enum SaveFormat {
+    /// Compact binary format with a summary header (`.sav`).
+    #[default]
+    Binary,
+    /// Human-readable RON, useful for debugging (`.ron`).
+    Ron,
+}
+
+impl SaveFormat {
+    /// File extension used for saves in this format.
+    pub fn extension(self) -> &'static str {
+        match self {
+            SaveFormat::Binary => "sav",
+            SaveFormat::Ron => "ron",
+        }
+    }
+
+    /// Determine the format of a save file from its extension.
+    pub fn from_path(path: &Path) -> Option<Self> {
+        match path.extension().and_then(|ext| ext.to_str()) {
+            Some("sav") => Some(SaveFormat::Binary),
+            Some("ron") => Some(SaveFormat::Ron),
+            _ => None,
+        }
+    }
+
+    /// Parse a format name as accepted by `AMBLE_SAVE_FORMAT` ("binary"/"sav" or "ron").
+    pub fn from_name(name: &str) -> Option<Self> {
+        match name.trim() {
+            n if n.eq_ignore_ascii_case("binary") || n.eq_ignore_ascii_case("sav") => Some(SaveFormat::Binary),
+            n if n.eq_ignore_ascii_case("ron") => Some(SaveFormat::Ron),
+            _ => None,
+        }
+    }
+}
 
 #[derive(Debug, Clone, PartialEq, Eq)]
 pub struct SaveSlot {
@@ -24,9 +103,11 @@ pub struct SaveSlot {
     pub path: PathBuf,
     pub file_name: String,
     pub modified: Option<SystemTime>,
+    /// File size in bytes (0 if unavailable).
+    pub len: u64,
 }
 
-#[derive(Debug, Clone, PartialEq, Eq)]
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
 pub struct SaveSummary {
     pub world_title: String,
     pub world_slug: String,
@@ -37,6 +118,46 @@ pub struct SaveSummary {
     pub score: usize,
 }
 
+/// Metadata stored at the front of a binary save, readable without the world body.
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+pub struct SaveHeader {
+    pub engine_version: String,
+    pub summary: SaveSummary,
+}
+
+impl SaveHeader {
+    /// Build the header describing `world`.
+    pub fn for_world(world: &AmbleWorld) -> Self {
+        SaveHeader {
+            engine_version: world.version.clone(),
+            summary: summarize_world(world),
+        }
+    }
+}
+
+/// Summary sidecar stored next to RON saves.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+struct SaveSidecar {
+    /// Size of the save file the sidecar describes; a mismatch marks the sidecar stale.
+    save_len: u64,
+    /// Modification time of the save file it describes, so a rewrite of the same size
+    /// is caught too. Sidecars written before this was recorded have none and are stale.
+    #[serde(default)]
+    save_modified: Option<SystemTime>,
+    header: SaveHeader,
+}
+
+/// Outcome of resolving a save's header: the header, or a message for the listing.
+type HeaderResult = std::result::Result<SaveHeader, String>;
+
+/// Cached header lookup, valid while the file's size and mtime are unchanged.
+#[derive(Debug, Clone)]
+struct CachedHeader {
+    len: u64,
+    modified: SystemTime,
+    header: HeaderResult,
+}
+
 #[derive(Debug, Clone, PartialEq, Eq)]
 pub enum SaveFileStatus {
     Ready,
@@ -69,6 +190,25 @@ pub fn set_active_save_dir(path: PathBuf) {
     }
 }
 
+/// Return the format used for new saves.
+pub fn active_save_format() -> SaveFormat {
+    ACTIVE_SAVE_FORMAT
+        .read()
+        .map_or_else(|_| SaveFormat::default(), |guard| *guard)
+}
+
+/// Set the format used for new saves.
+pub fn set_active_save_format(format: SaveFormat) {
+    if let Ok(mut guard) = ACTIVE_SAVE_FORMAT.write() {
+        *guard = format;
+    }
+}
+
+/// File name for `slot` saved by the running engine version in `format`.
+pub fn save_file_name(slot: &str, format: SaveFormat) -> String {
+    format!("{slot}-amble-{AMBLE_VERSION}.{}", format.extension())
+}
+
 /// Compute a world-specific save directory based on the world's metadata.
 pub fn save_dir_for_world(world: &AmbleWorld) -> PathBuf {
     let raw = if !world.world_slug.trim().is_empty() {
@@ -144,9 +284,7 @@ pub fn collect_save_slots_recursive(root: &Path) -> Result<Vec<SaveSlot>> {
 /// Returns an error if reading the directory or loading a save slot fails.
 pub fn build_save_entries(dir: &Path) -> Result<Vec<SaveFileEntry>> {
     let slots = collect_save_slots(dir)?;
-    let mut entries: Vec<_> = slots.into_iter().map(entry_for_slot).collect();
-    entries.sort_by(|a, b| b.modified.cmp(&a.modified).then(a.slot.cmp(&b.slot)));
-    Ok(entries)
+    Ok(entries_for_slots(slots))
 }
 
 /// Build descriptive entries for save files located in a root directory and its subfolders.
@@ -155,18 +293,160 @@ pub fn build_save_entries(dir: &Path) -> Result<Vec<SaveFileEntry>> {
 /// Returns an error if reading the directory or loading a save slot fails.
 pub fn build_save_entries_recursive(root: &Path) -> Result<Vec<SaveFileEntry>> {
     let slots = collect_save_slots_recursive(root)?;
-    let mut entries: Vec<_> = slots.into_iter().map(entry_for_slot).collect();
-    entries.sort_by(|a, b| b.modified.cmp(&a.modified).then(a.slot.cmp(&b.slot)));
-    Ok(entries)
+    Ok(entries_for_slots(slots))
 }
 
 /// Load a save file from disk and deserialize its world state.
 ///
+/// The format is chosen from the file extension; binary saves have their header
+/// validated and skipped before the world body is decoded. If an autosave journal
+/// extends the save, its complete records are replayed on top of the snapshot.
+/// Saves omit the descriptions, dialogue and rules still unchanged from the world's
+/// content template, and those are restored from it here (see [`crate::content`]).
+/// Rooms, items and NPCs are not split that way: their records are saved in full.
+///
 /// # Errors
-/// Returns an error if the file cannot be read or deserialized.
+/// Returns an error if the file cannot be read or deserialized, or if its world's
+/// content cannot be found.
 pub fn load_save_file(path: &Path) -> Result<AmbleWorld> {
-    let raw = fs::read_to_string(path).with_context(|| format!("reading save file {}", path.display()))?;
-    ron::from_str::<AmbleWorld>(&raw).with_context(|| format!("parsing save file {}", path.display()))
+    let mut world = read_snapshot(path)?;
+    match journal::replay_journal(&mut world, path) {
+        Ok(0) => {},
+        Ok(applied) => info!("replayed {applied} autosave journal record(s) for {}", path.display()),
+        Err(err) => warn!("skipping autosave journal for {}: {err:#}", path.display()),
+    }
+    crate::content::rehydrate(&mut world).with_context(|| format!("restoring content for {}", path.display()))?;
+    Ok(world)
+}
+
+fn read_snapshot(path: &Path) -> Result<AmbleWorld> {
+    match SaveFormat::from_path(path).unwrap_or_default() {
+        SaveFormat::Ron => {
+            let raw = fs::read_to_string(path).with_context(|| format!("reading save file {}", path.display()))?;
+            ron::from_str::<AmbleWorld>(&raw).with_context(|| format!("parsing save file {}", path.display()))
+        },
+        SaveFormat::Binary => {
+            let file = File::open(path).with_context(|| format!("reading save file {}", path.display()))?;
+            let mut reader = BufReader::new(file);
+            read_header(&mut reader).with_context(|| format!("reading header of save file {}", path.display()))?;
+            ciborium::from_reader::<AmbleWorld, _>(&mut reader)
+                .with_context(|| format!("parsing save file {}", path.display()))
+        },
+    }
+}
+
+/// Write `world` to `path` in the given format, streaming through a buffered writer.
+///
+/// The file is written to a temporary path and renamed into place, so a crash
+/// mid-save never leaves a truncated save behind. RON saves are followed by their
+/// summary sidecar, written the same way.
+///
+/// # Errors
+/// Returns an error if the file cannot be created or the world cannot be serialized.
+pub fn write_save_file(world: &AmbleWorld, path: &Path, format: SaveFormat) -> Result<()> {
+    write_atomically(path, |writer| match format {
+        SaveFormat::Ron => ron::ser::to_io_writer(writer, world)
+            .with_context(|| "error converting AmbleWorld to 'ron' format".to_string()),
+        SaveFormat::Binary => {
+            write_header(writer, &SaveHeader::for_world(world))?;
+            ciborium::into_writer(world, writer)
+                .with_context(|| "error converting AmbleWorld to binary save format".to_string())
+        },
+    })?;
+    if format == SaveFormat::Ron {
+        let metadata = fs::metadata(path).with_context(|| format!("reading metadata for '{}'", path.display()))?;
+        let sidecar = SaveSidecar {
+            save_len: metadata.len(),
+            save_modified: metadata.modified().ok(),
+            header: SaveHeader::for_world(world),
+        };
+        write_sidecar(path, &sidecar)?;
+    }
+    Ok(())
+}
+
+/// Stream `write` into a temporary file next to `path`, then rename it over `path`.
+fn write_atomically(path: &Path, write: impl FnOnce(&mut BufWriter<File>) -> Result<()>) -> Result<()> {
+    let mut tmp_name = path.as_os_str().to_owned();
+    tmp_name.push(".tmp");
+    let tmp_path = PathBuf::from(tmp_name);
+    let file = File::create(&tmp_path).with_context(|| format!("creating file '{}'", tmp_path.display()))?;
+    let mut writer = BufWriter::new(file);
+    let written = write(&mut writer).and_then(|()| {
+        let file = writer
+            .into_inner()
+            .map_err(|err| err.into_error())
+            .with_context(|| format!("failed to write '{}'", tmp_path.display()))?;
+        file.sync_all()
+            .with_context(|| format!("failed to sync '{}'", tmp_path.display()))
+    });
+    if let Err(err) = written {
+        let _ = fs::remove_file(&tmp_path);
+        return Err(err);
+    }
+    fs::rename(&tmp_path, path).with_context(|| format!("moving save into place at '{}'", path.display()))
+}
+
+/// Path of the summary sidecar for a RON save.
+fn sidecar_path(save_path: &Path) -> PathBuf {
+    save_path.with_extension("ron-summary")
+}
+
+fn write_sidecar(save_path: &Path, sidecar: &SaveSidecar) -> Result<()> {
+    write_atomically(&sidecar_path(save_path), |writer| {
+        ron::ser::to_io_writer(writer, sidecar).with_context(|| "error encoding save summary".to_string())
+    })
+}
+
+/// Read a RON save's sidecar, if present and describing a file of `save_len` bytes
+/// last modified at `save_modified`.
+fn read_sidecar(save_path: &Path, save_len: u64, save_modified: Option<SystemTime>) -> Option<SaveHeader> {
+    let raw = fs::read_to_string(sidecar_path(save_path)).ok()?;
+    let sidecar = ron::from_str::<SaveSidecar>(&raw).ok()?;
+    (sidecar.save_len == save_len && sidecar.save_modified == save_modified).then_some(sidecar.header)
+}
+
+/// Read only the header of a binary save file.
+///
+/// # Errors
+/// Returns an error if the file cannot be read or does not start with a valid header.
+pub fn read_save_header(path: &Path) -> Result<SaveHeader> {
+    let file = File::open(path).with_context(|| format!("reading save file {}", path.display()))?;
+    read_header(&mut BufReader::new(file))
+}
+
+fn write_header(writer: &mut impl Write, header: &SaveHeader) -> Result<()> {
+    let mut encoded = Vec::new();
+    ciborium::into_writer(header, &mut encoded).with_context(|| "error encoding save header".to_string())?;
+    let len = u32::try_from(encoded.len()).context("save header too large")?;
+    writer.write_all(SAVE_MAGIC)?;
+    writer.write_all(&SAVE_HEADER_VERSION.to_le_bytes())?;
+    writer.write_all(&len.to_le_bytes())?;
+    writer.write_all(&encoded)?;
+    Ok(())
+}
+
+fn read_header(reader: &mut impl Read) -> Result<SaveHeader> {
+    let mut magic = [0u8; 8];
+    reader.read_exact(&mut magic).context("reading save magic")?;
+    if &magic != SAVE_MAGIC {
+        bail!("not an Amble binary save file");
+    }
+    let mut version = [0u8; 2];
+    reader.read_exact(&mut version).context("reading save header version")?;
+    let version = u16::from_le_bytes(version);
+    if version != SAVE_HEADER_VERSION {
+        bail!("unsupported save header version {version} (expected {SAVE_HEADER_VERSION})");
+    }
+    let mut len = [0u8; 4];
+    reader.read_exact(&mut len).context("reading save header length")?;
+    let len = u32::from_le_bytes(len);
+    if len > MAX_HEADER_LEN {
+        bail!("save header length {len} exceeds limit");
+    }
+    let mut encoded = vec![0u8; len as usize];
+    reader.read_exact(&mut encoded).context("reading save header")?;
+    ciborium::from_reader(encoded.as_slice()).context("decoding save header")
 }
 
 /// Format a human-friendly modified time relative to now.
@@ -177,56 +457,141 @@ pub fn format_modified(modified: SystemTime) -> String {
     }
 }
 
-/// Build a full [`SaveFileEntry`] from a discovered save slot.
-fn entry_for_slot(slot: SaveSlot) -> SaveFileEntry {
-    let mut version = slot.version.clone();
-    let (summary, status) = match fs::read_to_string(&slot.path) {
-        Ok(raw) => match ron::from_str::<AmbleWorld>(&raw) {
-            Ok(world) => {
-                version.clone_from(&world.version);
-                let status = if world.version == AMBLE_VERSION {
-                    SaveFileStatus::Ready
-                } else {
-                    SaveFileStatus::VersionMismatch {
-                        save_version: world.version.clone(),
-                        current_version: AMBLE_VERSION.to_string(),
-                    }
-                };
-                let summary = SaveSummary {
-                    world_title: world.game_title.clone(),
-                    world_slug: world.world_slug.clone(),
-                    world_version: world.world_version.clone(),
-                    player_name: world.player.name.clone(),
-                    player_location: describe_location(&world),
-                    turn_count: world.turn_count,
-                    score: world.player.score,
-                };
-                (Some(summary), status)
-            },
-            Err(err) => {
-                warn!(
-                    "failed to parse save '{}' ({}): {}",
-                    slot.slot,
-                    slot.path.display(),
-                    err
-                );
-                (
-                    None,
-                    SaveFileStatus::Corrupted {
-                        message: format!("parse error: {}", trim_error(&err)),
-                    },
-                )
+/// Build sorted [`SaveFileEntry`] values for discovered save slots.
+///
+/// Headers come from the summary cache when the file is unchanged, otherwise from
+/// the binary header or RON sidecar. Saves with neither are parsed in full, in
+/// parallel, and their sidecars are backfilled for next time.
+fn entries_for_slots(slots: Vec<SaveSlot>) -> Vec<SaveFileEntry> {
+    let mut headers: Vec<Option<HeaderResult>> = slots.iter().map(cached_header).collect();
+    for (slot, header) in slots.iter().zip(headers.iter_mut()) {
+        if header.is_none() {
+            *header = quick_header(slot);
+        }
+    }
+
+    let unsummarized: Vec<usize> = (0..slots.len()).filter(|&idx| headers[idx].is_none()).collect();
+    let parse_targets: Vec<&SaveSlot> = unsummarized.iter().map(|&idx| &slots[idx]).collect();
+    for (idx, parsed) in unsummarized.into_iter().zip(parse_in_parallel(&parse_targets)) {
+        headers[idx] = Some(parsed);
+    }
+
+    let mut entries: Vec<_> = slots
+        .into_iter()
+        .zip(headers)
+        .map(|(slot, header)| {
+            let header = header.expect("every slot has a resolved header");
+            cache_header(&slot, &header);
+            entry_for_slot(slot, header)
+        })
+        .collect();
+    entries.sort_by(|a, b| b.modified.cmp(&a.modified).then(a.slot.cmp(&b.slot)));
+    entries
+}
+
+/// Header previously resolved for this file, if its size and mtime still match.
+fn cached_header(slot: &SaveSlot) -> Option<HeaderResult> {
+    let modified = slot.modified?;
+    let cache = SUMMARY_CACHE.read().ok()?;
+    let cached = cache.get(&slot.path)?;
+    (cached.len == slot.len && cached.modified == modified).then(|| cached.header.clone())
+}
+
+fn cache_header(slot: &SaveSlot, header: &HeaderResult) {
+    if let Some(modified) = slot.modified
+        && let Ok(mut cache) = SUMMARY_CACHE.write()
+    {
+        cache.insert(
+            slot.path.clone(),
+            CachedHeader {
+                len: slot.len,
+                modified,
+                header: header.clone(),
             },
+        );
+    }
+}
+
+/// Resolve a header without decoding the world, or `None` if a full parse is needed.
+fn quick_header(slot: &SaveSlot) -> Option<HeaderResult> {
+    match SaveFormat::from_path(&slot.path).unwrap_or_default() {
+        SaveFormat::Binary => Some(read_save_header(&slot.path).map_err(|err| {
+            warn!(
+                "failed to read save header '{}' ({}): {err:#}",
+                slot.slot,
+                slot.path.display()
+            );
+            format!("header error: {}", trim_error(&format!("{err:#}")))
+        })),
+        SaveFormat::Ron => read_sidecar(&slot.path, slot.len, slot.modified).map(Ok),
+    }
+}
+
+/// Fully parse RON saves that have no usable summary, spread across worker threads.
+fn parse_in_parallel(slots: &[&SaveSlot]) -> Vec<HeaderResult> {
+    if slots.is_empty() {
+        return Vec::new();
+    }
+    let workers = thread::available_parallelism()
+        .map_or(1, NonZeroUsize::get)
+        .min(slots.len());
+    let chunk_size = slots.len().div_ceil(workers);
+    thread::scope(|scope| {
+        let handles: Vec<_> = slots
+            .chunks(chunk_size)
+            .map(|chunk| scope.spawn(move || chunk.iter().map(|slot| parse_full_header(slot)).collect::<Vec<_>>()))
+            .collect();
+        handles
+            .into_iter()
+            .flat_map(|handle| handle.join().expect("save summary worker panicked"))
+            .collect()
+    })
+}
+
+/// Parse a RON save in full to summarize it, backfilling its sidecar on success.
+fn parse_full_header(slot: &SaveSlot) -> HeaderResult {
+    let raw = fs::read_to_string(&slot.path).map_err(|err| {
+        warn!("failed to read save '{}' ({}): {}", slot.slot, slot.path.display(), err);
+        format!("read error: {}", trim_error(&err))
+    })?;
+    let world = ron::from_str::<AmbleWorld>(&raw).map_err(|err| {
+        warn!(
+            "failed to parse save '{}' ({}): {}",
+            slot.slot,
+            slot.path.display(),
+            err
+        );
+        format!("parse error: {}", trim_error(&err))
+    })?;
+    let header = SaveHeader::for_world(&world);
+    let sidecar = SaveSidecar {
+        save_len: slot.len,
+        save_modified: slot.modified,
+        header: header.clone(),
+    };
+    if let Err(err) = write_sidecar(&slot.path, &sidecar) {
+        warn!("failed to write save summary for '{}': {err:#}", slot.path.display());
+    }
+    Ok(header)
+}
+
+/// Build a full [`SaveFileEntry`] from a discovered save slot and its resolved header.
+fn entry_for_slot(slot: SaveSlot, header: HeaderResult) -> SaveFileEntry {
+    let mut version = slot.version.clone();
+    let (summary, status) = match header {
+        Ok(header) => {
+            version.clone_from(&header.engine_version);
+            let status = if header.engine_version == AMBLE_VERSION {
+                SaveFileStatus::Ready
+            } else {
+                SaveFileStatus::VersionMismatch {
+                    save_version: header.engine_version,
+                    current_version: AMBLE_VERSION.to_string(),
+                }
+            };
+            (Some(header.summary), status)
         },
-        Err(err) => {
-            warn!("failed to read save '{}' ({}): {}", slot.slot, slot.path.display(), err);
-            (
-                None,
-                SaveFileStatus::Corrupted {
-                    message: format!("read error: {}", trim_error(&err)),
-                },
-            )
-        },
+        Err(message) => (None, SaveFileStatus::Corrupted { message }),
     };
 
     SaveFileEntry {
@@ -240,27 +605,41 @@ fn entry_for_slot(slot: SaveSlot) -> SaveFileEntry {
     }
 }
 
+/// Summarize a world for save listings.
+fn summarize_world(world: &AmbleWorld) -> SaveSummary {
+    SaveSummary {
+        world_title: world.game_title.clone(),
+        world_slug: world.world_slug.clone(),
+        world_version: world.world_version.clone(),
+        player_name: world.player.name.clone(),
+        player_location: describe_location(world),
+        turn_count: world.turn_count,
+        score: world.player.score,
+    }
+}
+
 fn slot_from_entry(entry: &fs::DirEntry) -> Option<SaveSlot> {
     let path = entry.path();
     if !path.is_file() {
         return None;
     }
-    if path.extension().and_then(|ext| ext.to_str()) != Some("ron") {
-        return None;
-    }
+    SaveFormat::from_path(&path)?;
     let file_name = path.file_name().and_then(|name| name.to_str())?.to_string();
     let stem = path.file_stem().and_then(|stem| stem.to_str())?;
     let (slot, version) = stem.rsplit_once("-amble-")?;
     if slot.is_empty() {
         return None;
     }
-    let modified = entry.metadata().ok().and_then(|meta| meta.modified().ok());
+    let metadata = entry.metadata().ok();
+    let modified = metadata.as_ref().and_then(|meta| meta.modified().ok());
+    let len = metadata.as_ref().map_or(0, fs::Metadata::len);
     Some(SaveSlot {
         slot: slot.to_string(),
         version: version.to_string(),
         path,
         file_name,
         modified,
+        len,
     })
 }
 
@@ -353,6 +732,165 @@ mod tests {
         Ok(())
     }
 
+    fn test_world() -> AmbleWorld {
+        let room_id = crate::idgen::new_room_id();
+        let room = Room {
+            id: room_id.clone(),
+            symbol: "room_symbol".into(),
+            name: "Test Room".into(),
+            base_description: "Desc".into(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
+            scenery_default: None,
+            location: Location::Nowhere,
+            visited: false,
+            exits: HashMap::new(),
+            contents: HashSet::new(),
+            npcs: HashSet::new(),
+        };
+        let mut world = AmbleWorld::new_empty();
+        world.version = AMBLE_VERSION.to_string();
+        world.player.name = "Tester".into();
+        world.player.score = 42;
+        world.turn_count = 7;
+        world.player.location = Location::Room(room_id.clone());
+        world.rooms.insert(room_id, room);
+        world
+    }
+
+    #[test]
+    fn binary_save_round_trips_world() -> Result<()> {
+        let dir = tempdir()?;
+        let world = test_world();
+        let path = dir.path().join(save_file_name("alpha", SaveFormat::Binary));
+        write_save_file(&world, &path, SaveFormat::Binary)?;
+
+        let loaded = load_save_file(&path)?;
+        assert_eq!(loaded.player.name, "Tester");
+        assert_eq!(loaded.turn_count, 7);
+        assert_eq!(loaded.player.location, world.player.location);
+        assert_eq!(loaded.rooms.len(), 1);
+        Ok(())
+    }
+
+    #[test]
+    fn ron_save_remains_loadable() -> Result<()> {
+        let dir = tempdir()?;
+        let path = dir.path().join(save_file_name("alpha", SaveFormat::Ron));
+        write_save_file(&test_world(), &path, SaveFormat::Ron)?;
+        assert!(fs::read_to_string(&path)?.contains("Tester"));
+        assert_eq!(load_save_file(&path)?.player.score, 42);
+        Ok(())
+    }
+
+    #[test]
+    fn binary_entries_are_built_from_header_only() -> Result<()> {
+        let dir = tempdir()?;
+        let path = dir.path().join(save_file_name("alpha", SaveFormat::Binary));
+        write_save_file(&test_world(), &path, SaveFormat::Binary)?;
+
+        // Replace the world body with junk: the listing must still succeed from the header.
+        let header_len = {
+            let mut encoded = Vec::new();
+            write_header(&mut encoded, &read_save_header(&path)?)?;
+            encoded.len()
+        };
+        let mut bytes = fs::read(&path)?;
+        bytes.truncate(header_len);
+        bytes.extend_from_slice(b"not a world");
+        fs::write(&path, bytes)?;
+
+        let entries = build_save_entries(dir.path())?;
+        assert_eq!(entries.len(), 1);
+        assert!(matches!(entries[0].status, SaveFileStatus::Ready));
+        let summary = entries[0].summary.as_ref().unwrap();
+        assert_eq!(summary.player_name, "Tester");
+        assert_eq!(summary.player_location.as_deref(), Some("Test Room"));
+        assert_eq!((summary.turn_count, summary.score), (7, 42));
+        assert!(load_save_file(&path).is_err());
+        Ok(())
+    }
+
+    #[test]
+    fn binary_entries_report_bad_header_as_corrupted() -> Result<()> {
+        let dir = tempdir()?;
+        fs::write(dir.path().join("beta-amble-0.60.0.sav"), b"AMBLESAV\x01")?;
+        let entries = build_save_entries(dir.path())?;
+        assert!(matches!(entries[0].status, SaveFileStatus::Corrupted { .. }));
+        assert!(entries[0].summary.is_none());
+        Ok(())
+    }
+
+    #[test]
+    fn ron_saves_are_listed_from_sidecar() -> Result<()> {
+        let dir = tempdir()?;
+        let path = dir.path().join(save_file_name("alpha", SaveFormat::Ron));
+        write_save_file(&test_world(), &path, SaveFormat::Ron)?;
+        assert!(sidecar_path(&path).exists());
+        assert!(!PathBuf::from(format!("{}.tmp", path.display())).exists());
+
+        // A sidecar that matches the save's size and mtime is trusted without parsing the save.
+        let metadata = fs::metadata(&path)?;
+        let (save_len, save_modified) = (metadata.len(), metadata.modified().ok());
+        let mut header = read_sidecar(&path, save_len, save_modified).unwrap();
+        header.summary.player_name = "From Sidecar".into();
+        write_sidecar(
+            &path,
+            &SaveSidecar {
+                save_len,
+                save_modified,
+                header,
+            },
+        )?;
+
+        let entries = build_save_entries(dir.path())?;
+        assert_eq!(entries.len(), 1);
+        assert_eq!(entries[0].summary.as_ref().unwrap().player_name, "From Sidecar");
+
+        // A stale sidecar is ignored, whether the size or the mtime changed.
+        assert!(read_sidecar(&path, save_len + 1, save_modified).is_none());
+        let rewritten = save_modified.map(|time| time + std::time::Duration::from_secs(1));
+        assert!(read_sidecar(&path, save_len, rewritten).is_none());
+        Ok(())
+    }
+
+    #[test]
+    fn legacy_ron_saves_are_parsed_and_backfilled() -> Result<()> {
+        let dir = tempdir()?;
+        for slot in ["one", "two", "three"] {
+            fs::write(
+                dir.path().join(save_file_name(slot, SaveFormat::Ron)),
+                ron::ser::to_string(&test_world())?,
+            )?;
+        }
+
+        let slots = collect_save_slots(dir.path())?;
+        let entries = build_save_entries(dir.path())?;
+        assert_eq!(entries.len(), 3);
+        assert!(
+            entries
+                .iter()
+                .all(|entry| matches!(entry.status, SaveFileStatus::Ready))
+        );
+        for slot in &slots {
+            assert!(sidecar_path(&slot.path).exists());
+            assert!(matches!(cached_header(slot), Some(Ok(_))));
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn save_format_from_name_and_path() {
+        assert_eq!(SaveFormat::from_name("RON"), Some(SaveFormat::Ron));
+        assert_eq!(SaveFormat::from_name(" binary "), Some(SaveFormat::Binary));
+        assert_eq!(SaveFormat::from_name("json"), None);
+        assert_eq!(
+            SaveFormat::from_path(Path::new("a-amble-1.sav")),
+            Some(SaveFormat::Binary)
+        );
+        assert_eq!(SaveFormat::from_path(Path::new("a-amble-1.txt")), None);
+    }
+
     #[test]
     fn build_save_entries_reports_status_variants() -> Result<()> {
         let dir = tempdir()?;
@@ -364,8 +902,8 @@ mod tests {
             symbol: "room_symbol".into(),
             name: "Test Room".into(),
             base_description: "Desc".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -17,7 +17,7 @@ use std::collections::BinaryHeap;
 use log::info;
 use serde::{Deserialize, Serialize};
 
-use crate::trigger::{ScriptedAction, TriggerCondition};
+use crate::trigger::{CompiledCondition, ScriptedAction, TriggerCondition};
 
 #[cfg(test)]
 const PLACEHOLDER_THRESHOLD: usize = 4;
@@ -78,7 +78,7 @@ impl Scheduler {
         &mut self,
         now: usize,
         turns_ahead: usize,
-        condition: Option<EventCondition>,
+        condition: Option<CompiledCondition>,
         on_false: OnFalsePolicy,
         actions: Vec<ScriptedAction>,
         note: Option<String>,
@@ -104,7 +104,7 @@ impl Scheduler {
     pub fn schedule_on_if(
         &mut self,
         on_turn: usize,
-        condition: Option<EventCondition>,
+        condition: Option<CompiledCondition>,
         on_false: OnFalsePolicy,
         actions: Vec<ScriptedAction>,
         note: Option<String>,
@@ -178,7 +178,7 @@ pub struct ScheduledEvent {
     pub actions: Vec<ScriptedAction>,
     pub note: Option<String>,
     /// Optional condition that must be true for the event to fire.
-    pub condition: Option<EventCondition>,
+    pub condition: Option<CompiledCondition>,
     /// Policy to apply when the condition evaluates to false.
     pub on_false: OnFalsePolicy,
 }
@@ -0,0 +1,504 @@
+//! Multi-session game server.
+//!
+//! The server loads a world once and shares it read-only (`Arc`) as a template;
+//! each connection gets its own [sandboxed](Session::sandboxed) [`Session`] started
+//! from that template, so no player can save, load, change the theme or use
+//! developer commands that would reach other sessions. Game work runs on a fixed
+//! pool of worker threads: every session is pinned to one worker, which owns it
+//! outright, so commands for a session run in order without locking. Connection
+//! threads only move lines between the socket and the pool.
+//!
+//! ## Protocol
+//! Line-oriented over TCP. The client sends one command per line. The server
+//! answers the greeting (sent on connect) and every command with the rendered
+//! frame text followed by a terminator line:
+//!
+//! ```text
+//! . turn=<n> score=<n>[ died][ quit]
+//! ```
+//!
+//! Body lines that begin with `.` are sent with an extra leading `.` (as in SMTP),
+//! so a line starting with a single `.` is always a terminator. The server closes
+//! the connection after answering `quit`, and drops a connection whose command line
+//! exceeds [`MAX_LINE_BYTES`].
+//!
+//! At most [`WorkerPool::max_connections`] connections are served at once; further
+//! clients wait in the listen backlog until a slot frees up.
+
+use std::collections::HashMap;
+use std::fmt::Write as _;
+use std::io::{self, BufRead, BufReader, Read, Write};
+use std::net::{TcpListener, TcpStream, ToSocketAddrs};
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Arc, Condvar, Mutex, mpsc};
+use std::thread;
+
+use anyhow::{Context, Result};
+use log::{info, warn};
+use textwrap::fill;
+
+use crate::session::{Frame, Session};
+use crate::world::AmbleWorld;
+
+/// Longest command line accepted from a client, in bytes (newline included).
+pub const MAX_LINE_BYTES: usize = 4096;
+
+/// Default limit on connections served at once.
+pub const DEFAULT_MAX_CONNECTIONS: usize = 1024;
+
+/// Work sent from connection threads to the session that owns a connection.
+enum Job {
+    Open {
+        id: u64,
+        reply: mpsc::Sender<Response>,
+    },
+    Command {
+        id: u64,
+        line: String,
+        reply: mpsc::Sender<Response>,
+    },
+    Close {
+        id: u64,
+    },
+}
+
+/// One encoded response, ready to write to the socket.
+struct Response {
+    bytes: Vec<u8>,
+    quit: bool,
+}
+
+/// Fixed pool of worker threads, each owning the sessions pinned to it.
+pub struct WorkerPool {
+    workers: Vec<mpsc::Sender<Job>>,
+    next_id: AtomicU64,
+    max_connections: usize,
+}
+
+impl WorkerPool {
+    /// Spawn `workers` threads serving sessions started from `template`.
+    pub fn new(template: Arc<AmbleWorld>, workers: usize) -> Self {
+        let workers = (0..workers.max(1))
+            .map(|idx| {
+                let (tx, rx) = mpsc::channel();
+                let template = Arc::clone(&template);
+                thread::Builder::new()
+                    .name(format!("amble-worker-{idx}"))
+                    .spawn(move || worker_loop(&template, &rx))
+                    .expect("failed to spawn server worker");
+                tx
+            })
+            .collect();
+        Self {
+            workers,
+            next_id: AtomicU64::new(0),
+            max_connections: DEFAULT_MAX_CONNECTIONS,
+        }
+    }
+
+    /// Serve at most `max` connections at once (at least one).
+    #[must_use]
+    pub fn with_max_connections(mut self, max: usize) -> Self {
+        self.max_connections = max.max(1);
+        self
+    }
+
+    /// Most connections served at once.
+    pub fn max_connections(&self) -> usize {
+        self.max_connections
+    }
+
+    /// Number of worker threads.
+    pub fn len(&self) -> usize {
+        self.workers.len()
+    }
+
+    /// True if the pool has no workers (never the case for a pool built with `new`).
+    pub fn is_empty(&self) -> bool {
+        self.workers.is_empty()
+    }
+
+    fn worker_for(&self, id: u64) -> &mpsc::Sender<Job> {
+        &self.workers[(id % self.workers.len() as u64) as usize]
+    }
+
+    /// Serve one client connection until it quits or disconnects.
+    fn handle_connection(&self, stream: TcpStream) -> io::Result<()> {
+        let id = self.next_id.fetch_add(1, Ordering::Relaxed);
+        let worker = self.worker_for(id);
+        let (reply_tx, reply_rx) = mpsc::channel();
+        let mut writer = stream.try_clone()?;
+        let mut reader = BufReader::new(stream);
+
+        let result = (|| {
+            send_job(
+                worker,
+                Job::Open {
+                    id,
+                    reply: reply_tx.clone(),
+                },
+            )?;
+            writer.write_all(&recv_reply(&reply_rx)?.bytes)?;
+
+            let mut line = String::new();
+            loop {
+                line.clear();
+                if (&mut reader).take(MAX_LINE_BYTES as u64).read_line(&mut line)? == 0 {
+                    return Ok(());
+                }
+                if !line.ends_with('\n') && line.len() == MAX_LINE_BYTES {
+                    return Err(io::Error::new(
+                        io::ErrorKind::InvalidData,
+                        format!("command line longer than {MAX_LINE_BYTES} bytes"),
+                    ));
+                }
+                let job = Job::Command {
+                    id,
+                    line: line.trim().to_string(),
+                    reply: reply_tx.clone(),
+                };
+                send_job(worker, job)?;
+                let response = recv_reply(&reply_rx)?;
+                writer.write_all(&response.bytes)?;
+                if response.quit {
+                    return Ok(());
+                }
+            }
+        })();
+        let _ = worker.send(Job::Close { id });
+        result
+    }
+}
+
+fn send_job(worker: &mpsc::Sender<Job>, job: Job) -> io::Result<()> {
+    worker
+        .send(job)
+        .map_err(|_| io::Error::other("server worker has stopped"))
+}
+
+fn recv_reply(replies: &mpsc::Receiver<Response>) -> io::Result<Response> {
+    replies
+        .recv()
+        .map_err(|_| io::Error::other("server worker has stopped"))
+}
+
+/// Run jobs for the sessions pinned to this worker until the pool is dropped.
+fn worker_loop(template: &AmbleWorld, jobs: &mpsc::Receiver<Job>) {
+    let mut sessions: HashMap<u64, Session> = HashMap::new();
+    let mut text = String::new();
+    while let Ok(job) = jobs.recv() {
+        match job {
+            Job::Open { id, reply } => {
+                let mut world = template.clone();
+                world.rng = template.rng.derive(id);
+                let session = Session::sandboxed(world);
+                text.clear();
+                greeting(session.world(), &mut text);
+                let _ = reply.send(encode_response(
+                    &text,
+                    session.world().turn_count,
+                    session.world().player.score,
+                    None,
+                ));
+                sessions.insert(id, session);
+            },
+            Job::Command { id, line, reply } => {
+                let Some(session) = sessions.get_mut(&id) else {
+                    continue;
+                };
+                text.clear();
+                let response = match session.send_rendered(&line, &mut text) {
+                    Ok(frame) => encode_response(&text, frame.turn, frame.score, Some(&frame)),
+                    Err(err) => {
+                        warn!("session {id}: command \"{line}\" failed: {err:#}");
+                        let _ = writeln!(text, "error: {err}");
+                        let world = session.world();
+                        encode_response(&text, world.turn_count, world.player.score, None)
+                    },
+                };
+                let _ = reply.send(response);
+            },
+            Job::Close { id } => {
+                sessions.remove(&id);
+            },
+        }
+    }
+}
+
+/// Opening text for a new session: the game title and intro.
+fn greeting(world: &AmbleWorld, out: &mut String) {
+    if !world.game_title.trim().is_empty() {
+        out.push_str(world.game_title.trim());
+        out.push('\n');
+    }
+    if !world.intro_text.trim().is_empty() {
+        out.push_str(&fill(world.intro_text.trim(), 80));
+        out.push('\n');
+    }
+}
+
+/// Frame `body` for the wire: dot-stuff lines beginning with `.` and append the terminator.
+fn encode_response(body: &str, turn: usize, score: usize, frame: Option<&Frame>) -> Response {
+    let mut bytes = Vec::with_capacity(body.len() + 32);
+    for line in body.lines() {
+        if line.starts_with('.') {
+            bytes.push(b'.');
+        }
+        bytes.extend_from_slice(line.as_bytes());
+        bytes.push(b'\n');
+    }
+    let died = frame.is_some_and(|f| f.player_died);
+    let quit = frame.is_some_and(|f| f.quit);
+    let _ = writeln!(
+        bytes,
+        ". turn={turn} score={score}{}{}",
+        if died { " died" } else { "" },
+        if quit { " quit" } else { "" }
+    );
+    Response { bytes, quit }
+}
+
+/// Counts open connections; [`ConnectionSlots::acquire`] waits while all are taken.
+struct ConnectionSlots {
+    open: Mutex<usize>,
+    freed: Condvar,
+    max: usize,
+}
+
+/// One taken connection slot, released when dropped.
+struct ConnectionSlot(Arc<ConnectionSlots>);
+
+impl ConnectionSlots {
+    fn acquire(self: &Arc<Self>) -> ConnectionSlot {
+        let mut open = self.open.lock().expect("connection slots poisoned");
+        while *open >= self.max {
+            open = self.freed.wait(open).expect("connection slots poisoned");
+        }
+        *open += 1;
+        ConnectionSlot(Arc::clone(self))
+    }
+}
+
+impl Drop for ConnectionSlot {
+    fn drop(&mut self) {
+        *self.0.open.lock().expect("connection slots poisoned") -= 1;
+        self.0.freed.notify_one();
+    }
+}
+
+/// Accept connections on `listener` forever, serving each from `pool`.
+///
+/// Once [`WorkerPool::max_connections`] connections are open, no more are accepted
+/// until one closes.
+///
+/// # Errors
+/// Returns an error only if the listener itself fails; per-connection errors are logged.
+pub fn serve(listener: &TcpListener, pool: &Arc<WorkerPool>) -> Result<()> {
+    info!(
+        "amble server listening on {} with {} workers, up to {} connections",
+        listener.local_addr().context("reading listener address")?,
+        pool.len(),
+        pool.max_connections
+    );
+    let slots = Arc::new(ConnectionSlots {
+        open: Mutex::new(0),
+        freed: Condvar::new(),
+        max: pool.max_connections,
+    });
+    loop {
+        let slot = slots.acquire();
+        let (stream, _) = listener.accept().context("accepting connection")?;
+        let _ = stream.set_nodelay(true);
+        let pool = Arc::clone(pool);
+        thread::spawn(move || {
+            let _slot = slot;
+            if let Err(err) = pool.handle_connection(stream) {
+                warn!("connection ended with error: {err}");
+            }
+        });
+    }
+}
+
+/// Blocking client for the server's line protocol (used by the load generator and benchmarks).
+pub struct Client {
+    reader: BufReader<TcpStream>,
+    writer: TcpStream,
+    line: String,
+}
+
+/// A response read by [`Client`].
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct ClientResponse {
+    /// Frame text with dot-stuffing removed.
+    pub body: String,
+    /// The terminator line's metadata, e.g. `turn=2 score=0`.
+    pub status: String,
+}
+
+impl Client {
+    /// Connect and read the greeting.
+    ///
+    /// # Errors
+    /// Returns an error if the connection fails or the greeting is malformed.
+    pub fn connect(addr: impl ToSocketAddrs) -> io::Result<(Self, ClientResponse)> {
+        let writer = TcpStream::connect(addr)?;
+        writer.set_nodelay(true)?;
+        let mut client = Self {
+            reader: BufReader::new(writer.try_clone()?),
+            writer,
+            line: String::new(),
+        };
+        let greeting = client.read_response()?;
+        Ok((client, greeting))
+    }
+
+    /// Send one command and wait for its response.
+    ///
+    /// # Errors
+    /// Returns an error on I/O failure or if the server closes the connection mid-response.
+    pub fn send(&mut self, command: &str) -> io::Result<ClientResponse> {
+        let mut request = Vec::with_capacity(command.len() + 1);
+        request.extend_from_slice(command.as_bytes());
+        request.push(b'\n');
+        self.writer.write_all(&request)?;
+        self.read_response()
+    }
+
+    fn read_response(&mut self) -> io::Result<ClientResponse> {
+        let mut response = ClientResponse::default();
+        loop {
+            self.line.clear();
+            if self.reader.read_line(&mut self.line)? == 0 {
+                return Err(io::Error::new(io::ErrorKind::UnexpectedEof, "server closed connection"));
+            }
+            let line = self.line.trim_end_matches(['\r', '\n']);
+            if let Some(rest) = line.strip_prefix('.') {
+                if !rest.starts_with('.') {
+                    response.status = rest.trim().to_string();
+                    return Ok(response);
+                }
+                response.body.push_str(rest);
+            } else {
+                response.body.push_str(line);
+            }
+            response.body.push('\n');
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::Location;
+    use crate::room::Room;
+    use crate::theme::THEME_MANAGER;
+    use std::collections::{HashMap, HashSet};
+
+    fn template() -> Arc<AmbleWorld> {
+        let mut world = AmbleWorld::new_empty();
+        world.game_title = ".Server Test".into();
+        let room = Room {
+            id: "server_lobby".into(),
+            symbol: "server_lobby".into(),
+            name: "Lobby".into(),
+            base_description: "A quiet lobby.".into(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
+            scenery_default: None,
+            location: Location::Nowhere,
+            visited: false,
+            exits: HashMap::new(),
+            contents: HashSet::new(),
+            npcs: HashSet::new(),
+        };
+        world.player.location = Location::Room(room.id);
+        world.rooms.insert(room.id, room);
+        Arc::new(world)
+    }
+
+    #[test]
+    fn sessions_are_independent_and_quit_closes_the_connection() {
+        let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+        let addr = listener.local_addr().unwrap();
+        let pool = Arc::new(WorkerPool::new(template(), 2));
+        thread::spawn(move || serve(&listener, &pool));
+
+        let (mut first, greeting) = Client::connect(addr).unwrap();
+        assert_eq!(greeting.body, ".Server Test\n", "dot-stuffing should round-trip");
+        assert_eq!(greeting.status, "turn=1 score=1");
+        let (mut second, _) = Client::connect(addr).unwrap();
+
+        let look = first.send("look").unwrap();
+        assert!(!look.body.is_empty());
+        assert_eq!(look.status, "turn=2 score=1");
+        assert_eq!(second.send("inventory").unwrap().status, "turn=1 score=1");
+
+        assert!(first.send("quit").unwrap().status.ends_with(" quit"));
+        assert!(first.send("look").is_err());
+        assert_eq!(second.send("look").unwrap().status, "turn=2 score=1");
+    }
+
+    #[test]
+    fn overlong_lines_close_the_connection() {
+        let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+        let addr = listener.local_addr().unwrap();
+        let pool = Arc::new(WorkerPool::new(template(), 1));
+        thread::spawn(move || serve(&listener, &pool));
+
+        let (mut client, _) = Client::connect(addr).unwrap();
+        assert!(client.send(&"x".repeat(MAX_LINE_BYTES)).is_err());
+        let (mut next, _) = Client::connect(addr).unwrap();
+        assert_eq!(next.send("look").unwrap().status, "turn=2 score=1");
+    }
+
+    #[test]
+    fn connections_past_the_limit_wait_for_a_free_slot() {
+        let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+        let addr = listener.local_addr().unwrap();
+        let pool = Arc::new(WorkerPool::new(template(), 1).with_max_connections(1));
+        thread::spawn(move || serve(&listener, &pool));
+
+        let (mut first, _) = Client::connect(addr).unwrap();
+        let (connected_tx, connected_rx) = mpsc::channel();
+        thread::spawn(move || {
+            let _ = connected_tx.send(Client::connect(addr).map(|(client, _)| client));
+        });
+        assert!(
+            connected_rx
+                .recv_timeout(std::time::Duration::from_millis(200))
+                .is_err(),
+            "second connection should wait while the first is open"
+        );
+        first.send("quit").unwrap();
+        let mut second = connected_rx
+            .recv_timeout(std::time::Duration::from_secs(5))
+            .unwrap()
+            .unwrap();
+        assert_eq!(second.send("look").unwrap().status, "turn=2 score=1");
+    }
+
+    #[test]
+    fn sessions_cannot_reach_shared_saves_or_theme() {
+        let listener = TcpListener::bind("127.0.0.1:0").unwrap();
+        let addr = listener.local_addr().unwrap();
+        let pool = Arc::new(WorkerPool::new(template(), 2));
+        thread::spawn(move || serve(&listener, &pool));
+        let theme_before = THEME_MANAGER.read().unwrap().current_name();
+
+        let (mut first, _) = Client::connect(addr).unwrap();
+        let (mut second, _) = Client::connect(addr).unwrap();
+        for command in ["save shared", "theme seaside", "saves"] {
+            let response = first.send(command).unwrap();
+            assert!(
+                response.body.contains("isn't available"),
+                "{command}: {}",
+                response.body
+            );
+            assert_eq!(response.status, "turn=1 score=1");
+        }
+        let load = second.send("load shared").unwrap();
+        assert!(load.body.contains("isn't available"));
+        assert_eq!(second.send("look").unwrap().status, "turn=2 score=1");
+        assert_eq!(THEME_MANAGER.read().unwrap().current_name(), theme_before);
+    }
+}
@@ -0,0 +1,256 @@
+//! Headless game sessions.
+//!
+//! A [`Session`] drives an [`AmbleWorld`] with command strings and returns each
+//! turn's output as structured data instead of printing it. It runs the same
+//! pipeline as the REPL (parse, dispatch, timed events, ambient triggers) but
+//! never touches the terminal: there is no prompt, no autosave and no death
+//! prompt, so callers decide what to do when the player dies or quits.
+//!
+//! Sessions are `Send`, so scripted playthroughs can be spread across threads.
+//! A [`Session::sandboxed`] session also refuses commands that reach outside its own
+//! world (saves, themes, developer tools), so several can share one process.
+
+use std::path::Path;
+
+use anyhow::Result;
+use log::info;
+
+use crate::command::Command;
+use crate::loader::load_world_from_path;
+use crate::repl::{
+    ReplControl, advance_timed_events, check_ambient_triggers, dispatch_command, parse_with_exit_fallback,
+    push_quit_summary,
+};
+use crate::view::{View, ViewItem};
+use crate::world::AmbleWorld;
+
+/// Output and metadata for a single command sent to a [`Session`].
+#[derive(Debug, Clone, PartialEq)]
+pub struct Frame {
+    /// The command the input was parsed into.
+    pub command: Command,
+    /// Everything the view would have shown this turn, in the order it was produced.
+    pub items: Vec<ViewItem>,
+    /// Turn number after the command was processed.
+    pub turn: usize,
+    /// Player score after the command was processed.
+    pub score: usize,
+    /// True if the command advanced the turn (and timed events ran).
+    pub turn_advanced: bool,
+    /// True if the world was replaced, e.g. by a `load` command.
+    pub world_reloaded: bool,
+    /// True if the player died during this turn's timed events.
+    pub player_died: bool,
+    /// True if the command asked to quit the game.
+    pub quit: bool,
+}
+
+/// A game in progress, driven by command strings rather than a terminal.
+#[derive(Debug, Clone)]
+pub struct Session {
+    world: AmbleWorld,
+    view: View,
+    /// Refuse [local-only](Command::is_local_only) commands.
+    sandboxed: bool,
+}
+
+impl Session {
+    /// Start a session on an already loaded world.
+    pub fn new(mut world: AmbleWorld) -> Self {
+        world.turn_count = world.turn_count.max(1);
+        Self {
+            world,
+            view: View::new(),
+            sandboxed: false,
+        }
+    }
+
+    /// Start a session that refuses [local-only](Command::is_local_only) commands, for
+    /// hosting several players' sessions in one process.
+    pub fn sandboxed(world: AmbleWorld) -> Self {
+        Self {
+            sandboxed: true,
+            ..Self::new(world)
+        }
+    }
+
+    /// Load the world at `world_path` (or its precompiled artifact) and start a session on it.
+    ///
+    /// # Errors
+    /// Returns an error if the world cannot be loaded.
+    pub fn load(world_path: &Path) -> Result<Self> {
+        Ok(Self::new(load_world_from_path(world_path)?))
+    }
+
+    /// The current world state.
+    pub fn world(&self) -> &AmbleWorld {
+        &self.world
+    }
+
+    /// Mutable access to the world, e.g. to set up a scenario before sending commands.
+    pub fn world_mut(&mut self) -> &mut AmbleWorld {
+        &mut self.world
+    }
+
+    /// Consume the session, returning the world.
+    pub fn into_world(self) -> AmbleWorld {
+        self.world
+    }
+
+    /// Process one line of player input and return the resulting frame.
+    ///
+    /// # Errors
+    /// Propagates failures from command handlers and triggered actions, such as
+    /// the player being in a room that does not exist.
+    pub fn send(&mut self, input: &str) -> Result<Frame> {
+        let mut frame = self.step(input)?;
+        frame.items = self.view.items.drain(..).map(|entry| entry.view_item).collect();
+        Ok(frame)
+    }
+
+    /// Like [`Session::send`], but also renders the frame as the terminal view would,
+    /// appending the text to `out`.
+    ///
+    /// # Errors
+    /// Same as [`Session::send`].
+    pub fn send_rendered(&mut self, input: &str, out: &mut String) -> Result<Frame> {
+        let mut frame = self.step(input)?;
+        frame.items = self.view.items.iter().map(|entry| entry.view_item.clone()).collect();
+        self.view.render_into(out);
+        Ok(frame)
+    }
+
+    /// Run one command through the turn pipeline, leaving its output in the view.
+    fn step(&mut self, input: &str) -> Result<Frame> {
+        let world = &mut self.world;
+        let view = &mut self.view;
+        view.reset();
+
+        let command = parse_with_exit_fallback(world, view, input.to_string())?;
+        info!("session input \"{input}\" ⇒ Command::{command:?}");
+
+        if self.sandboxed && command.is_local_only() {
+            view.push(ViewItem::Error(
+                "That command isn't available in this game.".to_string(),
+            ));
+            return Ok(Frame {
+                command,
+                items: Vec::new(),
+                turn: world.turn_count,
+                score: world.player.score,
+                turn_advanced: false,
+                world_reloaded: false,
+                player_died: false,
+                quit: false,
+            });
+        }
+
+        let dispatch = dispatch_command(&command, world, view)?;
+        let quit = dispatch.control == ReplControl::Quit;
+        let mut player_died = false;
+        if !quit {
+            if dispatch.turn_advanced && advance_timed_events(world, view)? {
+                player_died = true;
+                push_quit_summary(world, view);
+            }
+            if !player_died {
+                check_ambient_triggers(world, view)?;
+            }
+        }
+
+        Ok(Frame {
+            command,
+            items: Vec::new(),
+            turn: world.turn_count,
+            score: world.player.score,
+            turn_advanced: dispatch.turn_advanced,
+            world_reloaded: dispatch.world_reloaded,
+            player_died,
+            quit,
+        })
+    }
+}
+
+// Sessions are meant to be moved onto worker threads.
+const _: fn() = || {
+    fn assert_send<T: Send>() {}
+    assert_send::<Session>();
+};
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::Location;
+    use crate::room::{Exit, Room};
+    use std::collections::{HashMap, HashSet};
+
+    fn room(symbol: &str) -> Room {
+        Room {
+            id: symbol.into(),
+            symbol: symbol.into(),
+            name: symbol.to_uppercase(),
+            base_description: format!("The {symbol} room.").into(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
+            scenery_default: None,
+            location: Location::Nowhere,
+            visited: false,
+            exits: HashMap::new(),
+            contents: HashSet::new(),
+            npcs: HashSet::new(),
+        }
+    }
+
+    fn two_room_session() -> Session {
+        let mut world = AmbleWorld::new_empty();
+        let mut hall = room("session_hall");
+        hall.exits.insert("north".into(), Exit::new("session_study".into()));
+        world.rooms.insert(hall.id, hall);
+        let study = room("session_study");
+        world.rooms.insert(study.id, study);
+        world.player.location = Location::Room("session_hall".into());
+        Session::new(world)
+    }
+
+    #[test]
+    fn send_moves_player_and_reports_turn_metadata() {
+        let mut session = two_room_session();
+        let frame = session.send("go north").expect("move failed");
+        assert_eq!(frame.command, Command::MoveTo("north".into()));
+        assert!(frame.turn_advanced);
+        assert_eq!(frame.turn, 2);
+        assert!(!frame.quit && !frame.player_died);
+        assert!(!frame.items.is_empty());
+        assert_eq!(session.world().player.location, Location::Room("session_study".into()));
+
+        let frame = session.send("go north").expect("blocked move failed");
+        assert!(!frame.turn_advanced);
+        assert_eq!(frame.turn, 2);
+    }
+
+    #[test]
+    fn sandboxed_session_refuses_local_only_commands() {
+        let mut session = Session::sandboxed(two_room_session().into_world());
+        for input in ["save slot", "load slot", "theme default"] {
+            let frame = session.send(input).expect("command failed");
+            assert!(frame.command.is_local_only(), "{input} should be local-only");
+            assert!(!frame.turn_advanced && !frame.world_reloaded);
+            assert!(matches!(frame.items.as_slice(), [ViewItem::Error(_)]));
+        }
+        assert_eq!(session.world().turn_count, 1);
+        assert!(session.send("go north").expect("move failed").turn_advanced);
+    }
+
+    #[test]
+    fn quit_is_reported_without_ending_the_session() {
+        let mut session = two_room_session();
+        let frame = session.send("quit").expect("quit failed");
+        assert!(frame.quit);
+        assert!(
+            frame
+                .items
+                .iter()
+                .any(|item| matches!(item, ViewItem::QuitSummary { .. }))
+        );
+    }
+}
@@ -2,9 +2,10 @@
 //!
 //! Random text generation system for varied game responses.
 //!
-//! Amble uses the `gametools` crate's `Spinner` module to provide variety
-//! in user feedback and intermittent ambient events. Spinners are weighted
-//! random text generators that help avoid repetitive messages.
+//! Spinners provide variety in user feedback and intermittent ambient events.
+//! They are weighted random text generators that help avoid repetitive
+//! messages, and they draw from the world's seedable [`WorldRng`] so scripted
+//! runs are reproducible.
 //!
 //! The engine now supports two types of spinners:
 //! - **Core spinners** (`CoreSpinnerType`) are essential for engine operation
@@ -18,7 +19,68 @@ use serde::de::{self, Deserializer};
 use serde::{Deserialize, Serialize, Serializer};
 use std::collections::HashMap;
 
-use gametools::{Spinner, Wedge};
+use crate::rng::WorldRng;
+
+/// One weighted outcome on a [`Spinner`].
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct Wedge<T> {
+    pub value: T,
+    /// Relative likelihood of this wedge; 0 never lands.
+    pub width: usize,
+}
+
+impl<T> Wedge<T> {
+    /// A wedge of width 1.
+    pub fn new(value: T) -> Self {
+        Self::new_weighted(value, 1)
+    }
+
+    /// A wedge with the given relative width.
+    pub fn new_weighted(value: T, width: usize) -> Self {
+        Self { value, width }
+    }
+}
+
+/// Weighted random picker over a set of [`Wedge`]s.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct Spinner<T> {
+    wedges: Vec<Wedge<T>>,
+}
+
+impl<T: Clone> Spinner<T> {
+    pub fn new(wedges: Vec<Wedge<T>>) -> Self {
+        Self { wedges }
+    }
+
+    /// A copy of this spinner with `wedge` added.
+    #[must_use]
+    pub fn add_wedge(&self, wedge: Wedge<T>) -> Self {
+        let mut wedges = self.wedges.clone();
+        wedges.push(wedge);
+        Self { wedges }
+    }
+
+    pub fn wedges(&self) -> &[Wedge<T>] {
+        &self.wedges
+    }
+
+    /// Pick a value with probability proportional to its wedge's width, or `None`
+    /// if the spinner has no width at all.
+    pub fn spin(&self, rng: &WorldRng) -> Option<T> {
+        let total: usize = self.wedges.iter().map(|wedge| wedge.width).sum();
+        if total == 0 {
+            return None;
+        }
+        let mut landing = rng.below(total);
+        for wedge in &self.wedges {
+            if landing < wedge.width {
+                return Some(wedge.value.clone());
+            }
+            landing -= wedge.width;
+        }
+        None
+    }
+}
 
 /// Core spinner types that are essential for the engine to function.
 /// These have built-in defaults but can be overridden in world data.
@@ -325,6 +387,21 @@ mod tests {
         assert_eq!(custom_spinner, SpinnerType::Custom("ambientForest".to_string()));
     }
 
+    #[test]
+    fn spin_is_weighted_and_reproducible() {
+        let spinner = Spinner::new(vec![Wedge::new_weighted("never", 0), Wedge::new_weighted("always", 3)]);
+        let rng = WorldRng::seeded(1);
+        assert!((0..50).all(|_| spinner.spin(&rng) == Some("always")));
+        assert_eq!(Spinner::<&str>::new(Vec::new()).spin(&rng), None);
+
+        let mixed = spinner.add_wedge(Wedge::new("sometimes"));
+        let run = |seed| {
+            let rng = WorldRng::seeded(seed);
+            (0..20).map(|_| mixed.spin(&rng)).collect::<Vec<_>>()
+        };
+        assert_eq!(run(9), run(9));
+    }
+
     #[test]
     fn spinner_type_convenience_methods() {
         let core = SpinnerType::Core(CoreSpinnerType::Movement);
@@ -7,7 +7,7 @@
 use colored::{ColoredString, Colorize};
 use textwrap::{Options, wrap_algorithms::Penalties};
 
-use crate::theme::current_theme_colors;
+use crate::theme::with_theme_colors;
 
 /// Returns `textwrap::Options` for an indented, wrapped block of text.
 pub fn indented_block() -> Options<'static> {
@@ -59,94 +59,78 @@ pub trait GameStyle {
 
 impl GameStyle for &str {
     fn prompt_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.prompt.to_color())
-            .on_color(colors.prompt_bg.to_color())
+        with_theme_colors(|colors| {
+            self.color(colors.prompt.to_color())
+                .on_color(colors.prompt_bg.to_color())
+        })
     }
 
     fn status_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.to_uppercase().color(colors.status.to_color())
+        with_theme_colors(|colors| self.to_uppercase().color(colors.status.to_color()))
     }
 
     fn transition_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.italic().color(colors.transition.to_color())
+        with_theme_colors(|colors| self.italic().color(colors.transition.to_color()))
     }
 
     fn item_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.item.to_color())
+        with_theme_colors(|colors| self.color(colors.item.to_color()))
     }
 
     fn item_text_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.item_text.to_color())
+        with_theme_colors(|colors| self.color(colors.item_text.to_color()))
     }
 
     fn npc_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.npc.to_color()).underline()
+        with_theme_colors(|colors| self.color(colors.npc.to_color()).underline())
     }
 
     fn room_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.room.to_color())
+        with_theme_colors(|colors| self.color(colors.room.to_color()))
     }
 
     fn room_titlebar_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.room_titlebar.to_color()).underline()
+        with_theme_colors(|colors| self.color(colors.room_titlebar.to_color()).underline())
     }
 
     fn description_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.description.to_color())
+        with_theme_colors(|colors| self.color(colors.description.to_color()))
     }
 
     fn triggered_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.italic().color(colors.triggered.to_color())
+        with_theme_colors(|colors| self.italic().color(colors.triggered.to_color()))
     }
 
     fn trig_icon_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.bold().color(colors.trig_icon.to_color())
+        with_theme_colors(|colors| self.bold().color(colors.trig_icon.to_color()))
     }
 
     fn ambient_icon_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.dimmed().color(colors.ambient_icon.to_color())
+        with_theme_colors(|colors| self.dimmed().color(colors.ambient_icon.to_color()))
     }
 
     fn ambient_trig_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.ambient_trig.to_color()).dimmed()
+        with_theme_colors(|colors| self.color(colors.ambient_trig.to_color()).dimmed())
     }
 
     fn exit_visited_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.italic().color(colors.exit_visited.to_color())
+        with_theme_colors(|colors| self.italic().color(colors.exit_visited.to_color()))
     }
 
     fn exit_locked_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.italic().color(colors.exit_locked.to_color())
+        with_theme_colors(|colors| self.italic().color(colors.exit_locked.to_color()))
     }
 
     fn exit_unvisited_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.italic().color(colors.exit_unvisited.to_color())
+        with_theme_colors(|colors| self.italic().color(colors.exit_unvisited.to_color()))
     }
 
     fn error_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.error.to_color())
+        with_theme_colors(|colors| self.color(colors.error.to_color()))
     }
 
     fn error_icon_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.error_icon.to_color())
+        with_theme_colors(|colors| self.color(colors.error_icon.to_color()))
     }
 
     fn subheading_style(&self) -> ColoredString {
@@ -154,44 +138,38 @@ impl GameStyle for &str {
     }
 
     fn goal_active_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.goal_active.to_color())
+        with_theme_colors(|colors| self.color(colors.goal_active.to_color()))
     }
 
     fn goal_complete_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.goal_complete.to_color()).strikethrough()
+        with_theme_colors(|colors| self.color(colors.goal_complete.to_color()).strikethrough())
     }
 
     fn denied_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.italic().color(colors.denied.to_color())
+        with_theme_colors(|colors| self.italic().color(colors.denied.to_color()))
     }
 
     fn overlay_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.overlay.to_color())
+        with_theme_colors(|colors| self.color(colors.overlay.to_color()))
     }
 
     fn section_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        let bracketed = format!("[{self}]");
-        bracketed.color(colors.section.to_color())
+        with_theme_colors(|colors| {
+            let bracketed = format!("[{self}]");
+            bracketed.color(colors.section.to_color())
+        })
     }
 
     fn npc_quote_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.italic().color(colors.npc_quote.to_color())
+        with_theme_colors(|colors| self.italic().color(colors.npc_quote.to_color()))
     }
 
     fn highlight(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.color(colors.highlight.to_color())
+        with_theme_colors(|colors| self.color(colors.highlight.to_color()))
     }
 
     fn npc_movement_style(&self) -> ColoredString {
-        let colors = current_theme_colors();
-        self.italic().color(colors.npc_movement.to_color())
+        with_theme_colors(|colors| self.italic().color(colors.npc_movement.to_color()))
     }
 }
 
@@ -9,9 +9,11 @@ use crate::data_paths::data_path;
 use anyhow::{Context, Result};
 use colored::Color;
 use serde::{Deserialize, Serialize};
+use std::cell::RefCell;
 use std::collections::HashMap;
 use std::fs;
 use std::path::Path;
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::{Arc, LazyLock, RwLock};
 
 /// RGB color representation for theme configuration
@@ -232,6 +234,7 @@ impl ThemeManager {
             .write()
             .map_err(|_| anyhow::anyhow!("Failed to acquire theme lock"))?;
         *current = theme.clone();
+        publish_palette(theme.colors.clone());
 
         Ok(())
     }
@@ -274,14 +277,69 @@ pub fn init_themes() -> Result<()> {
     Ok(())
 }
 
+/// Published palette of the active theme, replaced wholesale on theme switch.
+static ACTIVE_PALETTE: LazyLock<RwLock<Arc<ThemeColors>>> = LazyLock::new(|| RwLock::new(Arc::default()));
+/// Bumped after every publish so threads know their cached palette is out of date.
+static PALETTE_EPOCH: AtomicU64 = AtomicU64::new(0);
+
+thread_local! {
+    /// This thread's copy of the active palette and the epoch it was taken at.
+    static CACHED_PALETTE: RefCell<Option<(u64, Arc<ThemeColors>)>> = const { RefCell::new(None) };
+}
+
+/// Make `colors` the palette used by all styling, on every thread.
+pub fn publish_palette(colors: ThemeColors) {
+    if let Ok(mut active) = ACTIVE_PALETTE.write() {
+        *active = Arc::new(colors);
+    }
+    PALETTE_EPOCH.fetch_add(1, Ordering::Release);
+}
+
+/// Run `f` with the active theme's palette.
+///
+/// Styling calls this for every styled string, so the common path only checks an
+/// atomic epoch against a thread-local snapshot: no locks are taken and nothing
+/// is cloned unless the theme has changed since this thread last looked.
+pub fn with_theme_colors<R>(f: impl FnOnce(&ThemeColors) -> R) -> R {
+    let epoch = PALETTE_EPOCH.load(Ordering::Acquire);
+    CACHED_PALETTE.with(|cache| {
+        let mut cache = cache.borrow_mut();
+        let palette = match cache.as_ref() {
+            Some((cached_epoch, palette)) if *cached_epoch == epoch => Arc::clone(palette),
+            _ => {
+                let palette = ACTIVE_PALETTE
+                    .read()
+                    .map_or_else(|_| Arc::default(), |active| Arc::clone(&active));
+                *cache = Some((epoch, Arc::clone(&palette)));
+                palette
+            },
+        };
+        drop(cache);
+        f(&palette)
+    })
+}
+
 /// Snapshot the color palette for the active theme, defaulting if unavailable.
 pub fn current_theme_colors() -> ThemeColors {
-    THEME_MANAGER
-        .read()
-        .ok()
-        .and_then(|m| {
-            let current = m.current();
-            current.read().ok().map(|t| t.colors.clone())
-        })
-        .unwrap_or_default()
+    with_theme_colors(ThemeColors::clone)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn published_palette_is_seen_by_styling() {
+        let mut colors = ThemeColors::default();
+        colors.item = ThemeColor::new(1, 2, 3);
+        publish_palette(colors);
+        assert_eq!(with_theme_colors(|c| (c.item.r, c.item.g, c.item.b)), (1, 2, 3));
+
+        // other threads pick up the new palette too
+        let seen = std::thread::spawn(|| with_theme_colors(|c| c.item.b)).join().unwrap();
+        assert_eq!(seen, 3);
+
+        publish_palette(ThemeColors::default());
+        assert_eq!(with_theme_colors(|c| c.item.r), ThemeColors::default().item.r);
+    }
 }
@@ -0,0 +1,261 @@
+//! Change-tracking map used for the world's entity tables.
+//!
+//! [`TrackedMap`] wraps a `HashMap` and records which keys have been handed out
+//! mutably, inserted or removed since the last time changes were taken. The
+//! autosave journal uses this to write only the entities touched during a turn.
+//!
+//! Read access goes through `Deref` to the inner map, so existing lookups are
+//! unchanged. The common mutating methods (`get_mut`, `insert`, `remove`,
+//! `entry`) record the affected key; anything else that needs `&mut HashMap`
+//! (via `DerefMut`) conservatively marks the whole map as changed.
+//!
+//! Every mutable access also stamps the map with a new [`revision`](TrackedMap::revision),
+//! which derived caches (such as entity search scopes) compare to know when to rebuild.
+
+use serde::{Deserialize, Deserializer, Serialize, Serializer};
+use std::collections::HashSet;
+use std::collections::hash_map::{self, Entry, HashMap};
+use std::hash::Hash;
+use std::ops::{Deref, DerefMut};
+use std::sync::atomic::{AtomicU64, Ordering};
+
+/// Source of revision stamps, shared by all maps so two different map states never
+/// carry the same stamp (even when one map replaces another wholesale).
+static NEXT_REVISION: AtomicU64 = AtomicU64::new(1);
+
+pub(crate) fn next_revision() -> u64 {
+    NEXT_REVISION.fetch_add(1, Ordering::Relaxed)
+}
+
+/// Keys changed since changes were last taken.
+#[derive(Debug, Clone)]
+pub enum MapChanges<K> {
+    /// Only these keys were touched (each is now present or removed).
+    Keys(HashSet<K>),
+    /// The map may have changed arbitrarily.
+    All,
+}
+
+impl<K: Eq + Hash> PartialEq for MapChanges<K> {
+    fn eq(&self, other: &Self) -> bool {
+        match (self, other) {
+            (MapChanges::Keys(a), MapChanges::Keys(b)) => a == b,
+            (MapChanges::All, MapChanges::All) => true,
+            _ => false,
+        }
+    }
+}
+
+impl<K: Eq + Hash> Eq for MapChanges<K> {}
+
+/// A `HashMap` that records which keys were mutated.
+#[derive(Debug, Clone)]
+pub struct TrackedMap<K, V> {
+    map: HashMap<K, V>,
+    changed: HashSet<K>,
+    all_changed: bool,
+    revision: u64,
+}
+
+impl<K, V> Default for TrackedMap<K, V> {
+    fn default() -> Self {
+        HashMap::new().into()
+    }
+}
+
+impl<K, V> TrackedMap<K, V> {
+    /// Stamp that changes whenever the map may have been mutated.
+    pub fn revision(&self) -> u64 {
+        self.revision
+    }
+}
+
+impl<K: Eq + Hash + Clone, V> TrackedMap<K, V> {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Mutable access to a value, marking its key as changed.
+    pub fn get_mut(&mut self, key: &K) -> Option<&mut V> {
+        let value = self.map.get_mut(key)?;
+        self.revision = next_revision();
+        if !self.all_changed {
+            self.changed.insert(key.clone());
+        }
+        Some(value)
+    }
+
+    /// Insert a value, marking its key as changed.
+    pub fn insert(&mut self, key: K, value: V) -> Option<V> {
+        self.revision = next_revision();
+        if !self.all_changed {
+            self.changed.insert(key.clone());
+        }
+        self.map.insert(key, value)
+    }
+
+    /// Remove a value, marking its key as changed.
+    pub fn remove(&mut self, key: &K) -> Option<V> {
+        let removed = self.map.remove(key)?;
+        self.revision = next_revision();
+        if !self.all_changed {
+            self.changed.insert(key.clone());
+        }
+        Some(removed)
+    }
+
+    /// Entry API access, marking the key as changed.
+    pub fn entry(&mut self, key: K) -> Entry<'_, K, V> {
+        self.revision = next_revision();
+        if !self.all_changed {
+            self.changed.insert(key.clone());
+        }
+        self.map.entry(key)
+    }
+
+    /// Mutable iteration over values; marks the whole map as changed.
+    pub fn values_mut(&mut self) -> hash_map::ValuesMut<'_, K, V> {
+        self.mark_all_changed();
+        self.map.values_mut()
+    }
+
+    /// Mutable iteration over entries; marks the whole map as changed.
+    pub fn iter_mut(&mut self) -> hash_map::IterMut<'_, K, V> {
+        self.mark_all_changed();
+        self.map.iter_mut()
+    }
+
+    /// Return the changes recorded since the last call and reset tracking.
+    pub fn take_changes(&mut self) -> MapChanges<K> {
+        if std::mem::take(&mut self.all_changed) {
+            self.changed.clear();
+            MapChanges::All
+        } else {
+            MapChanges::Keys(std::mem::take(&mut self.changed))
+        }
+    }
+
+    /// Forget any recorded changes (e.g. after writing a full snapshot).
+    pub fn clear_changes(&mut self) {
+        self.changed.clear();
+        self.all_changed = false;
+    }
+
+    fn mark_all_changed(&mut self) {
+        self.revision = next_revision();
+        self.all_changed = true;
+        self.changed.clear();
+    }
+}
+
+impl<K, V> Deref for TrackedMap<K, V> {
+    type Target = HashMap<K, V>;
+
+    fn deref(&self) -> &Self::Target {
+        &self.map
+    }
+}
+
+impl<K: Eq + Hash + Clone, V> DerefMut for TrackedMap<K, V> {
+    fn deref_mut(&mut self) -> &mut Self::Target {
+        self.mark_all_changed();
+        &mut self.map
+    }
+}
+
+impl<K, V> From<HashMap<K, V>> for TrackedMap<K, V> {
+    fn from(map: HashMap<K, V>) -> Self {
+        Self {
+            map,
+            changed: HashSet::new(),
+            all_changed: false,
+            revision: next_revision(),
+        }
+    }
+}
+
+impl<K: Eq + Hash, V> FromIterator<(K, V)> for TrackedMap<K, V> {
+    fn from_iter<I: IntoIterator<Item = (K, V)>>(iter: I) -> Self {
+        HashMap::from_iter(iter).into()
+    }
+}
+
+impl<'a, K, V> IntoIterator for &'a TrackedMap<K, V> {
+    type Item = (&'a K, &'a V);
+    type IntoIter = hash_map::Iter<'a, K, V>;
+
+    fn into_iter(self) -> Self::IntoIter {
+        self.map.iter()
+    }
+}
+
+impl<K: Serialize + Eq + Hash, V: Serialize> Serialize for TrackedMap<K, V> {
+    fn serialize<S: Serializer>(&self, serializer: S) -> Result<S::Ok, S::Error> {
+        self.map.serialize(serializer)
+    }
+}
+
+impl<'de, K: Deserialize<'de> + Eq + Hash, V: Deserialize<'de>> Deserialize<'de> for TrackedMap<K, V> {
+    fn deserialize<D: Deserializer<'de>>(deserializer: D) -> Result<Self, D::Error> {
+        HashMap::deserialize(deserializer).map(Self::from)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn records_touched_keys_only() {
+        let mut map: TrackedMap<&str, i32> = [("a", 1), ("b", 2), ("c", 3)].into_iter().collect();
+        *map.get_mut(&"a").unwrap() += 10;
+        map.insert("d", 4);
+        map.remove(&"b");
+        assert!(map.get_mut(&"missing").is_none());
+        assert_eq!(map.get("a"), Some(&11));
+
+        let MapChanges::Keys(keys) = map.take_changes() else {
+            panic!("expected key-level changes");
+        };
+        assert_eq!(keys, HashSet::from(["a", "b", "d"]));
+        assert_eq!(map.take_changes(), MapChanges::Keys(HashSet::new()));
+    }
+
+    #[test]
+    fn untracked_mutation_marks_everything() {
+        let mut map: TrackedMap<&str, i32> = [("a", 1)].into_iter().collect();
+        map.retain(|_, v| *v > 5);
+        assert_eq!(map.take_changes(), MapChanges::All);
+
+        for value in map.values_mut() {
+            *value += 1;
+        }
+        assert_eq!(map.take_changes(), MapChanges::All);
+    }
+
+    #[test]
+    fn revision_changes_on_mutable_access_only() {
+        let mut map: TrackedMap<&str, i32> = [("a", 1)].into_iter().collect();
+        let start = map.revision();
+        let _ = map.get(&"a");
+        assert_eq!(map.revision(), start);
+
+        map.get_mut(&"a");
+        let after_get_mut = map.revision();
+        assert_ne!(after_get_mut, start);
+        map.clear_changes();
+        assert_eq!(map.revision(), after_get_mut);
+        map.values_mut();
+        assert_ne!(map.revision(), after_get_mut);
+        assert_ne!(TrackedMap::<&str, i32>::new().revision(), map.revision());
+    }
+
+    #[test]
+    fn serializes_as_plain_map() {
+        let map: TrackedMap<String, i32> = [("a".to_string(), 1)].into_iter().collect();
+        let text = ron::to_string(&map).unwrap();
+        assert_eq!(text, ron::to_string(&*map).unwrap());
+        let back: TrackedMap<String, i32> = ron::from_str(&text).unwrap();
+        assert_eq!(*back, *map);
+    }
+}
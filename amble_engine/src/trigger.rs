@@ -5,10 +5,16 @@
 
 pub mod action;
 pub mod condition;
+pub mod index;
+pub mod program;
 
 pub use action::*;
 pub use condition::*;
+pub use index::{EventKind, TriggerIndex};
+pub use program::{CompiledCondition, ConditionProgram};
 
+use crate::content::Shared;
+use crate::profiler::{self, Phase, profile_eval};
 use crate::{AmbleWorld, View, helpers::plural_s};
 use anyhow::Result;
 
@@ -20,16 +26,25 @@ use serde::{Deserialize, Serialize};
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct Trigger {
     pub name: String,
-    pub conditions: EventCondition,
-    pub actions: Vec<ScriptedAction>,
+    #[serde(default = "pending_conditions", skip_serializing_if = "Shared::is_content")]
+    pub conditions: Shared<EventCondition>,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub actions: Shared<Vec<ScriptedAction>>,
     pub only_once: bool,
     pub fired: bool,
 }
 
+/// Placeholder for trigger conditions omitted from a save: matches nothing until restored.
+fn pending_conditions() -> Shared<EventCondition> {
+    Shared::pending_with(EventCondition::Any(Vec::new()))
+}
+
 /// Evaluate triggers against recent events and world state, execute any matching actions, and return the fired set.
 /// - The provided `events` slice represents instantaneous "event" conditions (e.g., player enters a room).
 /// - Persistent predicates (e.g. player is missing an item) are checked via [`TriggerCondition::is_ongoing`].
 /// - Each `Trigger` whose conditions are met has its actions dispatched in order, respecting the `only_once` flag.
+/// - Only candidates from the world's [`TriggerIndex`] for the supplied events (plus state-based triggers)
+///   are evaluated.
 ///
 /// # Errors
 /// - Propagates failures from action dispatch such as missing id references.
@@ -38,6 +53,10 @@ pub fn check_triggers<'a>(
     view: &mut View,
     events: &[TriggerCondition],
 ) -> Result<Vec<&'a Trigger>> {
+    let _phase = profiler::time_phase(Phase::Triggers);
+    world
+        .trigger_index
+        .ensure_current(&world.triggers, world.triggers_revision);
     let fire_plan = make_fire_plan(world, events);
     log_firing_triggers(&world.triggers, &fire_plan);
     fire_planned_actions(world, view, &fire_plan)?;
@@ -62,8 +81,40 @@ pub struct FirePlan {
     action_list: Vec<ScriptedAction>,
 }
 
+impl FirePlan {
+    /// Indices (into `world.triggers`) of the triggers selected to fire.
+    pub fn trigger_indices(&self) -> &[usize] {
+        &self.trig_indices
+    }
+}
+
 /// Construct a `FirePlan` from triggers and current world state.
-fn make_fire_plan(world: &AmbleWorld, events: &[TriggerCondition]) -> FirePlan {
+///
+/// Uses the trigger index when it is current, otherwise falls back to a full scan.
+pub fn make_fire_plan(world: &AmbleWorld, events: &[TriggerCondition]) -> FirePlan {
+    if !world
+        .trigger_index
+        .is_current(world.triggers.len(), world.triggers_revision)
+    {
+        return make_fire_plan_full_scan(world, events);
+    }
+    let trig_indices: Vec<_> = world
+        .trigger_index
+        .candidates(events)
+        .into_iter()
+        .filter(|idx| {
+            let t = &world.triggers[*idx];
+            (!t.only_once || !t.fired)
+                && profile_eval(&t.name, || {
+                    world.trigger_index.program(*idx).eval_with_events(world, events)
+                })
+        })
+        .collect();
+    plan_from_indices(world, trig_indices)
+}
+
+/// Construct a `FirePlan` by evaluating every non-ambient trigger in the world.
+pub fn make_fire_plan_full_scan(world: &AmbleWorld, events: &[TriggerCondition]) -> FirePlan {
     let trig_indices: Vec<_> = world
         .triggers
         .iter()
@@ -73,14 +124,18 @@ fn make_fire_plan(world: &AmbleWorld, events: &[TriggerCondition]) -> FirePlan {
                 && !t
                     .conditions
                     .any_trigger(|cond| matches!(cond, TriggerCondition::Ambient { .. }))
-                && t.conditions.eval_with_events(world, events)
+                && profile_eval(&t.name, || t.conditions.eval_with_events(world, events))
         })
         .map(|(idx, _)| idx)
         .collect();
+    plan_from_indices(world, trig_indices)
+}
 
+/// Gather the actions for the selected triggers into a `FirePlan`.
+fn plan_from_indices(world: &AmbleWorld, trig_indices: Vec<usize>) -> FirePlan {
     let action_list: Vec<_> = trig_indices
         .iter()
-        .flat_map(|i| world.triggers[*i].actions.clone())
+        .flat_map(|i| world.triggers[*i].actions.iter().cloned())
         .collect();
 
     FirePlan {
@@ -143,8 +198,8 @@ mod tests {
             symbol: "r1".into(),
             name: "Room1".into(),
             base_description: "Room1".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -157,8 +212,8 @@ mod tests {
             symbol: "r2".into(),
             name: "Room2".into(),
             base_description: "Room2".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -178,8 +233,8 @@ mod tests {
         let mut view = View::new();
         let trigger = Trigger {
             name: "move".into(),
-            conditions: EventCondition::Trigger(TriggerCondition::Enter(start_id.clone())),
-            actions: vec![ScriptedAction::new(TriggerAction::PushPlayerTo(dest_id.clone()))],
+            conditions: EventCondition::Trigger(TriggerCondition::Enter(start_id.clone())).into(),
+            actions: vec![ScriptedAction::new(TriggerAction::PushPlayerTo(dest_id.clone()))].into(),
             only_once: true,
             fired: false,
         };
@@ -201,15 +256,15 @@ mod tests {
         let (mut world, room1_id, room2_id) = build_test_world();
         let trigger1 = Trigger {
             name: "t1".into(),
-            conditions: EventCondition::Trigger(TriggerCondition::Enter(room1_id.clone())),
-            actions: vec![],
+            conditions: EventCondition::Trigger(TriggerCondition::Enter(room1_id.clone())).into(),
+            actions: vec![].into(),
             only_once: false,
             fired: false,
         };
         let trigger2 = Trigger {
             name: "t2".into(),
-            conditions: EventCondition::Trigger(TriggerCondition::Enter(room2_id.clone())),
-            actions: vec![],
+            conditions: EventCondition::Trigger(TriggerCondition::Enter(room2_id.clone())).into(),
+            actions: vec![].into(),
             only_once: false,
             fired: false,
         };
@@ -234,11 +289,12 @@ mod tests {
 
         world.triggers.push(Trigger {
             name: "score_once".into(),
-            conditions: EventCondition::Trigger(TriggerCondition::Enter(room_id.clone())),
+            conditions: EventCondition::Trigger(TriggerCondition::Enter(room_id.clone())).into(),
             actions: vec![ScriptedAction::new(TriggerAction::AwardPoints {
                 amount: 5,
                 reason: "first entry".into(),
-            })],
+            })]
+            .into(),
             only_once: true,
             fired: false,
         });
@@ -269,22 +325,25 @@ mod tests {
             conditions: EventCondition::Trigger(TriggerCondition::Ambient {
                 room_ids: HashSet::new(),
                 spinner: SpinnerType::Core(CoreSpinnerType::Movement),
-            }),
+            })
+            .into(),
             actions: vec![ScriptedAction::new(TriggerAction::AwardPoints {
                 amount: 100,
                 reason: "ambient shouldn't fire".into(),
-            })],
+            })]
+            .into(),
             only_once: false,
             fired: false,
         });
 
         world.triggers.push(Trigger {
             name: "enter_bonus".into(),
-            conditions: EventCondition::Trigger(TriggerCondition::Enter(room_id.clone())),
+            conditions: EventCondition::Trigger(TriggerCondition::Enter(room_id.clone())).into(),
             actions: vec![ScriptedAction::new(TriggerAction::AwardPoints {
                 amount: 3,
                 reason: "entered".into(),
-            })],
+            })]
+            .into(),
             only_once: false,
             fired: false,
         });
@@ -302,6 +361,47 @@ mod tests {
         assert!(!world.triggers[0].fired, "ambient trigger should remain unfired");
     }
 
+    #[test]
+    fn indexed_plan_matches_full_scan() {
+        let (mut world, room1_id, room2_id) = build_test_world();
+        world.player.flags.insert(crate::player::Flag::simple("lit", 0));
+        let conditions = [
+            EventCondition::Trigger(TriggerCondition::Enter(room1_id.clone())),
+            EventCondition::Trigger(TriggerCondition::Enter(room2_id.clone())),
+            EventCondition::Trigger(TriggerCondition::HasFlag("lit".into())),
+            EventCondition::Any(vec![
+                EventCondition::Trigger(TriggerCondition::Leave(room2_id.clone())),
+                EventCondition::Trigger(TriggerCondition::HasFlag("dark".into())),
+            ]),
+            EventCondition::All(vec![
+                EventCondition::Trigger(TriggerCondition::Enter(room1_id.clone())),
+                EventCondition::Trigger(TriggerCondition::HasFlag("lit".into())),
+            ]),
+        ];
+        for (i, conditions) in conditions.into_iter().enumerate() {
+            world.triggers.push(Trigger {
+                name: format!("t{i}"),
+                conditions: conditions.into(),
+                actions: vec![].into(),
+                only_once: false,
+                fired: false,
+            });
+        }
+        world.trigger_index = TriggerIndex::build(&world.triggers, world.triggers_revision);
+        for events in [
+            vec![],
+            vec![TriggerCondition::Enter(room1_id.clone())],
+            vec![
+                TriggerCondition::Enter(room2_id.clone()),
+                TriggerCondition::Leave(room1_id.clone()),
+            ],
+        ] {
+            let indexed = make_fire_plan(&world, &events);
+            let scanned = make_fire_plan_full_scan(&world, &events);
+            assert_eq!(indexed.trigger_indices(), scanned.trigger_indices());
+        }
+    }
+
     #[test]
     fn repeating_triggers_fire_even_if_marked_fired() {
         let (mut world, room_id, _) = build_test_world();
@@ -310,11 +410,12 @@ mod tests {
 
         world.triggers.push(Trigger {
             name: "repeatable".into(),
-            conditions: EventCondition::Trigger(TriggerCondition::Enter(room_id.clone())),
+            conditions: EventCondition::Trigger(TriggerCondition::Enter(room_id.clone())).into(),
             actions: vec![ScriptedAction::new(TriggerAction::AwardPoints {
                 amount: 2,
                 reason: "repeat".into(),
-            })],
+            })]
+            .into(),
             only_once: false,
             fired: true,
         });
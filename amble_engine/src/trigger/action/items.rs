@@ -84,7 +84,7 @@ pub fn set_item_description(world: &mut AmbleWorld, item_id: &ItemId, text: &str
     let item = world
         .get_item_mut(item_id)
         .with_context(|| format!("changing item '{item_id} description"))?;
-    item.description = text.to_string();
+    item.description.set(text.to_string());
     info!(
         "└─ action: SetItemDescription({}, \"{}\")",
         symbol_or_unknown(&world.items, item_id.clone()),
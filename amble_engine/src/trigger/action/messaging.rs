@@ -1,20 +1,21 @@
+use crate::spinners::{Spinner, Wedge};
 use anyhow::{Context, Result, bail};
-use gametools::{Spinner, Wedge};
 use log::info;
-use std::collections::HashMap;
-use std::hash::BuildHasher;
 
+use crate::content::Shared;
 use crate::spinners::SpinnerType;
 use crate::style::GameStyle;
+use crate::tracked_map::TrackedMap;
 use crate::view::{View, ViewItem};
 use crate::world::AmbleWorld;
 
-/// Adds a weighted text option ("wedge") to a random text spinner.
+/// Adds a weighted text option ("wedge") to a random text spinner, recording the
+/// changed spinner as a content override.
 ///
 /// # Errors
 /// Returns an error if the specified spinner type doesn't exist.
-pub fn add_spinner_wedge<S: BuildHasher>(
-    spinners: &mut HashMap<SpinnerType, Spinner<String>, S>,
+pub fn add_spinner_wedge(
+    spinners: &mut TrackedMap<SpinnerType, Shared<Spinner<String>>>,
     spin_type: &SpinnerType,
     text: &str,
     width: usize,
@@ -23,7 +24,8 @@ pub fn add_spinner_wedge<S: BuildHasher>(
     let spinref = spinners
         .get_mut(spin_type)
         .with_context(|| format!("add_spinner_wedge(_, {spin_type:?}, _, _): spinner not found"))?;
-    *spinref = spinref.add_wedge(wedge);
+    let updated = spinref.add_wedge(wedge);
+    spinref.set(updated);
     info!("└─ action: AddSpinnerWedge({spin_type:?}, \"{text}\"");
     Ok(())
 }
@@ -39,7 +41,7 @@ pub fn spinner_message(
     priority: Option<isize>,
 ) -> Result<()> {
     if let Some(spinner) = world.spinners.get(spinner_type) {
-        let msg = spinner.spin().unwrap_or_default();
+        let msg = spinner.spin(&world.rng).unwrap_or_default();
         if !msg.is_empty() {
             view.push_with_custom_priority(
                 ViewItem::AmbientEvent(format!("{}", msg.ambient_trig_style())),
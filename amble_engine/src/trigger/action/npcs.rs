@@ -106,7 +106,7 @@ pub fn npc_says_random(world: &AmbleWorld, view: &mut View, npc_id: &NpcId, prio
         .spinners
         .get(&SpinnerType::Core(CoreSpinnerType::NpcIgnore))
         .with_context(|| "failed lookup of NpcIgnore spinner".to_string())?;
-    let line = npc.random_dialogue(ignore_spinner);
+    let line = npc.random_dialogue(&world.rng, ignore_spinner);
     view.push_with_custom_priority(
         ViewItem::NpcSpeech {
             speaker: npc.name().to_string(),
@@ -176,7 +176,7 @@ fn apply_room_patch(world: &mut AmbleWorld, room_id: &RoomId, patch: &RoomPatch)
     }
 
     if let Some(ref new_desc) = patch.desc {
-        room.base_description.clone_from(new_desc);
+        room.base_description.set(new_desc.clone());
     }
 
     for (direction, _) in &removal_plan {
@@ -207,7 +207,7 @@ fn apply_npc_patch(world: &mut AmbleWorld, npc_id: &NpcId, patch: &NpcPatch) ->
         npc.name.clone_from(new_name);
     }
     if let Some(ref new_desc) = patch.desc {
-        npc.description.clone_from(new_desc);
+        npc.description.set(new_desc.clone());
     }
     if let Some(ref new_state) = patch.state {
         npc.state = new_state.clone();
@@ -331,11 +331,11 @@ fn apply_item_patch(world: &mut AmbleWorld, item_id: &ItemId, patch: &ItemPatch)
     }
 
     if let Some(ref new_desc) = patch.desc {
-        patched.description.clone_from(new_desc);
+        patched.description.set(new_desc.clone());
     }
 
     if patch.text.is_some() {
-        patched.text.clone_from(&patch.text);
+        patched.text.set(patch.text.clone());
     }
 
     if let Some(ref new_mov) = patch.movability {
@@ -346,8 +346,8 @@ fn apply_item_patch(world: &mut AmbleWorld, item_id: &ItemId, patch: &ItemPatch)
         patched.visibility = new_visibility;
     }
 
-    if patch.visible_when.is_some() {
-        patched.visible_when.clone_from(&patch.visible_when);
+    if let Some(visible_when) = &patch.visible_when {
+        patched.visible_when = Some(visible_when.clone().into());
     }
 
     if let Some(new_aliases) = &patch.aliases {
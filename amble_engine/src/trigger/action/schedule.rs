@@ -74,7 +74,7 @@ pub fn schedule_in_if(
     world.scheduler.schedule_in_if(
         world.turn_count,
         turns_ahead + 1,
-        Some(condition.clone()),
+        Some(condition.clone().into()),
         on_false,
         actions.to_vec(),
         note,
@@ -100,9 +100,13 @@ pub fn schedule_on_if(
         "└─ action: ScheduleOnIf(turn {on_turn}, {} actions, on_false={on_false:?}): \"{log_note}\"",
         actions.len()
     );
-    world
-        .scheduler
-        .schedule_on_if(on_turn, Some(condition.clone()), on_false, actions.to_vec(), note);
+    world.scheduler.schedule_on_if(
+        on_turn,
+        Some(condition.clone().into()),
+        on_false,
+        actions.to_vec(),
+        note,
+    );
     Ok(())
 }
 
@@ -216,7 +220,7 @@ pub fn schedule_in_if_flag_set(
     actions: &[ScriptedAction],
     note: Option<String>,
 ) -> Result<()> {
-    let condition = EventCondition::Trigger(TriggerCondition::HasFlag(flag.to_string()));
+    let condition = EventCondition::Trigger(TriggerCondition::HasFlag(flag.into()));
     schedule_in_if(world, view, turns_ahead, &condition, on_false, actions, note)
 }
 
@@ -230,7 +234,7 @@ pub fn schedule_on_if_flag_set(
     actions: &[ScriptedAction],
     note: Option<String>,
 ) -> Result<()> {
-    let condition = EventCondition::Trigger(TriggerCondition::HasFlag(flag.to_string()));
+    let condition = EventCondition::Trigger(TriggerCondition::HasFlag(flag.into()));
     schedule_on_if(world, view, on_turn, &condition, on_false, actions, note)
 }
 
@@ -244,7 +248,7 @@ pub fn schedule_in_if_flag_missing(
     actions: &[ScriptedAction],
     note: Option<String>,
 ) -> Result<()> {
-    let condition = EventCondition::Trigger(TriggerCondition::MissingFlag(flag.to_string()));
+    let condition = EventCondition::Trigger(TriggerCondition::MissingFlag(flag.into()));
     schedule_in_if(world, view, turns_ahead, &condition, on_false, actions, note)
 }
 
@@ -258,6 +262,6 @@ pub fn schedule_on_if_flag_missing(
     actions: &[ScriptedAction],
     note: Option<String>,
 ) -> Result<()> {
-    let condition = EventCondition::Trigger(TriggerCondition::MissingFlag(flag.to_string()));
+    let condition = EventCondition::Trigger(TriggerCondition::MissingFlag(flag.into()));
     schedule_on_if(world, view, on_turn, &condition, on_false, actions, note)
 }
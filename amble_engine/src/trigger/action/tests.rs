@@ -1,4 +1,5 @@
 use super::*;
+use crate::spinners::{Spinner, Wedge};
 use crate::{
     health::{HealthEffect, HealthState, LivingEntity},
     item::{ContainerState, Item},
@@ -8,7 +9,6 @@ use crate::{
     view::{View, ViewItem},
     world::{AmbleWorld, Location},
 };
-use gametools::{Spinner, Wedge};
 use std::collections::{HashMap, HashSet};
 
 fn build_test_world() -> (AmbleWorld, RoomId, RoomId) {
@@ -21,8 +21,8 @@ fn build_test_world() -> (AmbleWorld, RoomId, RoomId) {
         symbol: "r1".into(),
         name: "Room1".into(),
         base_description: "Room1".into(),
-        overlays: Vec::new(),
-        scenery: Vec::new(),
+        overlays: Vec::new().into(),
+        scenery: Vec::new().into(),
         scenery_default: None,
         location: Location::Nowhere,
         visited: false,
@@ -35,8 +35,8 @@ fn build_test_world() -> (AmbleWorld, RoomId, RoomId) {
         symbol: "r2".into(),
         name: "Room2".into(),
         base_description: "Room2".into(),
-        overlays: Vec::new(),
-        scenery: Vec::new(),
+        overlays: Vec::new().into(),
+        scenery: Vec::new().into(),
         scenery_default: None,
         location: Location::Nowhere,
         visited: false,
@@ -55,7 +55,7 @@ fn make_item(id: ItemId, location: Location, container_state: Option<ContainerSt
         id,
         symbol: "it".into(),
         name: "Item".into(),
-        description: String::new(),
+        description: String::new().into(),
         location,
         visibility: crate::item::ItemVisibility::Listed,
         visible_when: None,
@@ -65,7 +65,7 @@ fn make_item(id: ItemId, location: Location, container_state: Option<ContainerSt
         contents: HashSet::new(),
         abilities: HashSet::new(),
         interaction_requires: HashMap::new(),
-        text: None,
+        text: None.into(),
         consumable: None,
     }
 }
@@ -75,10 +75,10 @@ fn make_npc(id: NpcId, location: Location, state: NpcState) -> Npc {
         id,
         symbol: "n".into(),
         name: "Npc".into(),
-        description: String::new(),
+        description: String::new().into(),
         location,
         inventory: HashSet::new(),
-        dialogue: HashMap::new(),
+        dialogue: HashMap::new().into(),
         state,
         movement: None,
         health: HealthState::new_at_max(10),
@@ -98,8 +98,8 @@ fn modify_room_updates_name_desc_and_exits() {
             symbol: "lab".into(),
             name: "Lab".into(),
             base_description: "Original description".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -115,8 +115,8 @@ fn modify_room_updates_name_desc_and_exits() {
             symbol: "hall".into(),
             name: "Hall".into(),
             base_description: "Hall".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -132,8 +132,8 @@ fn modify_room_updates_name_desc_and_exits() {
             symbol: "vault".into(),
             name: "Vault".into(),
             base_description: "Vault".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -181,8 +181,8 @@ fn modify_room_missing_exit_ok() {
             symbol: "lab".into(),
             name: "Lab".into(),
             base_description: "Original description".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -572,7 +572,7 @@ fn modify_item_updates_scalar_fields() {
         Location::Room(room_id.clone()),
         Some(ContainerState::Closed),
     );
-    item.text = Some("old text".to_string());
+    item.text.set(Some("old text".to_string()));
     world.items.insert(item_id.clone(), item);
 
     let patch = ItemPatch {
@@ -1072,7 +1072,7 @@ fn npc_says_random_uses_npc_dialogue() {
     let (mut world, room1, _) = build_test_world();
     world.spinners.insert(
         crate::spinners::SpinnerType::Core(crate::spinners::CoreSpinnerType::NpcIgnore),
-        Spinner::new(vec![Wedge::new("Ignores you.".into())]),
+        Spinner::new(vec![Wedge::new("Ignores you.".into())]).into(),
     );
     let npc_id: NpcId = crate::idgen::new_id().into();
     let mut npc = make_npc(npc_id.clone(), Location::Room(room1.clone()), NpcState::Normal);
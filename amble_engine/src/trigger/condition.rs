@@ -5,15 +5,15 @@
 
 use std::collections::HashSet;
 
+use crate::rng::WorldRng;
 use crate::{Id, ItemId, NpcId, RoomId};
-use rand::random_bool;
 use serde::{Deserialize, Serialize};
 
 use crate::{
     AmbleWorld, ItemHolder, Location,
     item::{IngestMode, ItemAbility, ItemInteractionType},
     npc::NpcState,
-    player::Flag,
+    player::FlagRef,
     spinners::SpinnerType,
 };
 
@@ -42,9 +42,9 @@ pub enum TriggerCondition {
         npc_id: NpcId,
     },
     HasItem(ItemId),
-    HasFlag(String),
-    FlagInProgress(String),
-    FlagComplete(String),
+    HasFlag(FlagRef),
+    FlagInProgress(FlagRef),
+    FlagComplete(FlagRef),
     HasVisited(RoomId),
     InRoom(RoomId),
     Ingest {
@@ -58,7 +58,7 @@ pub enum TriggerCondition {
     },
     Leave(RoomId),
     LookAt(Id),
-    MissingFlag(String),
+    MissingFlag(FlagRef),
     MissingItem(ItemId),
     NpcDeath(NpcId),
     NpcHasItem {
@@ -105,9 +105,9 @@ impl TriggerCondition {
     /// This allows us to check chance conditions without having to pass an `AmbleWorld`
     /// reference, avoid some conflicts with the borrow checker. Returns true if called
     /// on any other type of `TriggerCondition`.
-    pub fn chance_value(&self) -> bool {
+    pub fn chance_value(&self, rng: &WorldRng) -> bool {
         match self {
-            Self::Chance { one_in } => random_bool(1.0 / *one_in),
+            Self::Chance { one_in } => rng.chance(1.0 / *one_in),
             _ => true,
         }
     }
@@ -117,31 +117,16 @@ impl TriggerCondition {
     /// This covers ongoing predicates such as flags, inventory membership,
     /// and NPC states. For chance triggers it performs the random roll.
     pub fn is_ongoing(&self, world: &AmbleWorld) -> bool {
-        let player_flag_set = |flag_str: &str| world.player.flags.iter().any(|f| f.value() == *flag_str);
         match self {
-            Self::Chance { one_in } => random_bool(1.0 / *one_in),
+            Self::Chance { one_in } => world.rng.chance(1.0 / *one_in),
             Self::ContainerHasItem { container_id, item_id } => world
                 .items
                 .get(item_id)
                 .is_some_and(|item| matches!(&item.location, Location::Item(id) if id == container_id)),
-            Self::HasFlag(flag) => player_flag_set(flag),
-            Self::MissingFlag(flag) => !player_flag_set(flag),
-            Self::FlagInProgress(flag) => world
-                .player
-                .flags
-                .get(&Flag::Simple {
-                    name: flag.into(),
-                    turn_set: usize::MAX, /* dummy - not used in hash */
-                })
-                .is_some_and(|f| !f.is_complete()),
-            Self::FlagComplete(flag) => world
-                .player
-                .flags
-                .get(&Flag::Simple {
-                    name: flag.into(),
-                    turn_set: usize::MAX,
-                })
-                .is_some_and(Flag::is_complete),
+            Self::HasFlag(flag) => world.player.flags.is_set(flag),
+            Self::MissingFlag(flag) => !world.player.flags.is_set(flag),
+            Self::FlagInProgress(flag) => world.player.flags.in_progress(flag),
+            Self::FlagComplete(flag) => world.player.flags.is_complete(flag),
             Self::HasVisited(room_id) => world.rooms.get(room_id).is_some_and(|r| r.visited),
             Self::InRoom(room_id) => world.player.location.room_id().is_ok_and(|id| room_id == &id),
             Self::NpcHasItem { npc_id, item_id } => world
@@ -183,8 +168,8 @@ mod tests {
             symbol: "r1".into(),
             name: "Room1".into(),
             base_description: "Room1".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -197,8 +182,8 @@ mod tests {
             symbol: "r2".into(),
             name: "Room2".into(),
             base_description: "Room2".into(),
-            overlays: Vec::new(),
-            scenery: Vec::new(),
+            overlays: Vec::new().into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -217,7 +202,7 @@ mod tests {
             id,
             symbol: "it".into(),
             name: "Item".into(),
-            description: String::new(),
+            description: String::new().into(),
             location,
             container_state,
             visibility: crate::item::ItemVisibility::Listed,
@@ -227,7 +212,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         }
     }
@@ -237,10 +222,10 @@ mod tests {
             id,
             symbol: "n".into(),
             name: "Npc".into(),
-            description: String::new(),
+            description: String::new().into(),
             location,
             inventory: HashSet::new(),
-            dialogue: HashMap::new(),
+            dialogue: HashMap::new().into(),
             state,
             movement: None,
             health: HealthState::new_at_max(20),
@@ -0,0 +1,280 @@
+//! Event index for trigger dispatch.
+//!
+//! Most triggers can only fire in response to a specific event (entering a room,
+//! taking an item, talking to an NPC...). Rather than evaluating every trigger on
+//! every call to [`check_triggers`](crate::trigger::check_triggers), the index maps
+//! each event kind and its primary id to the triggers that reference it, so only
+//! candidates for the events actually passed in need to be evaluated. Triggers that
+//! can become true from world state alone are kept in a separate list and are always
+//! evaluated.
+//!
+//! The index also holds each trigger's compiled [`ConditionProgram`].
+//!
+//! The index is derived data: it is built when the world is loaded, skipped during
+//! (de)serialization, and rebuilt on demand when the trigger list's length or
+//! [`triggers_revision`](crate::AmbleWorld::triggers_revision) no longer matches the
+//! one it was built from.
+
+use std::collections::HashMap;
+
+use crate::scheduler::EventCondition;
+use crate::trigger::{ConditionProgram, Trigger, TriggerCondition};
+
+/// Discriminant for the event-type (instantaneous) trigger conditions.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub enum EventKind {
+    ActOnItem,
+    Drop,
+    Enter,
+    GiveToNpc,
+    Ingest,
+    Insert,
+    Leave,
+    LookAt,
+    NpcDeath,
+    Open,
+    PlayerDeath,
+    Take,
+    TakeFromItem,
+    TakeFromNpc,
+    TalkToNpc,
+    Touch,
+    Unlock,
+    UseItem,
+    UseItemOnItem,
+}
+
+impl TriggerCondition {
+    /// Returns the event kind and primary id for event-type conditions, or `None` for
+    /// conditions that are evaluated against world state (flags, inventory, chance...).
+    ///
+    /// The key is only used to narrow candidates; full condition evaluation still decides
+    /// whether a trigger fires, so conditions with several ids are keyed on just one.
+    pub fn event_key(&self) -> Option<(EventKind, &str)> {
+        let key = match self {
+            Self::ActOnItem { target_id, .. } => (EventKind::ActOnItem, target_id.as_str()),
+            Self::Drop(item_id) => (EventKind::Drop, item_id.as_str()),
+            Self::Enter(room_id) => (EventKind::Enter, room_id.as_str()),
+            Self::GiveToNpc { npc_id, .. } => (EventKind::GiveToNpc, npc_id.as_str()),
+            Self::Ingest { item_id, .. } => (EventKind::Ingest, item_id.as_str()),
+            Self::Insert { item, .. } => (EventKind::Insert, item.as_str()),
+            Self::Leave(room_id) => (EventKind::Leave, room_id.as_str()),
+            Self::LookAt(id) => (EventKind::LookAt, id.as_str()),
+            Self::NpcDeath(npc_id) => (EventKind::NpcDeath, npc_id.as_str()),
+            Self::Open(item_id) => (EventKind::Open, item_id.as_str()),
+            Self::PlayerDeath => (EventKind::PlayerDeath, ""),
+            Self::Take(item_id) => (EventKind::Take, item_id.as_str()),
+            Self::TakeFromItem { loot_id, .. } => (EventKind::TakeFromItem, loot_id.as_str()),
+            Self::TakeFromNpc { item_id, .. } => (EventKind::TakeFromNpc, item_id.as_str()),
+            Self::TalkToNpc(npc_id) => (EventKind::TalkToNpc, npc_id.as_str()),
+            Self::Touch(item_id) => (EventKind::Touch, item_id.as_str()),
+            Self::Unlock(item_id) => (EventKind::Unlock, item_id.as_str()),
+            Self::UseItem { item_id, .. } => (EventKind::UseItem, item_id.as_str()),
+            Self::UseItemOnItem { target_id, .. } => (EventKind::UseItemOnItem, target_id.as_str()),
+            Self::Ambient { .. }
+            | Self::Chance { .. }
+            | Self::ContainerHasItem { .. }
+            | Self::HasItem(_)
+            | Self::HasFlag(_)
+            | Self::FlagInProgress(_)
+            | Self::FlagComplete(_)
+            | Self::HasVisited(_)
+            | Self::InRoom(_)
+            | Self::MissingFlag(_)
+            | Self::MissingItem(_)
+            | Self::NpcHasItem { .. }
+            | Self::NpcInState { .. }
+            | Self::WithNpc(_) => return None,
+        };
+        Some(key)
+    }
+}
+
+impl EventCondition {
+    /// True if the condition can only evaluate true when at least one of its event
+    /// conditions is present in the events passed for evaluation.
+    fn requires_event(&self) -> bool {
+        match self {
+            EventCondition::Trigger(tc) => tc.event_key().is_some(),
+            EventCondition::All(conds) => conds.iter().any(EventCondition::requires_event),
+            EventCondition::Any(conds) => !conds.is_empty() && conds.iter().all(EventCondition::requires_event),
+        }
+    }
+}
+
+/// Lookup table from events to the triggers that could respond to them.
+#[derive(Debug, Clone, Default)]
+pub struct TriggerIndex {
+    /// Triggers that require a matching event, keyed by event kind then id.
+    by_event: HashMap<EventKind, HashMap<String, Vec<usize>>>,
+    /// Non-ambient triggers that may fire from world state alone.
+    state_based: Vec<usize>,
+    /// Triggers containing an `Ambient` condition.
+    ambient: Vec<usize>,
+    /// Compiled conditions, parallel to the trigger list.
+    programs: Vec<ConditionProgram>,
+    /// Length and revision of the trigger list the index was built from (`None` = never built).
+    built_for: Option<(usize, u64)>,
+}
+
+impl TriggerIndex {
+    /// Build an index over the supplied triggers, stamped with the list's `revision`.
+    pub fn build(triggers: &[Trigger], revision: u64) -> Self {
+        let mut index = TriggerIndex {
+            built_for: Some((triggers.len(), revision)),
+            ..TriggerIndex::default()
+        };
+        for (idx, trigger) in triggers.iter().enumerate() {
+            let conditions = &trigger.conditions;
+            index.programs.push(ConditionProgram::compile(conditions));
+            if conditions.any_trigger(|c| matches!(c, TriggerCondition::Ambient { .. })) {
+                index.ambient.push(idx);
+            } else if conditions.requires_event() {
+                conditions.for_each_condition(|cond| {
+                    if let Some((kind, id)) = cond.event_key() {
+                        let slot = index
+                            .by_event
+                            .entry(kind)
+                            .or_default()
+                            .entry(id.to_string())
+                            .or_default();
+                        if slot.last() != Some(&idx) {
+                            slot.push(idx);
+                        }
+                    }
+                });
+            } else {
+                index.state_based.push(idx);
+            }
+        }
+        index
+    }
+
+    /// True if the index was built from a trigger list of this length and revision.
+    pub fn is_current(&self, trigger_count: usize, revision: u64) -> bool {
+        self.built_for == Some((trigger_count, revision))
+    }
+
+    /// Rebuild the index if the trigger list has changed since it was built.
+    pub fn ensure_current(&mut self, triggers: &[Trigger], revision: u64) {
+        if !self.is_current(triggers.len(), revision) {
+            *self = TriggerIndex::build(triggers, revision);
+        }
+    }
+
+    /// Indices of all non-ambient triggers that could fire given `events`, in trigger order.
+    pub fn candidates(&self, events: &[TriggerCondition]) -> Vec<usize> {
+        let mut candidates = self.state_based.clone();
+        for event in events {
+            if let Some((kind, id)) = event.event_key()
+                && let Some(list) = self.by_event.get(&kind).and_then(|ids| ids.get(id))
+            {
+                candidates.extend_from_slice(list);
+            }
+        }
+        candidates.sort_unstable();
+        candidates.dedup();
+        candidates
+    }
+
+    /// Indices of triggers containing an `Ambient` condition.
+    pub fn ambient(&self) -> &[usize] {
+        &self.ambient
+    }
+
+    /// Compiled condition for the trigger at `idx`.
+    ///
+    /// # Panics
+    /// Panics if `idx` is out of range for the trigger list the index was built from.
+    pub fn program(&self, idx: usize) -> &ConditionProgram {
+        &self.programs[idx]
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::RoomId;
+    use crate::spinners::{CoreSpinnerType, SpinnerType};
+    use std::collections::HashSet;
+
+    fn trigger(name: &str, conditions: EventCondition) -> Trigger {
+        Trigger {
+            name: name.into(),
+            conditions: conditions.into(),
+            actions: vec![].into(),
+            only_once: false,
+            fired: false,
+        }
+    }
+
+    fn enter(room: &str) -> EventCondition {
+        EventCondition::Trigger(TriggerCondition::Enter(RoomId::from(room)))
+    }
+
+    fn has_flag(flag: &str) -> EventCondition {
+        EventCondition::Trigger(TriggerCondition::HasFlag(flag.into()))
+    }
+
+    #[test]
+    fn event_triggers_are_keyed_by_event_and_id() {
+        let triggers = vec![
+            trigger("a", enter("hall")),
+            trigger("b", EventCondition::All(vec![enter("lab"), has_flag("x")])),
+        ];
+        let index = TriggerIndex::build(&triggers, 0);
+        assert_eq!(index.candidates(&[TriggerCondition::Enter("hall".into())]), vec![0]);
+        assert_eq!(index.candidates(&[TriggerCondition::Enter("lab".into())]), vec![1]);
+        assert!(index.candidates(&[TriggerCondition::Leave("lab".into())]).is_empty());
+        assert!(index.candidates(&[]).is_empty());
+    }
+
+    #[test]
+    fn any_with_state_branch_is_state_based() {
+        let triggers = vec![
+            trigger("event", enter("hall")),
+            trigger("mixed", EventCondition::Any(vec![enter("hall"), has_flag("x")])),
+            trigger("state", has_flag("y")),
+        ];
+        let index = TriggerIndex::build(&triggers, 0);
+        assert_eq!(index.candidates(&[]), vec![1, 2]);
+        assert_eq!(
+            index.candidates(&[TriggerCondition::Enter("hall".into())]),
+            vec![0, 1, 2]
+        );
+    }
+
+    #[test]
+    fn ambient_triggers_are_listed_separately() {
+        let ambient = EventCondition::Trigger(TriggerCondition::Ambient {
+            room_ids: HashSet::new(),
+            spinner: SpinnerType::Core(CoreSpinnerType::Movement),
+        });
+        let triggers = vec![trigger("amb", ambient), trigger("state", has_flag("y"))];
+        let index = TriggerIndex::build(&triggers, 0);
+        assert_eq!(index.ambient(), &[0]);
+        assert_eq!(index.candidates(&[]), vec![1]);
+    }
+
+    #[test]
+    fn index_reports_staleness_after_trigger_added() {
+        let mut triggers = vec![trigger("a", enter("hall"))];
+        let mut index = TriggerIndex::default();
+        assert!(!index.is_current(triggers.len(), 0));
+        index.ensure_current(&triggers, 0);
+        assert!(index.is_current(1, 0));
+        triggers.push(trigger("b", enter("lab")));
+        index.ensure_current(&triggers, 0);
+        assert_eq!(index.candidates(&[TriggerCondition::Enter("lab".into())]), vec![1]);
+    }
+
+    #[test]
+    fn index_rebuilds_when_same_length_list_is_replaced() {
+        let mut index = TriggerIndex::build(&[trigger("a", enter("hall"))], 1);
+        let replaced = vec![trigger("b", enter("lab"))];
+        assert!(!index.is_current(replaced.len(), 2));
+        index.ensure_current(&replaced, 2);
+        assert_eq!(index.candidates(&[TriggerCondition::Enter("lab".into())]), vec![0]);
+        assert!(index.candidates(&[TriggerCondition::Enter("hall".into())]).is_empty());
+    }
+}
@@ -0,0 +1,393 @@
+//! Compiled condition programs.
+//!
+//! `EventCondition` trees are convenient to author, serialize and display, but evaluating one
+//! means recursing through nested vectors and comparing whole enum payloads against every event.
+//! At load time each trigger, scheduled-event and `visible_when` condition is lowered into a
+//! [`ConditionProgram`]: a flat instruction array with short-circuit jumps, run by a simple loop.
+//!
+//! The tree form is retained alongside the program (see [`CompiledCondition`]) and remains the
+//! serialized representation, so saves and dev tooling are unaffected.
+
+use std::ops::Deref;
+
+use serde::{Deserialize, Serialize, Serializer};
+
+use crate::AmbleWorld;
+use crate::scheduler::EventCondition;
+use crate::trigger::TriggerCondition;
+
+/// A single instruction. Every instruction either sets the accumulator or conditionally jumps.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum Op {
+    /// acc = an event equal to the leaf condition was passed in.
+    Event(u32),
+    /// acc = the leaf condition holds in the current world state.
+    State(u32),
+    /// acc = constant (empty `All` / `Any` lists).
+    Const(bool),
+    /// Jump to the target if acc is false (short-circuit for `All`).
+    JumpIfFalse(u32),
+    /// Jump to the target if acc is true (short-circuit for `Any`).
+    JumpIfTrue(u32),
+}
+
+/// Flat, evaluable form of an `EventCondition`.
+///
+/// Leaf conditions are stored once in `leaves` and referenced by index, keeping the
+/// instruction array small and contiguous.
+#[derive(Debug, Clone, Default)]
+pub struct ConditionProgram {
+    ops: Vec<Op>,
+    leaves: Vec<TriggerCondition>,
+}
+
+impl ConditionProgram {
+    /// Lower a condition tree into a program.
+    pub fn compile(condition: &EventCondition) -> ConditionProgram {
+        let mut program = ConditionProgram::default();
+        program.lower(condition);
+        program
+    }
+
+    fn lower(&mut self, condition: &EventCondition) {
+        match condition {
+            EventCondition::Trigger(tc) => {
+                let leaf = to_u32(self.leaves.len());
+                self.leaves.push(tc.clone());
+                // Event-type conditions are never true from world state alone, and state
+                // conditions are never passed in as events, so each leaf needs only one test.
+                self.ops.push(if tc.event_key().is_some() {
+                    Op::Event(leaf)
+                } else {
+                    Op::State(leaf)
+                });
+            },
+            EventCondition::All(conds) => self.lower_chain(conds, true),
+            EventCondition::Any(conds) => self.lower_chain(conds, false),
+        }
+    }
+
+    /// Emit each sub-condition in order, jumping past the rest of the chain as soon as the
+    /// result is decided (first false for `All`, first true for `Any`).
+    fn lower_chain(&mut self, conds: &[EventCondition], is_all: bool) {
+        let Some((last, rest)) = conds.split_last() else {
+            self.ops.push(Op::Const(is_all));
+            return;
+        };
+        let mut exits = Vec::with_capacity(rest.len());
+        for cond in rest {
+            self.lower(cond);
+            exits.push(self.ops.len());
+            self.ops.push(Op::Const(false)); // placeholder, patched below
+        }
+        self.lower(last);
+        let end = to_u32(self.ops.len());
+        for pc in exits {
+            self.ops[pc] = if is_all {
+                Op::JumpIfFalse(end)
+            } else {
+                Op::JumpIfTrue(end)
+            };
+        }
+    }
+
+    /// Evaluate the program against the current world state and any recent events.
+    pub fn eval_with_events(&self, world: &AmbleWorld, events: &[TriggerCondition]) -> bool {
+        let mut acc = false;
+        let mut pc = 0;
+        while let Some(op) = self.ops.get(pc) {
+            pc += 1;
+            match *op {
+                Op::Event(leaf) => acc = self.event_present(leaf, events),
+                Op::State(leaf) => acc = self.leaves[leaf as usize].is_ongoing(world),
+                Op::Const(value) => acc = value,
+                Op::JumpIfFalse(target) => {
+                    if !acc {
+                        pc = target as usize;
+                    }
+                },
+                Op::JumpIfTrue(target) => {
+                    if acc {
+                        pc = target as usize;
+                    }
+                },
+            }
+        }
+        acc
+    }
+
+    /// Evaluate the program against the current world state.
+    pub fn eval(&self, world: &AmbleWorld) -> bool {
+        self.eval_with_events(world, &[])
+    }
+
+    /// True if one of `events` equals the leaf. The cheap kind/id key is compared first so the
+    /// full payload comparison only runs on likely matches.
+    fn event_present(&self, leaf: u32, events: &[TriggerCondition]) -> bool {
+        let leaf = &self.leaves[leaf as usize];
+        let key = leaf.event_key();
+        events.iter().any(|event| event.event_key() == key && event == leaf)
+    }
+
+    /// Number of instructions in the program.
+    pub fn len(&self) -> usize {
+        self.ops.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.ops.is_empty()
+    }
+}
+
+fn to_u32(n: usize) -> u32 {
+    u32::try_from(n).expect("condition program exceeds u32::MAX instructions")
+}
+
+/// An `EventCondition` paired with its compiled program.
+///
+/// Serializes as the plain condition tree; the program is rebuilt on deserialization.
+/// Derefs to the tree for inspection and display.
+#[derive(Debug, Clone, Deserialize)]
+#[serde(from = "EventCondition")]
+pub struct CompiledCondition {
+    tree: EventCondition,
+    program: ConditionProgram,
+}
+
+impl CompiledCondition {
+    /// The source condition tree.
+    pub fn tree(&self) -> &EventCondition {
+        &self.tree
+    }
+
+    /// The compiled program.
+    pub fn program(&self) -> &ConditionProgram {
+        &self.program
+    }
+
+    /// Evaluate the compiled condition against the current world state and any recent events.
+    pub fn eval_with_events(&self, world: &AmbleWorld, events: &[TriggerCondition]) -> bool {
+        self.program.eval_with_events(world, events)
+    }
+
+    /// Evaluate the compiled condition against the current world state.
+    pub fn eval(&self, world: &AmbleWorld) -> bool {
+        self.program.eval(world)
+    }
+}
+
+impl From<EventCondition> for CompiledCondition {
+    fn from(tree: EventCondition) -> Self {
+        let program = ConditionProgram::compile(&tree);
+        CompiledCondition { tree, program }
+    }
+}
+
+impl From<CompiledCondition> for EventCondition {
+    fn from(compiled: CompiledCondition) -> Self {
+        compiled.tree
+    }
+}
+
+impl Deref for CompiledCondition {
+    type Target = EventCondition;
+
+    fn deref(&self) -> &Self::Target {
+        &self.tree
+    }
+}
+
+impl PartialEq for CompiledCondition {
+    fn eq(&self, other: &Self) -> bool {
+        self.tree == other.tree
+    }
+}
+
+impl Serialize for CompiledCondition {
+    fn serialize<S>(&self, serializer: S) -> Result<S::Ok, S::Error>
+    where
+        S: Serializer,
+    {
+        self.tree.serialize(serializer)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::item::{Item, ItemAbility};
+    use crate::player::Flag;
+    use crate::room::Room;
+    use crate::world::Location;
+    use crate::{ItemId, RoomId};
+    use rand::rngs::StdRng;
+    use rand::{Rng, SeedableRng};
+
+    const ROOMS: [&str; 3] = ["hall", "lab", "vault"];
+    const ITEMS: [&str; 3] = ["lamp", "key", "coin"];
+    const FLAGS: [&str; 3] = ["lit", "open", "quest#1"];
+
+    fn leaf(tc: TriggerCondition) -> EventCondition {
+        EventCondition::Trigger(tc)
+    }
+
+    fn random_leaf(rng: &mut StdRng) -> TriggerCondition {
+        let room = RoomId::from(ROOMS[rng.random_range(0..ROOMS.len())]);
+        let item = ItemId::from(ITEMS[rng.random_range(0..ITEMS.len())]);
+        let flag = FLAGS[rng.random_range(0..FLAGS.len())];
+        match rng.random_range(0..10) {
+            0 => TriggerCondition::Enter(room),
+            1 => TriggerCondition::Leave(room),
+            2 => TriggerCondition::Take(item),
+            3 => TriggerCondition::UseItem {
+                item_id: item,
+                ability: ItemAbility::Read,
+            },
+            4 => TriggerCondition::HasFlag(flag.into()),
+            5 => TriggerCondition::MissingFlag(flag.into()),
+            6 => TriggerCondition::InRoom(room),
+            7 => TriggerCondition::HasVisited(room),
+            8 => TriggerCondition::HasItem(item),
+            _ => TriggerCondition::MissingItem(item),
+        }
+    }
+
+    fn random_event(rng: &mut StdRng) -> TriggerCondition {
+        loop {
+            let candidate = random_leaf(rng);
+            if candidate.event_key().is_some() {
+                return candidate;
+            }
+        }
+    }
+
+    fn random_condition(rng: &mut StdRng, depth: u32) -> EventCondition {
+        if depth == 0 || rng.random_bool(0.4) {
+            return leaf(random_leaf(rng));
+        }
+        let children = (0..rng.random_range(0..4))
+            .map(|_| random_condition(rng, depth - 1))
+            .collect();
+        if rng.random_bool(0.5) {
+            EventCondition::All(children)
+        } else {
+            EventCondition::Any(children)
+        }
+    }
+
+    fn random_world(rng: &mut StdRng) -> AmbleWorld {
+        let mut world = AmbleWorld::new_empty();
+        for symbol in ROOMS {
+            let id = RoomId::from(symbol);
+            world.rooms.insert(
+                id.clone(),
+                Room {
+                    id,
+                    symbol: symbol.into(),
+                    name: symbol.into(),
+                    base_description: String::new().into(),
+                    overlays: Vec::new().into(),
+                    scenery: Vec::new().into(),
+                    scenery_default: None,
+                    location: Location::Nowhere,
+                    visited: rng.random_bool(0.5),
+                    exits: std::collections::HashMap::new(),
+                    contents: std::collections::HashSet::new(),
+                    npcs: std::collections::HashSet::new(),
+                },
+            );
+        }
+        world.player.location = Location::Room(ROOMS[rng.random_range(0..ROOMS.len())].into());
+        for symbol in ITEMS {
+            let id = ItemId::from(symbol);
+            let carried = rng.random_bool(0.5);
+            world.items.insert(
+                id.clone(),
+                Item {
+                    id: id.clone(),
+                    symbol: symbol.into(),
+                    name: symbol.into(),
+                    location: if carried {
+                        Location::Inventory
+                    } else {
+                        Location::Nowhere
+                    },
+                    ..Item::default()
+                },
+            );
+            if carried {
+                world.player.inventory.insert(id);
+            }
+        }
+        if rng.random_bool(0.5) {
+            world.player.flags.insert(Flag::simple("lit", 0));
+        }
+        if rng.random_bool(0.5) {
+            world.player.flags.insert(Flag::simple("open", 0));
+        }
+        let mut quest = Flag::sequence("quest", Some(3), 0);
+        for _ in 0..rng.random_range(0..3) {
+            quest.advance();
+        }
+        world.player.flags.insert(quest);
+        world
+    }
+
+    #[test]
+    fn empty_lists_compile_to_identity_values() {
+        let world = AmbleWorld::new_empty();
+        assert!(ConditionProgram::compile(&EventCondition::All(vec![])).eval(&world));
+        assert!(!ConditionProgram::compile(&EventCondition::Any(vec![])).eval(&world));
+    }
+
+    #[test]
+    fn all_short_circuits_with_jump_to_end() {
+        let cond = EventCondition::All(vec![
+            leaf(TriggerCondition::HasFlag("a".into())),
+            EventCondition::Any(vec![
+                leaf(TriggerCondition::Enter("hall".into())),
+                leaf(TriggerCondition::HasFlag("b".into())),
+            ]),
+        ]);
+        let program = ConditionProgram::compile(&cond);
+        assert_eq!(
+            program.ops,
+            vec![
+                Op::State(0),
+                Op::JumpIfFalse(5),
+                Op::Event(1),
+                Op::JumpIfTrue(5),
+                Op::State(2),
+            ]
+        );
+    }
+
+    #[test]
+    fn compiled_condition_serializes_as_tree() {
+        let tree = EventCondition::Any(vec![leaf(TriggerCondition::HasFlag("a".into()))]);
+        let compiled = CompiledCondition::from(tree.clone());
+        let raw = ron::ser::to_string(&compiled).unwrap();
+        assert_eq!(raw, ron::ser::to_string(&tree).unwrap());
+        let decoded: CompiledCondition = ron::from_str(&raw).unwrap();
+        assert_eq!(decoded.tree(), &tree);
+        assert_eq!(decoded.program().len(), 1);
+    }
+
+    #[test]
+    fn compiled_programs_match_tree_evaluation_on_random_worlds() {
+        let mut rng = StdRng::seed_from_u64(0x00A3_B1E5);
+        for _ in 0..200 {
+            let world = random_world(&mut rng);
+            for _ in 0..25 {
+                let cond = random_condition(&mut rng, 3);
+                let program = ConditionProgram::compile(&cond);
+                let events: Vec<_> = (0..rng.random_range(0..3)).map(|_| random_event(&mut rng)).collect();
+                assert_eq!(
+                    program.eval_with_events(&world, &events),
+                    cond.eval_with_events(&world, &events),
+                    "mismatch for {cond:?} with events {events:?}"
+                );
+            }
+        }
+    }
+}
@@ -7,9 +7,31 @@ use crate::style::{GameStyle, normal_block};
 
 pub mod icons;
 pub mod view_item;
+use std::fmt;
+use std::io::{self, Write};
+use std::sync::{Arc, Mutex};
 use textwrap::{fill, termwidth};
 pub use view_item::ViewItem;
 
+/// Append formatted text to a frame buffer. Formatting into a `String` cannot fail.
+macro_rules! out {
+    ($buf:expr, $($arg:tt)*) => {{
+        use std::fmt::Write as _;
+        let _ = write!($buf, $($arg)*);
+    }};
+}
+
+/// Append formatted text and a newline to a frame buffer.
+macro_rules! outln {
+    ($buf:expr) => {
+        $buf.push('\n')
+    };
+    ($buf:expr, $($arg:tt)*) => {{
+        use std::fmt::Write as _;
+        let _ = writeln!($buf, $($arg)*);
+    }};
+}
+
 mod render_action;
 mod render_env;
 mod render_health;
@@ -19,14 +41,60 @@ mod render_player;
 mod render_system;
 mod render_trig;
 
+/// Destination for rendered frames.
+///
+/// Each frame is written with a single `write_all`, so a sink sees whole frames.
+/// Clones of a `Writer` sink share the same underlying writer.
+#[derive(Clone, Default)]
+pub enum ViewSink {
+    /// Standard output (the default for interactive play).
+    #[default]
+    Stdout,
+    /// Any other writer, e.g. a socket, log file or in-memory buffer.
+    Writer(Arc<Mutex<dyn Write + Send>>),
+}
+impl ViewSink {
+    /// Wrap an arbitrary writer as a sink.
+    pub fn writer(writer: impl Write + Send + 'static) -> Self {
+        Self::Writer(Arc::new(Mutex::new(writer)))
+    }
+
+    fn write_frame(&self, frame: &[u8]) -> io::Result<()> {
+        match self {
+            Self::Stdout => {
+                let mut stdout = io::stdout().lock();
+                stdout.write_all(frame)?;
+                stdout.flush()
+            },
+            Self::Writer(writer) => {
+                let mut writer = writer.lock().unwrap_or_else(std::sync::PoisonError::into_inner);
+                writer.write_all(frame)?;
+                writer.flush()
+            },
+        }
+    }
+}
+impl fmt::Debug for ViewSink {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        match self {
+            Self::Stdout => f.write_str("Stdout"),
+            Self::Writer(_) => f.write_str("Writer(..)"),
+        }
+    }
+}
+
 /// View aggregates information to be displayed on each pass through the REPL and then organizes
 /// and displays the result.
+///
+/// Each frame is rendered into one reusable buffer and handed to the [`ViewSink`] in a single write.
 #[derive(Debug, Clone)]
 pub struct View {
     pub width: usize,
     pub mode: ViewMode,
     pub items: Vec<ViewEntry>,
     pub sequence: usize,
+    sink: ViewSink,
+    frame: String,
 }
 impl Default for View {
     fn default() -> Self {
@@ -43,9 +111,21 @@ impl View {
             mode: ViewMode::Verbose,
             items: Vec::new(),
             sequence: 0,
+            sink: ViewSink::Stdout,
+            frame: String::new(),
         }
     }
 
+    /// Create a new empty view that writes its frames to `sink` instead of stdout.
+    pub fn with_sink(sink: ViewSink) -> Self {
+        Self { sink, ..Self::new() }
+    }
+
+    /// Replace the sink frames are written to, returning the previous one.
+    pub fn set_sink(&mut self, sink: ViewSink) -> ViewSink {
+        std::mem::replace(&mut self.sink, sink)
+    }
+
     pub fn push(&mut self, item: ViewItem) {
         self.push_with_custom_priority(item, None);
     }
@@ -68,93 +148,103 @@ impl View {
     }
 
     /// Compose and diplay all message contents in the current frame / turn.
+    ///
+    /// A failed write to the sink is logged and the frame dropped; it is not fatal to the game.
     pub fn flush(&mut self) {
+        // Reuse the previous frame's allocation.
+        let mut frame = std::mem::take(&mut self.frame);
+        frame.clear();
+        self.render_into(&mut frame);
+
+        if !frame.is_empty()
+            && let Err(e) = self.sink.write_frame(frame.as_bytes())
+        {
+            log::warn!("failed to write view frame: {e}");
+        }
+        self.frame = frame;
+    }
+
+    /// Compose the current frame, appending it to `out` instead of writing it to the sink,
+    /// and clear the entries for the next turn.
+    pub fn render_into(&mut self, out: &mut String) {
         // re-check terminal width in case it's been resized
         self.width = termwidth();
 
-        // Bin each item by section so we only iterate once.
-        let mut transitions = Vec::new();
-        let mut environment = Vec::new();
-        let mut direct = Vec::new();
-        let mut world = Vec::new();
-        let mut ambient = Vec::new();
-        let mut system = Vec::new();
+        // Note which sections are present in a single pass; renderers read entries in place.
+        let mut present = [false; Section::COUNT];
         for item in &self.items {
-            match item.view_item.section() {
-                Section::Transition => transitions.push(item.clone()),
-                Section::Environment => environment.push(item.clone()),
-                Section::DirectResult => direct.push(item.clone()),
-                Section::WorldResponse => world.push(item.clone()),
-                Section::Ambient => ambient.push(item.clone()),
-                Section::System => system.push(item.clone()),
-            }
+            present[item.section as usize] = true;
         }
 
         // Section Zero: Movement transition message, if any
-        if let Some(msg) = transitions.iter().find_map(|i| match &i.view_item {
+        if let Some(msg) = self.items.iter().find_map(|i| match &i.view_item {
             ViewItem::TransitionMessage(msg) => Some(msg),
             _ => None,
         }) {
-            println!("\n{}", fill(msg.as_str(), normal_block()).transition_style());
+            outln!(out, "\n{}", fill(msg.as_str(), normal_block()).transition_style());
         }
 
         // First Section: Environment / Frame of Reference
-        if !environment.is_empty() {
-            println!("{:.>width$}\n", "scene".section_style(), width = self.width);
-            self.environment();
+        if present[Section::Environment as usize] {
+            self.section_header(out, "scene");
+            self.environment(out);
         }
         // Fourth Section: Messages not related to last command / action (ambients, goals, etc.)
-        if !ambient.is_empty() {
-            println!("{:.>width$}\n", "surroundings".section_style(), width = self.width);
-            self.ambience();
+        if present[Section::Ambient as usize] {
+            self.section_header(out, "surroundings");
+            self.ambience(out);
         }
         // Second Section: Immediate/ direct results of player command
-        if !direct.is_empty() {
-            println!("{:.>width$}\n", "results".section_style(), width = self.width);
-            self.direct_results();
+        if present[Section::DirectResult as usize] {
+            self.section_header(out, "results");
+            self.direct_results(out);
         }
         // Third Section: Triggered World / NPC reaction to Command
-        if !world.is_empty() {
-            println!("{:.>width$}\n", "reactions".section_style(), width = self.width);
-            self.world_reaction();
+        if present[Section::WorldResponse as usize] {
+            self.section_header(out, "reactions");
+            self.world_reaction(out);
         }
         // Fifth Section: System Commands (load/save, help, quit etc)
-        if !system.is_empty() {
-            println!("{:.>width$}\n", "game".section_style(), width = self.width);
-            self.system();
+        if present[Section::System as usize] {
+            self.section_header(out, "game");
+            self.system(out);
         }
 
         // clear the buffer for the next turn
         self.items.clear();
     }
 
+    fn section_header(&self, out: &mut String, title: &str) {
+        outln!(out, "{:.>width$}\n", title.section_style(), width = self.width);
+    }
+
     // SECTION AGGREGATORS START HERE --------------------
 
-    fn environment(&mut self) {
+    fn environment(&mut self, out: &mut String) {
         // Show overview of room/area
-        render_env::room_description(self);
-        render_env::room_overlays(self);
-        render_env::room_item_list(self);
-        render_env::room_exit_list(self);
-        render_env::room_npc_list(self);
+        render_env::room_description(self, out);
+        render_env::room_overlays(self, out);
+        render_env::room_item_list(self, out);
+        render_env::room_exit_list(self, out);
+        render_env::room_npc_list(self, out);
     }
 
-    fn direct_results(&mut self) {
+    fn direct_results(&mut self, out: &mut String) {
         // direct inspection (read, look_at) results
-        render_item::item_detail(self);
-        render_item::item_text(self);
-        render_npc::npc_detail(self);
-        render_player::inventory(self);
-        render_player::goals(self);
+        render_item::item_detail(self, out);
+        render_item::item_text(self, out);
+        render_npc::npc_detail(self, out);
+        render_player::inventory(self, out);
+        render_player::goals(self, out);
 
         // successes / failures
-        render_action::action_success(self);
-        render_action::action_failure(self);
-        render_action::errors(self);
+        render_action::action_success(self, out);
+        render_action::action_failure(self, out);
+        render_action::errors(self, out);
     }
 
     /// Collect world reaction-type entries, sort, and display them in batches (`bucket`) according to priority view order.
-    fn world_reaction(&mut self) {
+    fn world_reaction(&self, out: &mut String) {
         let world_entries = self.world_entries_sorted();
         if world_entries.is_empty() {
             return;
@@ -165,29 +255,29 @@ impl View {
         for entry in world_entries {
             let priority = entry.effective_priority();
             if current_priority.is_some_and(|p| p != priority) {
-                Self::render_world_bucket(&bucket);
+                Self::render_world_bucket(&bucket, out);
                 bucket.clear();
             }
             bucket.push(entry);
             current_priority = Some(priority);
         }
         if !bucket.is_empty() {
-            Self::render_world_bucket(&bucket);
+            Self::render_world_bucket(&bucket, out);
         }
     }
 
     /// Display a collection of view entries that have the same effective priority.
-    fn render_world_bucket(entries: &[&ViewEntry]) {
+    fn render_world_bucket(entries: &[&ViewEntry], out: &mut String) {
         if entries.is_empty() {
             return;
         }
-        render_trig::triggered_event(entries);
-        render_npc::npc_events_sorted(entries);
-        render_health::character_harmed(entries);
-        render_health::status_change(entries);
-        render_health::character_healed(entries);
-        render_trig::points_awarded(entries);
-        render_health::character_death(entries);
+        render_trig::triggered_event(entries, out);
+        render_npc::npc_events_sorted(entries, out);
+        render_health::character_harmed(entries, out);
+        render_health::status_change(entries, out);
+        render_health::character_healed(entries, out);
+        render_trig::points_awarded(entries, out);
+        render_health::character_death(entries, out);
     }
 
     /// Filter all `ViewEntry`s for this frame, retaining only those in the `WorldResponse` section and sort them
@@ -206,16 +296,16 @@ impl View {
         world_entries
     }
 
-    fn ambience(&mut self) {
-        render_trig::ambient_event(self);
+    fn ambience(&mut self, out: &mut String) {
+        render_trig::ambient_event(self, out);
     }
 
-    fn system(&mut self) {
-        render_system::show_help(self);
-        render_system::saved_games(self);
-        render_system::load_or_save(self);
-        render_system::engine_message(self);
-        render_system::quit_summary(self);
+    fn system(&mut self, out: &mut String) {
+        render_system::show_help(self, out);
+        render_system::saved_games(self, out);
+        render_system::load_or_save(self, out);
+        render_system::engine_message(self, out);
+        render_system::quit_summary(self, out);
     }
 
     /// Clears the View's buffer but does not reset the mode.
@@ -245,6 +335,10 @@ pub enum Section {
     /// Meta/game-system feedback (saves, help, etc.).
     System,
 }
+impl Section {
+    /// Number of sections, for per-section lookup tables indexed by `section as usize`.
+    const COUNT: usize = 6;
+}
 
 /// `ViewMode` alters the way that each "frame" is rendered.
 #[derive(Debug, Copy, Clone, PartialEq, Eq)]
@@ -353,4 +447,40 @@ mod tests {
         assert_eq!(entries.len(), 1);
         assert!(matches!(entries[0].view_item, ViewItem::NpcSpeech { .. }));
     }
+
+    /// Records each `write` call so tests can check a frame arrives in one piece.
+    #[derive(Clone, Default)]
+    struct Capture(Arc<Mutex<Vec<Vec<u8>>>>);
+    impl Write for Capture {
+        fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+            self.0.lock().unwrap().push(buf.to_vec());
+            Ok(buf.len())
+        }
+        fn flush(&mut self) -> io::Result<()> {
+            Ok(())
+        }
+    }
+
+    #[test]
+    fn flush_writes_whole_frame_to_sink_once() {
+        let capture = Capture::default();
+        let mut view = View::with_sink(ViewSink::writer(capture.clone()));
+        view.push(ViewItem::ActionSuccess("You open the hatch.".into()));
+        view.push(ViewItem::AmbientEvent("A draft stirs the dust.".into()));
+        view.push(ViewItem::EngineMessage("Autosaved.".into()));
+        view.flush();
+
+        let writes = capture.0.lock().unwrap().clone();
+        assert_eq!(writes.len(), 1);
+        let frame = String::from_utf8(writes[0].clone()).unwrap();
+        let ambient = frame.find("A draft stirs the dust.").unwrap();
+        let result = frame.find("You open the hatch.").unwrap();
+        let engine = frame.find("Autosaved.").unwrap();
+        assert!(ambient < result && result < engine, "sections out of order:\n{frame}");
+        assert!(view.items.is_empty());
+
+        // an empty frame writes nothing
+        view.flush();
+        assert_eq!(capture.0.lock().unwrap().len(), 1);
+    }
 }
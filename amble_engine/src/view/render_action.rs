@@ -12,7 +12,7 @@ use crate::{
     view::icons::{ICON_ERROR, ICON_FAILURE, ICON_SUCCESS},
 };
 
-pub(super) fn action_success(view: &mut View) {
+pub(super) fn action_success(view: &mut View, out: &mut String) {
     let messages: Vec<_> = view
         .items
         .iter()
@@ -22,7 +22,8 @@ pub(super) fn action_success(view: &mut View) {
         })
         .collect();
     for msg in messages {
-        println!(
+        outln!(
+            out,
             "{}",
             fill(
                 format!("{} {}", ICON_SUCCESS.bright_green(), msg).as_str(),
@@ -32,7 +33,7 @@ pub(super) fn action_success(view: &mut View) {
     }
 }
 
-pub(super) fn action_failure(view: &mut View) {
+pub(super) fn action_failure(view: &mut View, out: &mut String) {
     let messages: Vec<_> = view
         .items
         .iter()
@@ -42,7 +43,8 @@ pub(super) fn action_failure(view: &mut View) {
         })
         .collect();
     for msg in messages {
-        println!(
+        outln!(
+            out,
             "{}",
             fill(
                 format!("{} {}", ICON_FAILURE.bright_red(), msg).as_str(),
@@ -52,7 +54,7 @@ pub(super) fn action_failure(view: &mut View) {
     }
 }
 
-pub(super) fn errors(view: &mut View) {
+pub(super) fn errors(view: &mut View, out: &mut String) {
     let messages: Vec<_> = view
         .items
         .iter()
@@ -62,7 +64,8 @@ pub(super) fn errors(view: &mut View) {
         })
         .collect();
     for msg in messages {
-        println!(
+        outln!(
+            out,
             "{}",
             fill(
                 format!("{:<4}{}", ICON_ERROR.error_icon_style(), msg).as_str(),
@@ -11,7 +11,7 @@ use crate::{
 };
 
 /// Used by `flush()` to show base room description
-pub(super) fn room_description(view: &mut View) {
+pub(super) fn room_description(view: &mut View, out: &mut String) {
     if let Some(ViewItem::RoomDescription {
         name,
         description,
@@ -25,11 +25,12 @@ pub(super) fn room_description(view: &mut View) {
         let display_mode = force_mode.unwrap_or(view.mode);
         if display_mode == ViewMode::ClearVerbose {
             // clear the screen
-            print!("\x1B[2J\x1B[H");
+            out!(out, "\x1B[2J\x1B[H");
         }
-        println!("{:^width$}", name.room_titlebar_style(), width = view.width);
+        outln!(out, "{:^width$}", name.room_titlebar_style(), width = view.width);
         if display_mode != ViewMode::Brief || !visited {
-            println!(
+            outln!(
+                out,
                 "{}",
                 render_wrapped(
                     description,
@@ -40,12 +41,12 @@ pub(super) fn room_description(view: &mut View) {
                 )
             );
 
-            println!();
+            outln!(out);
         }
     }
 }
 
-pub(super) fn room_overlays(view: &mut View) {
+pub(super) fn room_overlays(view: &mut View, out: &mut String) {
     // Note: force_mode is passed with a RoomOverlay item but currently unused
     // (overlays are displayed regardless of view mode)
     if let Some(ViewItem::RoomOverlays { text, .. }) = view.items.iter().find_map(|i| match i.view_item {
@@ -67,75 +68,78 @@ pub(super) fn room_overlays(view: &mut View) {
             let mut lines = wrapped.lines();
             if let Some(first_line) = lines.next() {
                 if first_line.is_empty() {
-                    println!("{bullet_prefix}");
+                    outln!(out, "{bullet_prefix}");
                 } else {
-                    println!("{bullet_prefix}{first_line}");
+                    outln!(out, "{bullet_prefix}{first_line}");
                 }
             } else {
-                println!("{bullet_prefix}");
+                outln!(out, "{bullet_prefix}");
             }
             for line in lines {
                 if line.is_empty() {
-                    println!("{indent_prefix}");
+                    outln!(out, "{indent_prefix}");
                 } else {
-                    println!("{indent_prefix}{line}");
+                    outln!(out, "{indent_prefix}{line}");
                 }
             }
         }
-        println!();
+        outln!(out);
     }
 }
 
-pub(super) fn room_item_list(view: &mut View) {
+pub(super) fn room_item_list(view: &mut View, out: &mut String) {
     if let Some(ViewItem::RoomItems(names)) = view.items.iter_mut().find_map(|i| match i.view_item {
         ViewItem::RoomItems(_) => Some(&mut i.view_item),
         _ => None,
     }) {
-        println!("{}:", "Items".subheading_style());
+        outln!(out, "{}:", "Items".subheading_style());
         names.sort();
         for name in names {
-            println!("    * {}", name.item_style());
+            outln!(out, "    * {}", name.item_style());
         }
     }
 }
 
-pub(super) fn room_exit_list(view: &mut View) {
+pub(super) fn room_exit_list(view: &mut View, out: &mut String) {
     if let Some(ViewItem::RoomExits(exit_lines)) = view.items.iter_mut().find_map(|i| match i.view_item {
         ViewItem::RoomExits(_) => Some(&mut i.view_item),
         _ => None,
     }) {
-        println!("{}:", "Exits".subheading_style());
+        outln!(out, "{}:", "Exits".subheading_style());
         exit_lines.sort();
         for exit in exit_lines {
-            print!("    > ");
+            out!(out, "    > ");
             match (exit.dest_visited, exit.exit_locked) {
-                (true, false) => println!(
+                (true, false) => outln!(
+                    out,
                     "{} (to {})",
                     exit.direction.exit_visited_style(),
                     exit.destination.room_style()
                 ),
-                (true, true) => println!(
+                (true, true) => outln!(
+                    out,
                     "{} (to {})",
                     exit.direction.exit_locked_style(),
                     exit.destination.room_style()
                 ),
-                (false, true) => println!("{}", exit.direction.exit_locked_style()),
-                (false, false) => println!("{}", exit.direction.exit_unvisited_style()),
+                (false, true) => outln!(out, "{}", exit.direction.exit_locked_style()),
+                (false, false) => outln!(out, "{}", exit.direction.exit_unvisited_style()),
             }
         }
-        println!();
+        outln!(out);
     }
 }
 
 /// Render a `ViewItem::RoomNpcs` into a list of NPCs and their descriptions.
-pub(super) fn room_npc_list(view: &mut View) {
+pub(super) fn room_npc_list(view: &mut View, out: &mut String) {
     if let Some(ViewItem::RoomNpcs(npcs)) = view.items.iter().find_map(|i| match i.view_item {
         ViewItem::RoomNpcs(_) => Some(&i.view_item),
         _ => None,
     }) {
-        println!("{}:", "Others".subheading_style());
+        outln!(out, "{}:", "Others".subheading_style());
         for npc_line in npcs {
-            println!(
+            outln!(
+                out,
                 "    {} - {}",
                 npc_line.name.npc_style(),
                 render_inline(&npc_line.description, StyleKind::Description, StyleMods::default())
@@ -15,7 +15,7 @@ use crate::{
 
 /// Renders messages indicating status effects being applied to or removed
 /// from the player.
-pub(super) fn status_change(entries: &[&ViewEntry]) {
+pub(super) fn status_change(entries: &[&ViewEntry], out: &mut String) {
     let status_msgs: Vec<_> = entries
         .iter()
         .copied()
@@ -23,7 +23,8 @@ pub(super) fn status_change(entries: &[&ViewEntry]) {
         .collect();
     for msg in &status_msgs {
         if let ViewItem::StatusChange { action, status } = &msg.view_item {
-            println!(
+            outln!(
+                out,
                 "{:<4}Status {}: {}",
                 ICON_STATUS.yellow(),
                 status.status_style(),
@@ -35,7 +36,7 @@ pub(super) fn status_change(entries: &[&ViewEntry]) {
         }
     }
     if !status_msgs.is_empty() {
-        println!();
+        outln!(out);
     }
 }
 
@@ -52,10 +53,11 @@ macro_rules! select_health_msgs {
 }
 
 /// Renders messages displayed when a character is harmed.
-pub(super) fn character_harmed(entries: &[&ViewEntry]) {
+pub(super) fn character_harmed(entries: &[&ViewEntry], out: &mut String) {
     let messages = select_health_msgs!(entries, CharacterHarmed, name, cause, amount);
     for (name, cause, amount) in messages {
-        println!(
+        outln!(
+            out,
             "{}",
             fill(
                 format!(
@@ -69,12 +71,12 @@ pub(super) fn character_harmed(entries: &[&ViewEntry]) {
                 normal_block()
             )
         );
-        println!();
+        outln!(out);
     }
 }
 
 /// Renders messages announcing the death of a character.
-pub(super) fn character_death(entries: &[&ViewEntry]) {
+pub(super) fn character_death(entries: &[&ViewEntry], out: &mut String) {
     let messages = select_health_msgs!(entries, CharacterDeath, name, cause, is_player);
     for (name, cause, is_player) in messages {
         let base = format!("{:<4}{}", ICON_DEATH.red(), name.npc_style());
@@ -88,19 +90,21 @@ pub(super) fn character_death(entries: &[&ViewEntry]) {
         } else {
             " dies.".to_string()
         };
-        println!(
+        outln!(
+            out,
             "{}",
             fill(format!("{base}{cause_text}{suffix}").as_str(), normal_block())
         );
-        println!();
+        outln!(out);
     }
 }
 
 /// Renders the message when a character is healed.
-pub(super) fn character_healed(entries: &[&ViewEntry]) {
+pub(super) fn character_healed(entries: &[&ViewEntry], out: &mut String) {
     let messages = select_health_msgs!(entries, CharacterHealed, name, cause, amount);
     for (name, cause, amount) in messages {
-        println!(
+        outln!(
+            out,
             "{}",
             fill(
                 format!(
@@ -114,6 +118,6 @@ pub(super) fn character_healed(entries: &[&ViewEntry]) {
                 normal_block()
             )
         );
-        println!();
+        outln!(out);
     }
 }
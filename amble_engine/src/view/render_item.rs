@@ -13,14 +13,15 @@ use crate::{
 
 /// Aggregates `ViewItem::ItemDescription`, `ViewItem::ItemConsumableStatus`, and `ViewItem:ItemContents`
 /// and renders them into a full item description.
-pub(super) fn item_detail(view: &mut View) {
+pub(super) fn item_detail(view: &mut View, out: &mut String) {
     // display item description
     if let Some(ViewItem::ItemDescription { name, description }) = view.items.iter().find_map(|i| match i.view_item {
         ViewItem::ItemDescription { .. } => Some(&i.view_item),
         _ => None,
     }) {
-        println!("{}", name.item_style().underline());
-        println!(
+        outln!(out, "{}", name.item_style().underline());
+        outln!(
+            out,
             "{}",
             render_wrapped(
                 description,
@@ -30,7 +31,7 @@ pub(super) fn item_detail(view: &mut View) {
                 StyleMods::default(),
             )
         );
-        println!();
+        outln!(out);
     }
 
     // display consumable status, if item is consumable
@@ -41,7 +42,8 @@ pub(super) fn item_detail(view: &mut View) {
             None
         }
     }) {
-        println!(
+        outln!(
+            out,
             "{}",
             fill(
                 format!("({} {})", "Consumable:".yellow(), status_line).as_str(),
@@ -50,7 +52,7 @@ pub(super) fn item_detail(view: &mut View) {
             .italic()
             .dimmed()
         );
-        println!();
+        outln!(out);
     }
 
     // display list of contained items
@@ -58,29 +60,31 @@ pub(super) fn item_detail(view: &mut View) {
         ViewItem::ItemContents(_) => Some(&i.view_item),
         _ => None,
     }) {
-        println!("{}:", "Contents".subheading_style());
+        outln!(out, "{}:", "Contents".subheading_style());
         if content_lines.is_empty() {
-            println!("   {}", "Empty".italic().dimmed());
+            outln!(out, "   {}", "Empty".italic().dimmed());
         } else {
             for line in content_lines {
-                println!(
+                outln!(
+                    out,
                     "   {} {}",
                     line.item_name.item_style(),
                     if line.restricted { "[R]" } else { "" }
                 );
             }
-            println!();
+            outln!(out);
         }
     }
 }
 
 /// Render the text / detail field for an `Item` to the display.
-pub(super) fn item_text(view: &mut View) {
+pub(super) fn item_text(view: &mut View, out: &mut String) {
     if let Some(entry) = view.items.iter().find(|i| matches!(i.view_item, ViewItem::ItemText(_)))
         && let ViewItem::ItemText(text) = &entry.view_item
     {
-        println!("{}:\n", "Looking closer, you see".subheading_style());
-        println!(
+        outln!(out, "{}:\n", "Looking closer, you see".subheading_style());
+        outln!(
+            out,
             "{}",
             render_wrapped(
                 text,
@@ -90,6 +94,6 @@ pub(super) fn item_text(view: &mut View) {
                 StyleMods::default(),
             )
         );
-        println!();
+        outln!(out);
     }
 }
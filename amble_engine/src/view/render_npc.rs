@@ -15,7 +15,7 @@ use crate::{
     view::icons::{ICON_NPC_ENTER, ICON_NPC_LEAVE},
 };
 
-pub(super) fn npc_detail(view: &mut View) {
+pub(super) fn npc_detail(view: &mut View, out: &mut String) {
     if let Some(entry) = view
         .items
         .iter()
@@ -27,13 +27,14 @@ pub(super) fn npc_detail(view: &mut View) {
             state,
         } = &entry.view_item
     {
-        println!("{}", name.npc_style().underline());
+        outln!(out, "{}", name.npc_style().underline());
         let formatted_state = if let NpcState::Custom(custom_state) = state {
             custom_state.highlight()
         } else {
             state.to_string().highlight()
         };
-        println!(
+        outln!(
+            out,
             "{}",
             fill(
                 format!(
@@ -49,7 +50,8 @@ pub(super) fn npc_detail(view: &mut View) {
         // if description has a multiple lines, bold the first as a tagline - otherwise
         // use the whole thing as the tagline + description.
         if let Some((tagline, rest)) = description.split_once('\n') {
-            println!(
+            outln!(
+                out,
                 "{}",
                 render_wrapped(
                     tagline,
@@ -62,7 +64,8 @@ pub(super) fn npc_detail(view: &mut View) {
                     },
                 )
             );
-            println!(
+            outln!(
+                out,
                 "{}",
                 render_wrapped(
                     rest,
@@ -73,7 +76,8 @@ pub(super) fn npc_detail(view: &mut View) {
                 )
             );
         } else {
-            println!(
+            outln!(
+                out,
                 "{}",
                 render_wrapped(
                     description,
@@ -87,18 +91,19 @@ pub(super) fn npc_detail(view: &mut View) {
                 )
             );
         }
-        println!();
+        outln!(out);
     }
     if let Some(ViewItem::NpcInventory(content_lines)) = view.items.iter().find_map(|i| match i.view_item {
         ViewItem::NpcInventory(_) => Some(&i.view_item),
         _ => None,
     }) {
-        println!("{}:", "Inventory".subheading_style());
+        outln!(out, "{}:", "Inventory".subheading_style());
         if content_lines.is_empty() {
-            println!("   {}", "(Empty)".dimmed().italic());
+            outln!(out, "   {}", "(Empty)".dimmed().italic());
         } else {
             for line in content_lines {
-                println!(
+                outln!(
+                    out,
                     "   {} {}",
                     line.item_name.item_style(),
                     if line.restricted { "[R]" } else { "" }
@@ -109,7 +114,7 @@ pub(super) fn npc_detail(view: &mut View) {
 }
 
 /// Collects and sorts, and then displays events related to NPC activities.
-pub(super) fn npc_events_sorted(entries: &[&ViewEntry]) {
+pub(super) fn npc_events_sorted(entries: &[&ViewEntry], out: &mut String) {
     // Collect all NPC-related events
     let mut npc_enters: Vec<_> = entries
         .iter()
@@ -137,19 +142,18 @@ pub(super) fn npc_events_sorted(entries: &[&ViewEntry]) {
                 ICON_NPC_ENTER.trig_icon_style(),
                 format!("{} {spin_msg}", npc_name.npc_style()).npc_movement_style()
             );
-            println!("{}", fill(formatted.as_str(), normal_block()));
+            outln!(out, "{}", fill(formatted.as_str(), normal_block()));
         }
     }
 
     // Then display speech events
     for quote in speech_msgs {
         if let ViewItem::NpcSpeech { speaker, quote } = &quote.view_item {
-            println!("{}:", speaker.npc_style());
-            println!(
+            outln!(out, "{}:", speaker.npc_style());
+            outln!(
+                out,
                 "{}",
-                fill((String::from("\"") + quote.as_str() + "\"").as_str(), indented_block())
-                    .clone()
-                    .npc_quote_style()
+                fill(format!("\"{quote}\"").as_str(), indented_block()).npc_quote_style()
             );
         }
     }
@@ -162,12 +166,12 @@ pub(super) fn npc_events_sorted(entries: &[&ViewEntry]) {
                 ICON_NPC_LEAVE.trig_icon_style(),
                 format!("{} {spin_msg}", npc_name.npc_style()).npc_movement_style()
             );
-            println!("{}", fill(formatted.as_str(), normal_block()));
+            outln!(out, "{}", fill(formatted.as_str(), normal_block()));
         }
     }
 
     // Add spacing if any NPC events were displayed
     if has_events {
-        println!();
+        outln!(out);
     }
 }
@@ -12,20 +12,20 @@ use crate::{
 };
 
 /// Displays the player's inventory list from `ViewItem::Inventory`
-pub(super) fn inventory(view: &mut View) {
+pub(super) fn inventory(view: &mut View, out: &mut String) {
     if let Some(entry) = view
         .items
         .iter_mut()
         .find(|i| matches!(i.view_item, ViewItem::Inventory(..)))
         && let ViewItem::Inventory(item_lines) = &mut entry.view_item
     {
-        println!("{}:", "Inventory".subheading_style());
+        outln!(out, "{}:", "Inventory".subheading_style());
         if item_lines.is_empty() {
-            println!("   {}", "You have... nothing at all.".italic().dimmed());
+            outln!(out, "   {}", "You have... nothing at all.".italic().dimmed());
         } else {
             item_lines.sort();
             for line in item_lines {
-                println!("   {}", line.item_name.item_style());
+                outln!(out, "   {}", line.item_name.item_style());
             }
         }
     }
@@ -33,7 +33,7 @@ pub(super) fn inventory(view: &mut View) {
 
 /// Displays the current lists of active goals (with descriptions) and a list of
 /// (crossed-out) completed goals.
-pub(super) fn goals(view: &mut View) {
+pub(super) fn goals(view: &mut View, out: &mut String) {
     let active: Vec<_> = view
         .items
         .iter()
@@ -50,14 +50,19 @@ pub(super) fn goals(view: &mut View) {
         return;
     }
 
-    println!("{}:", "Active Goals".subheading_style());
+    outln!(out, "{}:", "Active Goals".subheading_style());
     if active.is_empty() {
-        println!("   {}", "All goals met - explore to find more!\n".italic().dimmed());
+        outln!(
+            out,
+            "   {}",
+            "All goals met - explore to find more!\n".italic().dimmed()
+        );
     } else {
         for goal in active {
             if let ViewItem::ActiveGoal { name, description } = &goal.view_item {
-                println!("{}", name.goal_active_style());
-                println!(
+                outln!(out, "{}", name.goal_active_style());
+                outln!(
+                    out,
                     "{}",
                     render_wrapped(
                         description,
@@ -69,14 +74,14 @@ pub(super) fn goals(view: &mut View) {
                 );
             }
         }
-        println!();
+        outln!(out);
     }
 
     if !complete.is_empty() {
-        println!("{}:", "Completed Goals".subheading_style());
+        outln!(out, "{}:", "Completed Goals".subheading_style());
         for goal in complete {
             if let ViewItem::CompleteGoal { name, .. } = &goal.view_item {
-                println!("{}", name.goal_complete_style());
+                outln!(out, "{}", name.goal_complete_style());
             }
         }
     }
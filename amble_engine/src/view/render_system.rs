@@ -15,22 +15,23 @@ use crate::{
 };
 
 /// Used for generic messages from the engine -- rare.
-pub(super) fn engine_message(view: &mut View) {
-    let engine_msgs = view.items.iter().filter(|i| i.view_item.is_engine_message());
-    for msg in engine_msgs {
-        println!(
+pub(super) fn engine_message(view: &mut View, out: &mut String) {
+    let engine_msgs = view.items.iter().filter_map(|i| match &i.view_item {
+        ViewItem::EngineMessage(text) => Some(text),
+        _ => None,
+    });
+    for text in engine_msgs {
+        outln!(
+            out,
             "{}",
-            fill(
-                format!("{ICON_ENGINE:<4}{}", msg.view_item.clone().unwrap_engine_message()).as_str(),
-                normal_block()
-            )
+            fill(format!("{ICON_ENGINE:<4}{text}").as_str(), normal_block())
         );
     }
-    println!();
+    outln!(out);
 }
 
 /// Displays a list of available saved games.
-pub(super) fn saved_games(view: &mut View) {
+pub(super) fn saved_games(view: &mut View, out: &mut String) {
     let Some((directory, entries)) = view.items.iter().find_map(|entry| match &entry.view_item {
         ViewItem::SavedGamesList { directory, entries } => Some((directory, entries)),
         _ => None,
@@ -38,13 +39,14 @@ pub(super) fn saved_games(view: &mut View) {
         return;
     };
 
-    println!("{}", format!("Saved games in {directory}/").subheading_style());
+    outln!(out, "{}", format!("Saved games in {directory}/").subheading_style());
     if entries.is_empty() {
-        println!(
+        outln!(
+            out,
             "    {}",
             "No saved games found. Use `save <slot>` to create one.".italic()
         );
-        println!();
+        outln!(out);
         return;
     }
 
@@ -61,11 +63,12 @@ pub(super) fn saved_games(view: &mut View) {
         } else {
             format!("  • {slot_label} {version_label}")
         };
-        println!("{header}");
+        outln!(out, "{header}");
 
         if let Some(summary) = &entry.summary {
             let location = summary.player_location.as_deref().unwrap_or("Unknown location");
-            println!(
+            outln!(
+                out,
                 "    Player: {} | Turn {} | Score {} | Location: {}",
                 summary.player_name.as_str().highlight(),
                 summary.turn_count,
@@ -78,17 +81,19 @@ pub(super) fn saved_games(view: &mut View) {
                 } else {
                     format!(" v{}", summary.world_version)
                 };
-                println!(
+                outln!(
+                    out,
                     "    World: {}{}",
                     summary.world_title.as_str().highlight(),
                     version.dimmed()
                 );
             }
         } else {
-            println!("    {}", "Metadata unavailable for this save.".denied_style());
+            outln!(out, "    {}", "Metadata unavailable for this save.".denied_style());
         }
 
-        println!(
+        outln!(
+            out,
             "    {}",
             format!("load {}    [{}]", entry.slot, entry.path.display()).dimmed()
         );
@@ -98,28 +103,35 @@ pub(super) fn saved_games(view: &mut View) {
             SaveFileStatus::VersionMismatch {
                 save_version,
                 current_version,
-            } => println!(
+            } => outln!(
+                out,
                 "    {} {}",
                 "Warning:".bold().yellow(),
                 format!("saved with v{save_version}, current engine v{current_version}.").yellow()
             ),
-            SaveFileStatus::Corrupted { message } => println!("    {} {}", "Error:".bold().red(), message.red()),
+            SaveFileStatus::Corrupted { message } => outln!(out, "    {} {}", "Error:".bold().red(), message.red()),
         }
-        println!();
+        outln!(out);
     }
 }
 
 /// Displays confirmation message when a game is loaded or saved.
-pub(super) fn load_or_save(view: &mut View) {
+pub(super) fn load_or_save(view: &mut View, out: &mut String) {
     if let Some(entry) = view
         .items
         .iter()
         .find(|i| matches!(i.view_item, ViewItem::GameSaved { .. }))
         && let ViewItem::GameSaved { save_slot, save_file } = &entry.view_item
     {
-        println!("{}: \"{}\" ({})", "Game Saved".green().bold(), save_slot, save_file);
-        println!("{}", format!("Type \"load {save_slot}\" to reload it.").italic());
-        println!();
+        outln!(
+            out,
+            "{}: \"{}\" ({})",
+            "Game Saved".green().bold(),
+            save_slot,
+            save_file
+        );
+        outln!(out, "{}", format!("Type \"load {save_slot}\" to reload it.").italic());
+        outln!(out);
     }
     if let Some(entry) = view
         .items
@@ -127,13 +139,19 @@ pub(super) fn load_or_save(view: &mut View) {
         .find(|i| matches!(i.view_item, ViewItem::GameLoaded { .. }))
         && let ViewItem::GameLoaded { save_slot, save_file } = &entry.view_item
     {
-        println!("{}: \"{}\" ({})", "Game Loaded".green().bold(), save_slot, save_file);
-        println!();
+        outln!(
+            out,
+            "{}: \"{}\" ({})",
+            "Game Loaded".green().bold(),
+            save_slot,
+            save_file
+        );
+        outln!(out);
     }
 }
 
 /// Displays the general help message and command guide.
-pub(super) fn show_help(view: &mut View) {
+pub(super) fn show_help(view: &mut View, out: &mut String) {
     if let Some(entry) = view
         .items
         .iter()
@@ -141,26 +159,26 @@ pub(super) fn show_help(view: &mut View) {
         && let ViewItem::Help { basic_text, commands } = &entry.view_item
     {
         // Print the basic help text with proper text wrapping
-        println!("{}", fill(basic_text, normal_block()).italic().cyan());
-        println!();
+        outln!(out, "{}", fill(basic_text, normal_block()).italic().cyan());
+        outln!(out);
 
         // Partition commands into normal vs DEV (':'-prefixed)
         let (dev_cmds, normal_cmds): (Vec<_>, Vec<_>) =
             commands.iter().cloned().partition(|c| c.command.starts_with(':'));
 
         // Print normal commands section
-        println!("{}", "Some Common Commands:".bold().yellow());
-        println!();
+        outln!(out, "{}", "Some Common Commands:".bold().yellow());
+        outln!(out);
         for command in &normal_cmds {
             let formatted_line = format!("{} - {}", command.command.bold().green(), command.description.italic());
-            println!("{}", fill(&formatted_line, normal_block()));
+            outln!(out, "{}", fill(&formatted_line, normal_block()));
         }
 
         // Print developer commands section if present and DEV_MODE
         if crate::DEV_MODE && !dev_cmds.is_empty() {
-            println!();
-            println!("{}", "Developer Commands (DEV_MODE):".bold().yellow());
-            println!();
+            outln!(out);
+            outln!(out, "{}", "Developer Commands (DEV_MODE):".bold().yellow());
+            outln!(out);
             for command in &dev_cmds {
                 let desc = command
                     .description
@@ -168,7 +186,7 @@ pub(super) fn show_help(view: &mut View) {
                     .unwrap_or(&command.description)
                     .to_string();
                 let formatted_line = format!("{} - {}", command.command.bold().green(), desc.italic());
-                println!("{}", fill(&formatted_line, normal_block()));
+                outln!(out, "{}", fill(&formatted_line, normal_block()));
             }
         }
     }
@@ -176,7 +194,7 @@ pub(super) fn show_help(view: &mut View) {
 
 /// Displays the game summary when the player quits.
 #[allow(clippy::cast_precision_loss)]
-pub(super) fn quit_summary(view: &mut View) {
+pub(super) fn quit_summary(view: &mut View, out: &mut String) {
     if let Some(entry) = view
         .items
         .iter()
@@ -193,10 +211,15 @@ pub(super) fn quit_summary(view: &mut View) {
     {
         let score_pct = 100.0 * (*score as f32 / *max_score as f32);
         let visit_pct = 100.0 * (*visited as f32 / *max_visited as f32);
-        println!("{:^width$}", title.as_str().black().on_yellow(), width = termwidth());
-        println!("{:10} {}", "Rank:", rank.bright_cyan());
-        println!("{:10} {}", "Notes:", notes.description_style());
-        println!("{:10} {}/{} ({:.1}%)", "Score:", score, max_score, score_pct);
-        println!("{:10} {}/{} ({:.1}%)", "Visited:", visited, max_visited, visit_pct);
+        outln!(
+            out,
+            "{:^width$}",
+            title.as_str().black().on_yellow(),
+            width = termwidth()
+        );
+        outln!(out, "{:10} {}", "Rank:", rank.bright_cyan());
+        outln!(out, "{:10} {}", "Notes:", notes.description_style());
+        outln!(out, "{:10} {}/{} ({:.1}%)", "Score:", score, max_score, score_pct);
+        outln!(out, "{:10} {}/{} ({:.1}%)", "Visited:", visited, max_visited, visit_pct);
     }
 }
@@ -16,41 +16,37 @@ use crate::{
     view::icons::{ICON_AMBIENT, ICON_CELEBRATE, ICON_NEGATIVE, ICON_POSITIVE, ICON_TRIGGER},
 };
 
-pub(super) fn points_awarded(entries: &[&ViewEntry]) {
+pub(super) fn points_awarded(entries: &[&ViewEntry], out: &mut String) {
     let point_msgs = entries.iter().copied().filter(|i| i.view_item.is_points_awarded());
     for msg in point_msgs {
         if let ViewItem::PointsAwarded { amount, reason } = &msg.view_item {
             if amount.is_negative() {
                 let text = format!("{} (-{} point{})\n", reason, amount.abs(), plural_s(amount.abs())).bright_red();
-                println!("{:<4}{}", ICON_NEGATIVE.bright_red(), text);
+                outln!(out, "{:<4}{}", ICON_NEGATIVE.bright_red(), text);
             } else if *amount > 15 {
                 let text = format!("{} (+{} point{}!)\n", reason, amount, plural_s(*amount)).bright_blue();
-                println!("{:<4}{}", ICON_CELEBRATE.bright_blue(), text);
+                outln!(out, "{:<4}{}", ICON_CELEBRATE.bright_blue(), text);
             } else {
                 let text = format!("{} (+{} point{})\n", reason, amount, plural_s(*amount)).bright_green();
-                println!("{:<4}{}", ICON_POSITIVE.bright_green(), text);
+                outln!(out, "{:<4}{}", ICON_POSITIVE.bright_green(), text);
             }
         }
     }
 }
 
-pub(super) fn ambient_event(view: &mut View) {
-    let trig_messages = view
-        .items
-        .iter()
-        .filter(|i| matches!(i.view_item, ViewItem::AmbientEvent(_)));
-    for msg in trig_messages {
-        let formatted = format!(
-            "{:<4}{}",
-            ICON_AMBIENT.ambient_icon_style(),
-            msg.view_item.clone().unwrap_ambient_event().ambient_trig_style()
-        );
-        println!("{}", fill(formatted.as_str(), normal_block()));
-        println!();
+pub(super) fn ambient_event(view: &mut View, out: &mut String) {
+    let trig_messages = view.items.iter().filter_map(|i| match &i.view_item {
+        ViewItem::AmbientEvent(text) => Some(text),
+        _ => None,
+    });
+    for text in trig_messages {
+        let formatted = format!("{:<4}{}", ICON_AMBIENT.ambient_icon_style(), text.ambient_trig_style());
+        outln!(out, "{}", fill(formatted.as_str(), normal_block()));
+        outln!(out);
     }
 }
 
-pub(super) fn triggered_event(entries: &[&ViewEntry]) {
+pub(super) fn triggered_event(entries: &[&ViewEntry], out: &mut String) {
     let trig_messages = entries.iter().filter_map(|entry| match &entry.view_item {
         ViewItem::TriggeredEvent(text) => Some(text),
         _ => None,
@@ -68,7 +64,7 @@ pub(super) fn triggered_event(entries: &[&ViewEntry]) {
             },
         );
 
-        println!("{rendered}");
-        println!();
+        outln!(out, "{rendered}");
+        outln!(out);
     }
 }
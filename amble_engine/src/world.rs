@@ -3,27 +3,31 @@
 //! This module defines [`AmbleWorld`] and related types used at runtime to
 //! track the current state of the adventure.
 
+use crate::content::Shared;
+use crate::entity_search::SearchCache;
 use crate::item::{ContainerState, ItemVisibility};
 use crate::loader::scoring::ScoringConfig;
 use crate::npc::Npc;
+use crate::rng::WorldRng;
 use crate::spinners::{CoreSpinnerType, SpinnerType};
-use crate::trigger::Trigger;
+use crate::tracked_map::{self, TrackedMap};
+use crate::trigger::{Trigger, TriggerIndex};
 use crate::{AMBLE_VERSION, ItemId, NpcId, RoomId};
 use crate::{Goal, Item, Player, Room, Scheduler};
 
+use crate::spinners::Spinner;
 use anyhow::{Context, Result, anyhow};
-use gametools::Spinner;
 use log::info;
 use serde::{Deserialize, Serialize};
 
 use crate::Id;
-use std::collections::{HashMap, HashSet};
+use std::collections::HashSet;
 use variantly::Variantly;
 
 /// Kinds of places where a `WorldObject` may be located.
 /// Because Rooms *are* the locations, their location is always `Nowhere`
 /// Unspawned/despawned items and NPCs are also located `Nowhere`
-#[derive(Debug, Default, Clone, Serialize, Deserialize, Variantly, PartialEq, Eq)]
+#[derive(Debug, Default, Clone, Copy, Serialize, Deserialize, Variantly, PartialEq, Eq)]
 pub enum Location {
     Item(ItemId),
     Inventory,
@@ -72,9 +76,9 @@ pub trait WorldObject {
 #[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct AmbleWorld {
     /// Rooms or areas that define the game world
-    pub rooms: HashMap<RoomId, Room>,
+    pub rooms: TrackedMap<RoomId, Room>,
     /// Inanimate objects
-    pub items: HashMap<ItemId, Item>,
+    pub items: TrackedMap<ItemId, Item>,
     /// Actions that fire in response to events or changes in world state
     pub triggers: Vec<Trigger>,
     /// The player character
@@ -83,15 +87,19 @@ pub struct AmbleWorld {
     #[serde(default)]
     pub player_path: Vec<RoomId>,
     /// Text / phrase randomizers for ambient events, status effects, and to keep engine messages from being repetitive
-    pub spinners: HashMap<SpinnerType, Spinner<String>>,
+    /// (saves hold only spinners changed in play; the rest are restored from the world content)
+    #[serde(serialize_with = "crate::content::serialize_overrides")]
+    pub spinners: TrackedMap<SpinnerType, Shared<Spinner<String>>>,
     /// Non-playable characters
-    pub npcs: HashMap<NpcId, Npc>,
+    pub npcs: TrackedMap<NpcId, Npc>,
     /// The maximum achieveable score in the game
     pub max_score: usize,
     /// Goals or achievements to guide player progress
-    pub goals: Vec<Goal>,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub goals: Shared<Vec<Goal>>,
     /// Configuration for final scoring report when player quits the game
-    pub scoring: ScoringConfig,
+    #[serde(default = "Shared::pending", skip_serializing_if = "Shared::is_content")]
+    pub scoring: Shared<ScoringConfig>,
     /// Game title displayed at startup.
     pub game_title: String,
     /// Stable slug identifying the world content.
@@ -114,21 +122,37 @@ pub struct AmbleWorld {
     pub turn_count: usize,
     /// The Event Scheduler -- schedules conditional events for future game turns
     pub scheduler: Scheduler,
+    /// Source of every random draw (chance triggers, spinners, NPC dialogue and movement).
+    /// Saved with the game so a loaded save continues the same sequence.
+    #[serde(default)]
+    pub rng: WorldRng,
+    /// Item search candidates per room (derived from `rooms`/`items`, refilled on change)
+    #[serde(skip)]
+    pub search_cache: SearchCache,
+    /// Event-to-trigger lookup table (derived from `triggers`, rebuilt after load)
+    #[serde(skip)]
+    pub trigger_index: TriggerIndex,
+    /// Stamp of the current trigger list; changes whenever the list is replaced.
+    #[serde(skip)]
+    pub triggers_revision: u64,
+    /// Autosave journal session this world was last snapshotted for (`None` = never).
+    #[serde(skip)]
+    pub journal_epoch: Option<u64>,
 }
 impl AmbleWorld {
     /// Create a new empty world with a default player.
     pub fn new_empty() -> AmbleWorld {
         let world = Self {
-            rooms: HashMap::new(),
-            npcs: HashMap::new(),
-            items: HashMap::new(),
+            rooms: TrackedMap::new(),
+            npcs: TrackedMap::new(),
+            items: TrackedMap::new(),
             triggers: Vec::new(),
             player: Player::default(),
             player_path: Vec::new(),
-            spinners: HashMap::new(),
+            spinners: TrackedMap::new(),
             max_score: 0,
-            goals: Vec::new(),
-            scoring: ScoringConfig::default(),
+            goals: Shared::default(),
+            scoring: Shared::default(),
             game_title: String::new(),
             world_slug: String::new(),
             world_author: String::new(),
@@ -138,16 +162,28 @@ impl AmbleWorld {
             version: AMBLE_VERSION.to_string(),
             turn_count: 0,
             scheduler: Scheduler::default(),
+            rng: WorldRng::default(),
+            search_cache: SearchCache::default(),
+            trigger_index: TriggerIndex::default(),
+            triggers_revision: 0,
+            journal_epoch: None,
         };
         info!("new, empty 'AmbleWorld' created");
         world
     }
 
+    /// Replace the trigger list, stamping it with a new revision so the trigger index
+    /// is rebuilt even when the new list has the same length.
+    pub fn replace_triggers(&mut self, triggers: Vec<Trigger>) {
+        self.triggers = triggers;
+        self.triggers_revision = tracked_map::next_revision();
+    }
+
     /// Returns a random string from the selected spinner type, or a supplied default.
     pub fn spin_spinner(&self, spin_type: &SpinnerType, default: &'static str) -> String {
         self.spinners
             .get(spin_type)
-            .and_then(gametools::Spinner::spin)
+            .and_then(|spinner| spinner.spin(&self.rng))
             .unwrap_or_else(|| default.to_string())
     }
 
@@ -322,6 +358,7 @@ pub fn nearby_vessel_items(world: &AmbleWorld, room_id: &RoomId) -> Result<HashS
 mod tests {
     use super::*;
 
+    use crate::spinners::{Spinner, Wedge};
     use crate::{
         health::HealthState,
         item::{ContainerState, Item, Movability},
@@ -330,7 +367,6 @@ mod tests {
         room::Room,
         spinners::SpinnerType,
     };
-    use gametools::{Spinner, Wedge};
     use std::collections::{HashMap, HashSet};
 
     fn create_test_item(id: &ItemId, location: Location) -> Item {
@@ -348,7 +384,7 @@ mod tests {
             contents: HashSet::new(),
             abilities: HashSet::new(),
             interaction_requires: HashMap::new(),
-            text: None,
+            text: None.into(),
             consumable: None,
         }
     }
@@ -359,8 +395,8 @@ mod tests {
             symbol: format!("room_{id}"),
             name: format!("Room {id}"),
             base_description: "A test room".into(),
-            overlays: vec![],
-            scenery: Vec::new(),
+            overlays: vec![].into(),
+            scenery: Vec::new().into(),
             scenery_default: None,
             location: Location::Nowhere,
             visited: false,
@@ -379,7 +415,7 @@ mod tests {
             description: "A test NPC".into(),
             location,
             inventory: HashSet::new(),
-            dialogue: HashMap::new(),
+            dialogue: HashMap::new().into(),
             state: NpcState::Normal,
             movement: None,
             health: HealthState::new(),
@@ -470,7 +506,7 @@ mod tests {
         let spinner = Spinner::new(vec![Wedge::new("custom result".into())]);
         world
             .spinners
-            .insert(SpinnerType::Core(CoreSpinnerType::Movement), spinner);
+            .insert(SpinnerType::Core(CoreSpinnerType::Movement), spinner.into());
 
         let result = world.spin_spinner(&SpinnerType::Core(CoreSpinnerType::Movement), "default");
         assert_eq!(result, "custom result");
@@ -497,7 +533,7 @@ mod tests {
         let spinner = Spinner::new(vec![Wedge::new("custom result".into())]);
         world
             .spinners
-            .insert(SpinnerType::Custom("testSpinner".to_string()), spinner);
+            .insert(SpinnerType::Custom("testSpinner".to_string()), spinner.into());
 
         let result = world.spin_custom("testSpinner", "default");
         assert_eq!(result, "custom result");
@@ -35,7 +35,7 @@ fn test_item_accessible() {
         id: ae::idgen::new_id().into(),
         symbol: "i".into(),
         name: "Box".into(),
-        description: String::new(),
+        description: String::new().into(),
         location: world::Location::Nowhere,
         visibility: ae::item::ItemVisibility::Listed,
         visible_when: None,
@@ -45,7 +45,7 @@ fn test_item_accessible() {
         contents: Default::default(),
         abilities: Default::default(),
         interaction_requires: Default::default(),
-        text: None,
+        text: None.into(),
         consumable: None,
     };
     assert!(item.is_accessible());
@@ -79,7 +79,7 @@ fn test_find_world_object() {
         id: id.clone(),
         symbol: "i".into(),
         name: "Foo".into(),
-        description: String::new(),
+        description: String::new().into(),
         location: world::Location::Inventory,
         visibility: ae::item::ItemVisibility::Listed,
         visible_when: None,
@@ -89,7 +89,7 @@ fn test_find_world_object() {
         contents: Default::default(),
         abilities: Default::default(),
         interaction_requires: Default::default(),
-        text: None,
+        text: None.into(),
         consumable: None,
     };
     let mut items = HashMap::new();
@@ -178,7 +178,7 @@ fn test_interaction_requirement_met() {
         id: ae::idgen::new_id().into(),
         symbol: "t".into(),
         name: "tool".into(),
-        description: String::new(),
+        description: String::new().into(),
         location: world::Location::Nowhere,
         visibility: ae::item::ItemVisibility::Listed,
         visible_when: None,
@@ -188,14 +188,14 @@ fn test_interaction_requirement_met() {
         movability: item::Movability::Free,
         abilities: [ItemAbility::Clean].into_iter().collect(),
         interaction_requires: Default::default(),
-        text: None,
+        text: None.into(),
         consumable: None,
     };
     let target = Item {
         id: ae::idgen::new_id().into(),
         symbol: "x".into(),
         name: "target".into(),
-        description: String::new(),
+        description: String::new().into(),
         location: world::Location::Nowhere,
         visibility: ae::item::ItemVisibility::Listed,
         visible_when: None,
@@ -205,7 +205,7 @@ fn test_interaction_requirement_met() {
         contents: Default::default(),
         abilities: Default::default(),
         interaction_requires: std::iter::once((ItemInteractionType::Clean, ItemAbility::Clean)).collect(),
-        text: None,
+        text: None.into(),
         consumable: None,
     };
     assert!(ae::item::interaction_requirement_met(
@@ -243,10 +243,10 @@ fn test_worlddef_npc_to_world() {
     };
     let mut world = ae::loader::worlddef::build_world_from_def(&def).unwrap();
     ae::loader::placement::place_npcs(&mut world).unwrap();
-    let npc = world.npcs.get("npc").unwrap();
+    let npc = world.npcs.get(&NpcId::from("npc")).unwrap();
     assert_eq!(npc.name, "Npc");
     let room = world.rooms.get(&RoomId::from("room")).unwrap();
-    assert!(room.npcs.contains("npc"));
+    assert!(room.npcs.contains(&NpcId::from("npc")));
 }
 
 #[test]
@@ -280,7 +280,7 @@ fn test_worlddef_trigger_combines_event_and_conditions() {
     let world = ae::loader::worlddef::build_world_from_def(&def).unwrap();
     let trigger = &world.triggers[0];
 
-    match &trigger.conditions {
+    match &*trigger.conditions {
         EventCondition::All(list) => {
             assert_eq!(list.len(), 2);
             assert!(list.iter().any(|cond| matches!(
@@ -324,7 +324,7 @@ fn test_worlddef_any_condition_supports_ambient_without_rooms() {
     let world = ae::loader::worlddef::build_world_from_def(&def).unwrap();
     let trigger = &world.triggers[0];
 
-    match &trigger.conditions {
+    match &*trigger.conditions {
         EventCondition::Any(list) => {
             assert_eq!(list.len(), 2);
 
@@ -395,14 +395,14 @@ fn test_move_to_handler_simple() {
         id: r1.clone(),
         symbol: "r1".into(),
         name: "R1".into(),
-        base_description: String::new(),
-        overlays: vec![],
+        base_description: String::new().into(),
+        overlays: vec![].into(),
         location: world::Location::Nowhere,
         visited: true,
         exits: HashMap::new(),
         contents: HashSet::new(),
         npcs: HashSet::new(),
-        scenery: vec![],
+        scenery: vec![].into(),
         scenery_default: None,
     };
     room1.exits.insert(
@@ -420,14 +420,14 @@ fn test_move_to_handler_simple() {
         id: r2.clone(),
         symbol: "r2".into(),
         name: "R2".into(),
-        base_description: String::new(),
-        overlays: vec![],
+        base_description: String::new().into(),
+        overlays: vec![].into(),
         location: world::Location::Nowhere,
         visited: false,
         exits: HashMap::new(),
         contents: HashSet::new(),
         npcs: HashSet::new(),
-        scenery: vec![],
+        scenery: vec![].into(),
         scenery_default: None,
     };
     world.rooms.insert(r1.clone(), room1);
@@ -478,42 +478,42 @@ fn test_check_npc_movement() {
         id: r1.clone(),
         symbol: "r1".into(),
         name: "R1".into(),
-        base_description: String::new(),
-        overlays: vec![],
+        base_description: String::new().into(),
+        overlays: vec![].into(),
         location: world::Location::Nowhere,
         visited: true,
         exits: HashMap::new(),
         contents: HashSet::new(),
         npcs: HashSet::new(),
-        scenery: vec![],
+        scenery: vec![].into(),
         scenery_default: None,
     };
     let room2 = Room {
         id: r2.clone(),
         symbol: "r2".into(),
         name: "R2".into(),
-        base_description: String::new(),
-        overlays: vec![],
+        base_description: String::new().into(),
+        overlays: vec![].into(),
         location: world::Location::Nowhere,
         visited: false,
         exits: HashMap::new(),
         contents: HashSet::new(),
         npcs: HashSet::new(),
-        scenery: vec![],
+        scenery: vec![].into(),
         scenery_default: None,
     };
     let _room3 = Room {
         id: ae::idgen::new_room_id(),
         symbol: "r3".into(),
         name: "R3".into(),
-        base_description: String::new(),
-        overlays: vec![],
+        base_description: String::new().into(),
+        overlays: vec![].into(),
         location: world::Location::Nowhere,
         visited: false,
         exits: HashMap::new(),
         contents: HashSet::new(),
         npcs: HashSet::new(),
-        scenery: vec![],
+        scenery: vec![].into(),
         scenery_default: None,
     };
     world.rooms.insert(r1.clone(), room1);
@@ -523,10 +523,10 @@ fn test_check_npc_movement() {
         id: npc_id.clone(),
         symbol: "npc".into(),
         name: "NPC".into(),
-        description: String::new(),
+        description: String::new().into(),
         location: world::Location::Room(r1.clone()),
         inventory: HashSet::new(),
-        dialogue: HashMap::new(),
+        dialogue: HashMap::new().into(),
         state: npc::NpcState::Normal,
         health: HealthState::new_at_max(10),
         movement: Some(NpcMovement {
@@ -553,8 +553,8 @@ fn test_check_npc_movement() {
 fn test_check_ambient_triggers() {
     use ae::scheduler::EventCondition;
     use ae::spinners::SpinnerType;
+    use ae::spinners::{Spinner, Wedge};
     use ae::trigger::{Trigger, TriggerCondition};
-    use gametools::{Spinner, Wedge};
     let mut world = world::AmbleWorld::new_empty();
     let mut view = View::new();
     let r1 = ae::idgen::new_room_id();
@@ -562,28 +562,29 @@ fn test_check_ambient_triggers() {
         id: r1.clone(),
         symbol: "r1".into(),
         name: "R1".into(),
-        base_description: String::new(),
-        overlays: vec![],
+        base_description: String::new().into(),
+        overlays: vec![].into(),
         location: world::Location::Nowhere,
         visited: true,
         exits: std::collections::HashMap::new(),
         contents: std::collections::HashSet::new(),
         npcs: std::collections::HashSet::new(),
-        scenery: vec![],
+        scenery: vec![].into(),
         scenery_default: None,
     };
     world.rooms.insert(r1.clone(), room1);
     world.player.location = world::Location::Room(r1.clone());
     let spinner_type = SpinnerType::Custom("test_spinner".to_string());
     let spinner = Spinner::new(vec![Wedge::new("test message".to_string())]);
-    world.spinners.insert(spinner_type.clone(), spinner);
+    world.spinners.insert(spinner_type.clone(), spinner.into());
     let trigger = Trigger {
         name: "ambient".into(),
         conditions: EventCondition::Trigger(TriggerCondition::Ambient {
             room_ids: [r1.clone()].into_iter().collect(),
             spinner: spinner_type,
-        }),
-        actions: vec![],
+        })
+        .into(),
+        actions: vec![].into(),
         only_once: false,
         fired: false,
     };
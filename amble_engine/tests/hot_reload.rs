@@ -0,0 +1,84 @@
+use std::path::Path;
+
+use amble_engine::hot_reload::carry_over_state;
+use amble_engine::replay::Transcript;
+use amble_engine::session::Session;
+use amble_engine::{AmbleWorld, load_world_from_ron};
+
+fn manifest_path(relative: &str) -> std::path::PathBuf {
+    Path::new(env!("CARGO_MANIFEST_DIR")).join(relative)
+}
+
+/// The demo world after playing the demo walkthrough.
+fn played_world() -> AmbleWorld {
+    let transcript = Transcript::load(&manifest_path("tests/transcripts/amble-demo.txt")).expect("transcript");
+    let mut session = Session::load(&manifest_path("data/worlds/amble-demo.ron")).expect("world");
+    for command in &transcript.commands {
+        session.send(command).expect("command");
+    }
+    session.into_world()
+}
+
+fn fired_triggers(world: &AmbleWorld) -> Vec<&str> {
+    world
+        .triggers
+        .iter()
+        .filter(|t| t.fired)
+        .map(|t| t.name.as_str())
+        .collect()
+}
+
+#[test]
+fn reload_keeps_progress_for_matching_ids() {
+    let played = played_world();
+    let mut fresh = load_world_from_ron(&manifest_path("data/worlds/amble-demo.ron")).expect("world");
+    let report = carry_over_state(&played, &mut fresh).expect("carry over");
+
+    assert!(report.dropped.is_empty() && !report.player_moved);
+    assert_eq!(report.items, played.items.len());
+    assert_eq!(fresh.turn_count, played.turn_count);
+    assert_eq!(fresh.player.location, played.player.location);
+    assert_eq!(fresh.player.inventory, played.player.inventory);
+    assert_eq!(fresh.player.score, played.player.score);
+    assert_eq!(fired_triggers(&fresh), fired_triggers(&played));
+    for item in played.items.values() {
+        assert_eq!(
+            fresh.items.get(&item.id).unwrap().location,
+            item.location,
+            "{}",
+            item.symbol
+        );
+    }
+    for room in played.rooms.values() {
+        let reloaded = fresh.rooms.get(&room.id).unwrap();
+        assert_eq!(
+            (reloaded.visited, &reloaded.contents),
+            (room.visited, &room.contents),
+            "{}",
+            room.symbol
+        );
+    }
+}
+
+#[test]
+fn reload_drops_state_for_removed_content() {
+    let played = played_world();
+    let carried = played.player.inventory.len();
+    let mut removable: Vec<_> = played
+        .player
+        .inventory
+        .iter()
+        .copied()
+        .filter(|id| played.items.get(id).unwrap().contents.is_empty())
+        .collect();
+    removable.sort_by(|a, b| a.as_str().cmp(b.as_str()));
+    let removed = *removable.first().expect("walkthrough picks items up");
+
+    let mut fresh = load_world_from_ron(&manifest_path("data/worlds/amble-demo.ron")).expect("world");
+    fresh.items.remove(&removed);
+    let report = carry_over_state(&played, &mut fresh).expect("carry over");
+
+    assert_eq!(report.dropped, vec![played.items.get(&removed).unwrap().symbol.clone()]);
+    assert!(!fresh.player.inventory.contains(&removed));
+    assert_eq!(fresh.player.inventory.len(), carried - 1);
+}
@@ -0,0 +1,42 @@
+use std::path::Path;
+
+use amble_engine::replay::{Transcript, replay, replay_file};
+
+fn manifest_path(relative: &str) -> std::path::PathBuf {
+    Path::new(env!("CARGO_MANIFEST_DIR")).join(relative)
+}
+
+#[test]
+fn demo_walkthrough_replays_to_the_end() {
+    let world_path = manifest_path("data/worlds/amble-demo.ron");
+    let transcript_path = manifest_path("tests/transcripts/amble-demo.txt");
+    let transcript = Transcript::load(&transcript_path).expect("transcript");
+    assert!(transcript.seed.is_some());
+
+    let report = replay_file(&world_path, &transcript_path).expect("replay");
+    assert!(!report.ended_early, "walkthrough should not kill or quit the player");
+    assert_eq!(report.turns.len(), transcript.commands.len());
+    assert!(report.turns.last().unwrap().turn > report.turns[0].turn);
+    for command in &transcript.commands {
+        assert!(report.output.contains(&format!("> {command}\n")));
+    }
+}
+
+#[test]
+fn seeded_replays_are_identical() {
+    let world = amble_engine::load_world_from_ron(&manifest_path("data/worlds/amble-demo.ron")).expect("world");
+    let transcript = Transcript::load(&manifest_path("tests/transcripts/amble-demo.txt")).expect("transcript");
+    let first = replay(world.clone(), &transcript).expect("replay");
+    let second = replay(world, &transcript).expect("replay");
+    assert_eq!(first.diff_golden(&second.output), None);
+}
+
+#[test]
+fn replay_stops_when_the_player_quits() {
+    let world = amble_engine::load_world_from_ron(&manifest_path("data/worlds/amble-demo.ron")).expect("world");
+    let transcript = Transcript::parse("look\nquit\nlook\n").unwrap();
+    let report = replay(world, &transcript).expect("replay");
+    assert!(report.ended_early);
+    assert_eq!(report.turns.len(), 2);
+    assert_eq!(report.diff_golden(&report.output.clone()), None);
+}
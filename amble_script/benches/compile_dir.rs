@@ -0,0 +1,153 @@
+//! Parse, alias resolution and lowering (`compile_sources`) of the bundled Amble world
+//! and of a synthetic world ten times its size, on one thread and on every CPU; and
+//! the same world rebuilt through the compile cache after a one-file edit.
+//!
+//! The synthetic world repeats every source file ten times, renaming the condition
+//! aliases and action sets declared in each copy so they do not collide. Room and
+//! item ids still repeat, so only the per-file pipeline is timed, not `worlddef_from_asts`.
+
+use std::fs;
+use std::hint::black_box;
+use std::num::NonZeroUsize;
+use std::path::{Path, PathBuf};
+use std::thread;
+
+use amble_script::{CompileCache, compile_sources, compile_sources_cached};
+use criterion::{BatchSize, BenchmarkId, Criterion, Throughput, criterion_group, criterion_main};
+
+fn collect_sources(dir: &Path, out: &mut Vec<(String, String)>) {
+    let mut entries: Vec<PathBuf> = fs::read_dir(dir)
+        .expect("read source dir")
+        .map(|entry| entry.expect("dir entry").path())
+        .collect();
+    entries.sort();
+    for path in entries {
+        if path.is_dir() {
+            collect_sources(&path, out);
+        } else if path.extension().is_some_and(|ext| ext == "amble") {
+            let text = fs::read_to_string(&path).expect("read source");
+            out.push((path.display().to_string(), text));
+        }
+    }
+}
+
+/// Names declared by `let cond` and `let actions` across `sources`.
+fn global_names(sources: &[(String, String)]) -> Vec<String> {
+    sources
+        .iter()
+        .flat_map(|(_, text)| text.lines())
+        .filter_map(|line| {
+            let line = line.trim_start();
+            let rest = line
+                .strip_prefix("let cond ")
+                .or_else(|| line.strip_prefix("let actions "))?;
+            rest.split_whitespace().next().map(str::to_string)
+        })
+        .collect()
+}
+
+fn is_ident_char(c: char) -> bool {
+    c.is_ascii_alphanumeric() || c == '_' || c == '-'
+}
+
+/// Replace whole-word occurrences of `name` in `text` with `renamed`.
+fn rename_word(text: &str, name: &str, renamed: &str) -> String {
+    let mut out = String::with_capacity(text.len());
+    let mut rest = text;
+    while let Some(pos) = rest.find(name) {
+        let before = rest[..pos].chars().next_back();
+        let after = rest[pos + name.len()..].chars().next();
+        out.push_str(&rest[..pos]);
+        if before.is_some_and(is_ident_char) || after.is_some_and(is_ident_char) {
+            out.push_str(name);
+        } else {
+            out.push_str(renamed);
+        }
+        rest = &rest[pos + name.len()..];
+    }
+    out.push_str(rest);
+    out
+}
+
+/// `copies` copies of `sources`, with the global names of every copy after the first renamed.
+fn scaled(sources: &[(String, String)], copies: usize) -> Vec<(String, String)> {
+    let names = global_names(sources);
+    let mut out = sources.to_vec();
+    for copy in 1..copies {
+        for (path, text) in sources {
+            let mut text = text.clone();
+            for name in &names {
+                text = rename_word(&text, name, &format!("{name}_copy{copy}"));
+            }
+            out.push((format!("{path}#{copy}"), text));
+        }
+    }
+    out
+}
+
+fn bench_compile_dir(c: &mut Criterion) {
+    let mut base = Vec::new();
+    collect_sources(&Path::new(env!("CARGO_MANIFEST_DIR")).join("data/Amble"), &mut base);
+    let cpus = thread::available_parallelism().map_or(1, NonZeroUsize::get);
+
+    let mut group = c.benchmark_group("compile_dir");
+    group.sample_size(10);
+    for (label, sources) in [("amble", base.clone()), ("amble_x10", scaled(&base, 10))] {
+        let inputs: Vec<(&str, &str)> = sources.iter().map(|(p, t)| (p.as_str(), t.as_str())).collect();
+        compile_sources(&inputs, 1).expect("synthetic world compiles");
+        group.throughput(Throughput::Bytes(sources.iter().map(|(_, t)| t.len() as u64).sum()));
+        let mut job_counts = vec![1];
+        if cpus > 1 {
+            job_counts.push(cpus);
+        }
+        for jobs in job_counts {
+            group.bench_with_input(BenchmarkId::new(label, format!("{jobs}_jobs")), &inputs, |b, inputs| {
+                b.iter(|| compile_sources(black_box(inputs), jobs).expect("compiles"));
+            });
+        }
+    }
+    group.finish();
+}
+
+/// A full compile against an incremental rebuild: the same world with a warm cache,
+/// and with one file edited since the cache was filled.
+fn bench_compile_cache(c: &mut Criterion) {
+    let mut sources = Vec::new();
+    collect_sources(&Path::new(env!("CARGO_MANIFEST_DIR")).join("data/Amble"), &mut sources);
+    let cpus = thread::available_parallelism().map_or(1, NonZeroUsize::get);
+    let dir = tempfile::tempdir().expect("cache dir");
+    let inputs: Vec<(&str, &str)> = sources.iter().map(|(p, t)| (p.as_str(), t.as_str())).collect();
+    compile_sources_cached(&inputs, cpus, &CompileCache::new(dir.path())).expect("fills the cache");
+
+    let mut group = c.benchmark_group("compile_cache");
+    group.sample_size(10);
+    group.bench_function("uncached", |b| {
+        b.iter(|| compile_sources(black_box(&inputs), cpus).expect("compiles"));
+    });
+    group.bench_function("warm", |b| {
+        b.iter(|| compile_sources_cached(black_box(&inputs), cpus, &CompileCache::new(dir.path())).expect("compiles"));
+    });
+    // each iteration edits the largest file differently, so it is always a miss
+    let edited = (0..sources.len())
+        .max_by_key(|&idx| sources[idx].1.len())
+        .expect("world has sources");
+    let mut edit = 0_u64;
+    group.bench_function("one_file_edit", |b| {
+        b.iter_batched(
+            || {
+                edit += 1;
+                format!("{}\n# edit {edit}\n", sources[edited].1)
+            },
+            |text| {
+                let mut inputs = inputs.clone();
+                inputs[edited].1 = &text;
+                compile_sources_cached(&inputs, cpus, &CompileCache::new(dir.path())).expect("compiles")
+            },
+            BatchSize::SmallInput,
+        );
+    });
+    group.finish();
+}
+
+criterion_group!(benches, bench_compile_dir, bench_compile_cache);
+criterion_main!(benches);
@@ -0,0 +1,39 @@
+//! Fingerprint the compiler sources for the compile cache.
+//!
+//! `AMBLE_SCRIPT_BUILD_HASH` is the FNV-1a hash of every file under `src/` (paths and
+//! contents, in path order). The compile cache keys its directory by it, so a build
+//! whose grammar, parser or lowering changed never reads entries an older build wrote,
+//! even when the package version is the same.
+
+use std::fs;
+use std::path::{Path, PathBuf};
+
+fn main() {
+    println!("cargo:rerun-if-changed=src");
+    let mut files = Vec::new();
+    collect_files(Path::new("src"), &mut files);
+    files.sort();
+    let mut hash: u64 = 0xcbf2_9ce4_8422_2325;
+    for path in &files {
+        let contents = fs::read(path).unwrap_or_default();
+        for byte in path.to_string_lossy().bytes().chain([0]).chain(contents) {
+            hash ^= u64::from(byte);
+            hash = hash.wrapping_mul(0x0100_0000_01b3);
+        }
+    }
+    println!("cargo:rustc-env=AMBLE_SCRIPT_BUILD_HASH={hash:016x}");
+}
+
+fn collect_files(dir: &Path, files: &mut Vec<PathBuf>) {
+    let Ok(entries) = fs::read_dir(dir) else {
+        return;
+    };
+    for entry in entries.flatten() {
+        let path = entry.path();
+        if path.is_dir() {
+            collect_files(&path, files);
+        } else {
+            files.push(path);
+        }
+    }
+}
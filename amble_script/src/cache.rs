@@ -0,0 +1,215 @@
+//! Persistent on-disk cache of per-file compile results.
+//!
+//! Two kinds of entry are kept, both keyed by the FNV-1a hash and length of a
+//! file's text:
+//! - the file's `let cond` / `let actions` declarations, so the shared alias and
+//!   action-set environment can be rebuilt without parsing unchanged files;
+//! - the file's lowered ASTs, additionally keyed by the hash of that environment,
+//!   because lowering expands aliases and action sets inline.
+//!
+//! Editing one file therefore re-parses only that file. Editing an alias or action
+//! set changes the environment hash and re-lowers every file. Entries are CBOR files
+//! under a directory keyed by the compiler version and a hash of the compiler's own
+//! sources (computed by the build script), so a rebuilt compiler never reads an older
+//! build's results, even before the version is bumped. Cache problems are never fatal: an unreadable
+//! or corrupt entry is a miss and a failed write is ignored.
+
+use std::fs;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+use serde::Serialize;
+use serde::de::DeserializeOwned;
+
+use crate::parser::ProgramAstBundle;
+use crate::{ActionSetSpec, ConditionAliasSpec};
+
+/// Bump when the cache layout or the meaning of an entry changes.
+const CACHE_VERSION: u32 = 3;
+
+/// Environment variable overriding the default cache directory.
+pub const CACHE_DIR_ENV: &str = "AMBLE_SCRIPT_CACHE_DIR";
+
+/// Declarations of one file: its condition aliases and action sets.
+pub type DeclSpecs = (Vec<ConditionAliasSpec>, Vec<ActionSetSpec>);
+
+/// Identity of a source text: `(FNV-1a hash, byte length)`.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct SourceKey(u64, usize);
+
+impl SourceKey {
+    /// Key of `text`.
+    pub fn of(text: &str) -> Self {
+        Self(amble_data::artifact::content_hash(text.as_bytes()), text.len())
+    }
+}
+
+/// Hit and miss counts for one compile.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct CacheStats {
+    /// Files whose declarations came from the cache.
+    pub decl_hits: usize,
+    /// Files whose lowered ASTs came from the cache.
+    pub lowered_hits: usize,
+    /// Files that had to be parsed.
+    pub parsed: usize,
+}
+
+/// A compile cache rooted at a directory.
+#[derive(Debug)]
+pub struct CompileCache {
+    dir: PathBuf,
+    decl_hits: AtomicUsize,
+    lowered_hits: AtomicUsize,
+    parsed: AtomicUsize,
+}
+
+impl CompileCache {
+    /// A cache storing its entries under `root`.
+    pub fn new(root: impl AsRef<Path>) -> Self {
+        let dir = root.as_ref().join(format!(
+            "v{CACHE_VERSION}-{}-{}",
+            env!("CARGO_PKG_VERSION"),
+            env!("AMBLE_SCRIPT_BUILD_HASH")
+        ));
+        Self {
+            dir,
+            decl_hits: AtomicUsize::new(0),
+            lowered_hits: AtomicUsize::new(0),
+            parsed: AtomicUsize::new(0),
+        }
+    }
+
+    /// `$AMBLE_SCRIPT_CACHE_DIR`, or `amble_script-cache` under `$CARGO_TARGET_DIR`
+    /// (default `target`).
+    pub fn default_root() -> PathBuf {
+        if let Some(dir) = std::env::var_os(CACHE_DIR_ENV) {
+            return PathBuf::from(dir);
+        }
+        let target = std::env::var_os("CARGO_TARGET_DIR").map_or_else(|| PathBuf::from("target"), PathBuf::from);
+        target.join("amble_script-cache")
+    }
+
+    /// Counts recorded since the cache was opened.
+    pub fn stats(&self) -> CacheStats {
+        CacheStats {
+            decl_hits: self.decl_hits.load(Ordering::Relaxed),
+            lowered_hits: self.lowered_hits.load(Ordering::Relaxed),
+            parsed: self.parsed.load(Ordering::Relaxed),
+        }
+    }
+
+    pub(crate) fn load_decls(&self, key: SourceKey) -> Option<DeclSpecs> {
+        let decls = self.load(&self.decl_path(key));
+        if decls.is_some() {
+            self.decl_hits.fetch_add(1, Ordering::Relaxed);
+        }
+        decls
+    }
+
+    pub(crate) fn store_decls(&self, key: SourceKey, decls: &DeclSpecs) {
+        self.store(&self.decl_path(key), decls);
+    }
+
+    pub(crate) fn load_lowered(&self, key: SourceKey, env: u64) -> Option<ProgramAstBundle> {
+        let bundle = self.load(&self.lowered_path(key, env));
+        if bundle.is_some() {
+            self.lowered_hits.fetch_add(1, Ordering::Relaxed);
+        }
+        bundle
+    }
+
+    pub(crate) fn store_lowered(&self, key: SourceKey, env: u64, bundle: &ProgramAstBundle) {
+        self.store(&self.lowered_path(key, env), bundle);
+    }
+
+    pub(crate) fn record_parse(&self) {
+        self.parsed.fetch_add(1, Ordering::Relaxed);
+    }
+
+    fn decl_path(&self, SourceKey(hash, len): SourceKey) -> PathBuf {
+        self.dir.join("decls").join(format!("{hash:016x}-{len}.cbor"))
+    }
+
+    fn lowered_path(&self, SourceKey(hash, len): SourceKey, env: u64) -> PathBuf {
+        self.dir
+            .join("lowered")
+            .join(format!("{hash:016x}-{len}-{env:016x}.cbor"))
+    }
+
+    fn load<T: DeserializeOwned>(&self, path: &Path) -> Option<T> {
+        let bytes = fs::read(path).ok()?;
+        ciborium::from_reader(bytes.as_slice()).ok()
+    }
+
+    fn store<T: Serialize>(&self, path: &Path, value: &T) {
+        let mut bytes = Vec::new();
+        if ciborium::into_writer(value, &mut bytes).is_err() {
+            return;
+        }
+        let Some(parent) = path.parent() else {
+            return;
+        };
+        // write then rename, so a concurrent compile never reads a partial entry
+        let tmp = path.with_extension(format!("{}.tmp", std::process::id()));
+        let _ = fs::create_dir_all(parent)
+            .and_then(|()| fs::write(&tmp, &bytes))
+            .and_then(|()| fs::rename(&tmp, path));
+    }
+}
+
+/// Hash of the alias and action-set declarations of every file, in file order.
+///
+/// Room-set maps are hashed in sorted order so the result does not depend on
+/// `HashMap` iteration order. Each declaration's file position and offset are
+/// included, because statements inlined from an action set carry them.
+pub(crate) fn environment_hash<'a>(
+    files: impl IntoIterator<Item = (&'a [ConditionAliasSpec], &'a [ActionSetSpec])>,
+) -> u64 {
+    let mut hash = Fnv::default();
+    for (file, (aliases, action_sets)) in files.into_iter().enumerate() {
+        let specs = aliases.iter().map(|s| ("cond", &s.name, &s.text, &s.sets, 0)).chain(
+            action_sets
+                .iter()
+                .map(|s| ("actions", &s.name, &s.text, &s.sets, s.offset)),
+        );
+        for (kind, name, text, sets, offset) in specs {
+            hash.write(&file.to_le_bytes());
+            hash.write(&offset.to_le_bytes());
+            hash.write_str(kind);
+            hash.write_str(name);
+            hash.write_str(text);
+            let mut sets: Vec<_> = sets.iter().collect();
+            sets.sort();
+            for (set, rooms) in sets {
+                hash.write_str(set);
+                for room in rooms {
+                    hash.write_str(room);
+                }
+            }
+        }
+    }
+    hash.0
+}
+
+/// Incremental FNV-1a, matching `amble_data::artifact::content_hash`.
+struct Fnv(u64);
+
+impl Default for Fnv {
+    fn default() -> Self {
+        Self(0xcbf2_9ce4_8422_2325)
+    }
+}
+
+impl Fnv {
+    fn write(&mut self, bytes: &[u8]) {
+        for byte in bytes {
+            self.0 = (self.0 ^ u64::from(*byte)).wrapping_mul(0x0000_0100_0000_01b3);
+        }
+    }
+
+    fn write_str(&mut self, s: &str) {
+        self.write(&s.len().to_le_bytes());
+        self.write(s.as_bytes());
+    }
+}
@@ -0,0 +1,443 @@
+//! Multi-file compilation: parse, resolve shared definitions, and lower a set of
+//! DSL sources.
+//!
+//! [`compile_sources`] spreads the per-file work over worker threads. Workers claim
+//! files from a shared counter, so a few large files do not leave the other workers
+//! idle. Pest parse trees borrow their source and are not `Send`, so each worker
+//! keeps the trees it parsed and lowers those same files once the condition aliases
+//! and action sets from every file have been resolved. Results are returned in the
+//! input order, so the compiled world is identical for any number of jobs.
+//!
+//! [`compile_sources_cached`] additionally consults a [`CompileCache`]: files whose
+//! declarations are cached skip the parse before resolution, and files whose
+//! lowered ASTs are cached for the resolved environment are never parsed at all.
+
+use std::collections::HashMap;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::mpsc::{self, Receiver, Sender};
+use std::thread;
+
+use crate::cache::{CompileCache, DeclSpecs, SourceKey, environment_hash};
+use crate::parser::{AstError, ParsedProgram, ProgramAstBundle};
+use crate::{
+    ActionSetSpec, ActionStmt, ConditionAliasSpec, ConditionAst, resolve_action_sets, resolve_condition_aliases,
+};
+
+/// Condition aliases and action sets resolved across every file of a build.
+pub type GlobalDefinitions = (HashMap<String, ConditionAst>, HashMap<String, Vec<ActionStmt>>);
+
+/// Errors from compiling a set of source files.
+#[derive(Debug, thiserror::Error)]
+pub enum CompileError {
+    #[error("parse error in '{path}': {source}")]
+    Parse { path: String, source: AstError },
+    #[error("duplicate condition alias '{name}' in '{first}' and '{second}'")]
+    DuplicateAlias { name: String, first: String, second: String },
+    #[error("duplicate action set '{name}' in '{first}' and '{second}'")]
+    DuplicateActionSet { name: String, first: String, second: String },
+    #[error("condition alias error: {0}")]
+    Alias(AstError),
+    #[error("action set error: {0}")]
+    ActionSet(AstError),
+}
+
+/// Alias and action-set declarations of one file: `(path, aliases, action sets)`.
+pub type FileSpecs<'a> = (&'a str, &'a [ConditionAliasSpec], &'a [ActionSetSpec]);
+
+/// Resolve the condition aliases and action sets declared across `files`, rejecting
+/// names declared more than once.
+///
+/// Files are checked in the order given, so duplicates are reported against the
+/// earliest declaration. Each action set is stamped with its file's position in
+/// `files`, which the [`SourceSpan`](crate::SourceSpan)s of its statements then
+/// carry wherever they are inlined.
+///
+/// # Errors
+/// Returns an error for a duplicate name or a definition that fails to resolve.
+pub fn resolve_global_specs(files: &[FileSpecs<'_>]) -> Result<GlobalDefinitions, CompileError> {
+    let mut alias_specs: Vec<ConditionAliasSpec> = Vec::new();
+    let mut action_set_specs: Vec<ActionSetSpec> = Vec::new();
+    let mut seen_aliases: HashMap<&str, &str> = HashMap::new();
+    let mut seen_action_sets: HashMap<&str, &str> = HashMap::new();
+
+    for (file, aliases, _) in files {
+        for spec in *aliases {
+            if let Some(prev) = seen_aliases.insert(spec.name.as_str(), *file) {
+                return Err(CompileError::DuplicateAlias {
+                    name: spec.name.clone(),
+                    first: prev.to_string(),
+                    second: (*file).to_string(),
+                });
+            }
+        }
+        alias_specs.extend_from_slice(aliases);
+    }
+    let aliases = resolve_condition_aliases(&alias_specs).map_err(CompileError::Alias)?;
+
+    for (idx, (file, _, action_sets)) in files.iter().enumerate() {
+        for spec in *action_sets {
+            if let Some(prev) = seen_action_sets.insert(spec.name.as_str(), *file) {
+                return Err(CompileError::DuplicateActionSet {
+                    name: spec.name.clone(),
+                    first: prev.to_string(),
+                    second: (*file).to_string(),
+                });
+            }
+        }
+        let idx = u32::try_from(idx).ok();
+        action_set_specs.extend(action_sets.iter().map(|spec| ActionSetSpec {
+            file: idx,
+            ..spec.clone()
+        }));
+    }
+    let action_sets = resolve_action_sets(&action_set_specs, &aliases).map_err(CompileError::ActionSet)?;
+    Ok((aliases, action_sets))
+}
+
+type DeclMessage = (usize, Result<DeclSpecs, CompileError>);
+type LowerResult = (usize, Result<ProgramAstBundle, CompileError>);
+
+/// Parse and lower `sources` (`(path, text)` pairs) on up to `jobs` threads.
+///
+/// Returns one AST bundle per source, in input order.
+///
+/// # Errors
+/// Returns every parse and lowering error, in input order. Lowering only starts
+/// once every file has parsed and the shared definitions have resolved.
+pub fn compile_sources(sources: &[(&str, &str)], jobs: usize) -> Result<Vec<ProgramAstBundle>, Vec<CompileError>> {
+    compile(sources, jobs, None)
+}
+
+/// Like [`compile_sources`], but reuses the declarations and lowered ASTs of
+/// unchanged files from `cache` and stores those of files it had to compile.
+///
+/// # Errors
+/// As for [`compile_sources`].
+pub fn compile_sources_cached(
+    sources: &[(&str, &str)],
+    jobs: usize,
+    cache: &CompileCache,
+) -> Result<Vec<ProgramAstBundle>, Vec<CompileError>> {
+    compile(sources, jobs, Some(cache))
+}
+
+/// Resolved definitions handed to the workers for lowering.
+struct Plan {
+    globals: GlobalDefinitions,
+    /// [`environment_hash`] of the declarations (0 without a cache).
+    env: u64,
+}
+
+fn compile(
+    sources: &[(&str, &str)],
+    jobs: usize,
+    cache: Option<&CompileCache>,
+) -> Result<Vec<ProgramAstBundle>, Vec<CompileError>> {
+    let keys: Vec<SourceKey> = sources.iter().map(|(_, text)| SourceKey::of(text)).collect();
+    let mut decls: Vec<Option<DeclSpecs>> = match cache {
+        Some(cache) => keys.iter().map(|key| cache.load_decls(*key)).collect(),
+        None => vec![None; sources.len()],
+    };
+    // Files without cached declarations are parsed before resolution; the rest
+    // are only parsed afterwards, and only if their lowered ASTs are not cached.
+    let (early, late): (Vec<usize>, Vec<usize>) = (0..sources.len()).partition(|&idx| decls[idx].is_none());
+    let worker = Worker {
+        sources,
+        keys: &keys,
+        early: &early,
+        late: &late,
+        next_early: AtomicUsize::new(0),
+        next_late: AtomicUsize::new(0),
+        cache,
+    };
+    let jobs = jobs.clamp(1, sources.len().max(1));
+    let (decl_tx, decl_rx) = mpsc::channel::<DeclMessage>();
+
+    thread::scope(|scope| {
+        let mut workers = Vec::with_capacity(jobs);
+        let mut plan_txs = Vec::with_capacity(jobs);
+        for _ in 0..jobs {
+            let (plan_tx, plan_rx) = mpsc::channel();
+            plan_txs.push(plan_tx);
+            let decl_tx = decl_tx.clone();
+            let worker = &worker;
+            workers.push(scope.spawn(move || worker.run(decl_tx, &plan_rx)));
+        }
+        drop(decl_tx);
+
+        // The channel closes once every worker has finished parsing.
+        let mut errors = Vec::new();
+        for (idx, message) in decl_rx {
+            match message {
+                Ok(file_decls) => decls[idx] = Some(file_decls),
+                Err(e) => errors.push((idx, e)),
+            }
+        }
+
+        let plan = if errors.is_empty() {
+            let files: Vec<FileSpecs<'_>> = sources
+                .iter()
+                .zip(&decls)
+                .filter_map(|((path, _), file_decls)| {
+                    file_decls
+                        .as_ref()
+                        .map(|(aliases, action_sets)| (*path, aliases.as_slice(), action_sets.as_slice()))
+                })
+                .collect();
+            match resolve_global_specs(&files) {
+                Ok(globals) => {
+                    let env = cache.map_or(0, |_| {
+                        environment_hash(files.iter().map(|(_, aliases, action_sets)| (*aliases, *action_sets)))
+                    });
+                    Some(Plan { globals, env })
+                },
+                Err(e) => {
+                    errors.push((0, e));
+                    None
+                },
+            }
+        } else {
+            None
+        };
+        // Dropping the senders without sending tells the workers to stop.
+        if let Some(plan) = plan {
+            let plan = Arc::new(plan);
+            for tx in &plan_txs {
+                let _ = tx.send(Arc::clone(&plan));
+            }
+        }
+        drop(plan_txs);
+
+        let mut lowered = Vec::with_capacity(sources.len());
+        for worker in workers {
+            match worker.join() {
+                Ok(results) => lowered.extend(results),
+                Err(panic) => std::panic::resume_unwind(panic),
+            }
+        }
+        lowered.sort_by_key(|(idx, _)| *idx);
+        let mut bundles = Vec::with_capacity(lowered.len());
+        for (idx, result) in lowered {
+            match result {
+                Ok(bundle) => bundles.push(bundle),
+                Err(e) => errors.push((idx, e)),
+            }
+        }
+        if errors.is_empty() {
+            Ok(bundles)
+        } else {
+            errors.sort_by_key(|(idx, _)| *idx);
+            Err(errors.into_iter().map(|(_, e)| e).collect())
+        }
+    })
+}
+
+/// Work shared by the compile threads; each claims files from the `early` and
+/// `late` lists through the matching counter.
+struct Worker<'a> {
+    sources: &'a [(&'a str, &'a str)],
+    keys: &'a [SourceKey],
+    early: &'a [usize],
+    late: &'a [usize],
+    next_early: AtomicUsize,
+    next_late: AtomicUsize,
+    cache: Option<&'a CompileCache>,
+}
+
+impl<'a> Worker<'a> {
+    /// Parse claimed early files and report their declarations, then, once the
+    /// plan arrives, lower them and handle claimed late files (returning nothing
+    /// if the plan never arrives).
+    fn run(&self, decls: Sender<DeclMessage>, plan: &Receiver<Arc<Plan>>) -> Vec<LowerResult> {
+        let mut programs = Vec::new();
+        while let Some(&idx) = self.early.get(self.next_early.fetch_add(1, Ordering::Relaxed)) {
+            match self.parse(idx) {
+                Ok(program) => {
+                    let file_decls = (
+                        program.condition_alias_specs().to_vec(),
+                        program.action_set_specs().to_vec(),
+                    );
+                    if let Some(cache) = self.cache {
+                        cache.store_decls(self.keys[idx], &file_decls);
+                    }
+                    let _ = decls.send((idx, Ok(file_decls)));
+                    programs.push((idx, program));
+                },
+                Err(e) => {
+                    let _ = decls.send((idx, Err(e)));
+                },
+            }
+        }
+        drop(decls);
+
+        let Ok(plan) = plan.recv() else {
+            return Vec::new();
+        };
+        let mut results: Vec<LowerResult> = programs
+            .iter()
+            .map(|(idx, program)| (*idx, self.lower(*idx, program, &plan)))
+            .collect();
+        while let Some(&idx) = self.late.get(self.next_late.fetch_add(1, Ordering::Relaxed)) {
+            let cached = self
+                .cache
+                .and_then(|cache| cache.load_lowered(self.keys[idx], plan.env));
+            let result = match cached {
+                Some(bundle) => Ok(bundle),
+                None => self.parse(idx).and_then(|program| self.lower(idx, &program, &plan)),
+            };
+            results.push((idx, result));
+        }
+        results
+    }
+
+    fn parse(&self, idx: usize) -> Result<ParsedProgram<'a>, CompileError> {
+        let (path, text) = self.sources[idx];
+        if let Some(cache) = self.cache {
+            cache.record_parse();
+        }
+        ParsedProgram::parse(text).map_err(|source| CompileError::Parse {
+            path: path.to_string(),
+            source,
+        })
+    }
+
+    fn lower(&self, idx: usize, program: &ParsedProgram<'_>, plan: &Plan) -> Result<ProgramAstBundle, CompileError> {
+        let (aliases, action_sets) = &plan.globals;
+        let bundle = program
+            .lower_resolved(aliases, action_sets)
+            .map_err(|source| CompileError::Parse {
+                path: self.sources[idx].0.to_string(),
+                source,
+            })?;
+        if let Some(cache) = self.cache {
+            cache.store_lowered(self.keys[idx], plan.env, &bundle);
+        }
+        Ok(bundle)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::CacheStats;
+
+    const SHARED: &str = r#"
+let cond lamp_lit = has flag lamp-lit
+let actions greet = {
+  do show "Hello."
+}
+"#;
+
+    fn room(id: &str) -> String {
+        format!(
+            "room {id} {{\n  name \"{id}\"\n  desc \"A room.\"\n}}\ntrigger \"enter {id}\" when enter room {id} {{\n  if lamp_lit {{\n    do show \"Lit.\"\n  }}\n  run greet\n}}\n"
+        )
+    }
+
+    #[test]
+    fn results_follow_input_order_for_any_job_count() {
+        let rooms: Vec<String> = (0..12).map(|n| room(&format!("room-{n}"))).collect();
+        let mut sources = vec![("shared.amble", SHARED)];
+        let paths: Vec<String> = (0..rooms.len()).map(|n| format!("room-{n}.amble")).collect();
+        sources.extend(paths.iter().map(String::as_str).zip(rooms.iter().map(String::as_str)));
+
+        let serial = compile_sources(&sources, 1).expect("compiles on one job");
+        assert_eq!(serial.len(), sources.len());
+        assert_eq!(serial[3].2[0].id, "room-2");
+        for jobs in [2, 4, 16] {
+            assert_eq!(compile_sources(&sources, jobs).expect("compiles in parallel"), serial);
+        }
+    }
+
+    #[test]
+    fn inlined_action_sets_keep_their_declaring_file() {
+        let hall = room("hall");
+        let sources = [("shared.amble", SHARED), ("hall.amble", hall.as_str())];
+        let bundles = compile_sources(&sources, 2).expect("compiles");
+        let triggers = &bundles[1].1;
+
+        let guarded = triggers.iter().find(|t| !t.conditions.is_empty()).expect("if trigger");
+        assert!(guarded.conditions_span.slice(&hall).starts_with("if lamp_lit {"));
+        assert_eq!(guarded.actions[0].span.file, None);
+        assert_eq!(guarded.actions[0].span.span.slice(&hall), "do show \"Lit.\"");
+
+        let greeting = triggers.iter().find(|t| t.conditions.is_empty()).expect("run trigger");
+        assert_eq!(greeting.actions[0].span.file, Some(0));
+        assert_eq!(greeting.actions[0].span.span.slice(SHARED), "do show \"Hello.\"");
+    }
+
+    #[test]
+    fn errors_are_reported_in_input_order() {
+        let sources = [
+            ("a.amble", SHARED),
+            ("b.amble", "room {"),
+            ("c.amble", SHARED),
+            ("d.amble", "trigger"),
+        ];
+        let errors = compile_sources(&sources, 4).unwrap_err();
+        let paths: Vec<&str> = errors
+            .iter()
+            .map(|e| match e {
+                CompileError::Parse { path, .. } => path.as_str(),
+                _ => "",
+            })
+            .collect();
+        assert_eq!(paths, ["b.amble", "d.amble"]);
+
+        let errors = compile_sources(&[sources[0], sources[2]], 2).unwrap_err();
+        let [CompileError::DuplicateAlias { first, second, .. }] = &errors[..] else {
+            panic!("expected one duplicate alias error, got {errors:?}");
+        };
+        assert_eq!((first.as_str(), second.as_str()), ("a.amble", "c.amble"));
+    }
+
+    /// Compile `sources` through a fresh handle on the cache at `root`, returning the
+    /// bundles and that handle's hit counts.
+    fn compile_cached(root: &std::path::Path, sources: &[(&str, &str)]) -> (Vec<ProgramAstBundle>, CacheStats) {
+        let cache = CompileCache::new(root);
+        let bundles = compile_sources_cached(sources, 2, &cache).expect("compiles");
+        assert_eq!(bundles, compile_sources(sources, 1).expect("compiles uncached"));
+        (bundles, cache.stats())
+    }
+
+    #[test]
+    fn cache_reuses_unchanged_files_and_reparses_edits() {
+        let dir = tempfile::tempdir().unwrap();
+        let (hall, study) = (room("hall"), room("study"));
+        let sources = [
+            ("shared.amble", SHARED),
+            ("hall.amble", hall.as_str()),
+            ("study.amble", study.as_str()),
+        ];
+        assert_eq!(compile_cached(dir.path(), &sources).1.parsed, 3);
+
+        let (_, stats) = compile_cached(dir.path(), &sources);
+        assert_eq!((stats.decl_hits, stats.lowered_hits, stats.parsed), (3, 3, 0));
+
+        let edited = study.replace("A room.", "A quiet room.");
+        let sources = [sources[0], sources[1], ("study.amble", edited.as_str())];
+        let (bundles, stats) = compile_cached(dir.path(), &sources);
+        assert_eq!((stats.lowered_hits, stats.parsed), (2, 1));
+        assert_eq!(bundles[2].2[0].desc, "A quiet room.");
+    }
+
+    #[test]
+    fn alias_change_invalidates_files_that_use_it() {
+        let dir = tempfile::tempdir().unwrap();
+        let hall = room("hall");
+        let sources = [("shared.amble", SHARED), ("hall.amble", hall.as_str())];
+        let (before, _) = compile_cached(dir.path(), &sources);
+
+        let shared = SHARED.replace("has flag lamp-lit", "has flag lamp-on");
+        let sources = [("shared.amble", shared.as_str()), sources[1]];
+        let (after, stats) = compile_cached(dir.path(), &sources);
+        // hall.amble is unchanged, so its declarations are reused, but it is
+        // re-lowered because the alias it expands changed
+        assert_eq!((stats.decl_hits, stats.lowered_hits, stats.parsed), (1, 0, 2));
+        assert_ne!(before[1].1, after[1].1);
+
+        let (_, stats) = compile_cached(dir.path(), &sources);
+        assert_eq!((stats.lowered_hits, stats.parsed), (2, 0));
+    }
+}
@@ -39,14 +39,25 @@
 //! For a full language tour see `amble_script/docs/dsl_creator_handbook.md` in
 //! the repository.
 
+mod cache;
+mod compile;
 mod parser;
+mod span;
+mod symbols;
 mod worlddef;
+pub use cache::{CACHE_DIR_ENV, CacheStats, CompileCache};
+pub use compile::{
+    CompileError, FileSpecs, GlobalDefinitions, compile_sources, compile_sources_cached, resolve_global_specs,
+};
 pub use parser::{
-    AstError, collect_action_set_specs, collect_condition_alias_specs, parse_program, parse_program_full,
-    parse_program_full_with_aliases, parse_program_full_with_context, parse_trigger,
+    AstError, ParsedProgram, ProgramAstBundle, collect_action_set_specs, collect_condition_alias_specs, parse_program,
+    parse_program_full, parse_program_full_with_aliases, parse_program_full_with_context, parse_trigger,
 };
 pub use parser::{parse_goals, parse_items, parse_npcs, parse_rooms, parse_spinners};
+use serde::{Deserialize, Serialize};
+pub use span::{LineIndex, SourceSpan, Span};
 use std::collections::HashMap;
+pub use symbols::SymbolTable;
 pub use worlddef::{WorldDefError, worlddef_from_asts};
 
 pub fn resolve_condition_aliases(specs: &[ConditionAliasSpec]) -> Result<HashMap<String, ConditionAst>, AstError> {
@@ -62,24 +73,33 @@ pub fn resolve_action_sets(
 
 /// Captured top-level `let cond` declaration plus the room-set environment used
 /// to resolve it.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ConditionAliasSpec {
     pub name: String,
+    /// Source text of the condition. It is parsed when the alias environment is
+    /// resolved, because it may name aliases declared in other files, and it is
+    /// kept as text so specs can be cached without the file they came from.
     pub text: String,
     pub sets: HashMap<String, Vec<String>>,
 }
 
 /// Captured top-level `let actions` declaration plus the room-set environment used
 /// to resolve conditions inside it.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ActionSetSpec {
     pub name: String,
+    /// Source text of the action block, parsed on resolution like
+    /// [`ConditionAliasSpec::text`].
     pub text: String,
     pub sets: HashMap<String, Vec<String>>,
+    /// Index of the declaring file in a multi-file build (`None` within that file).
+    pub file: Option<u32>,
+    /// Byte offset of `text` in the declaring file.
+    pub offset: usize,
 }
 
 /// Game-level configuration AST.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct GameAst {
     pub title: String,
     pub slug: Option<String>,
@@ -92,7 +112,7 @@ pub struct GameAst {
 }
 
 /// Player definition (from `player` statement within the game block.)
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct PlayerAst {
     pub name: String,
     pub description: String,
@@ -101,7 +121,7 @@ pub struct PlayerAst {
 }
 
 /// Scorecard title and rank definitions from the `scoring` game block.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ScoringAst {
     pub report_title: Option<String>,
     pub ranks: Vec<ScoringRankAst>,
@@ -111,7 +131,7 @@ pub struct ScoringAst {
 ///
 /// `threshold` defines when the player ascends to this rank, specified as a
 /// percentage of total available points in the game.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ScoringRankAst {
     pub threshold: f32,
     pub name: String,
@@ -119,7 +139,7 @@ pub struct ScoringRankAst {
 }
 
 /// AST for a `Trigger`
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct TriggerAst {
     /// Human-readable trigger name.
     pub name: String,
@@ -127,8 +147,15 @@ pub struct TriggerAst {
     pub note: Option<String>,
     /// 1-based line number in the source file where this trigger starts.
     pub src_line: usize,
+    /// Byte span of the whole `trigger` block (shared by the triggers an `if` splits it into).
+    pub span: Span,
+    /// Byte span of the `when` clause.
+    pub event_span: Span,
     /// The event condition that triggers this (e.g., enter room, take, talk to npc).
     pub event: ConditionAst,
+    /// Byte span of the top-level `if` block that supplied `conditions` (the
+    /// trigger's span when there are none).
+    pub conditions_span: Span,
     /// List of conditions (currently only missing-flag).
     pub conditions: Vec<ConditionAst>,
     /// List of actions supported in this minimal version.
@@ -141,7 +168,7 @@ pub struct TriggerAst {
 ///
 /// These are the events that can be detected in the "when" clause and the conditions
 /// that can be tested in the `if` clause of a `trigger` statement.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum ConditionAst {
     /// Event: trigger has no event; conditions only.
     Always,
@@ -251,7 +278,7 @@ pub enum ConditionAst {
 }
 
 /// Ingestion modes supported by the DSL; mirrors engine `IngestMode`.
-#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
 pub enum IngestModeAst {
     Eat,
     Drink,
@@ -259,7 +286,7 @@ pub enum IngestModeAst {
 }
 
 /// Minimal action variants.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum ActionAst {
     /// Show a message to the player.
     Show(String),
@@ -474,17 +501,23 @@ pub enum ActionAst {
 }
 
 /// Top-level action statement with optional priority metadata.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ActionStmt {
     /// Optional priority assigned via `do priority <n>`.
     pub priority: Option<isize>,
     /// The underlying action emitted by the DSL.
     pub action: ActionAst,
+    /// Where the statement was written; inlined action sets keep their own file.
+    pub span: SourceSpan,
 }
 impl ActionStmt {
     /// Construct an action statement without priority metadata.
     pub fn new(action: ActionAst) -> Self {
-        Self { priority: None, action }
+        Self {
+            priority: None,
+            action,
+            span: SourceSpan::default(),
+        }
     }
 
     /// Construct an action statement with an explicit priority.
@@ -492,12 +525,19 @@ impl ActionStmt {
         Self {
             priority: Some(priority),
             action,
+            span: SourceSpan::default(),
         }
     }
+
+    /// The statement placed at `span`.
+    #[must_use]
+    pub fn at(self, span: SourceSpan) -> Self {
+        Self { span, ..self }
+    }
 }
 
 /// Data patch applied to an item when executing a `modify item` action.
-#[derive(Debug, Clone, PartialEq, Default)]
+#[derive(Debug, Clone, PartialEq, Default, Serialize, Deserialize)]
 pub struct ItemPatchAst {
     pub name: Option<String>,
     pub desc: Option<String>,
@@ -513,7 +553,7 @@ pub struct ItemPatchAst {
 }
 
 /// Data patch applied to a room when executing a `modify room` action.
-#[derive(Debug, Clone, PartialEq, Default)]
+#[derive(Debug, Clone, PartialEq, Default, Serialize, Deserialize)]
 pub struct RoomPatchAst {
     pub name: Option<String>,
     pub desc: Option<String>,
@@ -522,7 +562,7 @@ pub struct RoomPatchAst {
 }
 
 /// Exit data emitted inside a `modify room` action patch.
-#[derive(Debug, Clone, PartialEq, Default)]
+#[derive(Debug, Clone, PartialEq, Default, Serialize, Deserialize)]
 pub struct RoomExitPatchAst {
     pub direction: String,
     pub to: String,
@@ -534,14 +574,14 @@ pub struct RoomExitPatchAst {
 }
 
 /// NPC dialogue line update used inside a `modify npc` action.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct NpcDialoguePatchAst {
     pub state: NpcStateValue,
     pub line: String,
 }
 
 /// Movement timing update for an NPC.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum NpcTimingPatchAst {
     /// NPC moves every _n_ turns.
     EveryNTurns(usize),
@@ -550,7 +590,7 @@ pub enum NpcTimingPatchAst {
 }
 
 /// Movement configuration updates for an NPC.
-#[derive(Debug, Clone, PartialEq, Default)]
+#[derive(Debug, Clone, PartialEq, Default, Serialize, Deserialize)]
 pub struct NpcMovementPatchAst {
     pub route: Option<Vec<String>>,
     pub random_rooms: Option<Vec<String>>,
@@ -560,7 +600,7 @@ pub struct NpcMovementPatchAst {
 }
 
 /// Data patch applied to an NPC when executing a `modify npc` action.
-#[derive(Debug, Clone, PartialEq, Default)]
+#[derive(Debug, Clone, PartialEq, Default, Serialize, Deserialize)]
 pub struct NpcPatchAst {
     pub name: Option<String>,
     pub desc: Option<String>,
@@ -570,7 +610,7 @@ pub struct NpcPatchAst {
 }
 
 /// Policy to apply when a scheduled condition evaluates to false at fire time.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum OnFalseAst {
     /// Drop the scheduled event entirely.
     Cancel,
@@ -586,7 +626,7 @@ pub enum OnFalseAst {
 
 /// Minimal AST for a room definition.
 /// AST node describing a compiled room definition.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct RoomAst {
     pub id: String,
     pub name: String,
@@ -597,19 +637,23 @@ pub struct RoomAst {
     pub scenery: Vec<RoomSceneryAst>,
     pub scenery_default: Option<String>,
     pub src_line: usize,
+    /// Byte span of the definition in its source file.
+    pub span: Span,
 }
 
 /// Room-local scenery entry (look/examine only).
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct RoomSceneryAst {
     pub name: String,
     pub desc: Option<String>,
 }
 
 /// Connection between rooms emitted within a room AST.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ExitAst {
     pub to: String,
+    /// Byte span of the `exit` statement.
+    pub span: Span,
     pub hidden: bool,
     pub locked: bool,
     pub barred_message: Option<String>,
@@ -618,14 +662,14 @@ pub struct ExitAst {
 }
 
 /// Conditional overlay text applied to a room.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct OverlayAst {
     pub conditions: Vec<OverlayCondAst>,
     pub text: String,
 }
 
 /// Overlay predicate used when computing room description variants.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum OverlayCondAst {
     FlagSet(String),
     FlagUnset(String),
@@ -641,14 +685,14 @@ pub enum OverlayCondAst {
 }
 
 /// NPC state reference used in overlays and patches.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum NpcStateValue {
     Named(String),
     Custom(String),
 }
 
 /// AST node describing an item definition.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ItemAst {
     pub id: String,
     pub name: String,
@@ -664,10 +708,12 @@ pub struct ItemAst {
     pub interaction_requires: Vec<(String, String)>,
     pub consumable: Option<ConsumableAst>,
     pub src_line: usize,
+    /// Byte span of the definition in its source file.
+    pub span: Span,
 }
 
 /// Visibility settings for items.
-#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
 pub enum ItemVisibilityAst {
     Listed,
     Scenery,
@@ -675,7 +721,7 @@ pub enum ItemVisibilityAst {
 }
 
 /// Possible item locations in the DSL.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum ItemLocationAst {
     Inventory(String),
     Room(String),
@@ -685,7 +731,7 @@ pub enum ItemLocationAst {
 }
 
 /// Container states expressible in the DSL.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum ContainerStateAst {
     Open,
     Closed,
@@ -695,7 +741,7 @@ pub enum ContainerStateAst {
 }
 
 /// Movability options for items, mirroring the engine `Movability`.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum MovabilityAst {
     Free,
     Fixed { reason: String },
@@ -703,14 +749,14 @@ pub enum MovabilityAst {
 }
 
 /// Single item ability entry declared within an item.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ItemAbilityAst {
     pub ability: String,
     pub target: Option<String>,
 }
 
 /// Consumable configuration attached to an item.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct ConsumableAst {
     pub uses_left: usize,
     pub consume_on: Vec<ItemAbilityAst>,
@@ -718,7 +764,7 @@ pub struct ConsumableAst {
 }
 
 /// Behavior when a consumable item is depleted.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum ConsumableWhenAst {
     Despawn,
     ReplaceInventory { replacement: String },
@@ -730,15 +776,17 @@ pub enum ConsumableWhenAst {
 // -----------------
 
 /// Spinner definition containing weighted text wedges.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct SpinnerAst {
     pub id: String,
     pub wedges: Vec<SpinnerWedgeAst>,
     pub src_line: usize,
+    /// Byte span of the definition in its source file.
+    pub span: Span,
 }
 
 /// Individual wedge (value + weight) inside a spinner.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct SpinnerWedgeAst {
     pub text: String,
     pub width: usize,
@@ -749,14 +797,14 @@ pub struct SpinnerWedgeAst {
 // -----------------
 
 /// Movement types supported for NPC definitions.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum NpcMovementTypeAst {
     Route,
     Random,
 }
 
 /// Movement configuration emitted for NPCs.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct NpcMovementAst {
     pub movement_type: NpcMovementTypeAst,
     pub rooms: Vec<String>,
@@ -766,7 +814,7 @@ pub struct NpcMovementAst {
 }
 
 /// AST node describing an NPC definition.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct NpcAst {
     pub id: String,
     pub name: String,
@@ -777,10 +825,12 @@ pub struct NpcAst {
     pub movement: Option<NpcMovementAst>,
     pub dialogue: Vec<(String, Vec<String>)>,
     pub src_line: usize,
+    /// Byte span of the definition in its source file.
+    pub span: Span,
 }
 
 /// Location specifier used for NPC placement.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum NpcLocationAst {
     Room(String),
     Nowhere(String),
@@ -791,7 +841,7 @@ pub enum NpcLocationAst {
 // -----------------
 
 /// Logical grouping for goals used when rendering score breakdowns.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum GoalGroupAst {
     /// Mandatory goals that count toward completion.
     Required,
@@ -802,7 +852,7 @@ pub enum GoalGroupAst {
 }
 
 /// Conditions that can activate, complete, or fail a goal.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub enum GoalCondAst {
     /// Goal requires the player to have a flag.
     HasFlag(String),
@@ -821,7 +871,7 @@ pub enum GoalCondAst {
 }
 
 /// High-level representation of a single goal definition in the DSL.
-#[derive(Debug, Clone, PartialEq)]
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
 pub struct GoalAst {
     pub id: String,
     pub name: String,
@@ -831,4 +881,6 @@ pub struct GoalAst {
     pub failed_when: Option<GoalCondAst>,
     pub finished_when: GoalCondAst,
     pub src_line: usize,
+    /// Byte span of the definition in its source file.
+    pub span: Span,
 }
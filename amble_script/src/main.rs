@@ -1,18 +1,25 @@
 //! CLI entry point for `amble_script`.
 //! Typical usage:
 //! - `cargo run -p amble_script -- compile-dir /path/to/root/data/dir --out-dir amble_engine/data`
+//! - `cargo run -p amble_script -- watch amble_script/data/Amble --out-dir amble_engine/data`
 //! - `cargo run -p amble_script -- lint amble_script/data/Amble --deny-missing`
 
+use std::num::NonZeroUsize;
 use std::path::{Path, PathBuf};
-use std::{env, fs, process};
+use std::{env, fs, process, thread};
 
+use amble_data::{WorldManifest, artifact_path, encode_artifact, manifest_path};
 use amble_script::{
-    ActionAst, ActionSetSpec, ActionStmt, ConditionAliasSpec, ConditionAst, GameAst, GoalCondAst,
-    collect_action_set_specs, collect_condition_alias_specs, parse_program_full, parse_program_full_with_context,
-    resolve_action_sets, resolve_condition_aliases, worlddef_from_asts,
+    ActionAst, ActionStmt, CompileCache, CompileError, ConditionAst, GameAst, GoalCondAst, LineIndex, ProgramAstBundle,
+    SourceSpan, Span, SymbolTable, compile_sources, compile_sources_cached, parse_program_full, worlddef_from_asts,
 };
 use ron::ser::PrettyConfig;
 use std::collections::{HashMap, HashSet};
+use std::fmt::Write as _;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::time::{Duration, Instant, SystemTime};
+
+const SUBCOMMANDS: [&str; 4] = ["compile", "compile-dir", "watch", "lint"];
 
 fn main() {
     let args: Vec<String> = env::args().collect();
@@ -22,19 +29,19 @@ fn main() {
     // 2) direct:    <bin> <cmd> <args>
     // Extract subcommand and collect the rest for flags/positional
     let rest: Vec<String> = match args.as_slice() {
-        [_, flag, cmd, tail @ ..] if flag == "--" && (cmd == "compile" || cmd == "lint" || cmd == "compile-dir") => {
+        [_, flag, cmd, tail @ ..] if flag == "--" && SUBCOMMANDS.contains(&cmd.as_str()) => {
             let mut v = vec![cmd.clone()];
             v.extend_from_slice(tail);
             v
         },
-        [_, cmd, tail @ ..] if cmd == "compile" || cmd == "lint" || cmd == "compile-dir" => {
+        [_, cmd, tail @ ..] if SUBCOMMANDS.contains(&cmd.as_str()) => {
             let mut v = vec![cmd.clone()];
             v.extend_from_slice(tail);
             v
         },
         _ => {
             eprintln!(
-                "Usage:\n  amble_script compile <file.amble> [--out-world <world.ron>]\n  amble_script compile-dir <src_dir> --out-dir <engine_data_dir> [--out-world <world.ron>]\n  amble_script lint <file.amble|dir> [--data-dir <dir>] [--deny-missing]\n\nNotes:\n- compile-dir writes world.ron to the output directory by default."
+                "Usage:\n  amble_script compile <file.amble> [--out-world <world.ron>]\n  amble_script compile-dir <src_dir> --out-dir <engine_data_dir> [--out-world <world.ron>] [--jobs N] [--cache-dir <dir> | --no-cache]\n  amble_script watch <src_dir> --out-dir <engine_data_dir> [compile-dir options] [--interval-ms N]\n  amble_script lint <file.amble|dir> [--data-dir <dir>] [--deny-missing] [--jobs N]\n\nNotes:\n- compile-dir writes world.ron to the output directory by default.\n- watch recompiles whenever a source file changes."
             );
             process::exit(2);
         },
@@ -44,6 +51,8 @@ fn main() {
         run_compile(&rest[1..]);
     } else if cmd == "compile-dir" {
         run_compile_dir(&rest[1..]);
+    } else if cmd == "watch" {
+        run_watch(&rest[1..]);
     } else if cmd == "lint" {
         run_lint(&rest[1..]);
     } else {
@@ -124,8 +133,8 @@ fn run_compile(args: &[String]) {
         }
     }
     if let Some(out) = out_world.as_ref() {
-        if let Err(e) = fs::write(out, text) {
-            eprintln!("error: writing '{out}': {e}");
+        if let Err(e) = write_world_files(out, &worlddef, &text) {
+            eprintln!("error: {e}");
             process::exit(1);
         }
     } else {
@@ -133,13 +142,37 @@ fn run_compile(args: &[String]) {
     }
 }
 
-fn run_compile_dir(args: &[String]) {
-    use std::path::Path;
-    use std::process;
+/// Options of `compile-dir` and `watch`.
+struct CompileDirOptions {
+    src_dir: String,
+    out_dir: String,
+    out_world: Option<String>,
+    verbose: bool,
+    jobs: usize,
+    /// Compile cache root (`None` with `--no-cache`).
+    cache_root: Option<PathBuf>,
+    /// How often `watch` polls the sources for changes, or how long it waits for a
+    /// burst of file notifications to settle before rebuilding.
+    interval: Duration,
+}
+
+/// What a successful `compile-dir` build wrote.
+struct CompileDirOutcome {
+    out_path: String,
+    files: usize,
+    /// Files that had to be parsed (the rest came from the compile cache).
+    parsed: usize,
+}
+
+/// Parse the arguments of `command` (`compile-dir` or `watch`), exiting on bad usage.
+fn parse_compile_dir_args(args: &[String], command: &str) -> CompileDirOptions {
     let mut src_dir: Option<String> = None;
     let mut out_dir: Option<String> = None;
     let mut out_world: Option<String> = None;
     let mut verbose = false;
+    let mut jobs = thread::available_parallelism().map_or(1, NonZeroUsize::get);
+    let mut cache_root = Some(CompileCache::default_root());
+    let mut interval = Duration::from_millis(200);
     let mut i = 0;
     while i < args.len() {
         match args[i].as_str() {
@@ -167,6 +200,38 @@ fn run_compile_dir(args: &[String]) {
                 verbose = true;
                 i += 1;
             },
+            "--jobs" | "-j" => {
+                match args.get(i + 1).and_then(|n| n.parse::<usize>().ok()) {
+                    Some(n) if n > 0 => jobs = n,
+                    _ => {
+                        eprintln!("--jobs requires a positive number of threads");
+                        process::exit(2);
+                    },
+                }
+                i += 2;
+            },
+            "--cache-dir" => {
+                if i + 1 >= args.len() {
+                    eprintln!("--cache-dir requires a directory");
+                    process::exit(2);
+                }
+                cache_root = Some(PathBuf::from(&args[i + 1]));
+                i += 2;
+            },
+            "--no-cache" => {
+                cache_root = None;
+                i += 1;
+            },
+            "--interval-ms" if command == "watch" => {
+                match args.get(i + 1).and_then(|n| n.parse::<u64>().ok()) {
+                    Some(ms) if ms > 0 => interval = Duration::from_millis(ms),
+                    _ => {
+                        eprintln!("--interval-ms requires a positive number of milliseconds");
+                        process::exit(2);
+                    },
+                }
+                i += 2;
+            },
             flag if flag.starts_with("--") => {
                 eprintln!("unknown flag: {flag}");
                 process::exit(2);
@@ -183,29 +248,73 @@ fn run_compile_dir(args: &[String]) {
         }
     }
     if src_dir.is_none() || out_dir.is_none() {
+        let watch_flags = if command == "watch" { " [--interval-ms N]" } else { "" };
         eprintln!(
-            "Usage: amble_script compile-dir <src_dir> --out-dir <engine_data_dir> [--out-world <world.ron>]\n\nNote: Writes world.ron to the output directory by default."
+            "Usage: amble_script {command} <src_dir> --out-dir <engine_data_dir> [--out-world <world.ron>] [--jobs N] [--cache-dir <dir> | --no-cache]{watch_flags}\n\nNote: Writes world.ron to the output directory by default; --jobs defaults to the number of CPUs.\nUnchanged files are reused from the compile cache (default: $AMBLE_SCRIPT_CACHE_DIR or target/amble_script-cache)."
         );
         process::exit(2);
     }
-    let src_dir = src_dir.unwrap();
-    let out_dir = out_dir.unwrap();
+    CompileDirOptions {
+        src_dir: src_dir.unwrap(),
+        out_dir: out_dir.unwrap(),
+        out_world,
+        verbose,
+        jobs,
+        cache_root,
+        interval,
+    }
+}
+
+fn run_compile_dir(args: &[String]) {
+    let opts = parse_compile_dir_args(args, "compile-dir");
+    if compile_dir(&opts).is_err() {
+        process::exit(1);
+    }
+}
+
+/// Build `opts.src_dir` into the world files, reporting any errors on stderr.
+fn compile_dir(opts: &CompileDirOptions) -> Result<CompileDirOutcome, ()> {
+    let mut timer = PhaseTimer::new();
     // Collect DSL files
     let mut files = Vec::new();
-    collect_dsl_files_recursive(&src_dir, &mut files);
+    collect_dsl_files_recursive(&opts.src_dir, &mut files);
     if files.is_empty() {
-        eprintln!("compile-dir: no .amble/.able files in '{}'", &src_dir);
-        process::exit(1);
+        eprintln!("compile-dir: no .amble/.able files in '{}'", &opts.src_dir);
+        return Err(());
     }
     files.sort();
-    let global_aliases = collect_global_condition_aliases(&files, "compile-dir").unwrap_or_else(|msg| {
-        eprintln!("{msg}");
-        process::exit(1);
-    });
-    let global_action_sets = collect_global_action_sets(&files, &global_aliases, "compile-dir").unwrap_or_else(|msg| {
-        eprintln!("{msg}");
-        process::exit(1);
-    });
+    timer.lap("discover");
+
+    // Read every file, then parse and lower them across `jobs` worker threads.
+    let mut had_error = false;
+    let mut sources = Vec::with_capacity(files.len());
+    for f in &files {
+        match fs::read_to_string(f) {
+            Ok(src) => sources.push((f.as_str(), src)),
+            Err(e) => {
+                eprintln!("compile-dir: cannot read '{f}': {e}");
+                had_error = true;
+            },
+        }
+    }
+    timer.lap("read");
+    if had_error {
+        eprintln!("compile-dir: aborting due to previous errors");
+        return Err(());
+    }
+    let inputs: Vec<(&str, &str)> = sources.iter().map(|(f, src)| (*f, src.as_str())).collect();
+    let cache = opts.cache_root.as_ref().map(CompileCache::new);
+    let compiled = match &cache {
+        Some(cache) => compile_sources_cached(&inputs, opts.jobs, cache),
+        None => compile_sources(&inputs, opts.jobs),
+    };
+    let bundles = compiled.map_err(|errors| {
+        for e in errors {
+            eprintln!("compile-dir: {e}");
+        }
+        eprintln!("compile-dir: aborting due to previous errors");
+    })?;
+    timer.lap("parse, resolve and lower");
 
     let mut game: Option<GameAst> = None;
     let mut trigs = Vec::new();
@@ -214,94 +323,243 @@ fn run_compile_dir(args: &[String]) {
     let mut spinners = Vec::new();
     let mut npcs = Vec::new();
     let mut goals = Vec::new();
-    let mut total_t = 0usize;
-    let mut total_r = 0usize;
-    let mut total_i = 0usize;
-    let mut total_sp = 0usize;
-    let mut total_n = 0usize;
-    let mut total_g = 0usize;
-    let mut had_error = false;
-    for f in &files {
-        let src = match fs::read_to_string(f) {
-            Ok(s) => s,
-            Err(e) => {
-                eprintln!("compile-dir: cannot read '{f}': {e}");
+    for ((f, _), (gdef, t, r, it, sp, n, g)) in inputs.iter().zip(bundles) {
+        if let Some(next_game) = gdef {
+            if game.is_some() {
+                eprintln!("compile-dir: multiple game blocks found (in '{f}')");
                 had_error = true;
                 continue;
-            },
-        };
-        match parse_program_full_with_context(&src, &global_aliases, &global_action_sets) {
-            Ok((gdef, t, r, it, sp, n, g)) => {
-                if let Some(next_game) = gdef {
-                    if game.is_some() {
-                        eprintln!("compile-dir: multiple game blocks found (in '{f}')");
-                        had_error = true;
-                        continue;
-                    }
-                    game = Some(next_game);
-                }
-                trigs.extend(t);
-                rooms.extend(r);
-                items.extend(it);
-                spinners.extend(sp);
-                npcs.extend(n);
-                goals.extend(g);
-                if verbose {
-                    eprintln!(
-                        "{f}: triggers={}, rooms={}, items={}, spinners={}, npcs={}, goals={}",
-                        trigs.len(),
-                        rooms.len(),
-                        items.len(),
-                        spinners.len(),
-                        npcs.len(),
-                        goals.len()
-                    );
-                }
-                total_t = trigs.len();
-                total_r = rooms.len();
-                total_i = items.len();
-                total_sp = spinners.len();
-                total_n = npcs.len();
-                total_g = goals.len();
-            },
-            Err(e) => {
-                eprintln!("compile-dir: parse error in '{f}': {e}");
-                had_error = true;
-            },
+            }
+            game = Some(next_game);
+        }
+        trigs.extend(t);
+        rooms.extend(r);
+        items.extend(it);
+        spinners.extend(sp);
+        npcs.extend(n);
+        goals.extend(g);
+        if opts.verbose {
+            eprintln!(
+                "{f}: triggers={}, rooms={}, items={}, spinners={}, npcs={}, goals={}",
+                trigs.len(),
+                rooms.len(),
+                items.len(),
+                spinners.len(),
+                npcs.len(),
+                goals.len()
+            );
         }
     }
+    timer.lap("merge");
     if had_error {
         eprintln!("compile-dir: aborting due to previous errors");
-        process::exit(1);
+        return Err(());
     }
-    let worlddef =
-        worlddef_from_asts(game.as_ref(), &trigs, &rooms, &items, &spinners, &npcs, &goals).unwrap_or_else(|e| {
-            eprintln!("compile-dir worlddef error: {e}");
-            process::exit(1);
-        });
+    let worlddef = worlddef_from_asts(game.as_ref(), &trigs, &rooms, &items, &spinners, &npcs, &goals)
+        .map_err(|e| eprintln!("compile-dir worlddef error: {e}"))?;
+    timer.lap("build worlddef");
     let pretty = PrettyConfig::default();
-    let text = ron::ser::to_string_pretty(&worlddef, pretty).unwrap_or_else(|e| {
-        eprintln!("compile-dir worlddef serialization error: {e}");
-        process::exit(1);
-    });
+    let text = ron::ser::to_string_pretty(&worlddef, pretty)
+        .map_err(|e| eprintln!("compile-dir worlddef serialization error: {e}"))?;
+    timer.lap("serialize");
 
-    if !Path::new(&out_dir).exists()
-        && let Err(e) = fs::create_dir_all(&out_dir)
+    let out_dir = &opts.out_dir;
+    if !Path::new(out_dir).exists()
+        && let Err(e) = fs::create_dir_all(out_dir)
     {
         eprintln!("compile-dir: cannot create out-dir '{out_dir}': {e}");
-        process::exit(1);
+        return Err(());
     }
 
-    let out_path = out_world.unwrap_or_else(|| format!("{out_dir}/world.ron"));
-    if let Err(e) = fs::write(&out_path, text) {
-        eprintln!("write '{out_path}': {e}");
-        process::exit(1);
+    let out_path = opts.out_world.clone().unwrap_or_else(|| format!("{out_dir}/world.ron"));
+    write_world_files(&out_path, &worlddef, &text).map_err(|e| eprintln!("{e}"))?;
+    timer.lap("write");
+    let parsed = cache.as_ref().map_or(files.len(), |cache| cache.stats().parsed);
+    if opts.verbose {
+        eprintln!(
+            "Summary: triggers={}, rooms={}, items={}, spinners={}, npcs={}, goals={}",
+            trigs.len(),
+            rooms.len(),
+            items.len(),
+            spinners.len(),
+            npcs.len(),
+            goals.len()
+        );
+        if let Some(cache) = &cache {
+            let stats = cache.stats();
+            eprintln!(
+                "Cache: {} of {} files lowered from cache, {} declarations reused, {} parsed",
+                stats.lowered_hits,
+                files.len(),
+                stats.decl_hits,
+                stats.parsed
+            );
+        }
+        timer.report(files.len());
+    }
+    Ok(CompileDirOutcome {
+        out_path,
+        files: files.len(),
+        parsed,
+    })
+}
+
+/// Compile like `compile-dir`, then recompile whenever a source file changes.
+///
+/// With the `notify` feature (on by default) changes arrive as OS file notifications;
+/// a burst of them is collapsed into one rebuild once the sources have been quiet for
+/// `--interval-ms` (default 200 ms). Without the feature, or if notifications cannot
+/// be set up, the modification time and size of every source file are polled each
+/// `--interval-ms` instead. Rebuilds go through the compile cache, so only edited
+/// files are parsed again. A failed build leaves the previous world files in place.
+fn run_watch(args: &[String]) {
+    let opts = parse_compile_dir_args(args, "watch");
+    let stamps = source_stamps(&opts.src_dir);
+    watch_build(&opts);
+    eprintln!("watch: watching '{}' for changes (Ctrl-C to stop)", opts.src_dir);
+    #[cfg(feature = "notify")]
+    if let Err(err) = watch_notify(&opts) {
+        eprintln!(
+            "watch: file notifications unavailable ({err}); polling every {} ms",
+            opts.interval.as_millis()
+        );
+    }
+    watch_poll(&opts, stamps);
+}
+
+/// Rebuild on OS file notifications for DSL sources under `src_dir`.
+///
+/// Only returns if the watcher cannot be started or stops delivering events.
+#[cfg(feature = "notify")]
+fn watch_notify(opts: &CompileDirOptions) -> notify::Result<()> {
+    use notify::{RecursiveMode, Watcher};
+    use std::sync::mpsc;
+
+    let (tx, rx) = mpsc::channel();
+    let mut watcher = notify::recommended_watcher(tx)?;
+    watcher.watch(Path::new(&opts.src_dir), RecursiveMode::Recursive)?;
+    let touches_sources = |event: &notify::Event| !event.kind.is_access() && event.paths.iter().any(|p| is_dsl_path(p));
+    while let Ok(event) = rx.recv() {
+        if !touches_sources(&event?) {
+            continue;
+        }
+        // editors often write a file in several steps; wait for the burst to end
+        while rx.recv_timeout(opts.interval).is_ok() {}
+        watch_build(opts);
+    }
+    Ok(())
+}
+
+/// Rebuild whenever the modification time or size of a source file changes.
+fn watch_poll(opts: &CompileDirOptions, mut stamps: Vec<(String, Option<SystemTime>, u64)>) {
+    loop {
+        thread::sleep(opts.interval);
+        let current = source_stamps(&opts.src_dir);
+        if current != stamps {
+            stamps = current;
+            watch_build(opts);
+        }
+    }
+}
+
+fn watch_build(opts: &CompileDirOptions) {
+    let started = Instant::now();
+    match compile_dir(opts) {
+        Ok(outcome) => eprintln!(
+            "watch: wrote {} in {:.1} ms ({} of {} files recompiled); use :reload in a dev-mode game to pick it up",
+            outcome.out_path,
+            started.elapsed().as_secs_f64() * 1000.0,
+            outcome.parsed,
+            outcome.files
+        ),
+        Err(()) => eprintln!("watch: build failed; waiting for the next change"),
     }
-    if verbose {
+}
+
+/// Path, modification time and size of every DSL file under `dir`, sorted by path.
+fn source_stamps(dir: &str) -> Vec<(String, Option<SystemTime>, u64)> {
+    let mut files = Vec::new();
+    collect_dsl_files_recursive(dir, &mut files);
+    files.sort();
+    files
+        .into_iter()
+        .map(|file| {
+            let meta = fs::metadata(&file).ok();
+            let modified = meta.as_ref().and_then(|meta| meta.modified().ok());
+            let len = meta.map_or(0, |meta| meta.len());
+            (file, modified, len)
+        })
+        .collect()
+}
+
+/// Wall-clock timing of the `compile-dir` phases, reported under `--verbose`.
+struct PhaseTimer {
+    started: Instant,
+    last: Instant,
+    phases: Vec<(&'static str, Duration)>,
+}
+
+impl PhaseTimer {
+    fn new() -> Self {
+        let now = Instant::now();
+        Self {
+            started: now,
+            last: now,
+            phases: Vec::new(),
+        }
+    }
+
+    /// Record the time since the previous lap as phase `name`.
+    fn lap(&mut self, name: &'static str) {
+        let now = Instant::now();
+        self.phases.push((name, now - self.last));
+        self.last = now;
+    }
+
+    fn report(&self, file_count: usize) {
+        let total = self.last - self.started;
+        eprintln!("Timing ({file_count} files):");
+        for (name, elapsed) in &self.phases {
+            let share = if total.is_zero() {
+                0.0
+            } else {
+                elapsed.as_secs_f64() / total.as_secs_f64() * 100.0
+            };
+            eprintln!("  {name:<28} {:>9.2} ms  {share:>5.1}%", elapsed.as_secs_f64() * 1000.0);
+        }
+        eprintln!("  {:<28} {:>9.2} ms", "total", total.as_secs_f64() * 1000.0);
+    }
+}
+
+/// Write the compiled world text to `out_path` plus its companion files:
+/// - a metadata manifest (`<stem>.meta`), which lets the engine's world chooser
+///   list the world without parsing it;
+/// - a precompiled binary artifact (`<stem>.amblebin`), written only when the world
+///   passes validation, which the engine loads instead of parsing and re-validating
+///   the RON.
+fn write_world_files(out_path: &str, worlddef: &amble_data::WorldDef, text: &str) -> Result<(), String> {
+    // never leave an artifact from a previous compile next to a world it doesn't match
+    let artifact_path = artifact_path(Path::new(out_path));
+    let _ = fs::remove_file(&artifact_path);
+    fs::write(out_path, text).map_err(|e| format!("write '{out_path}': {e}"))?;
+    let manifest = WorldManifest::for_world(worlddef, text.as_bytes());
+    let manifest_text = ron::ser::to_string_pretty(&manifest, PrettyConfig::default())
+        .map_err(|e| format!("manifest serialization error: {e}"))?;
+    let manifest_path = manifest_path(Path::new(out_path));
+    fs::write(&manifest_path, manifest_text).map_err(|e| format!("write '{}': {e}", manifest_path.display()))?;
+
+    let errors = amble_data::validate_world(worlddef);
+    if !errors.is_empty() {
         eprintln!(
-            "Summary: triggers={total_t}, rooms={total_r}, items={total_i}, spinners={total_sp}, npcs={total_n}, goals={total_g}"
+            "warning: world has {} validation error(s); skipping binary artifact '{}'",
+            errors.len(),
+            artifact_path.display()
         );
+        return Ok(());
     }
+    let artifact =
+        encode_artifact(worlddef, text.as_bytes()).map_err(|e| format!("world artifact encoding error: {e}"))?;
+    fs::write(&artifact_path, artifact).map_err(|e| format!("write '{}': {e}", artifact_path.display()))
 }
 
 fn run_lint(args: &[String]) {
@@ -309,6 +567,7 @@ fn run_lint(args: &[String]) {
     let mut path: Option<String> = None;
     let mut data_dir: Option<String> = None;
     let mut deny_missing = false;
+    let mut jobs = thread::available_parallelism().map_or(1, NonZeroUsize::get);
     let mut i = 0;
     while i < args.len() {
         match args[i].as_str() {
@@ -326,6 +585,16 @@ fn run_lint(args: &[String]) {
                 i += 1;
                 continue;
             },
+            "--jobs" | "-j" => {
+                match args.get(i + 1).and_then(|n| n.parse::<usize>().ok()) {
+                    Some(n) if n > 0 => jobs = n,
+                    _ => {
+                        eprintln!("--jobs requires a positive number of threads");
+                        process::exit(2);
+                    },
+                }
+                i += 2;
+            },
             s => {
                 if path.is_none() {
                     path = Some(s.to_string());
@@ -335,15 +604,10 @@ fn run_lint(args: &[String]) {
         }
     }
     if path.is_none() {
-        eprintln!("Usage: amble_script lint <file.amble> [--data-dir <dir>] [--deny-missing]");
+        eprintln!("Usage: amble_script lint <file.amble|dir> [--data-dir <dir>] [--deny-missing] [--jobs N]");
         process::exit(2);
     }
     let path = path.unwrap();
-    let data_dir = data_dir.unwrap_or_else(|| "amble_engine/data".to_string());
-    let world = load_world_refs(&data_dir).unwrap_or_else(|e| {
-        eprintln!("lint: failed to load data dir '{}': {}", &data_dir, e);
-        process::exit(2);
-    });
 
     // Support linting a single file or a directory of files (recursive)
     let mut files = Vec::new();
@@ -360,39 +624,173 @@ fn run_lint(args: &[String]) {
         files.push(path.clone());
     }
 
-    let alias_scope_files = lint_alias_scope_files(&path, md.is_dir()).unwrap_or_else(|msg| {
+    // Compile the whole project once so every file resolves its references against
+    // the ids the sources define now, not against a previously compiled world.ron.
+    let mut scope_files = lint_alias_scope_files(&path, md.is_dir()).unwrap_or_else(|msg| {
         eprintln!("{msg}");
         process::exit(1);
     });
-    let shared_aliases = if alias_scope_files.is_empty() {
-        None
-    } else {
-        Some(
-            collect_global_condition_aliases(&alias_scope_files, "lint").unwrap_or_else(|msg| {
-                eprintln!("{msg}");
-                process::exit(1);
-            }),
-        )
-    };
-    let shared_action_sets = shared_aliases.as_ref().map(|aliases| {
-        collect_global_action_sets(&alias_scope_files, aliases, "lint").unwrap_or_else(|msg| {
-            eprintln!("{msg}");
-            process::exit(1);
-        })
-    });
+    let canonical = |file: &str| fs::canonicalize(file).unwrap_or_else(|_| PathBuf::from(file));
+    let scope_keys: HashMap<PathBuf, usize> = scope_files
+        .iter()
+        .enumerate()
+        .map(|(idx, file)| (canonical(file), idx))
+        .collect();
+    let mut targets = Vec::with_capacity(files.len());
+    for file in &files {
+        if let Some(idx) = scope_keys.get(&canonical(file)) {
+            targets.push(*idx);
+        } else {
+            targets.push(scope_files.len());
+            scope_files.push(file.clone());
+        }
+    }
+    let scope = compile_lint_scope(&scope_files, jobs);
+    for error in &scope.errors {
+        eprintln!("{error}");
+    }
+    let mut symbols = SymbolTable::from_bundles(scope.bundles.iter().flatten());
+    if let Some(data_dir) = &data_dir {
+        symbols.extend(load_world_refs(data_dir));
+    }
 
+    // Files that failed to compile were reported above; lint the rest.
+    targets.retain(|&idx| scope.bundles[idx].is_some());
+    let compiled: Vec<(&str, &str)> = scope
+        .compiled
+        .iter()
+        .map(|&idx| (scope.sources[idx].0.as_str(), scope.sources[idx].1.as_str()))
+        .collect();
+    let reports = map_parallel(&targets, jobs, |&idx| {
+        let (file, src) = &scope.sources[idx];
+        let bundle = scope.bundles[idx]
+            .as_ref()
+            .expect("targets were filtered to compiled files");
+        lint_one_file(file, src, bundle, &symbols, &compiled)
+    });
     let mut any_missing = 0usize;
-    for f in files {
-        any_missing += lint_one_file(&f, &world, shared_aliases.as_ref(), shared_action_sets.as_ref());
+    for (missing, report) in reports {
+        eprint!("{report}");
+        any_missing += missing;
     }
-    if any_missing == 0 {
+    if any_missing == 0 && scope.errors.is_empty() {
         eprintln!("lint: OK (no missing cross references)");
     }
-    if deny_missing && any_missing > 0 {
+    if !scope.errors.is_empty() || (deny_missing && any_missing > 0) {
         process::exit(1);
     }
 }
 
+/// Source files of a lint run and their ASTs, in the same order.
+struct LintScope {
+    /// `(path, text)` of every file (empty text if it could not be read).
+    sources: Vec<(String, String)>,
+    /// AST of every file, or `None` if the file failed to read or compile.
+    bundles: Vec<Option<ProgramAstBundle>>,
+    /// Indices into `sources` of the files compiled together, in compile order;
+    /// a [`SourceSpan::file`] indexes this list.
+    compiled: Vec<usize>,
+    /// Diagnostics for the files (or shared definitions) that failed.
+    errors: Vec<String>,
+}
+
+/// Read `files`, then parse and lower them together on up to `jobs` threads, so
+/// shared condition aliases and action sets resolve across all of them.
+///
+/// A file that fails to read, parse or lower is reported in
+/// [`LintScope::errors`] and dropped, and the rest are compiled again without it,
+/// so one broken file does not hide the diagnostics of the others. Files that
+/// used definitions from a dropped file then fail and are reported in turn.
+fn compile_lint_scope(files: &[String], jobs: usize) -> LintScope {
+    let mut sources = Vec::with_capacity(files.len());
+    let mut errors = Vec::new();
+    let mut live = Vec::with_capacity(files.len());
+    for (idx, file) in files.iter().enumerate() {
+        match fs::read_to_string(file) {
+            Ok(src) => {
+                live.push(idx);
+                sources.push((file.clone(), src));
+            },
+            Err(e) => {
+                errors.push(format!("lint: cannot read '{file}': {e}"));
+                sources.push((file.clone(), String::new()));
+            },
+        }
+    }
+    let mut bundles: Vec<Option<ProgramAstBundle>> = files.iter().map(|_| None).collect();
+    let mut compiled = Vec::new();
+    while !live.is_empty() {
+        let inputs: Vec<(&str, &str)> = live
+            .iter()
+            .map(|&idx| (sources[idx].0.as_str(), sources[idx].1.as_str()))
+            .collect();
+        let failures = match compile_sources(&inputs, jobs) {
+            Ok(lowered) => {
+                for (&idx, bundle) in live.iter().zip(lowered) {
+                    bundles[idx] = Some(bundle);
+                }
+                compiled = live;
+                break;
+            },
+            Err(failures) => failures,
+        };
+        let mut failed: HashSet<&str> = HashSet::new();
+        for e in &failures {
+            errors.push(format!("lint: {e}"));
+            match e {
+                CompileError::Parse { path, .. } => {
+                    failed.insert(path);
+                },
+                CompileError::DuplicateAlias { second, .. } | CompileError::DuplicateActionSet { second, .. } => {
+                    failed.insert(second);
+                },
+                CompileError::Alias(_) | CompileError::ActionSet(_) => {},
+            }
+        }
+        // A shared definition that does not resolve cannot be blamed on one
+        // file, so nothing is left to lint.
+        if failed.is_empty() {
+            break;
+        }
+        live.retain(|&idx| !failed.contains(sources[idx].0.as_str()));
+    }
+    LintScope {
+        sources,
+        bundles,
+        compiled,
+        errors,
+    }
+}
+
+/// Apply `f` to every item on up to `jobs` threads, returning the results in input order.
+fn map_parallel<T: Sync, R: Send>(items: &[T], jobs: usize, f: impl Fn(&T) -> R + Sync) -> Vec<R> {
+    let next = AtomicUsize::new(0);
+    let workers = jobs.clamp(1, items.len().max(1));
+    let mut results: Vec<(usize, R)> = thread::scope(|scope| {
+        let handles: Vec<_> = (0..workers)
+            .map(|_| {
+                scope.spawn(|| {
+                    let mut done = Vec::new();
+                    loop {
+                        let idx = next.fetch_add(1, Ordering::Relaxed);
+                        let Some(item) = items.get(idx) else {
+                            break;
+                        };
+                        done.push((idx, f(item)));
+                    }
+                    done
+                })
+            })
+            .collect();
+        handles
+            .into_iter()
+            .flat_map(|handle| handle.join().expect("lint worker panicked"))
+            .collect()
+    });
+    results.sort_by_key(|(idx, _)| *idx);
+    results.into_iter().map(|(_, result)| result).collect()
+}
+
 fn collect_dsl_files_recursive(dir: &str, out: &mut Vec<String>) {
     if let Ok(rd) = fs::read_dir(dir) {
         for ent in rd.flatten() {
@@ -403,8 +801,7 @@ fn collect_dsl_files_recursive(dir: &str, out: &mut Vec<String>) {
                 }
                 continue;
             }
-            if let Some(ext) = p.extension().and_then(|e| e.to_str())
-                && (ext == "amble" || ext == "able")
+            if is_dsl_path(&p)
                 && let Some(s) = p.to_str()
             {
                 out.push(s.to_string());
@@ -413,6 +810,13 @@ fn collect_dsl_files_recursive(dir: &str, out: &mut Vec<String>) {
     }
 }
 
+/// True if `path` has a DSL source extension (`.amble` or `.able`).
+fn is_dsl_path(path: &Path) -> bool {
+    path.extension()
+        .and_then(|e| e.to_str())
+        .is_some_and(|ext| ext == "amble" || ext == "able")
+}
+
 fn lint_alias_scope_files(path: &str, is_dir: bool) -> Result<Vec<String>, String> {
     let scope_root = if is_dir {
         PathBuf::from(path)
@@ -440,62 +844,28 @@ fn discover_lint_project_root(path: &Path) -> Result<PathBuf, String> {
     Ok(start.to_path_buf())
 }
 
+/// Check the references of one file against `symbols`.
+///
+/// `compiled` lists the `(path, text)` of the files compiled with it, which a
+/// [`SourceSpan::file`] indexes, so references inlined from an action set are
+/// reported where the set declares them.
+///
+/// Returns the number of missing references and the diagnostics to print, so
+/// files can be linted in parallel and still report in a stable order.
 fn lint_one_file(
     path: &str,
-    world: &WorldRefs,
-    aliases: Option<&HashMap<String, ConditionAst>>,
-    action_sets: Option<&HashMap<String, Vec<ActionStmt>>>,
-) -> usize {
-    let src = match fs::read_to_string(path) {
-        Ok(s) => s,
-        Err(e) => {
-            eprintln!("lint: cannot read '{path}': {e}");
-            return 0;
-        },
-    };
-    let parsed = match (aliases, action_sets) {
-        (Some(shared_aliases), Some(shared_action_sets)) => {
-            parse_program_full_with_context(&src, shared_aliases, shared_action_sets)
-        },
-        (Some(shared_aliases), None) => parse_program_full_with_context(&src, shared_aliases, &HashMap::new()),
-        (None, _) => parse_program_full(&src),
-    };
-    let (_game, asts, rooms_asts, item_asts, spinner_asts, npc_asts, goal_asts) = match parsed {
-        Ok(v) => v,
-        Err(e) => {
-            eprintln!("lint: parse error in '{path}': {e}");
-            return 0;
-        },
-    };
-    let mut refs: HashMap<&'static str, HashSet<String>> = HashMap::new();
-    refs.insert("item", HashSet::new());
-    refs.insert("room", HashSet::new());
-    refs.insert("npc", HashSet::new());
-    refs.insert("spinner", HashSet::new());
-    refs.insert("flag", HashSet::new());
-    // Collect ids defined in this DSL file so references can target them without false positives
-    let mut defined_rooms: HashSet<String> = HashSet::new();
-    let mut defined_items: HashSet<String> = HashSet::new();
-    let mut defined_npcs: HashSet<String> = HashSet::new();
-    let mut defined_spinners: HashSet<String> = HashSet::new();
-    let mut defined_goals: HashSet<String> = HashSet::new();
-    for r in &rooms_asts {
-        defined_rooms.insert(r.id.clone());
-    }
-    for it in &item_asts {
-        defined_items.insert(it.id.clone());
-    }
-    for n in &npc_asts {
-        defined_npcs.insert(n.id.clone());
-    }
-    for sp in &spinner_asts {
-        defined_spinners.insert(sp.id.clone());
-    }
-    for g in &goal_asts {
-        defined_goals.insert(g.id.clone());
-    }
-    for t in &asts {
+    src: &str,
+    bundle: &ProgramAstBundle,
+    symbols: &SymbolTable,
+    compiled: &[(&str, &str)],
+) -> (usize, String) {
+    let (_game, asts, rooms_asts, _item_asts, _spinner_asts, npc_asts, goal_asts) = bundle;
+    let mut out = String::new();
+    let mut refs = FileRefs::default();
+    for t in asts {
+        refs.at = t.event_span.into();
         gather_refs_from_condition(&t.event, &mut refs);
+        refs.at = t.conditions_span.into();
         for c in &t.conditions {
             gather_refs_from_condition(c, &mut refs);
         }
@@ -503,17 +873,18 @@ fn lint_one_file(
             gather_refs_from_action(stmt, &mut refs);
         }
     }
-    for r in &rooms_asts {
+    for r in rooms_asts {
         gather_refs_from_room(r, &mut refs);
     }
     // Lint NPC dialogue bucket duplicates and movement room references
     if !npc_asts.is_empty() {
-        for n in &npc_asts {
+        for n in npc_asts {
             // warn on duplicate dialogue states
             let mut seen_states: HashSet<&str> = HashSet::new();
             for (state_key, _lines) in &n.dialogue {
                 if !seen_states.insert(state_key.as_str()) {
-                    eprintln!(
+                    let _ = writeln!(
+                        out,
                         "lint: warning: NPC '{}' has duplicate dialogue bucket '{}'",
                         n.id, state_key
                     );
@@ -521,270 +892,119 @@ fn lint_one_file(
             }
         }
     }
+    let mut lines = HashMap::new();
+    lines.insert(None, (path, LineIndex::new(src)));
     let mut missing = 0usize;
-    for id in &refs["item"] {
-        if !world.items.contains(id) && !defined_items.contains(id) {
-            report_missing_with_location(path, &src, "item", id, &world.items);
+    let mut check = |kind: &str, id: &str, at: SourceSpan| {
+        if !symbols.contains(kind, id) {
+            let (file, lines) = lines.entry(at.file).or_insert_with(|| {
+                let (file, text) = at
+                    .file
+                    .and_then(|f| compiled.get(f as usize))
+                    .copied()
+                    .unwrap_or((path, src));
+                (file, LineIndex::new(text))
+            });
+            report_missing_with_location(&mut out, file, lines, kind, id, at.span, symbols);
+            if *file != path {
+                let _ = writeln!(out, "  note: inlined into '{path}' by `run`");
+            }
             missing += 1;
         }
-    }
-    for id in &refs["room"] {
-        if !world.rooms.contains(id) && !defined_rooms.contains(id) {
-            let mut cands = world.rooms.clone();
-            cands.extend(defined_rooms.iter().cloned());
-            report_missing_with_location(path, &src, "room", id, &cands);
-            missing += 1;
+    };
+    for kind in ["item", "room", "npc", "spinner", "flag"] {
+        let mut ids: Vec<(&String, &SourceSpan)> = refs.by_kind.get(kind).into_iter().flatten().collect();
+        ids.sort_by(|a, b| a.0.cmp(b.0));
+        for (id, at) in ids {
+            check(kind, id, *at);
         }
     }
     // Lint NPC movement rooms
-    if !npc_asts.is_empty() {
-        for n in &npc_asts {
-            if let Some(mv) = &n.movement {
-                for rid in &mv.rooms {
-                    if !world.rooms.contains(rid) && !defined_rooms.contains(rid) {
-                        let mut cands = world.rooms.clone();
-                        cands.extend(defined_rooms.iter().cloned());
-                        report_missing_with_location(path, &src, "room", rid, &cands);
-                        missing += 1;
-                    }
-                }
+    for n in npc_asts {
+        if let Some(mv) = &n.movement {
+            for rid in &mv.rooms {
+                check("room", rid, n.span.into());
             }
         }
     }
     // Lint goals conditions
-    for g in &goal_asts {
-        let check = |cond: &GoalCondAst, missing: &mut usize| {
-            match cond {
-                GoalCondAst::HasFlag(f)
-                | GoalCondAst::MissingFlag(f)
-                | GoalCondAst::FlagInProgress(f)
-                | GoalCondAst::FlagComplete(f) => {
-                    // Skip empty sentinel used by parser for missing "start when" (activate_when)
-                    if f.trim().is_empty() {
-                        return;
-                    }
-                    let base = f.split('#').next().unwrap_or(f);
-                    if !world.flags.contains(base) {
-                        report_missing_with_location(path, &src, "flag", f, &world.flags);
-                        *missing += 1;
-                    }
-                },
-                GoalCondAst::HasItem(i) => {
-                    if !world.items.contains(i) {
-                        report_missing_with_location(path, &src, "item", i, &world.items);
-                        *missing += 1;
-                    }
-                },
-                GoalCondAst::ReachedRoom(r) => {
-                    if !world.rooms.contains(r) {
-                        report_missing_with_location(path, &src, "room", r, &world.rooms);
-                        *missing += 1;
-                    }
-                },
-                GoalCondAst::GoalComplete(id) => {
-                    if !world.goals.contains(id) && !defined_goals.contains(id) {
-                        // Suggest from both world and locally-defined goal ids for better hints
-                        let mut cands = world.goals.clone();
-                        cands.extend(defined_goals.iter().cloned());
-                        report_missing_with_location(path, &src, "goal", id, &cands);
-                        *missing += 1;
-                    }
-                },
-            }
+    for g in goal_asts {
+        let mut check_goal = |cond: &GoalCondAst| match cond {
+            GoalCondAst::HasFlag(f)
+            | GoalCondAst::MissingFlag(f)
+            | GoalCondAst::FlagInProgress(f)
+            | GoalCondAst::FlagComplete(f) => {
+                // Skip empty sentinel used by parser for missing "start when" (activate_when)
+                if !f.trim().is_empty() {
+                    check("flag", f, g.span.into());
+                }
+            },
+            GoalCondAst::HasItem(i) => check("item", i, g.span.into()),
+            GoalCondAst::ReachedRoom(r) => check("room", r, g.span.into()),
+            GoalCondAst::GoalComplete(id) => check("goal", id, g.span.into()),
         };
-        check(&g.finished_when, &mut missing);
+        check_goal(&g.finished_when);
         if let Some(cond) = &g.activate_when {
-            check(cond, &mut missing);
+            check_goal(cond);
         }
         if let Some(cond) = &g.failed_when {
-            check(cond, &mut missing);
-        }
-    }
-    for id in &refs["npc"] {
-        if !world.npcs.contains(id) && !defined_npcs.contains(id) {
-            report_missing_with_location(path, &src, "npc", id, &world.npcs);
-            missing += 1;
-        }
-    }
-    for id in &refs["spinner"] {
-        if !world.spinners.contains(id) && !defined_spinners.contains(id) {
-            report_missing_with_location(path, &src, "spinner", id, &world.spinners);
-            missing += 1;
+            check_goal(cond);
         }
     }
-    for id in &refs["flag"] {
-        let base = id.split('#').next().unwrap_or(id).to_string();
-        if !world.flags.contains(&base) {
-            report_missing_with_location(path, &src, "flag", id, &world.flags);
-            missing += 1;
-        }
-    }
-    missing
+    (missing, out)
 }
 
-fn collect_global_condition_aliases(files: &[String], label: &str) -> Result<HashMap<String, ConditionAst>, String> {
-    let mut all_specs: Vec<ConditionAliasSpec> = Vec::new();
-    let mut seen: HashMap<String, String> = HashMap::new();
-
-    for file in files {
-        let src = fs::read_to_string(file).map_err(|e| format!("{label}: cannot read '{file}': {e}"))?;
-        let specs =
-            collect_condition_alias_specs(&src).map_err(|e| format!("{label}: parse error in '{file}': {e}"))?;
-        for spec in &specs {
-            if let Some(prev) = seen.insert(spec.name.clone(), file.clone()) {
-                return Err(format!(
-                    "{label}: duplicate condition alias '{}' in '{}' and '{}'",
-                    spec.name, prev, file
-                ));
-            }
-        }
-        all_specs.extend(specs);
-    }
-
-    resolve_condition_aliases(&all_specs).map_err(|e| format!("{label}: condition alias error: {e}"))
+/// References found in one file: kind -> id -> span of the first statement,
+/// clause or definition that mentions it.
+#[derive(Default)]
+struct FileRefs {
+    by_kind: HashMap<&'static str, HashMap<String, SourceSpan>>,
+    /// Innermost spanned node currently being walked.
+    at: SourceSpan,
 }
 
-fn collect_global_action_sets(
-    files: &[String],
-    aliases: &HashMap<String, ConditionAst>,
-    label: &str,
-) -> Result<HashMap<String, Vec<ActionStmt>>, String> {
-    let mut all_specs: Vec<ActionSetSpec> = Vec::new();
-    let mut seen: HashMap<String, String> = HashMap::new();
-
-    for file in files {
-        let src = fs::read_to_string(file).map_err(|e| format!("{label}: cannot read '{file}': {e}"))?;
-        let specs = collect_action_set_specs(&src).map_err(|e| format!("{label}: parse error in '{file}': {e}"))?;
-        for spec in &specs {
-            if let Some(prev) = seen.insert(spec.name.clone(), file.clone()) {
-                return Err(format!(
-                    "{label}: duplicate action set '{}' in '{}' and '{}'",
-                    spec.name, prev, file
-                ));
-            }
-        }
-        all_specs.extend(specs);
+impl FileRefs {
+    fn add(&mut self, kind: &'static str, id: &str) {
+        let at = self.at;
+        self.by_kind
+            .entry(kind)
+            .or_default()
+            .entry(id.to_string())
+            .or_insert(at);
     }
-
-    resolve_action_sets(&all_specs, aliases).map_err(|e| format!("{label}: action set error: {e}"))
 }
 
 fn report_missing_with_location(
+    out: &mut String,
     path: &str,
-    src: &str,
+    lines: &LineIndex<'_>,
     kind: &str,
     id: &str,
-    candidates: &std::collections::HashSet<String>,
+    at: Span,
+    symbols: &SymbolTable,
 ) {
-    if let Some((line_no, col, line)) = find_position_for_id(src, kind, id) {
-        let suggestions = suggest_ids(id, candidates);
-        if suggestions.is_empty() {
-            eprintln!(
-                "{}:{}:{}: unknown {} '{}'\n{}\n{}^",
-                path,
-                line_no,
-                col,
-                kind,
-                id,
-                line,
-                " ".repeat(col.saturating_sub(1))
-            );
-        } else {
-            eprintln!(
-                "{}:{}:{}: unknown {} '{}' (did you mean: {}?)\n{}\n{}^",
-                path,
-                line_no,
-                col,
-                kind,
-                id,
-                suggestions.join(", "),
-                line,
-                " ".repeat(col.saturating_sub(1))
-            );
-        }
+    let suggestions = symbols
+        .ids(kind)
+        .map(|candidates| suggest_ids(id, candidates))
+        .unwrap_or_default();
+    let hint = if suggestions.is_empty() {
+        String::new()
     } else {
-        let suggestions = suggest_ids(id, candidates);
-        if suggestions.is_empty() {
-            eprintln!("{path}: unknown {kind} '{id}'");
-        } else {
-            eprintln!(
-                "{path}: unknown {kind} '{id}' (did you mean: {}?)",
-                suggestions.join(", ")
-            );
-        }
-    }
-}
-
-fn find_position_for_id(src: &str, kind: &str, id: &str) -> Option<(usize, usize, String)> {
-    let patterns: Vec<String> = match kind {
-        "item" => vec![
-            format!(" item {}", id),
-            format!(" container {}", id),
-            format!(" description {}", id),
-            format!(" restrict item {}", id),
-        ],
-        "room" => vec![format!(" room {}", id), format!(" to {}", id), format!(" from {}", id)],
-        "npc" => vec![
-            format!(" npc {}", id),
-            format!(" from npc {}", id),
-            format!(" with npc {}", id),
-        ],
-        "spinner" => vec![format!(" spinner {}", id), format!(" ambient {}", id)],
-        "goal" => vec![format!(" goal complete {}", id)],
-        "flag" => vec![
-            format!(" flag {}", id),
-            format!(" missing flag {}", id),
-            format!(" has flag {}", id),
-            format!(" flag in progress {}", id),
-            format!(" flag complete {}", id),
-            format!(" required_flags({}", id),
-        ],
-        _ => vec![id.to_string()],
+        format!(" (did you mean: {}?)", suggestions.join(", "))
     };
-    let bytes = src.as_bytes();
-    for pat in patterns {
-        if let Some(idx) = src.find(&pat) {
-            return byte_index_to_line_col(src, idx + pat.find(id).unwrap_or(0));
-        }
-    }
-    // Fallback: find id as a whole word
-    let mut i = 0usize;
-    while let Some(pos) = src[i..].find(id) {
-        let abs = i + pos;
-        if is_word_boundary(bytes, abs.saturating_sub(1)) && is_word_boundary(bytes, abs + id.len()) {
-            return byte_index_to_line_col(src, abs);
-        }
-        i = abs + id.len();
-    }
-    None
-}
-
-fn is_word_boundary(bytes: &[u8], idx: usize) -> bool {
-    if idx >= bytes.len() {
-        return true;
-    }
-    let c = bytes[idx] as char;
-    !(c.is_alphanumeric() || c == '_' || c == '-' || c == ':')
-}
-
-fn byte_index_to_line_col(src: &str, idx: usize) -> Option<(usize, usize, String)> {
-    let mut line_no = 1usize;
-    let mut col = 1usize;
-
-    let mut line_start = 0usize;
-    for (pos, ch) in src.char_indices() {
-        if pos >= idx {
-            col = idx.saturating_sub(line_start) + 1;
-            break;
-        }
-        if ch == '\n' {
-            line_no += 1;
-            line_start = pos + 1;
-        }
-    }
-    let line_end = src[idx..].find('\n').map(|off| idx + off).unwrap_or(src.len());
-    let line = src[line_start..line_end].to_string();
-    Some((line_no, col, line))
+    let (line_no, col) = lines.line_col(at.start());
+    let _ = writeln!(
+        out,
+        "{}:{}:{}: unknown {} '{}'{}\n{}\n{}^",
+        path,
+        line_no,
+        col,
+        kind,
+        id,
+        hint,
+        lines.line(line_no),
+        " ".repeat(col.saturating_sub(1))
+    );
 }
 
 fn suggest_ids(target: &str, candidates: &std::collections::HashSet<String>) -> Vec<String> {
@@ -829,13 +1049,13 @@ fn edit_distance_bounded(a: &str, b: &str, _max: usize) -> usize {
     prev[m]
 }
 
-fn gather_refs_from_condition(c: &ConditionAst, out: &mut HashMap<&'static str, HashSet<String>>) {
+fn gather_refs_from_condition(c: &ConditionAst, out: &mut FileRefs) {
     match c {
         ConditionAst::EnterRoom(r)
         | ConditionAst::LeaveRoom(r)
         | ConditionAst::PlayerInRoom(r)
         | ConditionAst::HasVisited(r) => {
-            out.get_mut("room").unwrap().insert(r.clone());
+            out.add("room", r);
         },
         ConditionAst::TakeItem(i)
         | ConditionAst::TouchItem(i)
@@ -845,60 +1065,60 @@ fn gather_refs_from_condition(c: &ConditionAst, out: &mut HashMap<&'static str,
         | ConditionAst::UnlockItem(i)
         | ConditionAst::HasItem(i)
         | ConditionAst::MissingItem(i) => {
-            out.get_mut("item").unwrap().insert(i.clone());
+            out.add("item", i);
         },
         ConditionAst::TalkToNpc(n) | ConditionAst::WithNpc(n) => {
-            out.get_mut("npc").unwrap().insert(n.clone());
+            out.add("npc", n);
         },
         ConditionAst::UseItem { item, .. } => {
-            out.get_mut("item").unwrap().insert(item.clone());
+            out.add("item", item);
         },
         ConditionAst::Ingest { item, .. } => {
-            out.get_mut("item").unwrap().insert(item.clone());
+            out.add("item", item);
         },
         ConditionAst::GiveToNpc { item, npc } => {
-            out.get_mut("item").unwrap().insert(item.clone());
-            out.get_mut("npc").unwrap().insert(npc.clone());
+            out.add("item", item);
+            out.add("npc", npc);
         },
         ConditionAst::UseItemOnItem { tool, target, .. } => {
-            out.get_mut("item").unwrap().insert(tool.clone());
-            out.get_mut("item").unwrap().insert(target.clone());
+            out.add("item", tool);
+            out.add("item", target);
         },
         ConditionAst::NpcDeath(npc) => {
-            out.get_mut("npc").unwrap().insert(npc.clone());
+            out.add("npc", npc);
         },
         ConditionAst::PlayerDeath => { /* no references */ },
         ConditionAst::ActOnItem { target, .. } => {
-            out.get_mut("item").unwrap().insert(target.clone());
+            out.add("item", target);
         },
         ConditionAst::TakeFromNpc { item, npc } => {
-            out.get_mut("item").unwrap().insert(item.clone());
-            out.get_mut("npc").unwrap().insert(npc.clone());
+            out.add("item", item);
+            out.add("npc", npc);
         },
         ConditionAst::TakeFromItem { loot, container } => {
-            out.get_mut("item").unwrap().insert(loot.clone());
-            out.get_mut("item").unwrap().insert(container.clone());
+            out.add("item", loot);
+            out.add("item", container);
         },
         ConditionAst::InsertItemInto { item, container } => {
-            out.get_mut("item").unwrap().insert(item.clone());
-            out.get_mut("item").unwrap().insert(container.clone());
+            out.add("item", item);
+            out.add("item", container);
         },
         ConditionAst::NpcHasItem { npc, item } => {
-            out.get_mut("npc").unwrap().insert(npc.clone());
-            out.get_mut("item").unwrap().insert(item.clone());
+            out.add("npc", npc);
+            out.add("item", item);
         },
         ConditionAst::NpcInState { npc, .. } => {
-            out.get_mut("npc").unwrap().insert(npc.clone());
+            out.add("npc", npc);
         },
         ConditionAst::ContainerHasItem { container, item } => {
-            out.get_mut("item").unwrap().insert(container.clone());
-            out.get_mut("item").unwrap().insert(item.clone());
+            out.add("item", container);
+            out.add("item", item);
         },
         ConditionAst::Ambient { spinner, rooms } => {
-            out.get_mut("spinner").unwrap().insert(spinner.clone());
+            out.add("spinner", spinner);
             if let Some(rs) = rooms {
                 for r in rs {
-                    out.get_mut("room").unwrap().insert(r.clone());
+                    out.add("room", r);
                 }
             }
         },
@@ -912,67 +1132,68 @@ fn gather_refs_from_condition(c: &ConditionAst, out: &mut HashMap<&'static str,
         | ConditionAst::HasFlag(f)
         | ConditionAst::FlagInProgress(f)
         | ConditionAst::FlagComplete(f) => {
-            out.get_mut("flag").unwrap().insert(f.clone());
+            out.add("flag", f);
         },
     }
 }
 
-fn gather_refs_from_action(stmt: &ActionStmt, out: &mut HashMap<&'static str, HashSet<String>>) {
+fn gather_refs_from_action(stmt: &ActionStmt, out: &mut FileRefs) {
+    out.at = stmt.span;
     match &stmt.action {
         ActionAst::ReplaceItem { old_sym, new_sym } | ActionAst::ReplaceDropItem { old_sym, new_sym } => {
-            out.get_mut("item").unwrap().insert(old_sym.clone());
-            out.get_mut("item").unwrap().insert(new_sym.clone());
+            out.add("item", old_sym);
+            out.add("item", new_sym);
         },
         ActionAst::SpawnItemIntoRoom { item, room } => {
-            out.get_mut("item").unwrap().insert(item.clone());
-            out.get_mut("room").unwrap().insert(room.clone());
+            out.add("item", item);
+            out.add("room", room);
         },
         ActionAst::DespawnItem(i)
         | ActionAst::LockItem(i)
         | ActionAst::UnlockItemAction(i)
         | ActionAst::SetItemMovability { item: i, .. } => {
-            out.get_mut("item").unwrap().insert(i.clone());
+            out.add("item", i);
         },
         ActionAst::PushPlayerTo(r) => {
-            out.get_mut("room").unwrap().insert(r.clone());
+            out.add("room", r);
         },
         ActionAst::GiveItemToPlayer { npc, item } => {
-            out.get_mut("npc").unwrap().insert(npc.clone());
-            out.get_mut("item").unwrap().insert(item.clone());
+            out.add("npc", npc);
+            out.add("item", item);
         },
         ActionAst::SpawnItemInInventory(i) | ActionAst::SpawnItemCurrentRoom(i) => {
-            out.get_mut("item").unwrap().insert(i.clone());
+            out.add("item", i);
         },
         ActionAst::SpawnItemInContainer { item, container } => {
-            out.get_mut("item").unwrap().insert(item.clone());
-            out.get_mut("item").unwrap().insert(container.clone());
+            out.add("item", item);
+            out.add("item", container);
         },
         ActionAst::SpawnNpcIntoRoom { npc, room } => {
-            out.get_mut("npc").unwrap().insert(npc.clone());
-            out.get_mut("room").unwrap().insert(room.clone());
+            out.add("npc", npc);
+            out.add("room", room);
         },
         ActionAst::SetItemDescription { item, .. } => {
-            out.get_mut("item").unwrap().insert(item.clone());
+            out.add("item", item);
         },
         ActionAst::NpcSays { npc, .. }
         | ActionAst::DespawnNpc(npc)
         | ActionAst::NpcSaysRandom { npc }
         | ActionAst::NpcRefuseItem { npc, .. }
         | ActionAst::SetNpcState { npc, .. } => {
-            out.get_mut("npc").unwrap().insert(npc.clone());
+            out.add("npc", npc);
         },
         ActionAst::SetContainerState { item, .. } => {
-            out.get_mut("item").unwrap().insert(item.clone());
+            out.add("item", item);
         },
         ActionAst::SpinnerMessage { spinner } | ActionAst::AddSpinnerWedge { spinner, .. } => {
-            out.get_mut("spinner").unwrap().insert(spinner.clone());
+            out.add("spinner", spinner);
         },
         ActionAst::SetBarredMessage { exit_from, exit_to, .. } | ActionAst::RevealExit { exit_from, exit_to, .. } => {
-            out.get_mut("room").unwrap().insert(exit_from.clone());
-            out.get_mut("room").unwrap().insert(exit_to.clone());
+            out.add("room", exit_from);
+            out.add("room", exit_to);
         },
         ActionAst::LockExit { from_room, .. } | ActionAst::UnlockExit { from_room, .. } => {
-            out.get_mut("room").unwrap().insert(from_room.clone());
+            out.add("room", from_room);
         },
         ActionAst::ScheduleIn { actions, .. } | ActionAst::ScheduleOn { actions, .. } => {
             for aa in actions {
@@ -985,77 +1206,74 @@ fn gather_refs_from_action(stmt: &ActionStmt, out: &mut HashMap<&'static str, Ha
                 gather_refs_from_action(aa, out);
             }
         },
+        ActionAst::Conditional {
+            condition,
+            actions,
+            false_actions,
+        } => {
+            gather_refs_from_condition(condition, out);
+            for aa in actions.iter().chain(false_actions.iter().flatten()) {
+                gather_refs_from_action(aa, out);
+            }
+        },
         ActionAst::ResetFlag(f) | ActionAst::AdvanceFlag(f) | ActionAst::RemoveFlag(f) => {
-            out.get_mut("flag").unwrap().insert(f.clone());
+            out.add("flag", f);
         },
         _ => {},
     }
 }
 
-fn gather_refs_from_room(r: &amble_script::RoomAst, out: &mut HashMap<&'static str, HashSet<String>>) {
+fn gather_refs_from_room(r: &amble_script::RoomAst, out: &mut FileRefs) {
     // Exits: target rooms
     for (_, ex) in &r.exits {
-        out.get_mut("room").unwrap().insert(ex.to.clone());
+        out.at = ex.span.into();
+        out.add("room", &ex.to);
         // required_items are item ids (string symbols)
         for it in &ex.required_items {
-            out.get_mut("item").unwrap().insert(it.clone());
+            out.add("item", it);
         }
         for fl in &ex.required_flags {
-            out.get_mut("flag").unwrap().insert(fl.clone());
+            out.add("flag", fl);
         }
     }
     // Overlays: collect referenced items/npcs/rooms
+    out.at = r.span.into();
     for ov in &r.overlays {
         for c in &ov.conditions {
             use amble_script::OverlayCondAst as O;
             match c {
                 O::ItemPresent(i) | O::ItemAbsent(i) | O::PlayerHasItem(i) | O::PlayerMissingItem(i) => {
-                    out.get_mut("item").unwrap().insert(i.clone());
+                    out.add("item", i);
                 },
                 O::NpcPresent(n) | O::NpcAbsent(n) | O::NpcInState { npc: n, .. } => {
-                    out.get_mut("npc").unwrap().insert(n.clone());
+                    out.add("npc", n);
                 },
                 O::ItemInRoom { item, room } => {
-                    out.get_mut("item").unwrap().insert(item.clone());
-                    out.get_mut("room").unwrap().insert(room.clone());
+                    out.add("item", item);
+                    out.add("room", room);
                 },
                 O::FlagSet(f) | O::FlagUnset(f) | O::FlagComplete(f) => {
-                    out.get_mut("flag").unwrap().insert(f.clone());
+                    out.add("flag", f);
                 },
             }
         }
     }
 }
 
-struct WorldRefs {
-    items: HashSet<String>,
-    rooms: HashSet<String>,
-    npcs: HashSet<String>,
-    spinners: HashSet<String>,
-    flags: HashSet<String>,
-    goals: HashSet<String>,
-}
-
-fn load_world_refs(dir: &str) -> Result<WorldRefs, String> {
-    let mut world = WorldRefs {
-        items: HashSet::new(),
-        rooms: HashSet::new(),
-        npcs: HashSet::new(),
-        spinners: HashSet::new(),
-        flags: HashSet::new(),
-        goals: HashSet::new(),
-    };
-
+/// Ids defined by the compiled `world.ron` in `dir`, for linting files that reference
+/// content outside the source tree being linted. A missing or unreadable file yields
+/// an empty table.
+fn load_world_refs(dir: &str) -> SymbolTable {
+    let mut world = SymbolTable::default();
     let world_path = format!("{dir}/world.ron");
-    let raw = match fs::read_to_string(&world_path) {
-        Ok(text) => text,
-        Err(_) => return Ok(world),
+    let Ok(raw) = fs::read_to_string(&world_path) else {
+        return world;
     };
     let def: amble_data::WorldDef = match ron::from_str(&raw) {
         Ok(def) => def,
         Err(err) => {
             eprintln!("lint: warning: failed to parse world.ron: {err}");
-            return Ok(world);
+            return world;
         },
     };
 
@@ -1067,8 +1285,7 @@ fn load_world_refs(dir: &str) -> Result<WorldRefs, String> {
     for trigger in &def.triggers {
         collect_flags_from_action_defs(&trigger.actions, &mut world.flags);
     }
-
-    Ok(world)
+    world
 }
 
 fn collect_flags_from_action_defs(actions: &[amble_data::ActionDef], out: &mut HashSet<String>) {
@@ -1144,12 +1361,76 @@ mod tests {
         .expect("write usage");
 
         let scope_files = lint_alias_scope_files(target.to_str().expect("utf-8 path"), false).expect("scope files");
-        let aliases = collect_global_condition_aliases(&scope_files, "lint-test").expect("resolve aliases");
-        let action_sets = collect_global_action_sets(&scope_files, &aliases, "lint-test").expect("resolve action sets");
-        let src = fs::read_to_string(&target).expect("read target");
-        parse_program_full_with_context(&src, &aliases, &action_sets)
-            .expect("single-file lint should parse with shared aliases");
+        let scope = compile_lint_scope(&scope_files, 2);
+        assert!(
+            scope.errors.is_empty(),
+            "single-file lint should parse with shared aliases: {:?}",
+            scope.errors
+        );
+        let idx = scope_files
+            .iter()
+            .position(|file| Path::new(file) == target)
+            .expect("target in scope");
+        let symbols = SymbolTable::from_bundles(scope.bundles.iter().flatten());
+        let bundle = scope.bundles[idx].as_ref().expect("target compiled");
+        let compiled: Vec<(&str, &str)> = scope
+            .compiled
+            .iter()
+            .map(|&i| (scope.sources[i].0.as_str(), scope.sources[i].1.as_str()))
+            .collect();
+        let (missing, report) = lint_one_file(&scope_files[idx], &scope.sources[idx].1, bundle, &symbols, &compiled);
+        // hint_radio and hint-radio-on are defined nowhere in this project
+        assert_eq!(missing, 2, "{report}");
+        assert!(report.contains("unknown item 'hint_radio'"), "{report}");
+
+        fs::remove_dir_all(root).expect("remove temp dir");
+    }
+
+    #[test]
+    fn lint_scope_reports_parse_errors_per_file_and_keeps_the_rest() {
+        let root = make_temp_dir("lint-parse-error");
+        let good = root.join("good.amble");
+        let broken = root.join("broken.amble");
+        fs::write(&good, "room cellar {\n  name \"Cellar\"\n  desc \"Damp.\"\n}\n").expect("write good");
+        fs::write(&broken, "room hall {\n  name \"Hall\"\n").expect("write broken");
+
+        let scope_files = lint_alias_scope_files(root.to_str().expect("utf-8 path"), true).expect("scope files");
+        let scope = compile_lint_scope(&scope_files, 2);
+        assert_eq!(scope.errors.len(), 1, "{:?}", scope.errors);
+        assert!(scope.errors[0].contains("broken.amble"), "{:?}", scope.errors);
+        for (idx, file) in scope_files.iter().enumerate() {
+            assert_eq!(scope.bundles[idx].is_some(), Path::new(file) == good, "{file}");
+        }
 
         fs::remove_dir_all(root).expect("remove temp dir");
     }
+
+    #[test]
+    fn missing_reference_in_an_action_set_points_at_its_declaring_file() {
+        let shared = "let actions tidy = {\n  do despawn item lanturn\n}\n";
+        let hall = "room hall {\n  name \"Hall\"\n  desc \"A hall.\"\n}\n\ntrigger \"tidy\" when enter room hall {\n  run tidy\n  do push player to celar\n}\n";
+        let sources = [("shared.amble", shared), ("hall.amble", hall)];
+        let bundles = compile_sources(&sources, 1).expect("compiles");
+        let symbols = SymbolTable::from_bundles(&bundles);
+        let (missing, report) = lint_one_file("hall.amble", hall, &bundles[1], &symbols, &sources);
+        assert_eq!(missing, 2, "{report}");
+        assert!(
+            report.contains("shared.amble:2:3: unknown item 'lanturn'\n  do despawn item lanturn\n  ^\n  note: inlined into 'hall.amble' by `run`"),
+            "{report}"
+        );
+        assert!(report.contains("hall.amble:8:3: unknown room 'celar'"), "{report}");
+    }
+
+    #[test]
+    fn missing_room_exit_points_at_its_exit_statement() {
+        let src = "room cellar {\n  name \"Cellar\"\n  desc \"Damp.\"\n}\n\nroom hall {\n  name \"Hall\"\n  desc \"A hall.\"\n  exit down -> celar\n}\n";
+        let bundle = parse_program_full(src).expect("parse");
+        let symbols = SymbolTable::from_bundles([&bundle]);
+        let (missing, report) = lint_one_file("rooms.amble", src, &bundle, &symbols, &[]);
+        assert_eq!(missing, 1);
+        assert!(
+            report.starts_with("rooms.amble:9:3: unknown room 'celar' (did you mean: cellar?)"),
+            "{report}"
+        );
+    }
 }
@@ -1,10 +1,10 @@
 use std::collections::HashMap;
 
+use crate::span::LineIndex;
 use crate::{ActionSetSpec, ActionStmt, ConditionAst};
 
 use super::AstError;
 use super::actions::parse_actions_from_body;
-use super::helpers::SourceMap;
 
 pub(super) fn resolve_action_sets(
     specs: &[ActionSetSpec],
@@ -69,7 +69,7 @@ impl ActionSetResolver<'_> {
 
         self.visiting.push(name.to_string());
         let parsed = {
-            let smap = SourceMap::new(&spec.text);
+            let smap = LineIndex::excerpt(&spec.text, spec.file, spec.offset);
             let cond_aliases = self.cond_aliases;
             let mut lookup = |candidate: &str| self.resolve_action_set(candidate);
             parse_actions_from_body(&spec.text, &spec.text, &smap, &spec.sets, cond_aliases, &mut lookup)?
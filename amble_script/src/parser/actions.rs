@@ -3,6 +3,7 @@ use std::collections::HashMap;
 
 use pest::Parser;
 
+use crate::span::{LineIndex, SourceSpan};
 use crate::{
     ActionAst, ActionStmt, ConditionAst, ContainerStateAst, ItemAbilityAst, ItemPatchAst, NpcDialoguePatchAst,
     NpcMovementPatchAst, NpcPatchAst, NpcStateValue, NpcTimingPatchAst, OnFalseAst, RoomExitPatchAst, RoomPatchAst,
@@ -10,7 +11,7 @@ use crate::{
 
 use super::conditions::parse_condition_text;
 use super::helpers::{
-    SourceMap, extract_body, extract_note, is_ident_char, parse_movability_opt, parse_string_at, str_offset, unquote,
+    extract_body, extract_note, is_ident_char, parse_movability_opt, parse_string_at, str_offset, unquote,
 };
 use super::{AstError, DslParser, Rule};
 
@@ -719,11 +720,11 @@ fn parse_amount_turns_and_cause(rest: &str, label: &str) -> Result<(u32, Option<
     Ok((amount, turns, cause))
 }
 
-fn shape_at(msg: &'static str, source: &str, smap: &SourceMap, body: &str, offset: usize) -> AstError {
+fn shape_at(msg: &'static str, source: &str, smap: &LineIndex<'_>, body: &str, offset: usize) -> AstError {
     let base = str_offset(source, body);
     let abs = base + offset;
     let (line_no, col) = smap.line_col(abs);
-    let snippet = smap.line_snippet(line_no);
+    let snippet = smap.line(line_no);
     AstError::ShapeAt {
         msg,
         context: format!(
@@ -733,11 +734,11 @@ fn shape_at(msg: &'static str, source: &str, smap: &SourceMap, body: &str, offse
     }
 }
 
-fn shape_at_condition(msg: &'static str, source: &str, smap: &SourceMap, body: &str, cond_text: &str) -> AstError {
+fn shape_at_condition(msg: &'static str, source: &str, smap: &LineIndex<'_>, body: &str, cond_text: &str) -> AstError {
     let base = str_offset(source, body);
     let cond_abs = base + (cond_text.as_ptr() as usize - body.as_ptr() as usize);
     let (line_no, col) = smap.line_col(cond_abs);
-    let snippet = smap.line_snippet(line_no);
+    let snippet = smap.line(line_no);
     AstError::ShapeAt {
         msg,
         context: format!(
@@ -771,7 +772,7 @@ pub(super) fn parse_if_action(
     body: &str,
     start: usize,
     source: &str,
-    smap: &SourceMap,
+    smap: &LineIndex<'_>,
     sets: &HashMap<String, Vec<String>>,
     aliases: &HashMap<String, ConditionAst>,
     resolve_action_set: &mut dyn FnMut(&str) -> Result<Option<Vec<ActionStmt>>, AstError>,
@@ -829,7 +830,7 @@ pub(super) fn parse_if_action(
 fn parse_modify_action(
     remainder: &str,
     source: &str,
-    smap: &SourceMap,
+    smap: &LineIndex<'_>,
     body: &str,
     offset: usize,
     sets: &HashMap<String, Vec<String>>,
@@ -859,7 +860,7 @@ fn parse_modify_action(
 fn parse_schedule_action_line(
     remainder: &str,
     source: &str,
-    smap: &SourceMap,
+    smap: &LineIndex<'_>,
     sets: &HashMap<String, Vec<String>>,
     aliases: &HashMap<String, ConditionAst>,
     resolve_action_set: &mut dyn FnMut(&str) -> Result<Option<Vec<ActionStmt>>, AstError>,
@@ -876,7 +877,7 @@ fn parse_run_line(
     body: &str,
     start: usize,
     source: &str,
-    smap: &SourceMap,
+    smap: &LineIndex<'_>,
     resolve_action_set: &mut dyn FnMut(&str) -> Result<Option<Vec<ActionStmt>>, AstError>,
 ) -> Result<Option<(Vec<ActionStmt>, usize)>, AstError> {
     let remainder = &body[start..];
@@ -918,7 +919,7 @@ fn parse_do_line(
     body: &str,
     start: usize,
     source: &str,
-    smap: &SourceMap,
+    smap: &LineIndex<'_>,
 ) -> Result<Option<(ActionStmt, usize)>, AstError> {
     let remainder = &body[start..];
     if !remainder.trim_start().starts_with("do ") {
@@ -940,12 +941,14 @@ fn parse_do_line(
 pub(super) fn parse_actions_from_body(
     body: &str,
     source: &str,
-    smap: &SourceMap,
+    smap: &LineIndex<'_>,
     sets: &HashMap<String, Vec<String>>,
     aliases: &HashMap<String, ConditionAst>,
     resolve_action_set: &mut dyn FnMut(&str) -> Result<Option<Vec<ActionStmt>>, AstError>,
 ) -> Result<Vec<ActionStmt>, AstError> {
     let mut out = Vec::new();
+    let base = str_offset(source, body);
+    let span_of = |start: usize, end: usize| smap.source_span(base + start, base + end);
     let mut i = 0usize;
     while i < body.len() {
         i = skip_ws_and_comments(body, i);
@@ -953,30 +956,31 @@ pub(super) fn parse_actions_from_body(
             break;
         }
         if let Some((action, new_i)) = parse_if_action(body, i, source, smap, sets, aliases, resolve_action_set)? {
-            out.push(action);
+            out.push(action.at(span_of(i, new_i)));
             i = new_i;
             continue;
         }
         let remainder = &body[i..];
         if let Some((action, new_i)) = parse_modify_action(remainder, source, smap, body, i, sets, aliases)? {
-            out.push(action);
+            out.push(action.at(span_of(i, new_i)));
             i = new_i;
             continue;
         }
         if let Some((action, new_i)) =
             parse_schedule_action_line(remainder, source, smap, sets, aliases, resolve_action_set, i)?
         {
-            out.push(action);
+            out.push(action.at(span_of(i, new_i)));
             i = new_i;
             continue;
         }
+        // Statements from an action set keep the spans they were declared with.
         if let Some((actions, new_i)) = parse_run_line(body, i, source, smap, resolve_action_set)? {
             out.extend(actions);
             i = new_i;
             continue;
         }
         if let Some((action, new_i)) = parse_do_line(body, i, source, smap)? {
-            out.push(action);
+            out.push(action.at(span_of(i, new_i)));
             i = new_i;
             continue;
         }
@@ -1166,6 +1170,7 @@ pub(super) fn parse_modify_item_action(
         ActionStmt {
             priority,
             action: ActionAst::ModifyItem { item, patch },
+            span: SourceSpan::default(),
         },
         consumed,
     ))
@@ -1245,6 +1250,7 @@ pub(super) fn parse_modify_room_action(text: &str) -> Result<(ActionStmt, usize)
         ActionStmt {
             priority,
             action: ActionAst::ModifyRoom { room, patch },
+            span: SourceSpan::default(),
         },
         consumed,
     ))
@@ -1385,6 +1391,7 @@ pub(super) fn parse_modify_npc_action(text: &str) -> Result<(ActionStmt, usize),
         ActionStmt {
             priority,
             action: ActionAst::ModifyNpc { npc, patch },
+            span: SourceSpan::default(),
         },
         consumed,
     ))
@@ -1605,7 +1612,7 @@ fn find_schedule_block(rest1: &str, brace_pos: usize) -> Result<(usize, &str), A
 pub(super) fn parse_schedule_action(
     text: &str,
     source: &str,
-    smap: &SourceMap,
+    smap: &LineIndex<'_>,
     sets: &HashMap<String, Vec<String>>,
     aliases: &HashMap<String, ConditionAst>,
     resolve_action_set: &mut dyn FnMut(&str) -> Result<Option<Vec<ActionStmt>>, AstError>,
@@ -1646,6 +1653,7 @@ pub(super) fn parse_schedule_action(
         ActionStmt {
             priority: header.priority,
             action: act,
+            span: SourceSpan::default(),
         },
         consumed,
     ))
@@ -1682,5 +1690,9 @@ pub(super) fn parse_action_from_str(text: &str) -> Result<ActionStmt, AstError>
         Cow::Borrowed(trimmed)
     };
     let action = parse_action_core(&source)?;
-    Ok(ActionStmt { priority, action })
+    Ok(ActionStmt {
+        priority,
+        action,
+        span: SourceSpan::default(),
+    })
 }
@@ -1,10 +1,12 @@
+use crate::span::{LineIndex, Span};
 use crate::{GoalAst, GoalCondAst, GoalGroupAst};
 
 use super::helpers::unquote;
 use super::{AstError, Rule};
 
-pub(super) fn parse_goal_pair(goal: pest::iterators::Pair<Rule>, _source: &str) -> Result<GoalAst, AstError> {
-    let (src_line, _src_col) = goal.as_span().start_pos().line_col();
+pub(super) fn parse_goal_pair(goal: pest::iterators::Pair<Rule>, lines: &LineIndex<'_>) -> Result<GoalAst, AstError> {
+    let span = Span::from(goal.as_span());
+    let src_line = lines.line_col(span.start()).0;
     let mut it = goal.into_inner();
     let id = it.next().ok_or(AstError::Shape("goal id"))?.as_str().to_string();
     let block = it.next().ok_or(AstError::Shape("goal block"))?;
@@ -61,6 +63,7 @@ pub(super) fn parse_goal_pair(goal: pest::iterators::Pair<Rule>, _source: &str)
         failed_when,
         finished_when,
         src_line,
+        span,
     })
 }
 
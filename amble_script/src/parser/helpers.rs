@@ -267,39 +267,6 @@ pub(super) fn strip_leading_ws_and_comments(s: &str) -> &str {
     }
     &s[i..]
 }
-pub(super) struct SourceMap {
-    line_starts: Vec<usize>,
-    src: String,
-}
-impl SourceMap {
-    pub(super) fn new(source: &str) -> Self {
-        let mut starts = vec![0usize];
-        for (i, ch) in source.char_indices() {
-            if ch == '\n' {
-                starts.push(i + 1);
-            }
-        }
-        Self {
-            line_starts: starts,
-            src: source.to_string(),
-        }
-    }
-    pub(super) fn line_col(&self, offset: usize) -> (usize, usize) {
-        let idx = match self.line_starts.binary_search(&offset) {
-            Ok(i) => i,
-            Err(i) => i.saturating_sub(1),
-        };
-        let line_start = *self.line_starts.get(idx).unwrap_or(&0);
-        let line_no = idx + 1;
-        let col = offset.saturating_sub(line_start) + 1;
-        (line_no, col)
-    }
-    pub(super) fn line_snippet(&self, line_no: usize) -> String {
-        let start = *self.line_starts.get(line_no - 1).unwrap_or(&0);
-        let end = *self.line_starts.get(line_no).unwrap_or(&self.src.len());
-        self.src[start..end].trim_end_matches(['\r', '\n']).to_string()
-    }
-}
 pub(super) fn str_offset(full: &str, slice: &str) -> usize {
     (slice.as_ptr() as usize) - (full.as_ptr() as usize)
 }
@@ -1,5 +1,6 @@
 use std::collections::HashMap;
 
+use crate::span::{LineIndex, Span};
 use crate::{
     ConditionAst, ConsumableAst, ConsumableWhenAst, ContainerStateAst, ItemAbilityAst, ItemAst, ItemLocationAst,
     ItemVisibilityAst, MovabilityAst,
@@ -11,11 +12,12 @@ use super::{AstError, Rule};
 
 pub(super) fn parse_item_pair(
     item: pest::iterators::Pair<Rule>,
-    _source: &str,
+    lines: &LineIndex<'_>,
     sets: &HashMap<String, Vec<String>>,
     aliases: &HashMap<String, ConditionAst>,
 ) -> Result<ItemAst, AstError> {
-    let (src_line, _src_col) = item.as_span().start_pos().line_col();
+    let span = Span::from(item.as_span());
+    let src_line = lines.line_col(span.start()).0;
     let mut it = item.into_inner();
     let id = it
         .next()
@@ -267,5 +269,6 @@ pub(super) fn parse_item_pair(
         interaction_requires: requires,
         consumable,
         src_line,
+        span,
     })
 }
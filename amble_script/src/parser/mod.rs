@@ -4,10 +4,12 @@
 //! compiler's abstract syntax tree for triggers, rooms, items, and more.
 
 use pest::Parser;
+use pest::iterators::Pair;
 use pest_derive::Parser as PestParser;
 
 use std::collections::HashMap;
 
+use crate::span::LineIndex;
 use crate::{ActionSetSpec, ConditionAliasSpec, GoalAst, ItemAst, NpcAst, RoomAst, SpinnerAst, TriggerAst};
 
 mod action_sets;
@@ -33,7 +35,6 @@ use conditions::{
 };
 use game::parse_game_pair;
 use goal::parse_goal_pair;
-use helpers::SourceMap;
 use item::parse_item_pair;
 use npc::parse_npc_pair;
 use room::parse_room_pair;
@@ -111,90 +112,165 @@ pub fn parse_program_full_with_context(
     aliases: &HashMap<String, crate::ConditionAst>,
     action_sets: &HashMap<String, Vec<crate::ActionStmt>>,
 ) -> Result<ProgramAstBundle, AstError> {
-    let mut pairs = DslParser::parse(Rule::program, source).map_err(|e| AstError::Pest(e.to_string()))?;
-    let pair = pairs.next().ok_or(AstError::Shape("expected program"))?;
-    let smap = SourceMap::new(source);
-    let (sets, local_alias_specs, local_action_set_specs) = collect_sets_and_specs(&pair)?;
-    let local_aliases = resolve_condition_aliases_with_base_impl(&local_alias_specs, aliases)?;
-    let mut merged_aliases = aliases.clone();
-    merged_aliases.extend(local_aliases);
-    let local_action_sets =
-        action_sets::resolve_action_sets_with_base(&local_action_set_specs, &merged_aliases, action_sets)?;
-    let mut merged_action_sets = action_sets.clone();
-    merged_action_sets.extend(local_action_sets);
-    let mut game_pair = None;
-    let mut trigger_pairs = Vec::new();
-    let mut room_pairs = Vec::new();
-    let mut item_pairs = Vec::new();
-    let mut spinner_pairs = Vec::new();
-    let mut npc_pairs = Vec::new();
-    let mut goal_pairs = Vec::new();
-    for item in pair.clone().into_inner() {
-        match item.as_rule() {
-            Rule::set_decl | Rule::cond_decl | Rule::action_set_decl => {},
-            Rule::game_def => {
-                if game_pair.is_some() {
-                    return Err(AstError::Shape("multiple game blocks"));
-                }
-                game_pair = Some(item);
-            },
-            Rule::trigger => {
-                trigger_pairs.push(item);
-            },
-            Rule::room_def => {
-                room_pairs.push(item);
-            },
-            Rule::item_def => {
-                item_pairs.push(item);
-            },
-            Rule::spinner_def => {
-                spinner_pairs.push(item);
-            },
-            Rule::npc_def => {
-                npc_pairs.push(item);
-            },
-            Rule::goal_def => {
-                goal_pairs.push(item);
-            },
-            _ => {},
-        }
-    }
-    let mut triggers = Vec::new();
-    for trig in trigger_pairs {
-        let mut ts = parse_trigger_pair(trig, source, &smap, &sets, &merged_aliases, &merged_action_sets)?;
-        triggers.append(&mut ts);
-    }
-    let mut rooms = Vec::new();
-    for rp in room_pairs {
-        let r = parse_room_pair(rp, source)?;
-        rooms.push(r);
+    ParsedProgram::parse(source)?.lower(aliases, action_sets)
+}
+
+/// A source file parsed once by the grammar, retained so that its shared
+/// definitions can be collected and its contents lowered to ASTs later without
+/// parsing the file again.
+///
+/// Multi-file callers parse every file, gather [`condition_alias_specs`](Self::condition_alias_specs)
+/// and [`action_set_specs`](Self::action_set_specs) from all of them, resolve those
+/// once, and then lower each program with the resolved maps.
+#[derive(Debug, Clone)]
+pub struct ParsedProgram<'a> {
+    source: &'a str,
+    program: Pair<'a, Rule>,
+    sets: HashMap<String, Vec<String>>,
+    alias_specs: Vec<ConditionAliasSpec>,
+    action_set_specs: Vec<ActionSetSpec>,
+}
+
+impl<'a> ParsedProgram<'a> {
+    /// Parse `source` with the DSL grammar and collect its top-level declarations.
+    ///
+    /// # Errors
+    /// Returns an error if the source cannot be parsed as a program.
+    pub fn parse(source: &'a str) -> Result<Self, AstError> {
+        let mut pairs = DslParser::parse(Rule::program, source).map_err(|e| AstError::Pest(e.to_string()))?;
+        let program = pairs.next().ok_or(AstError::Shape("expected program"))?;
+        let (sets, alias_specs, action_set_specs) = collect_sets_and_specs(&program)?;
+        Ok(Self {
+            source,
+            program,
+            sets,
+            alias_specs,
+            action_set_specs,
+        })
     }
-    let mut items = Vec::new();
-    for ip in item_pairs {
-        let it = parse_item_pair(ip, source, &sets, &merged_aliases)?;
-        items.push(it);
+
+    /// Top-level `let cond` declarations in this program.
+    pub fn condition_alias_specs(&self) -> &[ConditionAliasSpec] {
+        &self.alias_specs
     }
-    let mut spinners = Vec::new();
-    for sp in spinner_pairs {
-        let s = parse_spinner_pair(sp, source)?;
-        spinners.push(s);
+
+    /// Top-level `let actions` declarations in this program.
+    pub fn action_set_specs(&self) -> &[ActionSetSpec] {
+        &self.action_set_specs
     }
-    let mut npcs = Vec::new();
-    for np in npc_pairs {
-        let n = parse_npc_pair(np, source)?;
-        npcs.push(n);
+
+    /// Lower the program to ASTs, resolving its own aliases and action sets on top
+    /// of the caller-provided ones (local definitions take precedence).
+    ///
+    /// # Errors
+    /// Returns an error when a local definition cannot be resolved or the grammar
+    /// encounters an unexpected shape.
+    pub fn lower(
+        &self,
+        aliases: &HashMap<String, crate::ConditionAst>,
+        action_sets: &HashMap<String, Vec<crate::ActionStmt>>,
+    ) -> Result<ProgramAstBundle, AstError> {
+        let local_aliases = resolve_condition_aliases_with_base_impl(&self.alias_specs, aliases)?;
+        let mut merged_aliases = aliases.clone();
+        merged_aliases.extend(local_aliases);
+        let local_action_sets =
+            action_sets::resolve_action_sets_with_base(&self.action_set_specs, &merged_aliases, action_sets)?;
+        let mut merged_action_sets = action_sets.clone();
+        merged_action_sets.extend(local_action_sets);
+        self.lower_resolved(&merged_aliases, &merged_action_sets)
     }
-    let mut goals = Vec::new();
-    for gp in goal_pairs {
-        let g = parse_goal_pair(gp, source)?;
-        goals.push(g);
+
+    /// Lower the program to ASTs using already-resolved aliases and action sets.
+    ///
+    /// The maps must already include this program's own definitions, as they do
+    /// when resolved from the specs of every program in a multi-file build; they
+    /// are used as-is, without re-resolving or copying them.
+    ///
+    /// # Errors
+    /// Returns an error when the grammar encounters an unexpected shape or a
+    /// reference cannot be resolved.
+    pub fn lower_resolved(
+        &self,
+        aliases: &HashMap<String, crate::ConditionAst>,
+        action_sets: &HashMap<String, Vec<crate::ActionStmt>>,
+    ) -> Result<ProgramAstBundle, AstError> {
+        let source = self.source;
+        let sets = &self.sets;
+        let smap = LineIndex::new(source);
+        let mut game_pair = None;
+        let mut trigger_pairs = Vec::new();
+        let mut room_pairs = Vec::new();
+        let mut item_pairs = Vec::new();
+        let mut spinner_pairs = Vec::new();
+        let mut npc_pairs = Vec::new();
+        let mut goal_pairs = Vec::new();
+        for item in self.program.clone().into_inner() {
+            match item.as_rule() {
+                Rule::set_decl | Rule::cond_decl | Rule::action_set_decl => {},
+                Rule::game_def => {
+                    if game_pair.is_some() {
+                        return Err(AstError::Shape("multiple game blocks"));
+                    }
+                    game_pair = Some(item);
+                },
+                Rule::trigger => {
+                    trigger_pairs.push(item);
+                },
+                Rule::room_def => {
+                    room_pairs.push(item);
+                },
+                Rule::item_def => {
+                    item_pairs.push(item);
+                },
+                Rule::spinner_def => {
+                    spinner_pairs.push(item);
+                },
+                Rule::npc_def => {
+                    npc_pairs.push(item);
+                },
+                Rule::goal_def => {
+                    goal_pairs.push(item);
+                },
+                _ => {},
+            }
+        }
+        let mut triggers = Vec::new();
+        for trig in trigger_pairs {
+            let mut ts = parse_trigger_pair(trig, source, &smap, sets, aliases, action_sets)?;
+            triggers.append(&mut ts);
+        }
+        let mut rooms = Vec::new();
+        for rp in room_pairs {
+            let r = parse_room_pair(rp, &smap)?;
+            rooms.push(r);
+        }
+        let mut items = Vec::new();
+        for ip in item_pairs {
+            let it = parse_item_pair(ip, &smap, sets, aliases)?;
+            items.push(it);
+        }
+        let mut spinners = Vec::new();
+        for sp in spinner_pairs {
+            let s = parse_spinner_pair(sp, &smap)?;
+            spinners.push(s);
+        }
+        let mut npcs = Vec::new();
+        for np in npc_pairs {
+            let n = parse_npc_pair(np, &smap)?;
+            npcs.push(n);
+        }
+        let mut goals = Vec::new();
+        for gp in goal_pairs {
+            let g = parse_goal_pair(gp, &smap)?;
+            goals.push(g);
+        }
+        let game = if let Some(gp) = game_pair {
+            Some(parse_game_pair(gp, source)?)
+        } else {
+            None
+        };
+        Ok((game, triggers, rooms, items, spinners, npcs, goals))
     }
-    let game = if let Some(gp) = game_pair {
-        Some(parse_game_pair(gp, source)?)
-    } else {
-        None
-    };
-    Ok((game, triggers, rooms, items, spinners, npcs, goals))
 }
 
 /// Collect top-level condition alias definitions from a source file.
@@ -205,10 +281,7 @@ pub fn parse_program_full_with_context(
 /// # Errors
 /// Returns an error if the source cannot be parsed as a program.
 pub fn collect_condition_alias_specs(source: &str) -> Result<Vec<ConditionAliasSpec>, AstError> {
-    let mut pairs = DslParser::parse(Rule::program, source).map_err(|e| AstError::Pest(e.to_string()))?;
-    let pair = pairs.next().ok_or(AstError::Shape("expected program"))?;
-    let (_, specs, _) = collect_sets_and_specs(&pair)?;
-    Ok(specs)
+    Ok(ParsedProgram::parse(source)?.alias_specs)
 }
 
 /// Collect top-level action set definitions from a source file.
@@ -220,10 +293,7 @@ pub fn collect_condition_alias_specs(source: &str) -> Result<Vec<ConditionAliasS
 /// # Errors
 /// Returns an error if the source cannot be parsed as a program.
 pub fn collect_action_set_specs(source: &str) -> Result<Vec<ActionSetSpec>, AstError> {
-    let mut pairs = DslParser::parse(Rule::program, source).map_err(|e| AstError::Pest(e.to_string()))?;
-    let pair = pairs.next().ok_or(AstError::Shape("expected program"))?;
-    let (_, _, specs) = collect_sets_and_specs(&pair)?;
-    Ok(specs)
+    Ok(ParsedProgram::parse(source)?.action_set_specs)
 }
 
 /// Resolve collected condition alias specs into reusable condition ASTs.
@@ -245,7 +315,7 @@ pub fn resolve_action_sets(
 }
 
 fn collect_sets_and_specs(
-    pair: &pest::iterators::Pair<'_, Rule>,
+    pair: &Pair<'_, Rule>,
 ) -> Result<
     (
         HashMap<String, Vec<String>>,
@@ -307,11 +377,13 @@ fn collect_sets_and_specs(
             .as_str()
             .to_string();
         let block = it.next().ok_or(AstError::Shape("action set block"))?;
-        let body = helpers::extract_body(block.as_str())?.to_string();
+        let body = helpers::extract_body(block.as_str())?;
         action_set_specs.push(ActionSetSpec {
             name,
-            text: body,
+            text: body.to_string(),
             sets: sets.clone(),
+            file: None,
+            offset: block.as_span().start() + helpers::str_offset(block.as_str(), body),
         });
     }
 
@@ -384,6 +456,11 @@ mod tests {
         ActionAst, ActionStmt, ConditionAst, ContainerStateAst, MovabilityAst, NpcStateValue, NpcTimingPatchAst,
     };
 
+    /// The actions of `stmts`, ignoring priorities and spans.
+    fn actions_of(stmts: &[ActionStmt]) -> Vec<&ActionAst> {
+        stmts.iter().map(|stmt| &stmt.action).collect()
+    }
+
     #[test]
     fn game_block_parses() {
         let src = r#"
@@ -993,6 +1070,45 @@ trigger "Radio Hint" when always {
         );
     }
 
+    #[test]
+    fn parsed_programs_lower_with_globally_resolved_definitions() {
+        let defs = r#"
+let cond radio_ready = has flag radio-on
+let actions announce = {
+  do show "Ready."
+}
+"#;
+        let usage = r#"
+trigger "Radio Hint" when always {
+  if radio_ready {
+    run announce
+  }
+}
+"#;
+        let programs = [
+            super::ParsedProgram::parse(defs).expect("parse defs"),
+            super::ParsedProgram::parse(usage).expect("parse usage"),
+        ];
+        let alias_specs: Vec<_> = programs
+            .iter()
+            .flat_map(|p| p.condition_alias_specs().iter().cloned())
+            .collect();
+        let set_specs: Vec<_> = programs
+            .iter()
+            .flat_map(|p| p.action_set_specs().iter().cloned())
+            .collect();
+        let aliases = super::resolve_condition_aliases(&alias_specs).expect("resolve aliases");
+        let action_sets = super::resolve_action_sets(&set_specs, &aliases).expect("resolve action sets");
+
+        let (_game, lowered, ..) = programs[1]
+            .lower_resolved(&aliases, &action_sets)
+            .expect("lowering succeeds");
+        let (_game, reparsed, ..) =
+            super::parse_program_full_with_context(usage, &aliases, &action_sets).expect("context parse succeeds");
+        assert_eq!(lowered, reparsed);
+        assert_eq!(lowered[0].conditions, vec![ConditionAst::HasFlag("radio-on".into())]);
+    }
+
     #[test]
     fn parse_program_full_with_aliases_merges_local_aliases() {
         let defs = r#"
@@ -1064,14 +1180,8 @@ trigger "Radio Hint" when always {
 
         assert_eq!(triggers.len(), 1);
         assert_eq!(triggers[0].actions.len(), 2);
-        assert_eq!(
-            triggers[0].actions[0],
-            ActionStmt::new(ActionAst::AddFlag("radio-ready".into()))
-        );
-        assert_eq!(
-            triggers[0].actions[1],
-            ActionStmt::new(ActionAst::Show("Ready.".into()))
-        );
+        assert_eq!(triggers[0].actions[0].action, ActionAst::AddFlag("radio-ready".into()));
+        assert_eq!(triggers[0].actions[1].action, ActionAst::Show("Ready.".into()));
     }
 
     #[test]
@@ -1096,8 +1206,8 @@ trigger "Radio Hint" when always {
             .expect("cross-file action set parse succeeds");
 
         assert_eq!(
-            triggers[0].actions,
-            vec![ActionStmt::new(ActionAst::AddFlag("radio-ready".into()))]
+            actions_of(&triggers[0].actions),
+            [&ActionAst::AddFlag("radio-ready".into())]
         );
     }
 
@@ -1129,10 +1239,7 @@ trigger "Radio Hint" when always {
                 false_actions,
             } => {
                 assert_eq!(**condition, ConditionAst::HasFlag("radio-on".into()));
-                assert_eq!(
-                    actions,
-                    &vec![ActionStmt::new(ActionAst::AddFlag("nested-ready".into()))]
-                );
+                assert_eq!(actions_of(actions), [&ActionAst::AddFlag("nested-ready".into())]);
                 assert_eq!(false_actions, &None);
             },
             other => panic!("expected conditional action, got {other:?}"),
@@ -1153,14 +1260,11 @@ trigger "Radio Hint" when always {
 
         assert_eq!(triggers.len(), 2);
         assert_eq!(triggers[0].conditions, vec![ConditionAst::HasFlag("radio-on".into())]);
-        assert_eq!(
-            triggers[0].actions,
-            vec![ActionStmt::new(ActionAst::Show("Ready.".into()))]
-        );
+        assert_eq!(actions_of(&triggers[0].actions), [&ActionAst::Show("Ready.".into())]);
         assert!(triggers[1].conditions.is_empty());
         assert_eq!(
-            triggers[1].actions,
-            vec![ActionStmt::new(ActionAst::AddFlag("radio-ready".into()))]
+            actions_of(&triggers[1].actions),
+            [&ActionAst::AddFlag("radio-ready".into())]
         );
     }
 
@@ -1187,10 +1291,10 @@ trigger "Radio Hint" when always {
                 false_actions,
             } => {
                 assert_eq!(**condition, ConditionAst::HasFlag("radio-on".into()));
-                assert_eq!(actions, &vec![ActionStmt::new(ActionAst::Show("Ready.".into()))]);
+                assert_eq!(actions_of(actions), [&ActionAst::Show("Ready.".into())]);
                 assert_eq!(
-                    false_actions,
-                    &Some(vec![ActionStmt::new(ActionAst::Show("Not ready.".into()))])
+                    false_actions.as_deref().map(actions_of),
+                    Some(vec![&ActionAst::Show("Not ready.".into())])
                 );
             },
             other => panic!("expected conditional action, got {other:?}"),
@@ -1224,7 +1328,7 @@ trigger "Radio Hint" when always {
                 false_actions: Some(false_actions),
             } => {
                 assert_eq!(**condition, ConditionAst::HasFlag("radio-on".into()));
-                assert_eq!(actions, &vec![ActionStmt::new(ActionAst::AddFlag("first-path".into()))]);
+                assert_eq!(actions_of(actions), [&ActionAst::AddFlag("first-path".into())]);
                 assert_eq!(false_actions.len(), 1);
                 match &false_actions[0].action {
                     ActionAst::Conditional {
@@ -1233,14 +1337,8 @@ trigger "Radio Hint" when always {
                         false_actions: Some(false_actions),
                     } => {
                         assert_eq!(**condition, ConditionAst::HasItem("hint_radio".into()));
-                        assert_eq!(
-                            actions,
-                            &vec![ActionStmt::new(ActionAst::AddFlag("second-path".into()))]
-                        );
-                        assert_eq!(
-                            false_actions,
-                            &vec![ActionStmt::new(ActionAst::AddFlag("third-path".into()))]
-                        );
+                        assert_eq!(actions_of(actions), [&ActionAst::AddFlag("second-path".into())]);
+                        assert_eq!(actions_of(false_actions), [&ActionAst::AddFlag("third-path".into())]);
                     },
                     other => panic!("expected nested conditional action, got {other:?}"),
                 }
@@ -1276,10 +1374,10 @@ trigger "Radio Hint" when always {
             .expect("local action sets should merge");
 
         assert_eq!(
-            triggers[0].actions,
-            vec![
-                ActionStmt::new(ActionAst::AddFlag("radio-ready".into())),
-                ActionStmt::new(ActionAst::Show("Need a hint.".into())),
+            actions_of(&triggers[0].actions),
+            [
+                &ActionAst::AddFlag("radio-ready".into()),
+                &ActionAst::Show("Need a hint.".into()),
             ]
         );
     }
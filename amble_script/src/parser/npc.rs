@@ -1,10 +1,12 @@
+use crate::span::{LineIndex, Span};
 use crate::{NpcAst, NpcMovementAst, NpcMovementTypeAst, NpcStateValue};
 
 use super::helpers::{parse_string_at, unquote};
 use super::{AstError, Rule};
 
-pub(super) fn parse_npc_pair(npc: pest::iterators::Pair<Rule>, _source: &str) -> Result<NpcAst, AstError> {
-    let (src_line, _src_col) = npc.as_span().start_pos().line_col();
+pub(super) fn parse_npc_pair(npc: pest::iterators::Pair<Rule>, lines: &LineIndex<'_>) -> Result<NpcAst, AstError> {
+    let span = Span::from(npc.as_span());
+    let src_line = lines.line_col(span.start()).0;
     let mut it = npc.into_inner();
     let id = it
         .next()
@@ -310,5 +312,6 @@ pub(super) fn parse_npc_pair(npc: pest::iterators::Pair<Rule>, _source: &str) ->
         movement,
         dialogue,
         src_line,
+        span,
     })
 }
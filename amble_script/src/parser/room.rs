@@ -1,13 +1,14 @@
+use crate::span::{LineIndex, Span};
 use crate::{RoomAst, RoomSceneryAst};
 
 use super::helpers::unquote;
 use super::{AstError, Rule};
 
-pub(super) fn parse_room_pair(room: pest::iterators::Pair<Rule>, _source: &str) -> Result<RoomAst, AstError> {
+pub(super) fn parse_room_pair(room: pest::iterators::Pair<Rule>, lines: &LineIndex<'_>) -> Result<RoomAst, AstError> {
     // room_def = "room" ~ ident ~ room_block
-    let (src_line, _src_col) = room.as_span().start_pos().line_col();
+    let span = Span::from(room.as_span());
+    let src_line = lines.line_col(span.start()).0;
     let mut it = room.into_inner();
-    // capture source line from the outer pair's span; .line_col() is 1-based
     // Note: this is the start of the room keyword; good enough for a reference
     let id = it
         .next()
@@ -59,6 +60,7 @@ pub(super) fn parse_room_pair(room: pest::iterators::Pair<Rule>, _source: &str)
                 visited = Some(val);
             },
             Rule::exit_stmt => {
+                let exit_span = Span::from(inner_stmt.as_span());
                 let mut it = inner_stmt.into_inner();
                 let dir_tok = it.next().ok_or(AstError::Shape("exit direction"))?;
                 let dir = if dir_tok.as_rule() == Rule::string {
@@ -133,6 +135,7 @@ pub(super) fn parse_room_pair(room: pest::iterators::Pair<Rule>, _source: &str)
                     dir,
                     crate::ExitAst {
                         to,
+                        span: exit_span,
                         hidden,
                         locked,
                         barred_message,
@@ -390,5 +393,6 @@ pub(super) fn parse_room_pair(room: pest::iterators::Pair<Rule>, _source: &str)
         scenery,
         scenery_default,
         src_line,
+        span,
     })
 }
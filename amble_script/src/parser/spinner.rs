@@ -1,10 +1,15 @@
+use crate::span::{LineIndex, Span};
 use crate::{SpinnerAst, SpinnerWedgeAst};
 
 use super::helpers::unquote;
 use super::{AstError, Rule};
 
-pub(super) fn parse_spinner_pair(sp: pest::iterators::Pair<Rule>, _source: &str) -> Result<SpinnerAst, AstError> {
-    let (src_line, _src_col) = sp.as_span().start_pos().line_col();
+pub(super) fn parse_spinner_pair(
+    sp: pest::iterators::Pair<Rule>,
+    lines: &LineIndex<'_>,
+) -> Result<SpinnerAst, AstError> {
+    let span = Span::from(sp.as_span());
+    let src_line = lines.line_col(span.start()).0;
     let mut it = sp.into_inner();
     let id = it
         .next()
@@ -32,5 +37,10 @@ pub(super) fn parse_spinner_pair(sp: pest::iterators::Pair<Rule>, _source: &str)
         };
         wedges.push(SpinnerWedgeAst { text, width });
     }
-    Ok(SpinnerAst { id, wedges, src_line })
+    Ok(SpinnerAst {
+        id,
+        wedges,
+        src_line,
+        span,
+    })
 }
@@ -1,24 +1,26 @@
 use pest::Parser;
 use std::collections::HashMap;
 
+use crate::span::{LineIndex, Span};
 use crate::{ActionStmt, ConditionAst, IngestModeAst, TriggerAst};
 
 use super::actions::{
     parse_action_from_str, parse_if_action, parse_modify_item_action, parse_modify_npc_action,
     parse_modify_room_action, parse_schedule_action,
 };
-use super::helpers::{SourceMap, extract_body, is_ident_char, str_offset, unquote};
+use super::helpers::{extract_body, is_ident_char, str_offset, unquote};
 use super::{AstError, DslParser, Rule};
 
 pub(super) fn parse_trigger_pair(
     trig: pest::iterators::Pair<Rule>,
     source: &str,
-    smap: &SourceMap,
+    smap: &LineIndex<'_>,
     sets: &HashMap<String, Vec<String>>,
     aliases: &HashMap<String, ConditionAst>,
     action_sets: &HashMap<String, Vec<ActionStmt>>,
 ) -> Result<Vec<TriggerAst>, AstError> {
-    let src_line = trig.as_span().start_pos().line_col().0;
+    let span = Span::from(trig.as_span());
+    let src_line = smap.line_col(span.start()).0;
     let mut it = trig.into_inner();
 
     // trigger -> "trigger" ~ string ~ (only once|note)* ~ "when" ~ when_cond ~ block
@@ -46,6 +48,7 @@ pub(super) fn parse_trigger_pair(
         }
         next_pair = it.next().ok_or(AstError::Shape("expected when or more modifiers"))?;
     }
+    let event_span = Span::from(next_pair.as_span());
     let mut when = next_pair;
     if when.as_rule() == Rule::when_cond {
         when = when.into_inner().next().ok_or(AstError::Shape("empty when_cond"))?;
@@ -254,6 +257,8 @@ pub(super) fn parse_trigger_pair(
     let mut unconditional_actions: Vec<ActionStmt> = Vec::new();
     let mut lowered: Vec<TriggerAst> = Vec::new();
     let mut resolve_action_set = |name: &str| Ok(action_sets.get(name).cloned());
+    let base = str_offset(source, inner);
+    let span_of = |start: usize, end: usize| smap.source_span(base + start, base + end);
     let bytes = inner.as_bytes();
     let mut i = 0usize;
     while i < inner.len() {
@@ -273,6 +278,7 @@ pub(super) fn parse_trigger_pair(
         }
         if let Some((action, new_i)) = parse_if_action(inner, i, source, smap, sets, aliases, &mut resolve_action_set)?
         {
+            let if_span = span_of(i, new_i);
             match action.action {
                 crate::ActionAst::Conditional {
                     condition,
@@ -282,7 +288,10 @@ pub(super) fn parse_trigger_pair(
                     name: name.clone(),
                     note: None,
                     src_line,
+                    span,
+                    event_span,
                     event: event.clone(),
+                    conditions_span: if_span.span,
                     conditions: vec![*condition],
                     actions,
                     only_once,
@@ -290,6 +299,7 @@ pub(super) fn parse_trigger_pair(
                 other => unconditional_actions.push(ActionStmt {
                     priority: action.priority,
                     action: other,
+                    span: if_span,
                 }),
             }
             i = new_i;
@@ -298,7 +308,7 @@ pub(super) fn parse_trigger_pair(
         let remainder = &inner[i..];
         match parse_modify_item_action(remainder, sets, aliases) {
             Ok((action, used)) => {
-                unconditional_actions.push(action);
+                unconditional_actions.push(action.at(span_of(i, i + used)));
                 i += used;
                 continue;
             },
@@ -307,7 +317,7 @@ pub(super) fn parse_trigger_pair(
                 let base = str_offset(source, inner);
                 let abs = base + i;
                 let (line_no, col) = smap.line_col(abs);
-                let snippet = smap.line_snippet(line_no);
+                let snippet = smap.line(line_no);
                 return Err(AstError::ShapeAt {
                     msg: m,
                     context: format!(
@@ -320,7 +330,7 @@ pub(super) fn parse_trigger_pair(
         }
         match parse_modify_room_action(remainder) {
             Ok((action, used)) => {
-                unconditional_actions.push(action);
+                unconditional_actions.push(action.at(span_of(i, i + used)));
                 i += used;
                 continue;
             },
@@ -329,7 +339,7 @@ pub(super) fn parse_trigger_pair(
                 let base = str_offset(source, inner);
                 let abs = base + i;
                 let (line_no, col) = smap.line_col(abs);
-                let snippet = smap.line_snippet(line_no);
+                let snippet = smap.line(line_no);
                 return Err(AstError::ShapeAt {
                     msg: m,
                     context: format!(
@@ -343,7 +353,7 @@ pub(super) fn parse_trigger_pair(
 
         match parse_modify_npc_action(remainder) {
             Ok((action, used)) => {
-                unconditional_actions.push(action);
+                unconditional_actions.push(action.at(span_of(i, i + used)));
                 i += used;
                 continue;
             },
@@ -352,7 +362,7 @@ pub(super) fn parse_trigger_pair(
                 let base = str_offset(source, inner);
                 let abs = base + i;
                 let (line_no, col) = smap.line_col(abs);
-                let snippet = smap.line_snippet(line_no);
+                let snippet = smap.line(line_no);
                 return Err(AstError::ShapeAt {
                     msg: m,
                     context: format!(
@@ -366,7 +376,7 @@ pub(super) fn parse_trigger_pair(
         // Top-level do schedule ... or do ... line
         match parse_schedule_action(remainder, source, smap, sets, aliases, &mut resolve_action_set) {
             Ok((action, used)) => {
-                unconditional_actions.push(action);
+                unconditional_actions.push(action.at(span_of(i, i + used)));
                 i += used;
                 continue;
             },
@@ -414,12 +424,12 @@ pub(super) fn parse_trigger_pair(
             }
             let line = inner[i..j].trim_end();
             match parse_action_from_str(line) {
-                Ok(a) => unconditional_actions.push(a),
+                Ok(a) => unconditional_actions.push(a.at(span_of(i, j))),
                 Err(AstError::Shape(m)) => {
                     let base = str_offset(source, inner);
                     let abs = base + i;
                     let (line_no, col) = smap.line_col(abs);
-                    let snippet = smap.line_snippet(line_no);
+                    let snippet = smap.line(line_no);
                     return Err(AstError::ShapeAt {
                         msg: m,
                         context: format!(
@@ -443,7 +453,10 @@ pub(super) fn parse_trigger_pair(
             name,
             note: trig_note.clone(),
             src_line,
+            span,
+            event_span,
             event,
+            conditions_span: span,
             conditions: Vec::new(),
             actions: unconditional_actions,
             only_once,
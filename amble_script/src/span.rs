@@ -0,0 +1,167 @@
+//! Source spans and line lookup for diagnostics.
+//!
+//! Definition nodes (triggers, rooms, items, spinners, NPCs, goals) and room exits
+//! carry the byte [`Span`] of their source text. Action statements carry a
+//! [`SourceSpan`], because a `run` can inline statements declared in another file.
+//! A [`LineIndex`] built once per file borrows that file's text and turns byte
+//! offsets into line/column positions by binary search, so diagnostics never copy
+//! or re-scan the source.
+
+use serde::{Deserialize, Serialize};
+
+/// Half-open byte range `start..end` within one source file.
+///
+/// Spans are relative to the file the node was parsed from; a multi-file build
+/// keeps one AST bundle per file, so the bundle's position identifies the file.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Hash, Serialize, Deserialize)]
+pub struct Span {
+    pub start: u32,
+    pub end: u32,
+}
+
+impl Span {
+    /// Span of `start..end` (offsets past `u32::MAX` saturate).
+    pub fn new(start: usize, end: usize) -> Self {
+        let clamp = |offset: usize| u32::try_from(offset).unwrap_or(u32::MAX);
+        Self {
+            start: clamp(start),
+            end: clamp(end),
+        }
+    }
+
+    /// Start offset as a `usize`.
+    pub fn start(self) -> usize {
+        self.start as usize
+    }
+
+    /// End offset as a `usize`.
+    pub fn end(self) -> usize {
+        self.end as usize
+    }
+
+    /// The spanned text of `source`, or `""` if the span does not fit it.
+    pub fn slice(self, source: &str) -> &str {
+        source.get(self.start()..self.end()).unwrap_or("")
+    }
+}
+
+impl From<pest::Span<'_>> for Span {
+    fn from(span: pest::Span<'_>) -> Self {
+        Self::new(span.start(), span.end())
+    }
+}
+
+/// A [`Span`] together with the file it belongs to.
+///
+/// `file` is `None` for the file whose AST holds the node. Statements inlined from a
+/// `let actions` set declared in another file of a multi-file build carry
+/// `Some(index)` of that file in the compiled sources, which is also the position
+/// of its AST bundle.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Hash, Serialize, Deserialize)]
+pub struct SourceSpan {
+    pub file: Option<u32>,
+    pub span: Span,
+}
+
+impl From<Span> for SourceSpan {
+    /// A span in the file whose AST holds the node.
+    fn from(span: Span) -> Self {
+        Self { file: None, span }
+    }
+}
+
+/// Line start offsets of one source file, borrowing its text.
+#[derive(Debug, Clone)]
+pub struct LineIndex<'a> {
+    source: &'a str,
+    line_starts: Vec<usize>,
+    /// File and byte offset of `source` within it, for [`Self::source_span`].
+    file: Option<u32>,
+    base: usize,
+}
+
+impl<'a> LineIndex<'a> {
+    /// Index the lines of `source`.
+    pub fn new(source: &'a str) -> Self {
+        Self::excerpt(source, None, 0)
+    }
+
+    /// Index the lines of `source`, an excerpt starting at byte `base` of `file`
+    /// (such as the body of a `let actions` declaration).
+    ///
+    /// Line and column positions stay relative to the excerpt; only
+    /// [`source_span`](Self::source_span) maps back into the file.
+    pub fn excerpt(source: &'a str, file: Option<u32>, base: usize) -> Self {
+        let line_starts = std::iter::once(0)
+            .chain(source.match_indices('\n').map(|(i, _)| i + 1))
+            .collect();
+        Self {
+            source,
+            line_starts,
+            file,
+            base,
+        }
+    }
+
+    /// The [`SourceSpan`] of bytes `start..end` of the indexed text.
+    pub fn source_span(&self, start: usize, end: usize) -> SourceSpan {
+        SourceSpan {
+            file: self.file,
+            span: Span::new(self.base + start, self.base + end),
+        }
+    }
+
+    /// The indexed source text.
+    pub fn source(&self) -> &'a str {
+        self.source
+    }
+
+    /// 1-based `(line, column)` of byte `offset`; the column counts bytes.
+    pub fn line_col(&self, offset: usize) -> (usize, usize) {
+        let idx = match self.line_starts.binary_search(&offset) {
+            Ok(i) => i,
+            Err(i) => i.saturating_sub(1),
+        };
+        let line_start = self.line_starts.get(idx).copied().unwrap_or(0);
+        (idx + 1, offset.saturating_sub(line_start) + 1)
+    }
+
+    /// Text of 1-based line `line_no`, without its line ending.
+    pub fn line(&self, line_no: usize) -> &'a str {
+        let start = self
+            .line_starts
+            .get(line_no.saturating_sub(1))
+            .copied()
+            .unwrap_or(self.source.len());
+        let end = self.line_starts.get(line_no).copied().unwrap_or(self.source.len());
+        self.source[start..end].trim_end_matches(['\r', '\n'])
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn line_index_maps_offsets_and_lines() {
+        let src = "room a {\r\n  name \"A\"\n}\n";
+        let index = LineIndex::new(src);
+        assert_eq!(index.line_col(0), (1, 1));
+        assert_eq!(index.line_col(src.find("name").unwrap()), (2, 3));
+        assert_eq!(index.line_col(src.len()), (4, 1));
+        assert_eq!(index.line(1), "room a {");
+        assert_eq!(index.line(2), "  name \"A\"");
+        assert_eq!(index.line(9), "");
+        assert_eq!(Span::new(2, 6).slice(src), "om a");
+
+        let excerpt = LineIndex::excerpt("  name", Some(3), 10);
+        assert_eq!(excerpt.line_col(2), (1, 3));
+        assert_eq!(
+            excerpt.source_span(2, 6),
+            SourceSpan {
+                file: Some(3),
+                span: Span::new(12, 16)
+            }
+        );
+    }
+}
@@ -0,0 +1,140 @@
+//! Symbol table of the ids a set of sources defines.
+//!
+//! Built straight from lowered ASTs, so cross-reference checks see the sources as
+//! they are now rather than the last compiled `world.ron`. Flags count as defined
+//! when some trigger sets them (`add flag` / `add seq flag`), including inside
+//! conditional and scheduled action blocks.
+
+use std::collections::HashSet;
+
+use crate::parser::ProgramAstBundle;
+use crate::{ActionAst, ActionStmt};
+
+/// Ids defined across a set of sources, by kind.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct SymbolTable {
+    pub rooms: HashSet<String>,
+    pub items: HashSet<String>,
+    pub npcs: HashSet<String>,
+    pub spinners: HashSet<String>,
+    pub goals: HashSet<String>,
+    /// Base names of flags set by some trigger (sequence flags without a `#step`).
+    pub flags: HashSet<String>,
+}
+
+impl SymbolTable {
+    /// Collect the ids defined by every bundle.
+    pub fn from_bundles<'a>(bundles: impl IntoIterator<Item = &'a ProgramAstBundle>) -> Self {
+        let mut table = Self::default();
+        for bundle in bundles {
+            table.add_bundle(bundle);
+        }
+        table
+    }
+
+    /// Add the ids defined by one file's ASTs.
+    pub fn add_bundle(&mut self, bundle: &ProgramAstBundle) {
+        let (_game, triggers, rooms, items, spinners, npcs, goals) = bundle;
+        self.rooms.extend(rooms.iter().map(|room| room.id.clone()));
+        self.items.extend(items.iter().map(|item| item.id.clone()));
+        self.npcs.extend(npcs.iter().map(|npc| npc.id.clone()));
+        self.spinners.extend(spinners.iter().map(|spinner| spinner.id.clone()));
+        self.goals.extend(goals.iter().map(|goal| goal.id.clone()));
+        for trigger in triggers {
+            collect_set_flags(&trigger.actions, &mut self.flags);
+        }
+    }
+
+    /// Add every id of `other`.
+    pub fn extend(&mut self, other: SymbolTable) {
+        self.rooms.extend(other.rooms);
+        self.items.extend(other.items);
+        self.npcs.extend(other.npcs);
+        self.spinners.extend(other.spinners);
+        self.goals.extend(other.goals);
+        self.flags.extend(other.flags);
+    }
+
+    /// Ids of `kind` (`room`, `item`, `npc`, `spinner`, `goal` or `flag`).
+    pub fn ids(&self, kind: &str) -> Option<&HashSet<String>> {
+        match kind {
+            "room" => Some(&self.rooms),
+            "item" => Some(&self.items),
+            "npc" => Some(&self.npcs),
+            "spinner" => Some(&self.spinners),
+            "goal" => Some(&self.goals),
+            "flag" => Some(&self.flags),
+            _ => None,
+        }
+    }
+
+    /// True if `id` of `kind` is defined; flag references may carry a `#step` suffix.
+    pub fn contains(&self, kind: &str, id: &str) -> bool {
+        let id = if kind == "flag" {
+            id.split('#').next().unwrap_or(id)
+        } else {
+            id
+        };
+        self.ids(kind).is_some_and(|ids| ids.contains(id))
+    }
+}
+
+fn collect_set_flags(actions: &[ActionStmt], out: &mut HashSet<String>) {
+    for stmt in actions {
+        match &stmt.action {
+            ActionAst::AddFlag(name) | ActionAst::AddSeqFlag { name, .. } => {
+                out.insert(name.clone());
+            },
+            ActionAst::Conditional {
+                actions, false_actions, ..
+            } => {
+                collect_set_flags(actions, out);
+                if let Some(false_actions) = false_actions {
+                    collect_set_flags(false_actions, out);
+                }
+            },
+            ActionAst::ScheduleIn { actions, .. }
+            | ActionAst::ScheduleOn { actions, .. }
+            | ActionAst::ScheduleInIf { actions, .. }
+            | ActionAst::ScheduleOnIf { actions, .. } => collect_set_flags(actions, out),
+            _ => {},
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::parse_program_full;
+
+    #[test]
+    fn collects_ids_and_nested_flags() {
+        let src = r#"
+room hall {
+  name "Hall"
+  desc "A hall."
+}
+item lamp {
+  name "Lamp"
+  desc "A lamp."
+  location room hall
+}
+trigger "Light" when take lamp {
+  do add flag lamp-taken
+  if has flag lamp-taken {
+    do schedule in 2 {
+      do add seq flag lamp-glow limit 3
+    }
+  }
+}
+"#;
+        let bundle = parse_program_full(src).expect("parse");
+        let table = SymbolTable::from_bundles([&bundle]);
+        assert!(table.contains("room", "hall"));
+        assert!(table.contains("item", "lamp"));
+        assert!(table.contains("flag", "lamp-taken"));
+        assert!(table.contains("flag", "lamp-glow#2"));
+        assert!(!table.contains("room", "lamp"));
+        assert!(!table.contains("npc", "hall"));
+    }
+}
@@ -323,6 +323,31 @@ fn refresh_content(workspace: &Workspace, args: &ContentRefreshArgs) -> Result<(
                 target_world.display()
             )
         })?;
+        let compiled_manifest = staging_dir.join("world.meta");
+        let target_manifest = worlds_dir.join(format!("{}.meta", world.slug));
+        fs::copy(&compiled_manifest, &target_manifest).with_context(|| {
+            format!(
+                "copying world manifest from {} to {}",
+                compiled_manifest.display(),
+                target_manifest.display()
+            )
+        })?;
+        // the binary artifact is only emitted for worlds that pass validation; drop any
+        // artifact left from an earlier build so it can't shadow the new world
+        let compiled_artifact = staging_dir.join("world.amblebin");
+        let target_artifact = worlds_dir.join(format!("{}.amblebin", world.slug));
+        if compiled_artifact.is_file() {
+            fs::copy(&compiled_artifact, &target_artifact).with_context(|| {
+                format!(
+                    "copying world artifact from {} to {}",
+                    compiled_artifact.display(),
+                    target_artifact.display()
+                )
+            })?;
+        } else if target_artifact.exists() {
+            fs::remove_file(&target_artifact)
+                .with_context(|| format!("removing stale world artifact {}", target_artifact.display()))?;
+        }
 
         let mut lint_cmd = cargo_cmd("run", workspace);
         lint_cmd.arg("-p").arg("amble_script").arg("--bin").arg("amble_script");